@@ -0,0 +1,60 @@
+// host/AllocCounter.cpp
+#include <stdlib.h>
+#include <new>
+#include "./AllocCounter.h"
+
+std::atomic<uint64_t> AllocCounter::allocations{0};
+std::atomic<uint64_t> AllocCounter::allocatedBytes{0};
+
+static void *countedAlloc(size_t size)
+{
+    AllocCounter::allocations.fetch_add(1, std::memory_order_relaxed);
+    AllocCounter::allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    return malloc(size ? size : 1);
+}
+
+void *operator new(size_t size)
+{
+    void *pointer = countedAlloc(size);
+    if (!pointer)
+        throw std::bad_alloc();
+    return pointer;
+}
+
+void *operator new[](size_t size)
+{
+    void *pointer = countedAlloc(size);
+    if (!pointer)
+        throw std::bad_alloc();
+    return pointer;
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    return countedAlloc(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    return countedAlloc(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+    free(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept
+{
+    free(pointer);
+}
@@ -0,0 +1,25 @@
+// host/AllocCounter.h
+#pragma once
+#include <stdint.h>
+#include <atomic>
+
+// Счетчик выделений памяти в host-сборке: глобальные operator new/delete
+// заменены в AllocCounter.cpp. Для замеров аллокаций на кадр.
+// Короткие строки std::string (внутри String шима) хранятся без кучи -
+// на ESP32 String выделяет память под любую непустую строку.
+class AllocCounter
+{
+public:
+    static std::atomic<uint64_t> allocations;
+    static std::atomic<uint64_t> allocatedBytes;
+
+    static uint64_t getAllocations()
+    {
+        return allocations.load(std::memory_order_relaxed);
+    }
+
+    static uint64_t getAllocatedBytes()
+    {
+        return allocatedBytes.load(std::memory_order_relaxed);
+    }
+};
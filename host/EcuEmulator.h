@@ -0,0 +1,353 @@
+// host/EcuEmulator.h
+#pragma once
+#include <Arduino.h>
+#include <poll.h>
+#include <unistd.h>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "infrastructure/protocol/WBusFramer.h"
+#include "interfaces/IClock.h"
+#include "./EcuModel.h"
+
+// Профиль помех на линии между контроллером и эмулятором.
+// Вероятности - в промилле (на кадр, для потери байт - на байт).
+struct EcuFaultProfile
+{
+    const char *name;
+    uint32_t latencyMinMs;   // Задержка ответа блока
+    uint32_t latencyMaxMs;
+    uint32_t byteTimeUs;     // Время байта на линии (0 - кадр целиком)
+    uint16_t nakPerMille;    // NAK 0x22 вместо ответа
+    uint16_t silencePerMille; // Нет ответа
+    uint16_t dropPerMille;   // Потерянный байт ответа
+    uint16_t flipPerMille;   // Инвертированный бит в ответе
+    uint16_t noisePerMille;  // Мусорный байт перед ответом
+    uint32_t unsupportedSensors; // Маска страниц 0x50 (бит = индекс), на которые NAK 0x33
+    bool multiRead;          // Поддержка группового чтения 0x50 0x30
+
+    // 2400 бод, 8E1: 11 бит на байт
+    static const uint32_t WIRE_BYTE_US = 4583;
+
+    static const EcuFaultProfile *getProfiles(size_t &count)
+    {
+        static const EcuFaultProfile profiles[] = {
+            {"clean", 20, 40, WIRE_BYTE_US, 0, 0, 0, 0, 0, 0, true},
+            {"slow", 150, 450, WIRE_BYTE_US, 0, 0, 0, 0, 0, 0, true},
+            {"nak", 20, 40, WIRE_BYTE_US, 100, 0, 0, 0, 0, 0, true},
+            {"lossy", 20, 40, WIRE_BYTE_US, 0, 30, 5, 0, 0, 0, true},
+            {"noisy", 20, 40, WIRE_BYTE_US, 0, 0, 0, 50, 50, 0, true},
+            {"unsupported", 20, 40, WIRE_BYTE_US, 0, 0, 0, 0, 0, (1UL << 0x0A) | (1UL << 0x0F) | (1UL << 0x13), false},
+            {"stress", 30, 300, WIRE_BYTE_US, 50, 20, 3, 30, 30, 1UL << 0x13, true}};
+        count = sizeof(profiles) / sizeof(profiles[0]);
+        return profiles;
+    }
+
+    static const EcuFaultProfile *find(const String &name)
+    {
+        size_t count = 0;
+        const EcuFaultProfile *profiles = getProfiles(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            if (name == profiles[i].name)
+                return &profiles[i];
+        }
+        return nullptr;
+    }
+
+    bool isUnsupported(const uint8_t *request, size_t length) const
+    {
+        if (length < 5 || request[2] != WBusCommandBuilder::CMD_READ_SENSOR)
+            return false;
+
+        if (request[3] != WBusCommandBuilder::SENSOR_MULTI_READ)
+            return request[3] < 32 && (unsupportedSensors & (1UL << request[3]));
+
+        if (!multiRead)
+            return true;
+        for (size_t i = 4; i + 1 < length; i++)
+        {
+            if (request[i] < 32 && (unsupportedSensors & (1UL << request[i])))
+                return true;
+        }
+        return false;
+    }
+};
+
+// Счетчики эмулятора: что пришло и какие помехи внесены
+struct EcuEmulatorStats
+{
+    uint32_t requests = 0;
+    uint32_t responses = 0; // Отправленные кадры (ACK и NAK)
+    uint32_t naks = 0;      // NAK модели (состояние, неизвестная страница)
+    uint32_t injectedNaks = 0;
+    uint32_t unsupported = 0;
+    uint32_t silenced = 0;
+    uint32_t droppedBytes = 0;
+    uint32_t flippedFrames = 0;
+    uint32_t noiseBytes = 0;
+
+    String toJson() const
+    {
+        String json = "{";
+        json += "\"requests\":" + String(requests) + ",";
+        json += "\"responses\":" + String(responses) + ",";
+        json += "\"naks\":" + String(naks) + ",";
+        json += "\"injectedNaks\":" + String(injectedNaks) + ",";
+        json += "\"unsupported\":" + String(unsupported) + ",";
+        json += "\"silenced\":" + String(silenced) + ",";
+        json += "\"droppedBytes\":" + String(droppedBytes) + ",";
+        json += "\"flippedFrames\":" + String(flippedFrames) + ",";
+        json += "\"noiseBytes\":" + String(noiseBytes);
+        json += "}";
+        return json;
+    }
+};
+
+// Эмулятор блока на своем конце линии: выделяет запросы F4, отвечает через
+// EcuModel с задержкой и помехами профиля. Ответ раскладывается по времени
+// (байт за байтом) в очередь исходящих. Два режима:
+// - start(fd): отдельный поток пишет байты в socketpair/PTY по реальным часам,
+//   как настоящий блок - независимо от основного цикла;
+// - виртуальная линия (HostBusManager::openVirtual): receive() и takeDue()
+//   вызываются из цикла, время задает VirtualClock.
+class EcuEmulator
+{
+private:
+    struct ScheduledByte
+    {
+        int64_t dueUs;
+        uint8_t value;
+        bool endOfBurst; // Последний байт ответа: момент, когда его стоит забрать
+    };
+
+    IClock &clock;
+    int fd = -1;
+    EcuModel model;
+    WBusFramer framer{0}; // Паузы внутри запроса не проверяем
+    EcuFaultProfile profile;
+    EcuEmulatorStats stats;
+    mutable std::mutex mutex; // profile, stats, phase, outgoing
+    EcuModel::Phase phase = EcuModel::Phase::OFF;
+    uint32_t initialSeed;
+    uint32_t randomState;
+    std::deque<ScheduledByte> outgoing;
+    int64_t lineFreeUs = 0; // Конец последнего запланированного байта
+
+    // xorshift32: воспроизводимые прогоны при одинаковом seed
+    uint32_t nextRandom()
+    {
+        randomState ^= randomState << 13;
+        randomState ^= randomState >> 17;
+        randomState ^= randomState << 5;
+        return randomState;
+    }
+
+    bool roll(uint16_t perMille)
+    {
+        return perMille > 0 && nextRandom() % 1000 < perMille;
+    }
+
+    // Байт на линии с момента atUs; потерянный байт занимает время, но не доставляется
+    void scheduleByte(int64_t &atUs, uint8_t value, bool deliver, uint32_t byteTimeUs)
+    {
+        atUs += byteTimeUs;
+        if (deliver)
+            outgoing.push_back({atUs, value, false});
+    }
+
+    // Запрос принят целиком к моменту endUs
+    void serve(const uint8_t *request, size_t length, int64_t endUs)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.requests++;
+
+        std::vector<uint8_t> response;
+        if (roll(profile.silencePerMille))
+        {
+            stats.silenced++;
+            phase = model.getPhase();
+            return;
+        }
+
+        if (roll(profile.nakPerMille))
+        {
+            stats.injectedNaks++;
+            EcuModel::createNak(request[2], EcuModel::NAK_CONDITIONS, response);
+        }
+        else if (profile.isUnsupported(request, length))
+        {
+            stats.unsupported++;
+            EcuModel::createNak(request[2], EcuModel::NAK_UNSUPPORTED, response);
+        }
+        else
+        {
+            model.respond(request, length, static_cast<unsigned long>(endUs / 1000), response);
+            stats.naks += response[2] == 0x7F ? 1 : 0;
+        }
+        phase = model.getPhase();
+
+        uint32_t span = profile.latencyMaxMs > profile.latencyMinMs ? profile.latencyMaxMs - profile.latencyMinMs : 0;
+        int64_t atUs = endUs + (profile.latencyMinMs + (span > 0 ? nextRandom() % (span + 1) : 0)) * 1000LL;
+        if (atUs < lineFreeUs)
+            atUs = lineFreeUs; // Однопроводная линия: ответы не накладываются
+
+        if (roll(profile.flipPerMille))
+        {
+            // Заголовок не трогаем - иначе это просто потерянный кадр
+            size_t position = 1 + nextRandom() % (response.size() - 1);
+            response[position] ^= static_cast<uint8_t>(1 << (nextRandom() % 8));
+            stats.flippedFrames++;
+        }
+
+        size_t queuedBefore = outgoing.size();
+        if (roll(profile.noisePerMille))
+        {
+            scheduleByte(atUs, static_cast<uint8_t>(0x01 + nextRandom() % 0x40), true, profile.byteTimeUs);
+            stats.noiseBytes++;
+        }
+
+        for (uint8_t value : response)
+        {
+            bool dropped = roll(profile.dropPerMille);
+            stats.droppedBytes += dropped ? 1 : 0;
+            scheduleByte(atUs, value, !dropped, profile.byteTimeUs);
+        }
+
+        if (outgoing.size() > queuedBefore)
+            outgoing.back().endOfBurst = true;
+        lineFreeUs = atUs;
+        stats.responses++;
+    }
+
+    void run()
+    {
+        uint8_t buffer[64];
+        std::vector<uint8_t> due;
+        while (true)
+        {
+            // Ждем запрос, но не дольше, чем до следующего байта ответа
+            int64_t nextUs = nextByteUs();
+            int timeoutMs = nextUs < 0 ? 50 : static_cast<int>((nextUs - clock.nowUs() + 999) / 1000);
+            pollfd descriptor = {fd, POLLIN, 0};
+            if (::poll(&descriptor, 1, timeoutMs < 0 ? 0 : timeoutMs) > 0)
+            {
+                ssize_t count = ::read(fd, buffer, sizeof(buffer));
+                if (count <= 0)
+                    return;
+                receive(buffer, static_cast<size_t>(count), clock.nowUs());
+            }
+
+            due.clear();
+            takeDue(clock.nowUs(), due);
+            for (uint8_t value : due)
+            {
+                ssize_t written = ::write(fd, &value, 1);
+                (void)written;
+            }
+        }
+    }
+
+    int64_t nextByteUs() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return outgoing.empty() ? -1 : outgoing.front().dueUs;
+    }
+
+public:
+    EcuEmulator(const EcuFaultProfile &initial, IClock &clk, uint32_t seed = 1)
+        : clock(clk), profile(initial), initialSeed(seed != 0 ? seed : 1), randomState(initialSeed) {}
+
+    // Поток эмулятора живет до завершения процесса
+    void start(int descriptor)
+    {
+        fd = descriptor;
+        std::thread([this]()
+                    { run(); })
+            .detach();
+    }
+
+    // Байты запроса с линии; законченный запрос F4 планирует ответ
+    void receive(const uint8_t *data, size_t length, int64_t nowUs)
+    {
+        for (size_t i = 0; i < length; i++)
+        {
+            framer.feed(data[i], static_cast<uint32_t>(nowUs), [this, nowUs](const uint8_t *frame, size_t frameLength)
+                        {
+                            if (frame[0] == TXHEADER)
+                                serve(frame, frameLength, nowUs); });
+        }
+    }
+
+    // Байты ответа, время которых наступило
+    void takeDue(int64_t nowUs, std::vector<uint8_t> &out)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        while (!outgoing.empty() && outgoing.front().dueUs <= nowUs)
+        {
+            out.push_back(outgoing.front().value);
+            outgoing.pop_front();
+        }
+    }
+
+    // Конец ближайшего ответа (мкс), -1 - передавать нечего.
+    // Виртуальная линия забирает ответ целиком, а не по байту
+    int64_t nextBurstEndUs() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const ScheduledByte &scheduled : outgoing)
+        {
+            if (scheduled.endOfBurst)
+                return scheduled.dueUs;
+        }
+        return outgoing.empty() ? -1 : outgoing.back().dueUs;
+    }
+
+    void setProfile(const EcuFaultProfile &next)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        profile = next;
+    }
+
+    String getProfileName() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return profile.name;
+    }
+
+    EcuEmulatorStats getStats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats;
+    }
+
+    void resetStats()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats = EcuEmulatorStats();
+    }
+
+    // Новый блок с профилем next: модель выключена, неотправленные ответы
+    // отброшены, случайная последовательность начинается заново с seed
+    void restart(const EcuFaultProfile &next)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        profile = next;
+        model = EcuModel();
+        framer.reset();
+        stats = EcuEmulatorStats();
+        phase = EcuModel::Phase::OFF;
+        randomState = initialSeed;
+        outgoing.clear();
+        lineFreeUs = 0;
+    }
+
+    String toJson() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return "{\"profile\":\"" + String(profile.name) + "\",\"phase\":\"" + EcuModel::getPhaseName(phase) +
+               "\",\"stats\":" + stats.toJson() + "}";
+    }
+};
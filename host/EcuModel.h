@@ -0,0 +1,522 @@
+// host/EcuModel.h
+#pragma once
+#include <Arduino.h>
+#include <vector>
+#include "common/ProtocolConstants.h"
+#include "infrastructure/protocol/WBusCommandBuilder.h"
+
+// Программная модель блока управления Webasto: отвечает на все запросы,
+// которые собирает WBusCommandBuilder. Фазы работы сжаты по времени
+// (запуск - секунды, а не минуты), значения датчиков следуют за фазой.
+// Без потоков и ввода-вывода: запрос -> ответ, время передается снаружи.
+class EcuModel
+{
+public:
+    enum class Phase
+    {
+        OFF,         // Выключен
+        START,       // Старт: свеча и вентилятор
+        STABILIZE,   // Стабилизация пламени
+        RUN,         // Горение полная нагрузка
+        VENTILATION, // Вентиляция без горения
+        SHUTDOWN     // Продувка после выключения
+    };
+
+    static const uint8_t NAK_CONDITIONS = 0x22;  // Команда недопустима в текущем состоянии
+    static const uint8_t NAK_UNSUPPORTED = 0x33; // Неизвестная команда или страница
+
+    static const unsigned long START_DURATION_MS = 4000;
+    static const unsigned long STABILIZE_DURATION_MS = 2000;
+    static const unsigned long SHUTDOWN_DURATION_MS = 3000;
+
+private:
+    struct StoredError
+    {
+        uint8_t code;
+        uint8_t counter;
+
+        StoredError(uint8_t errorCode, uint8_t errorCounter) : code(errorCode), counter(errorCounter) {}
+    };
+
+    Phase phase = Phase::OFF;
+    unsigned long phaseSince = 0;
+    uint8_t mode = 0;           // Команда запуска (0x21/0x22/0x23/0x25)
+    unsigned long runUntil = 0; // Окончание заданного времени работы
+    bool circulationPump = false;
+
+    uint8_t testComponent = 0; // Тест компонента (0 - нет)
+    uint8_t testMagnitude = 0;
+    unsigned long testUntil = 0;
+
+    float temperature = 20.0f;
+    unsigned long lastUpdate = 0;
+
+    uint16_t workingHours = 412;
+    uint8_t workingMinutes = 17;
+    uint16_t startCounter = 1093;
+    std::vector<StoredError> errors = {{0x12, 3}, {0x2A, 1}};
+
+    static void appendWord(std::vector<uint8_t> &out, uint16_t value)
+    {
+        out.push_back(static_cast<uint8_t>(value >> 8));
+        out.push_back(static_cast<uint8_t>(value & 0xFF));
+    }
+
+    static void appendText(std::vector<uint8_t> &out, const char *text)
+    {
+        while (*text)
+            out.push_back(static_cast<uint8_t>(*text++));
+    }
+
+    void setPhase(Phase next, unsigned long now)
+    {
+        if (phase == next)
+            return;
+
+        if (next == Phase::START)
+            startCounter++;
+        phase = next;
+        phaseSince = now;
+    }
+
+    bool isHeating() const
+    {
+        return phase == Phase::START || phase == Phase::STABILIZE || phase == Phase::RUN;
+    }
+
+    bool isActive() const
+    {
+        return isHeating() || phase == Phase::VENTILATION;
+    }
+
+    bool isTesting(uint8_t component) const
+    {
+        return testComponent == component;
+    }
+
+    uint8_t stateCode() const
+    {
+        switch (phase)
+        {
+        case Phase::START:
+            return 0x24;
+        case Phase::STABILIZE:
+            return 0x25;
+        case Phase::RUN:
+            return 0x06;
+        case Phase::VENTILATION:
+            return 0x1C;
+        case Phase::SHUTDOWN:
+            return 0x00;
+        default:
+            return 0x04;
+        }
+    }
+
+    uint16_t heatPowerW() const
+    {
+        switch (phase)
+        {
+        case Phase::STABILIZE:
+            return 2500;
+        case Phase::RUN:
+            return mode == WBusCommandBuilder::CMD_BOOST_MODE ? 6000 : 5000;
+        default:
+            return 0;
+        }
+    }
+
+    // Данные страницы датчиков (без индекса); false - страница неизвестна
+    bool sensorPage(uint8_t index, std::vector<uint8_t> &out) const
+    {
+        bool flame = phase == Phase::STABILIZE || phase == Phase::RUN;
+        bool fan = isActive() || phase == Phase::SHUTDOWN || isTesting(WBusCommandBuilder::TEST_COMBUSTION_FAN);
+        bool glowPlug = phase == Phase::START || isTesting(WBusCommandBuilder::TEST_GLOW_PLUG);
+        bool fuelPump = flame || isTesting(WBusCommandBuilder::TEST_FUEL_PUMP);
+        bool circulation = isHeating() || circulationPump || isTesting(WBusCommandBuilder::TEST_CIRCULATION_PUMP);
+
+        switch (index)
+        {
+        case WBusCommandBuilder::SENSOR_STATUS_FLAGS:
+        {
+            uint8_t flags = isActive() ? 0x01 : 0x00;
+            if (isActive() && mode == WBusCommandBuilder::CMD_SUPP_HEAT)
+                flags |= 0x10;
+            if (isActive() && (mode == WBusCommandBuilder::CMD_PARK_HEAT || mode == WBusCommandBuilder::CMD_BOOST_MODE))
+                flags |= 0x20;
+            if (phase == Phase::VENTILATION)
+                flags |= 0x40;
+            uint8_t boost = isActive() && mode == WBusCommandBuilder::CMD_BOOST_MODE ? 0x10 : 0x00;
+            out.insert(out.end(), {flags, 0x00, 0x00, boost, 0x00});
+            return true;
+        }
+
+        case WBusCommandBuilder::SENSOR_ON_OFF_FLAGS:
+            out.push_back((fan ? 0x01 : 0) | (glowPlug ? 0x02 : 0) | (fuelPump ? 0x04 : 0) |
+                          (circulation ? 0x08 : 0) | (isTesting(WBusCommandBuilder::TEST_VEHICLE_FAN) ? 0x10 : 0) |
+                          (isTesting(WBusCommandBuilder::TEST_FUEL_PREHEATING) ? 0x20 : 0) | (flame ? 0x40 : 0));
+            return true;
+
+        case WBusCommandBuilder::SENSOR_FUEL_SETTINGS:
+            out.insert(out.end(), {0x1D, 0x3C, 0x3C});
+            return true;
+
+        case WBusCommandBuilder::SENSOR_OPERATIONAL:
+            out.push_back(static_cast<uint8_t>(static_cast<int>(temperature) + 50));
+            appendWord(out, isActive() ? 12400 : 12750);
+            out.push_back(flame ? 0x01 : 0x00);
+            appendWord(out, heatPowerW());
+            appendWord(out, flame ? 1800 : 650);
+            return true;
+
+        case WBusCommandBuilder::SENSOR_OPERATING_TIMES:
+            appendWord(out, workingHours);
+            out.push_back(workingMinutes);
+            appendWord(out, workingHours + 57);
+            out.push_back(workingMinutes);
+            appendWord(out, startCounter);
+            return true;
+
+        case WBusCommandBuilder::SENSOR_OPERATING_STATE:
+            out.insert(out.end(), {stateCode(), static_cast<uint8_t>(phase), static_cast<uint8_t>(phase == Phase::START ? 0x01 : flame ? 0x08 : 0x00), 0x00, 0x00, 0x00});
+            return true;
+
+        case WBusCommandBuilder::SENSOR_BURNING_DURATION:
+            for (uint8_t level = 0; level < 8; level++)
+            {
+                appendWord(out, level < 4 ? workingHours / (level + 2) : 0);
+                out.push_back(static_cast<uint8_t>(level * 7));
+            }
+            return true;
+
+        case WBusCommandBuilder::SENSOR_WORKING_DURATION:
+            appendWord(out, workingHours);
+            out.push_back(workingMinutes);
+            appendWord(out, 3);
+            out.push_back(41);
+            return true;
+
+        case WBusCommandBuilder::SENSOR_START_COUNTERS:
+            appendWord(out, startCounter - 12);
+            appendWord(out, 12);
+            appendWord(out, startCounter);
+            return true;
+
+        case WBusCommandBuilder::SENSOR_SUBSYSTEMS_STATUS:
+            out.push_back(glowPlug ? (isTesting(WBusCommandBuilder::TEST_GLOW_PLUG) ? testMagnitude : 0x96) : 0x00);
+            out.push_back(fuelPump ? (isTesting(WBusCommandBuilder::TEST_FUEL_PUMP) ? testMagnitude : 0x08) : 0x00);
+            out.push_back(fan ? (isTesting(WBusCommandBuilder::TEST_COMBUSTION_FAN) ? testMagnitude : 0x78) : 0x00);
+            out.push_back(0x00);
+            out.push_back(circulation ? 0xC8 : 0x00);
+            return true;
+
+        case WBusCommandBuilder::SENSOR_OTHER_DURATION:
+        case WBusCommandBuilder::SENSOR_VENTILATION_DURATION:
+            appendWord(out, 9);
+            out.push_back(12);
+            return true;
+
+        case WBusCommandBuilder::SENSOR_TEMPERATURE_THRESHOLDS:
+            out.insert(out.end(), {0x5A, 0x69, 0x55, 0x4B});
+            return true;
+
+        case WBusCommandBuilder::SENSOR_FUEL_PREWARMING:
+        {
+            bool prewarming = phase == Phase::START || isTesting(WBusCommandBuilder::TEST_FUEL_PREHEATING);
+            appendWord(out, 1200);
+            appendWord(out, prewarming ? 80 : 0);
+            return true;
+        }
+
+        case WBusCommandBuilder::SENSOR_SPARK_TRANSMISSION:
+            out.push_back(0x00);
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    bool infoPage(uint8_t index, std::vector<uint8_t> &out) const
+    {
+        switch (index)
+        {
+        case WBusCommandBuilder::INFO_DEVICE_ID:
+            out.insert(out.end(), {0x09, 0x01, 0x23, 0x45, 0x67});
+            return true;
+        case WBusCommandBuilder::INFO_HARDWARE_VERSION:
+            out.insert(out.end(), {0x14, 0x0C});
+            return true;
+        case WBusCommandBuilder::INFO_DATASET_ID:
+            out.insert(out.end(), {0x09, 0x06, 0x78, 0x54, 0x00, 0x01});
+            return true;
+        case WBusCommandBuilder::INFO_CTRL_MFG_DATE:
+            out.insert(out.end(), {0x15, 0x03, 0x12});
+            return true;
+        case WBusCommandBuilder::INFO_HEATER_MFG_DATE:
+            out.insert(out.end(), {0x02, 0x04, 0x12});
+            return true;
+        case WBusCommandBuilder::INFO_UNKNOWN_06:
+        case WBusCommandBuilder::INFO_UNKNOWN_0D:
+            out.insert(out.end(), {0x00, 0x00});
+            return true;
+        case WBusCommandBuilder::INFO_CUSTOMER_ID:
+            appendText(out, "1K0815071");
+            return true;
+        case WBusCommandBuilder::INFO_SERIAL_NUMBER:
+            out.insert(out.end(), {0x00, 0x01, 0x23, 0x45, 0x67, 0x00, 0x50, 0x43});
+            return true;
+        case WBusCommandBuilder::INFO_WBUS_VERSION:
+            out.push_back(0x33);
+            return true;
+        case WBusCommandBuilder::INFO_DEVICE_NAME:
+            appendText(out, "PQ46 TTEVO");
+            return true;
+        case WBusCommandBuilder::INFO_WBUS_CODE:
+            out.insert(out.end(), {0x71, 0x7C, 0xC4, 0xE7, 0x3F, 0x80, 0x00});
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool readErrors(const uint8_t *request, size_t length, std::vector<uint8_t> &out)
+    {
+        uint8_t index = request[3];
+        out.push_back(index);
+
+        switch (index)
+        {
+        case WBusCommandBuilder::ERROR_READ_LIST:
+            out.push_back(static_cast<uint8_t>(errors.size()));
+            for (const StoredError &error : errors)
+            {
+                out.push_back(error.code);
+                out.push_back(error.counter);
+            }
+            return true;
+
+        case WBusCommandBuilder::ERROR_READ_DETAILS:
+            if (length < 6)
+                return false;
+            for (const StoredError &error : errors)
+            {
+                if (error.code != request[4])
+                    continue;
+
+                out.insert(out.end(), {error.code, 0x01, static_cast<uint8_t>(error.counter - 1), 0x04, 0x00, 0x46});
+                appendWord(out, 12600);
+                appendWord(out, workingHours - 20);
+                out.push_back(33);
+                return true;
+            }
+            return false;
+
+        case WBusCommandBuilder::ERROR_CLEAR:
+            errors.clear();
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    bool startMode(uint8_t command, uint8_t minutes, unsigned long now)
+    {
+        mode = command;
+        runUntil = now + static_cast<unsigned long>(minutes) * 60000UL;
+        testComponent = 0;
+
+        if (command == WBusCommandBuilder::CMD_VENTILATE)
+            setPhase(Phase::VENTILATION, now);
+        else if (!isHeating())
+            setPhase(Phase::START, now);
+        return true;
+    }
+
+    bool runTest(const uint8_t *request, size_t length, unsigned long now)
+    {
+        if (length < 8 || isActive())
+            return false;
+
+        testComponent = request[3];
+        testMagnitude = request[6];
+        testUntil = now + request[4] * 1000UL;
+        return true;
+    }
+
+public:
+    // Фазы и тест компонента по времени; вызывается перед каждым запросом
+    void update(unsigned long now)
+    {
+        unsigned long elapsed = lastUpdate == 0 ? 0 : now - lastUpdate;
+        lastUpdate = now;
+
+        if (testComponent != 0 && (long)(now - testUntil) >= 0)
+            testComponent = 0;
+
+        if (isActive() && (long)(now - runUntil) >= 0)
+            setPhase(Phase::SHUTDOWN, now);
+
+        switch (phase)
+        {
+        case Phase::START:
+            if (now - phaseSince >= START_DURATION_MS)
+                setPhase(Phase::STABILIZE, now);
+            break;
+        case Phase::STABILIZE:
+            if (now - phaseSince >= STABILIZE_DURATION_MS)
+                setPhase(Phase::RUN, now);
+            break;
+        case Phase::SHUTDOWN:
+            if (now - phaseSince >= SHUTDOWN_DURATION_MS)
+            {
+                setPhase(Phase::OFF, now);
+                mode = 0;
+            }
+            break;
+        default:
+            break;
+        }
+
+        // Температура растет при горении и остывает до 20°C
+        float rate = elapsed / 1000.0f;
+        if (phase == Phase::STABILIZE || phase == Phase::RUN)
+            temperature = temperature + rate * 2.0f > 80.0f ? 80.0f : temperature + rate * 2.0f;
+        else
+            temperature = temperature - rate * 0.5f < 20.0f ? 20.0f : temperature - rate * 0.5f;
+    }
+
+    // Ответ на запрос F4 len cmd ...; возвращает длину кадра ответа (ACK или NAK)
+    size_t respond(const uint8_t *request, size_t length, unsigned long now, std::vector<uint8_t> &response)
+    {
+        update(now);
+
+        uint8_t command = request[2];
+        std::vector<uint8_t> payload;
+        bool accepted = false;
+        uint8_t failCode = NAK_UNSUPPORTED;
+
+        switch (command)
+        {
+        case WBusCommandBuilder::CMD_SHUTDOWN:
+            if (isActive())
+                setPhase(Phase::SHUTDOWN, now);
+            testComponent = 0;
+            accepted = true;
+            break;
+
+        case WBusCommandBuilder::CMD_PARK_HEAT:
+        case WBusCommandBuilder::CMD_VENTILATE:
+        case WBusCommandBuilder::CMD_SUPP_HEAT:
+        case WBusCommandBuilder::CMD_BOOST_MODE:
+            accepted = length >= 5 && startMode(command, request[3], now);
+            payload.assign(request + 3, request + length - 1);
+            break;
+
+        case WBusCommandBuilder::CMD_CIRC_PUMP_CTRL:
+            circulationPump = length >= 5 && request[3] != 0;
+            accepted = true;
+            payload.assign(request + 3, request + length - 1);
+            break;
+
+        case WBusCommandBuilder::CMD_KEEPALIVE:
+            // Поддержка режима возможна только пока он активен
+            accepted = length >= 5 && isActive() && request[3] == mode;
+            failCode = NAK_CONDITIONS;
+            payload.assign(request + 3, request + length - 1);
+            break;
+
+        case WBusCommandBuilder::CMD_DIAGNOSTIC:
+        case WBusCommandBuilder::CMD_FUEL_CIRCULATION:
+            accepted = !isActive();
+            failCode = NAK_CONDITIONS;
+            payload.assign(request + 3, request + length - 1);
+            break;
+
+        case WBusCommandBuilder::CMD_TEST_COMPONENT:
+            accepted = runTest(request, length, now);
+            failCode = NAK_CONDITIONS;
+            payload.assign(request + 3, request + length - 1);
+            break;
+
+        case WBusCommandBuilder::CMD_READ_SENSOR:
+            if (length < 5)
+                break;
+            payload.push_back(request[3]);
+            if (request[3] == WBusCommandBuilder::SENSOR_MULTI_READ)
+            {
+                accepted = true;
+                for (size_t i = 4; accepted && i + 1 < length; i++)
+                {
+                    payload.push_back(request[i]);
+                    accepted = WBusCommandBuilder::getSensorPageLength(request[i]) > 0 && sensorPage(request[i], payload);
+                }
+            }
+            else
+            {
+                accepted = sensorPage(request[3], payload);
+            }
+            break;
+
+        case WBusCommandBuilder::CMD_READ_INFO:
+            if (length < 5)
+                break;
+            payload.push_back(request[3]);
+            accepted = infoPage(request[3], payload);
+            break;
+
+        case WBusCommandBuilder::CMD_READ_ERRORS:
+            accepted = length >= 5 && readErrors(request, length, payload);
+            break;
+
+        default:
+            break;
+        }
+
+        // Ответ не помещается в кадр - как и блок, отказываем
+        if (!accepted || payload.size() + 4 > WBUS_MAX_FRAME_LENGTH)
+            return createNak(command, failCode, response);
+
+        response = {RXHEADER, static_cast<uint8_t>(payload.size() + 2), static_cast<uint8_t>(command | 0x80)};
+        response.insert(response.end(), payload.begin(), payload.end());
+
+        uint8_t checksum = 0;
+        for (uint8_t value : response)
+            checksum ^= value;
+        response.push_back(checksum);
+        return response.size();
+    }
+
+    // NAK: 4F 04 7F cmd code cs
+    static size_t createNak(uint8_t command, uint8_t code, std::vector<uint8_t> &response)
+    {
+        response = {RXHEADER, 0x04, 0x7F, command, code};
+        response.push_back(response[0] ^ response[1] ^ response[2] ^ response[3] ^ response[4]);
+        return response.size();
+    }
+
+    Phase getPhase() const
+    {
+        return phase;
+    }
+
+    static const char *getPhaseName(Phase value)
+    {
+        switch (value)
+        {
+        case Phase::START:
+            return "START";
+        case Phase::STABILIZE:
+            return "STABILIZE";
+        case Phase::RUN:
+            return "RUN";
+        case Phase::VENTILATION:
+            return "VENTILATION";
+        case Phase::SHUTDOWN:
+            return "SHUTDOWN";
+        default:
+            return "OFF";
+        }
+    }
+};
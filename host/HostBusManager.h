@@ -0,0 +1,306 @@
+// host/HostBusManager.h
+#pragma once
+#include <Arduino.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <termios.h>
+#include "interfaces/IBusManager.h"
+#include "core/EventBus.h"
+#include "core/ConfigManager.h"
+#include "domain/Events.h"
+#include "interfaces/IClock.h"
+#include "./EcuEmulator.h"
+
+// Шина K-Line для Linux: псевдотерминал (его открывает внешний эмулятор
+// или USB-адаптер через socat), UNIX сокет либо пара сокетов со встроенным
+// эмулятором EcuEmulator. Передача мгновенная, без
+// расчета времени по скорости; переданный кадр возвращается в прием,
+// как эхо на однопроводной линии. BREAK и пробуждение только публикуются.
+//
+// Виртуальная линия (openVirtual) - без дескрипторов и потоков: кадр занимает
+// линию длина * время байта по виртуальным часам, эхо и ответ эмулятора
+// доставляются в прием в свое время. Для ускоренных прогонов на VirtualClock.
+class HostBusManager : public IBusManager
+{
+private:
+    HardwareSerial &serial;
+    EventBus &eventBus;
+    const BusConfig &config;
+    IClock &clock;
+
+    int fd = -1;
+    int ptySlaveFd = -1; // Держим slave открытым: отключение эмулятора не дает HUP
+    String endpoint;
+
+    ConnectionState connectionState = ConnectionState::DISCONNECTED;
+    int64_t txCompleteUs = 0;
+
+    // Виртуальная линия
+    EcuEmulator *virtualEcu = nullptr;
+    std::vector<uint8_t> echo; // Эхо передаваемого кадра, доставляется к txCompleteUs
+    std::vector<uint8_t> due;
+    uint64_t txBytes = 0;
+    uint64_t rxBytes = 0;
+
+    uint32_t byteTimeUs() const
+    {
+        return static_cast<uint32_t>(config.getBitsPerChar() * 1000000UL / config.baudRate);
+    }
+
+    void publishOperation(BusDriverOperation operation)
+    {
+        eventBus.publish<BusDriverOperationEvent>(EventType::BUS_DRIVER_OPERATION, {operation, 0});
+    }
+
+public:
+    HostBusManager(ConfigManager &configMngr, HardwareSerial &serialRef, EventBus &bus, IClock &clk)
+        : serial(serialRef), eventBus(bus), config(configMngr.getConfig().bus), clock(clk) {}
+
+    ~HostBusManager()
+    {
+        serial.detach();
+        if (fd >= 0)
+            ::close(fd);
+        if (ptySlaveFd >= 0)
+            ::close(ptySlaveFd);
+    }
+
+    // Новый псевдотерминал в raw режиме; путь к slave - getEndpoint()
+    bool openPty()
+    {
+        int master = ::posix_openpt(O_RDWR | O_NOCTTY);
+        if (master < 0 || ::grantpt(master) != 0 || ::unlockpt(master) != 0)
+        {
+            if (master >= 0)
+                ::close(master);
+            return false;
+        }
+
+        endpoint = ::ptsname(master);
+        ptySlaveFd = ::open(endpoint.c_str(), O_RDWR | O_NOCTTY);
+
+        termios settings;
+        if (ptySlaveFd >= 0 && ::tcgetattr(ptySlaveFd, &settings) == 0)
+        {
+            ::cfmakeraw(&settings);
+            ::tcsetattr(ptySlaveFd, TCSANOW, &settings);
+        }
+
+        fd = master;
+        return true;
+    }
+
+    // Подключение к UNIX сокету, который слушает эмулятор
+    bool openSocket(const char *path)
+    {
+        int sock = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (sock < 0)
+            return false;
+
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+
+        if (::connect(sock, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+        {
+            ::close(sock);
+            return false;
+        }
+
+        endpoint = path;
+        fd = sock;
+        return true;
+    }
+
+    // Пара сокетов внутри процесса: второй конец отдается эмулятору блока
+    bool openSocketPair(int &peerFd)
+    {
+        int pair[2];
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0)
+            return false;
+
+        endpoint = "socketpair";
+        fd = pair[0];
+        peerFd = pair[1];
+        return true;
+    }
+
+    // Линия внутри основного цикла: запросы сразу уходят эмулятору
+    bool openVirtual(EcuEmulator &ecu)
+    {
+        endpoint = "virtual";
+        virtualEcu = &ecu;
+        return true;
+    }
+
+    const String &getEndpoint() const
+    {
+        return endpoint;
+    }
+
+    bool initialize() override
+    {
+        if (virtualEcu)
+            return true;
+        if (fd < 0)
+            return false;
+
+        serial.attach(fd, true);
+        return true;
+    }
+
+    void connect() override
+    {
+        wakeUp();
+    }
+
+    void disconnect() override
+    {
+        sleep();
+    }
+
+    bool isConnected() const override
+    {
+        return connectionState == ConnectionState::CONNECTED;
+    }
+
+    ConnectionState getConnectionState() const override
+    {
+        return connectionState;
+    }
+
+    bool sendCommand(const uint8_t *data, size_t length) override
+    {
+        if (!isConnected())
+            return false;
+
+        if (!virtualEcu)
+        {
+            serial.write(data, length);
+            txCompleteUs = clock.nowUs();
+            return true;
+        }
+
+        // Эмулятор получает запрос в момент окончания передачи
+        txCompleteUs = clock.nowUs() + static_cast<int64_t>(length) * byteTimeUs();
+        echo.assign(data, data + length);
+        virtualEcu->receive(data, length, txCompleteUs);
+        txBytes += length;
+        clock.wakeAtUs(txCompleteUs);
+        return true;
+    }
+
+    bool isTxComplete() override
+    {
+        if (echo.empty() || clock.nowUs() >= txCompleteUs)
+            return true;
+
+        clock.wakeAtUs(txCompleteUs);
+        return false;
+    }
+
+    int64_t getTxCompleteUs() const override
+    {
+        return txCompleteUs;
+    }
+
+    void sendBreak() override
+    {
+        if (isConnected())
+            publishOperation(BusDriverOperation::BREAK);
+    }
+
+    void wakeUp() override
+    {
+        if (fd < 0 && !virtualEcu)
+            return;
+
+        connectionState = ConnectionState::CONNECTED;
+        publishOperation(BusDriverOperation::WAKE);
+    }
+
+    void sleep() override
+    {
+        connectionState = ConnectionState::DISCONNECTED;
+        publishOperation(BusDriverOperation::SLEEP);
+    }
+
+    // Доставка эха и ответов виртуальной линии, чье время наступило
+    void process() override
+    {
+        if (!virtualEcu)
+            return;
+
+        int64_t now = clock.nowUs();
+        if (!echo.empty())
+        {
+            if (now >= txCompleteUs)
+            {
+                serial.inject(echo.data(), echo.size());
+                echo.clear();
+            }
+            else
+            {
+                clock.wakeAtUs(txCompleteUs);
+            }
+        }
+
+        due.clear();
+        virtualEcu->takeDue(now, due);
+        if (!due.empty())
+        {
+            serial.inject(due.data(), due.size());
+            rxBytes += due.size();
+        }
+
+        int64_t nextUs = virtualEcu->nextBurstEndUs();
+        if (nextUs >= 0)
+            clock.wakeAtUs(nextUs);
+    }
+
+    // Байты на линии (переданные и принятые) - для оценки загрузки шины
+    uint64_t getTxBytes() const
+    {
+        return txBytes;
+    }
+
+    uint64_t getRxBytes() const
+    {
+        return rxBytes;
+    }
+
+    // Время линии, занятое всеми переданными и принятыми байтами (мс)
+    uint64_t getWireBusyMs() const
+    {
+        return (txBytes + rxBytes) * byteTimeUs() / 1000;
+    }
+
+    bool isBusy() const override
+    {
+        return false;
+    }
+
+    void sendBreakSignal(bool set) override {}
+
+    String getLineTimingJson() const override
+    {
+        return "{\"pulses\":0}";
+    }
+
+    int available() override
+    {
+        return serial.available();
+    }
+
+    uint8_t read() override
+    {
+        return serial.read();
+    }
+
+    void flush() override
+    {
+        serial.flush();
+    }
+};
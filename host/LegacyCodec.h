@@ -0,0 +1,151 @@
+// host/LegacyCodec.h
+#pragma once
+#include <Arduino.h>
+#include <vector>
+#include "common/ProtocolConstants.h"
+#include "common/Utils.h"
+
+// Прежние PacketParser и HEX функции Utils (до PacketView и HexCodec) -
+// только как точка отсчета для MicroBench. В прошивке не используются.
+// Оставлены перегрузки, которые вызывали декодеры; сообщения об ошибках
+// убраны, byteCount в parseFromString инициализирован (в оригинале -
+// неопределенное поведение). Копирование и преобразования - как были.
+class LegacyUtils
+{
+public:
+    static bool isHexString(String str)
+    {
+        for (unsigned int i = 0; i < str.length(); i++)
+        {
+            char c = str[i];
+            if (!((c >= '0' && c <= '9') || (c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f')))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static String byteToHexString(uint8_t b)
+    {
+        return (b < 0x10) ? "0" + String(b, HEX) : String(b, HEX);
+    }
+
+    static String bytesToHexString(const uint8_t *data, size_t length)
+    {
+        String result = "";
+        for (size_t i = 0; i < length; i++)
+        {
+            if (i > 0)
+                result += " ";
+
+            result += byteToHexString(data[i]);
+        }
+        result.toLowerCase();
+        return result;
+    }
+
+    static uint8_t hexStringToByte(const String &hexStr)
+    {
+        return (uint8_t)strtol(hexStr.c_str(), NULL, 16);
+    }
+
+    static uint8_t extractByteFromString(String response, int bytePosition)
+    {
+        String cleanTx = response;
+        cleanTx.replace(" ", "");
+
+        if (bytePosition >= 0 && cleanTx.length() >= static_cast<size_t>(bytePosition + 1) * 2)
+        {
+            String byteStr = cleanTx.substring(bytePosition * 2, bytePosition * 2 + 2);
+            return hexStringToByte(byteStr);
+        }
+
+        return 0;
+    }
+};
+
+class LegacyPacketParser
+{
+private:
+    struct PacketData
+    {
+        uint8_t header;
+        uint8_t length;
+        uint8_t command;
+        std::vector<uint8_t> bytes;
+        uint8_t checksum;
+        bool isValid = false;
+        bool isResponse = false;
+        bool isNak = false;
+    };
+
+    PacketData packet;
+
+public:
+    struct WithIndex
+    {
+        uint8_t value;
+        explicit WithIndex(uint8_t idx) : value(idx) {}
+    };
+
+    bool parseFromString(const String &hexCommand, uint8_t expectedCommand, WithIndex idx)
+    {
+        String cleanCmd = hexCommand;
+        cleanCmd.replace(" ", "");
+        cleanCmd.toLowerCase();
+
+        if (hexCommand.isEmpty() || !LegacyUtils::isHexString(cleanCmd) || cleanCmd.length() < 8)
+        {
+            return false;
+        }
+
+        size_t length = cleanCmd.length() / 2;
+        uint8_t data[length];
+        int byteCount = 0;
+
+        for (size_t i = 0; i < cleanCmd.length(); i += 2)
+        {
+            data[byteCount++] = LegacyUtils::hexStringToByte(cleanCmd.substring(i, i + 2));
+        }
+
+        return parseFromBytes(data, byteCount, expectedCommand, idx);
+    }
+
+    bool parseFromBytes(const uint8_t *data, size_t length, uint8_t expectedCommand, WithIndex idx)
+    {
+        packet = PacketData();
+
+        if (data == nullptr || length < 4 || length != static_cast<size_t>(data[1]) + 2)
+            return false;
+
+        packet.bytes.assign(data, data + length);
+
+        packet.header = data[0];
+        packet.length = data[1];
+        packet.command = data[2];
+        packet.isResponse = packet.header == RXHEADER;
+
+        if (packet.isResponse && length >= 6)
+        {
+            packet.isNak = (data[2] == 0x7F);
+        }
+
+        packet.checksum = data[length - 1];
+        packet.isValid = Utils::validateChecksum(data, length);
+
+        if (!packet.isValid)
+            return false;
+
+        uint8_t actualCommand = packet.command;
+        if (packet.isResponse && !packet.isNak)
+            actualCommand = packet.command & 0x7F;
+
+        if (actualCommand != expectedCommand)
+            return false;
+
+        return packet.bytes.size() >= 5 && data[3] == idx.value;
+    }
+
+    const std::vector<uint8_t> &getBytes() const { return packet.bytes; }
+};
@@ -0,0 +1,155 @@
+// host/MicroBench.h
+#pragma once
+#include <Arduino.h>
+#include "common/HexCodec.h"
+#include "common/PacketView.h"
+#include "common/Utils.h"
+#include "./AllocCounter.h"
+#include "./LegacyCodec.h"
+
+// Микрозамеры горячего пути разбора и HEX: прежняя реализация против текущей
+// на одном и том же кадре. Для каждой операции - нс и аллокации на кадр.
+// Результат операции складывается в sink, чтобы компилятор ее не выбросил.
+class MicroBench
+{
+private:
+    struct Result
+    {
+        const char *name;
+        double nsPerFrame;
+        double allocationsPerFrame;
+    };
+
+    uint32_t iterations;
+    uint32_t sink = 0;
+    String json;
+
+    // Ответ на чтение страницы 0x05 (операционные измерения)
+    uint8_t frame[14] = {RXHEADER, 0x0C, 0xD0, 0x05, 0x50, 0x04, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    String frameHex;
+
+    template <typename Operation>
+    Result measure(const char *name, Operation operation)
+    {
+        // Прогрев: статические буферы и таблицы до начала отсчета
+        for (uint32_t i = 0; i < 1000; i++)
+            sink += operation();
+
+        uint64_t allocationsBefore = AllocCounter::getAllocations();
+        int64_t startedUs = esp_timer_get_time();
+
+        for (uint32_t i = 0; i < iterations; i++)
+            sink += operation();
+
+        int64_t elapsedUs = esp_timer_get_time() - startedUs;
+        uint64_t allocations = AllocCounter::getAllocations() - allocationsBefore;
+
+        return {name, elapsedUs * 1000.0 / iterations, static_cast<double>(allocations) / iterations};
+    }
+
+    void beginSection(const char *section)
+    {
+        if (json.length() > 1)
+            json += "],";
+        json += "\"" + String(section) + "\":[";
+    }
+
+    void report(const Result &result, bool first = false)
+    {
+        if (!first)
+            json += ",";
+        json += "{\"name\":\"" + String(result.name) + "\",";
+        json += "\"nsPerFrame\":" + String(result.nsPerFrame, 1) + ",";
+        json += "\"allocationsPerFrame\":" + String(result.allocationsPerFrame, 2) + "}";
+    }
+
+    // PacketParser копировал кадр в std::vector (а из HEX строки - еще и
+    // чистил строку и резал ее substring); PacketView только проверяет кадр
+    void benchParser()
+    {
+        beginSection("parser");
+
+        report(measure("PacketParser::parseFromString", [this]()
+                       {
+                           LegacyPacketParser parser;
+                           return parser.parseFromString(frameHex, 0x50, LegacyPacketParser::WithIndex(0x05)) ? parser.getBytes()[4] : 0u; }),
+               true);
+
+        report(measure("PacketParser::parseFromBytes", [this]()
+                       {
+                           LegacyPacketParser parser;
+                           return parser.parseFromBytes(frame, sizeof(frame), 0x50, LegacyPacketParser::WithIndex(0x05)) ? parser.getBytes()[4] : 0u; }));
+
+        report(measure("PacketView", [this]()
+                       {
+                           PacketView view(frame, sizeof(frame));
+                           return view.matches(0x50, PacketView::WithIndex(0x05), PacketView::WithMinLength(sizeof(frame))) ? view[4] : 0u; }));
+    }
+
+    // HEX на кадр: прежние функции Utils (String на каждый байт, копия строки
+    // на каждое извлечение) против HexCodec и новых оберток Utils
+    void benchHex()
+    {
+        beginSection("hex");
+
+        report(measure("before: Utils::bytesToHexString", [this]()
+                       { return LegacyUtils::bytesToHexString(frame, sizeof(frame)).length(); }),
+               true);
+
+        report(measure("after: Utils::bytesToHexString", [this]()
+                       { return Utils::bytesToHexString(frame, sizeof(frame)).length(); }));
+
+        report(measure("after: HexCodec::encode", [this]()
+                       {
+                           char hex[HexCodec::encodedSize(sizeof(frame))];
+                           return static_cast<unsigned>(HexCodec::encode(frame, sizeof(frame), hex, sizeof(hex))); }));
+
+        // SnifferManager разбирал кадр четырьмя extractByteFromString
+        report(measure("before: 4x Utils::extractByteFromString", [this]()
+                       {
+                           unsigned sum = 0;
+                           for (int position = 0; position < 4; position++)
+                               sum += LegacyUtils::extractByteFromString(frameHex, position);
+                           return sum; }));
+
+        report(measure("after: 4x Utils::extractByteFromString", [this]()
+                       {
+                           unsigned sum = 0;
+                           for (int position = 0; position < 4; position++)
+                               sum += Utils::extractByteFromString(frameHex, position);
+                           return sum; }));
+
+        report(measure("before: decode by substring", [this]()
+                       {
+                           String clean = frameHex;
+                           clean.replace(" ", "");
+                           uint8_t bytes[sizeof(frame)];
+                           size_t count = 0;
+                           for (size_t i = 0; i + 1 < clean.length() && count < sizeof(bytes); i += 2)
+                               bytes[count++] = LegacyUtils::hexStringToByte(clean.substring(i, i + 2));
+                           return static_cast<unsigned>(bytes[count - 1]); }));
+
+        report(measure("after: HexCodec::decode", [this]()
+                       {
+                           uint8_t bytes[sizeof(frame)];
+                           size_t count = HexCodec::decode(frameHex.c_str(), frameHex.length(), bytes, sizeof(bytes));
+                           return static_cast<unsigned>(bytes[count - 1]); }));
+    }
+
+public:
+    explicit MicroBench(uint32_t iterationCount) : iterations(iterationCount > 0 ? iterationCount : 1)
+    {
+        frame[sizeof(frame) - 1] = Utils::calculateChecksum(frame, sizeof(frame) - 1);
+        frameHex = Utils::bytesToHexString(frame, sizeof(frame));
+    }
+
+    void run()
+    {
+        json = "{";
+        benchParser();
+        benchHex();
+        json += "],\"iterations\":" + String(iterations) + ",\"sink\":" + String(sink) + "}";
+
+        Serial.println("{\"microbench\":" + json + "}");
+    }
+};
@@ -0,0 +1,145 @@
+// host/ReceiverBench.h
+#pragma once
+#include <Arduino.h>
+#include <initializer_list>
+#include <vector>
+#include "core/EventBus.h"
+#include "core/ConfigManager.h"
+#include "application/CommandReceiver.h"
+#include "./AllocCounter.h"
+#include "./VirtualClock.h"
+
+// Замер приема: поток байт (эхо запроса + ответ блока, как на K-Line)
+// проходит через CommandReceiver - framer, очередь кадров, PacketView и
+// публикацию событий. Печатает кадры/с и аллокации на кадр в двух вариантах:
+// без подписчиков TX/RX и с подписчиком, который строит HEX каждого кадра
+// (так события публиковались до перехода на FrameReceivedEvent).
+class ReceiverBench
+{
+private:
+    // Очередь кадров вмещает QUEUE_SIZE - 1 кадров (эхо запроса и ответ - два кадра)
+    static const size_t PAIRS_PER_BATCH = (KLineReceiverTask::QUEUE_SIZE - 1) / 2;
+
+    struct Result
+    {
+        uint32_t frames = 0;
+        int64_t elapsedUs = 0;
+        uint64_t allocations = 0;
+    };
+
+    EventBus &eventBus;
+    ConfigManager &configManager;
+    std::vector<uint8_t> stream;
+    size_t pairCount = 0;
+
+    // F4/4F, затем команда и данные; длина и контрольная сумма дописываются
+    void appendFrame(std::initializer_list<uint8_t> body)
+    {
+        size_t start = stream.size();
+        auto it = body.begin();
+        stream.push_back(*it++);
+        stream.push_back(static_cast<uint8_t>(body.size()));
+        stream.insert(stream.end(), it, body.end());
+        stream.push_back(Utils::calculateChecksum(stream.data() + start, stream.size() - start));
+    }
+
+    // Типичный цикл опроса: multi-read, одиночная страница, keep-alive, статус
+    void buildStream()
+    {
+        appendFrame({TXHEADER, 0x50, 0x30, 0x01, 0x03, 0x05, 0x06, 0x07, 0x0C});
+        appendFrame({RXHEADER, 0xD0, 0x30, 0x01, 0x00, 0x03, 0x12, 0x34, 0x05, 0x50, 0x04, 0x41, 0x00, 0x00,
+                     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x10, 0x00, 0x20, 0x00, 0x30, 0x07, 0x04,
+                     0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x01, 0x00});
+        appendFrame({TXHEADER, 0x50, 0x05});
+        appendFrame({RXHEADER, 0xD0, 0x05, 0x50, 0x04, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+        appendFrame({TXHEADER, 0x44, 0x2A, 0x00});
+        appendFrame({RXHEADER, 0xC4, 0x00});
+        appendFrame({TXHEADER, 0x50, 0x07});
+        appendFrame({RXHEADER, 0xD0, 0x07, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00});
+        pairCount = 4;
+    }
+
+    Result runPass(uint32_t frames)
+    {
+        HardwareSerial serial(KLINE_UART_NUM);
+        VirtualClock clock;
+        CommandReceiver receiver(serial, eventBus, configManager, clock);
+        receiver.initialize(false);
+
+        // Партия не больше очереди кадров: poll() разбирает все доступные байты
+        std::vector<uint8_t> batch;
+        for (size_t i = 0; i < PAIRS_PER_BATCH / pairCount; i++)
+            batch.insert(batch.end(), stream.begin(), stream.end());
+        uint32_t batchPairs = static_cast<uint32_t>(PAIRS_PER_BATCH / pairCount * pairCount);
+
+        Result result;
+        while (result.frames < frames)
+        {
+            serial.inject(batch.data(), batch.size());
+
+            uint64_t allocationsBefore = AllocCounter::getAllocations();
+            int64_t startedUs = esp_timer_get_time();
+
+            uint32_t answered = 0;
+            while (answered < batchPairs)
+            {
+                receiver.process();
+                if (!receiver.isRxReceived())
+                    break;
+                answered++;
+            }
+
+            result.elapsedUs += esp_timer_get_time() - startedUs;
+            result.allocations += AllocCounter::getAllocations() - allocationsBefore;
+            result.frames += answered * 2;
+
+            if (answered < batchPairs)
+            {
+                Serial.println("❌ Приемник потерял кадры: " + String(answered) + "/" + String(batchPairs));
+                break;
+            }
+        }
+        return result;
+    }
+
+    static String resultToJson(const Result &result)
+    {
+        float seconds = result.elapsedUs / 1000000.0f;
+        String json = "{";
+        json += "\"frames\":" + String(result.frames) + ",";
+        json += "\"framesPerSec\":" + String(seconds > 0 ? result.frames / seconds : 0.0f, 0) + ",";
+        json += "\"nsPerFrame\":" + String(result.frames > 0 ? result.elapsedUs * 1000.0 / result.frames : 0.0, 1) + ",";
+        json += "\"allocationsPerFrame\":" + String(result.frames > 0 ? static_cast<double>(result.allocations) / result.frames : 0.0, 3);
+        json += "}";
+        return json;
+    }
+
+public:
+    ReceiverBench(EventBus &bus, ConfigManager &configMngr) : eventBus(bus), configManager(configMngr)
+    {
+        buildStream();
+    }
+
+    void run(uint32_t frames)
+    {
+        // Прогрев: первые кадры заполняют статические таблицы и буферы
+        runPass(KLineReceiverTask::QUEUE_SIZE);
+
+        Result binary = runPass(frames);
+
+        uint32_t hexBytes = 0;
+        auto hexSubscriber = [&hexBytes](const Event &event)
+        {
+            const auto &frameEvent = static_cast<const TypedEvent<FrameReceivedEvent> &>(event);
+            hexBytes += frameEvent.data.frame.toHexString().length();
+        };
+        eventBus.subscribe(EventType::TX_RECEIVED, hexSubscriber);
+        eventBus.subscribe(EventType::RX_RECEIVED, hexSubscriber);
+
+        Result hex = runPass(frames);
+
+        Serial.println("{\"receiver\":{\"binary\":" + resultToJson(binary) +
+                       ",\"hexPerFrame\":" + resultToJson(hex) +
+                       ",\"hexBytes\":" + String(hexBytes) + "}}");
+    }
+};
@@ -0,0 +1,199 @@
+// host/ScriptedBus.h
+#pragma once
+#include <Arduino.h>
+#include <vector>
+#include "interfaces/IBusManager.h"
+#include "interfaces/IClock.h"
+#include "core/EventBus.h"
+#include "core/ConfigManager.h"
+#include "core/FileSystemManager.h"
+#include "application/CommandReceiver.h"
+#include "application/CommandManager.h"
+#include "common/Utils.h"
+#include "./VirtualClock.h"
+
+// Шина для модульных тестов: блока нет, ответы подает сам тест (reply).
+// Кадр передается length * время байта по виртуальным часам и сразу
+// возвращается в прием эхом, как на однопроводной линии.
+class ScriptedBus : public IBusManager
+{
+private:
+    HardwareSerial &serial;
+    const BusConfig &config;
+    IClock &clock;
+
+    ConnectionState connectionState = ConnectionState::CONNECTED;
+    int64_t txCompleteUs = 0;
+    bool txPending = false;
+
+public:
+    std::vector<std::vector<uint8_t>> sent; // Переданные кадры по порядку
+    std::vector<unsigned long> sentAt;      // Время начала передачи каждого кадра (мс)
+    uint32_t breaks = 0;
+
+    ScriptedBus(HardwareSerial &serialRef, const BusConfig &busConfig, IClock &clk)
+        : serial(serialRef), config(busConfig), clock(clk) {}
+
+    uint32_t byteTimeUs() const
+    {
+        return static_cast<uint32_t>(config.getBitsPerChar() * 1000000UL / config.baudRate);
+    }
+
+    // Ответ блока; контрольная сумма дописывается, если ее нет в кадре
+    void reply(std::vector<uint8_t> frame)
+    {
+        if (frame.size() < 2 || frame.size() != static_cast<size_t>(frame[1]) + 2)
+            frame.push_back(Utils::calculateChecksum(frame.data(), frame.size()));
+        serial.inject(frame.data(), frame.size());
+    }
+
+    const std::vector<uint8_t> &last() const
+    {
+        return sent.back();
+    }
+
+    void reset()
+    {
+        sent.clear();
+        sentAt.clear();
+        breaks = 0;
+        txPending = false;
+        connectionState = ConnectionState::CONNECTED;
+    }
+
+    bool initialize() override { return true; }
+    void connect() override { connectionState = ConnectionState::CONNECTED; }
+    void disconnect() override { connectionState = ConnectionState::DISCONNECTED; }
+    bool isConnected() const override { return connectionState == ConnectionState::CONNECTED; }
+    ConnectionState getConnectionState() const override { return connectionState; }
+
+    bool sendCommand(const uint8_t *data, size_t length) override
+    {
+        sent.emplace_back(data, data + length);
+        sentAt.push_back(clock.nowMs());
+        txCompleteUs = clock.nowUs() + static_cast<int64_t>(length) * byteTimeUs();
+        txPending = true;
+        clock.wakeAtUs(txCompleteUs);
+        return true;
+    }
+
+    bool isTxComplete() override
+    {
+        return !txPending || clock.nowUs() >= txCompleteUs;
+    }
+
+    int64_t getTxCompleteUs() const override
+    {
+        return txCompleteUs;
+    }
+
+    void sendBreak() override { breaks++; }
+    void wakeUp() override {}
+    void sleep() override {}
+
+    // Эхо кадра приходит к концу передачи
+    void process() override
+    {
+        if (!txPending || clock.nowUs() < txCompleteUs)
+            return;
+
+        txPending = false;
+        serial.inject(sent.back().data(), sent.back().size());
+    }
+
+    bool isBusy() const override { return false; }
+    void sendBreakSignal(bool set) override {}
+    String getLineTimingJson() const override { return "{}"; }
+    int available() override { return serial.available(); }
+    uint8_t read() override { return static_cast<uint8_t>(serial.read()); }
+    void flush() override {}
+};
+
+// Стек CommandManager на ScriptedBus и VirtualClock. Подписки EventBus
+// живут до конца программы, поэтому стек создается один раз на набор
+// тестов, а между тестами сбрасывается reset().
+struct ScriptedStack
+{
+    VirtualClock clock;
+    HardwareSerial serial;
+    FileSystemManager fileSystemManager;
+    ConfigManager configManager;
+    CommandReceiver commandReceiver;
+    ScriptedBus bus;
+    CommandManager commandManager;
+
+    ScriptedStack()
+        : serial(1),
+          configManager(EventBus::getInstance(), fileSystemManager),
+          commandReceiver(serial, EventBus::getInstance(), configManager, clock),
+          bus(serial, configManager.getConfig().bus, clock),
+          commandManager(configManager, EventBus::getInstance(), bus, commandReceiver, clock)
+    {
+        commandReceiver.initialize(false);
+        commandManager.initialize();
+    }
+
+    const BusConfig &config() const
+    {
+        return configManager.getConfig().bus;
+    }
+
+    // Один проход цикла, затем скачок к ближайшему пробуждению
+    void step()
+    {
+        bus.process();
+        commandReceiver.process();
+        commandManager.process();
+        clock.idle(100);
+    }
+
+    void runFor(unsigned long ms)
+    {
+        unsigned long startedAt = clock.nowMs();
+        while (clock.nowMs() - startedAt < ms)
+            step();
+    }
+
+    // Проходы цикла до выполнения условия (не дольше limitMs)
+    template <typename Condition>
+    bool runUntil(Condition done, unsigned long limitMs = 60000)
+    {
+        unsigned long startedAt = clock.nowMs();
+        while (!done())
+        {
+            if (clock.nowMs() - startedAt >= limitMs)
+                return false;
+            step();
+        }
+        return true;
+    }
+
+    // Проходы цикла, пока не будет передано count кадров (не дольше limitMs)
+    bool runUntilSent(size_t count, unsigned long limitMs = 60000)
+    {
+        unsigned long startedAt = clock.nowMs();
+        while (bus.sent.size() < count)
+        {
+            if (clock.nowMs() - startedAt >= limitMs)
+                return false;
+            step();
+        }
+
+        // Эхо и переход в ожидание ответа
+        runFor(static_cast<unsigned long>(bus.last().size() * bus.byteTimeUs() / 1000 + 1));
+        return true;
+    }
+
+    void reset()
+    {
+        commandManager.clear();
+        commandManager.resetBusHealth();
+        commandManager.setMultiReadSupported(false);
+        runFor(1);
+        while (serial.available())
+            serial.read();
+        commandReceiver.process();
+        bus.reset();
+        clock.sleepMs(configManager.getConfig().bus.commandTimeout);
+    }
+};
@@ -0,0 +1,87 @@
+// host/VirtualClock.h
+#pragma once
+#include <stdint.h>
+#include "interfaces/IClock.h"
+
+// Детерминированное виртуальное время для host-сборки. Пока проход цикла
+// работает, время стоит; idle() перескакивает к ближайшему пробуждению,
+// которое запросили компоненты (таймеры, опрос, линия, эмулятор).
+// Сутки опроса и keep-alive проходят за секунды реального времени.
+// Цикл и все компоненты работают в одном потоке - без блокировок.
+class VirtualClock : public IClock
+{
+private:
+    static const int64_t NO_WAKE = INT64_MAX;
+    static const int64_t MIN_STEP_US = 100; // Пробуждение "сейчас" - как пауза цикла на host
+
+    int64_t currentUs;
+    int64_t wakeUs = NO_WAKE;
+    uint32_t maxStepUs; // Предел скачка: компоненты без запроса пробуждения (пауза кадра)
+
+    uint64_t passes = 0;
+    uint64_t capped = 0; // Скачков, ограниченных maxStepUs (пробуждение не запрошено)
+
+public:
+    // Время начинается не с нуля: 0 в компонентах часто значит "не задано"
+    explicit VirtualClock(uint32_t maxStepMs = 100, int64_t startUs = 1000000)
+        : currentUs(startUs), maxStepUs(maxStepMs * 1000) {}
+
+    unsigned long nowMs() const override
+    {
+        return static_cast<unsigned long>(currentUs / 1000);
+    }
+
+    int64_t nowUs() const override
+    {
+        return currentUs;
+    }
+
+    void sleepMs(uint32_t ms) override
+    {
+        currentUs += static_cast<int64_t>(ms) * 1000;
+    }
+
+    void sleepUs(uint32_t us) override
+    {
+        currentUs += us;
+    }
+
+    void wakeAt(unsigned long deadlineMs) override
+    {
+        // Дедлайн по millis() мог перейти через 0 - сравниваем разницей
+        long ahead = static_cast<long>(deadlineMs - nowMs());
+        wakeAtUs(currentUs + static_cast<int64_t>(ahead) * 1000);
+    }
+
+    void wakeAtUs(int64_t deadlineUs) override
+    {
+        if (deadlineUs < wakeUs)
+            wakeUs = deadlineUs;
+    }
+
+    void idle(uint32_t maxUs) override
+    {
+        int64_t target = wakeUs;
+        if (target > currentUs + maxStepUs)
+        {
+            target = currentUs + maxStepUs;
+            capped++;
+        }
+        if (target < currentUs + MIN_STEP_US)
+            target = currentUs + MIN_STEP_US;
+
+        currentUs = target;
+        wakeUs = NO_WAKE;
+        passes++;
+    }
+
+    uint64_t getPasses() const
+    {
+        return passes;
+    }
+
+    uint64_t getCappedSteps() const
+    {
+        return capped;
+    }
+};
@@ -0,0 +1,529 @@
+// host/main.cpp
+// Сборка для Linux (pio run -e native): прием, очередь команд, менеджеры и
+// декодеры работают с шиной на псевдотерминале или UNIX сокете - для
+// регрессионных прогонов и замеров без нагревателя и ESP32.
+//
+//   .pio/build/native/program [--socket PATH] [--fs DIR] [--connect] [--duration MS]
+//                             [--emulate PROFILE] [--seed N] [--bench SECONDS]
+//                             [--virtual] [--step-ms N] [--bench-rx FRAMES]
+//                             [--microbench ITERATIONS]
+//
+// Без --socket создается PTY, путь к нему печатается при запуске.
+// --emulate подключает встроенный эмулятор блока (EcuEmulator) с профилем
+// помех: clean, slow, nak, lossy, noisy, unsupported, stress.
+// --bench прогоняет все профили по SECONDS секунд (подключение, запуск,
+// работа, выключение) и печатает отчет по каждому.
+// --virtual - виртуальное время (VirtualClock) и виртуальная линия с
+// эмулятором, без потоков. Без --bench прогоняется сценарий на --duration мс
+// виртуального времени (по умолчанию сутки): подключение, опрос, keep-alive,
+// паркинг-нагрев по 45 минут каждые 4 часа; в конце - отчет с загрузкой шины.
+// --step-ms - наибольший скачок времени, если пробуждение не запрошено.
+// --bench-rx - замер приемника (ReceiverBench): кадры/с и аллокации на кадр.
+// --microbench - микрозамеры разбора (MicroBench): прежняя реализация и текущая.
+// Команды из stdin: connect, dc, start, stop, stats, ecu или HEX кадр.
+// В сборке тестов (pio test) точку входа дает набор тестов.
+#ifndef PIO_UNIT_TESTING
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <csignal>
+#include "core/EventBus.h"
+#include "core/ConfigManager.h"
+#include "core/FileSystemManager.h"
+#include "application/CommandReceiver.h"
+#include "application/CommandManager.h"
+#include "application/DeviceInfoManager.h"
+#include "application/SensorManager.h"
+#include "application/ErrorsManager.h"
+#include "application/HeaterController.h"
+#include "application/SnifferManager.h"
+#include "common/Constants.h"
+#include "common/Timer.h"
+#include "core/SystemClock.h"
+#include "./HostBusManager.h"
+#include "./EcuEmulator.h"
+#include "./VirtualClock.h"
+#include "./ReceiverBench.h"
+#include "./MicroBench.h"
+
+// Глобальные объекты Arduino API
+HardwareSerial Serial(0);
+LittleFSFS LittleFS;
+
+static volatile sig_atomic_t stopRequested = 0;
+
+// Переходы BUS_HEALTH_CHANGED за прогон: сколько раз шина деградировала или
+// пропадала и за сколько восстанавливалась до HEALTHY
+struct RecoveryStats
+{
+    uint32_t degraded = 0;
+    uint32_t down = 0;
+    uint32_t recoveries = 0;
+    uint32_t recoveryMaxMs = 0;
+    uint32_t recoverySumMs = 0;
+    unsigned long unhealthySince = 0;
+    bool unhealthy = false;
+
+    void onChanged(BusHealth newState, unsigned long now)
+    {
+        if (newState == BusHealth::DEGRADED)
+            degraded++;
+        else if (newState == BusHealth::DOWN)
+            down++;
+
+        if (newState != BusHealth::HEALTHY && !unhealthy)
+        {
+            unhealthy = true;
+            unhealthySince = now;
+        }
+        else if (newState == BusHealth::HEALTHY && unhealthy)
+        {
+            uint32_t elapsed = now - unhealthySince;
+            unhealthy = false;
+            recoveries++;
+            recoverySumMs += elapsed;
+            if (elapsed > recoveryMaxMs)
+                recoveryMaxMs = elapsed;
+        }
+    }
+
+    String toJson() const
+    {
+        String json = "{";
+        json += "\"degraded\":" + String(degraded) + ",";
+        json += "\"down\":" + String(down) + ",";
+        json += "\"recoveries\":" + String(recoveries) + ",";
+        json += "\"recoveryAvgMs\":" + String(recoveries > 0 ? recoverySumMs / recoveries : 0) + ",";
+        json += "\"recoveryMaxMs\":" + String(recoveryMaxMs) + ",";
+        json += "\"unrecovered\":" + String(unhealthy ? "true" : "false");
+        json += "}";
+        return json;
+    }
+};
+
+static void printStats(CommandManager &commandManager, CommandReceiver &commandReceiver)
+{
+    WBusFramerStats framer = commandReceiver.getFramerStats();
+
+    Serial.println("{\"stats\":" + commandManager.getStatisticsJson() +
+                   ",\"timing\":" + commandManager.getTimingJson() +
+                   ",\"health\":" + commandManager.getHealthJson() +
+                   ",\"framer\":{\"framesReceived\":" + String(framer.framesReceived) +
+                   ",\"droppedFrames\":" + String(framer.droppedFrames()) + "}}");
+}
+
+// Итог прогона профиля: сторона контроллера (CommandManager, CommandReceiver),
+// восстановление шины, состояние нагревателя и счетчики эмулятора
+static void printBenchReport(const EcuFaultProfile &profile, unsigned long elapsedMs, CommandManager &commandManager,
+                             CommandReceiver &commandReceiver, const RecoveryStats &recovery,
+                             const String &heatingState, const String &finalState, const EcuEmulator &emulator)
+{
+    OpcodeStats totals = commandManager.getStatistics().getTotals();
+    WBusFramerStats framer = commandReceiver.getFramerStats();
+    float seconds = elapsedMs / 1000.0f;
+
+    String json = "{\"profile\":\"" + String(profile.name) + "\",";
+    json += "\"seconds\":" + String(seconds, 1) + ",";
+    json += "\"commands\":{";
+    json += "\"requests\":" + String(totals.requests) + ",";
+    json += "\"responses\":" + String(totals.responses) + ",";
+    json += "\"timeouts\":" + String(totals.timeouts) + ",";
+    json += "\"retries\":" + String(totals.retries) + ",";
+    json += "\"naks\":" + String(totals.naks) + ",";
+    json += "\"mismatches\":" + String(totals.mismatches) + ",";
+    json += "\"responsesPerSec\":" + String(seconds > 0 ? totals.responses / seconds : 0.0f, 2) + ",";
+    json += "\"rttMinMs\":" + String(totals.rttMinMs) + ",";
+    json += "\"rttAvgMs\":" + String(totals.responses > 0 ? totals.rttSumMs / totals.responses : 0) + ",";
+    json += "\"rttMaxMs\":" + String(totals.rttMaxMs);
+    json += "},";
+    json += "\"receiver\":{";
+    json += "\"framesReceived\":" + String(framer.framesReceived) + ",";
+    json += "\"checksumErrors\":" + String(framer.checksumErrors) + ",";
+    json += "\"lengthErrors\":" + String(framer.lengthErrors) + ",";
+    json += "\"gapAborts\":" + String(framer.gapAborts) + ",";
+    json += "\"resyncs\":" + String(framer.resyncs) + ",";
+    json += "\"discardedBytes\":" + String(framer.discardedBytes) + ",";
+    json += "\"queueOverflows\":" + String(commandReceiver.getQueueOverflows());
+    json += "},";
+    json += "\"recovery\":" + recovery.toJson() + ",";
+    json += "\"heater\":{\"heating\":\"" + heatingState + "\",\"final\":\"" + finalState + "\"},";
+    json += "\"ecu\":" + emulator.getStats().toJson();
+    json += "}";
+
+    Serial.println(json);
+}
+
+// Итог прогона на виртуальном времени: сколько смоделировано и за сколько
+// реального времени, объем обмена и загрузка шины
+static void printSimulationReport(const VirtualClock &clock, unsigned long virtualMs, int64_t wallUs,
+                                  CommandManager &commandManager, const HostBusManager &busManager,
+                                  uint32_t keepAlives, uint32_t heatCycles, const RecoveryStats &recovery,
+                                  const EcuEmulator &emulator)
+{
+    OpcodeStats totals = commandManager.getStatistics().getTotals();
+    uint64_t busyMs = busManager.getWireBusyMs();
+
+    String json = "{\"virtualHours\":" + String(virtualMs / 3600000.0f, 2) + ",";
+    json += "\"wallSeconds\":" + String(wallUs / 1000000.0f, 2) + ",";
+    json += "\"speedup\":" + String(wallUs > 0 ? virtualMs * 1000.0 / wallUs : 0.0, 0) + ",";
+    json += "\"passes\":" + String(clock.getPasses()) + ",";
+    json += "\"cappedSteps\":" + String(clock.getCappedSteps()) + ",";
+    json += "\"commands\":{";
+    json += "\"requests\":" + String(totals.requests) + ",";
+    json += "\"responses\":" + String(totals.responses) + ",";
+    json += "\"timeouts\":" + String(totals.timeouts) + ",";
+    json += "\"retries\":" + String(totals.retries) + ",";
+    json += "\"naks\":" + String(totals.naks) + ",";
+    json += "\"rttAvgMs\":" + String(totals.responses > 0 ? totals.rttSumMs / totals.responses : 0);
+    json += "},";
+    json += "\"keepAlives\":" + String(keepAlives) + ",";
+    json += "\"heatCycles\":" + String(heatCycles) + ",";
+    json += "\"bus\":{";
+    json += "\"txBytes\":" + String(busManager.getTxBytes()) + ",";
+    json += "\"rxBytes\":" + String(busManager.getRxBytes()) + ",";
+    json += "\"busyMs\":" + String(busyMs) + ",";
+    json += "\"utilizationPct\":" + String(virtualMs > 0 ? busyMs * 100.0 / virtualMs : 0.0, 2);
+    json += "},";
+    json += "\"health\":" + commandManager.getHealthJson() + ",";
+    json += "\"recovery\":" + recovery.toJson() + ",";
+    json += "\"ecu\":" + emulator.getStats().toJson();
+    json += "}";
+
+    Serial.println(json);
+}
+
+// Строка из stdin без блокировки цикла
+static bool readConsoleLine(String &line)
+{
+    static String pending;
+
+    pollfd descriptor = {STDIN_FILENO, POLLIN, 0};
+    while (::poll(&descriptor, 1, 0) > 0 && (descriptor.revents & POLLIN))
+    {
+        char c;
+        if (::read(STDIN_FILENO, &c, 1) != 1)
+            return false;
+
+        if (c == '\n')
+        {
+            line = pending;
+            line.trim();
+            pending = String();
+            return true;
+        }
+        pending += c;
+    }
+    return false;
+}
+
+int main(int argc, char **argv)
+{
+    const char *socketPath = nullptr;
+    bool connectOnStart = false;
+    long durationMs = 0;
+    const EcuFaultProfile *emulatedProfile = nullptr;
+    uint32_t seed = 1;
+    long benchSeconds = 0;
+    bool virtualTime = false;
+    uint32_t stepMs = 100;
+    uint32_t benchRxFrames = 0;
+    uint32_t microbenchIterations = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        String arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc)
+            socketPath = argv[++i];
+        else if (arg == "--fs" && i + 1 < argc)
+            LittleFS.setRoot(argv[++i]);
+        else if (arg == "--connect")
+            connectOnStart = true;
+        else if (arg == "--duration" && i + 1 < argc)
+            durationMs = atol(argv[++i]);
+        else if (arg == "--emulate" && i + 1 < argc && (emulatedProfile = EcuFaultProfile::find(argv[i + 1])))
+            i++;
+        else if (arg == "--seed" && i + 1 < argc)
+            seed = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--bench" && i + 1 < argc)
+            benchSeconds = atol(argv[++i]);
+        else if (arg == "--virtual")
+            virtualTime = true;
+        else if (arg == "--step-ms" && i + 1 < argc)
+            stepMs = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--bench-rx" && i + 1 < argc)
+            benchRxFrames = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--microbench" && i + 1 < argc)
+            microbenchIterations = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        else
+        {
+            Serial.println("Usage: " + String(argv[0]) + " [--socket PATH] [--fs DIR] [--connect] [--duration MS]"
+                                                         " [--emulate clean|slow|nak|lossy|noisy|unsupported|stress] [--seed N] [--bench SECONDS]"
+                                                         " [--virtual] [--step-ms N] [--bench-rx FRAMES]"
+                                                         " [--microbench ITERATIONS]");
+            return 2;
+        }
+    }
+
+    size_t profileCount = 0;
+    const EcuFaultProfile *profiles = EcuFaultProfile::getProfiles(profileCount);
+    if ((benchSeconds > 0 || virtualTime) && !emulatedProfile)
+        emulatedProfile = &profiles[0];
+    if (virtualTime && durationMs <= 0)
+        durationMs = 24L * 3600L * 1000L;
+
+    setvbuf(stdout, nullptr, _IOLBF, 0);
+
+    if (microbenchIterations > 0)
+    {
+        MicroBench microBench(microbenchIterations);
+        microBench.run();
+        Serial.flush();
+        std::_Exit(0);
+    }
+
+    std::signal(SIGINT, [](int)
+                { stopRequested = 1; });
+    std::signal(SIGTERM, [](int)
+                { stopRequested = 1; });
+
+    EventBus &eventBus = EventBus::getInstance();
+    FileSystemManager fileSystemManager;
+    ConfigManager configManager(eventBus, fileSystemManager);
+
+    // Замер приемника - до создания стека, чтобы кадры не уходили подписчикам
+    if (benchRxFrames > 0)
+    {
+        configManager.initialize();
+        ReceiverBench receiverBench(eventBus, configManager);
+        receiverBench.run(benchRxFrames);
+        Serial.flush();
+        std::_Exit(0);
+    }
+
+    SystemClock systemClock;
+    VirtualClock virtualClock(stepMs);
+    IClock &clock = virtualTime ? static_cast<IClock &>(virtualClock) : systemClock;
+
+    HardwareSerial kLineSerial(KLINE_UART_NUM);
+    HostBusManager busManager(configManager, kLineSerial, eventBus, clock);
+    CommandReceiver commandReceiver(kLineSerial, eventBus, configManager, clock);
+    CommandManager commandManager(configManager, eventBus, busManager, commandReceiver, clock);
+    DeviceInfoManager deviceInfoManager(eventBus, commandManager);
+    SensorManager sensorManager(eventBus, commandManager);
+    ErrorsManager errorsManager(eventBus, commandManager);
+    HeaterController heaterController(eventBus, commandManager, busManager, deviceInfoManager, sensorManager, errorsManager, clock);
+    SnifferManager snifferManager(eventBus, deviceInfoManager, sensorManager, errorsManager, heaterController);
+
+    EcuEmulator emulator(emulatedProfile ? *emulatedProfile : profiles[0], clock, seed);
+    RecoveryStats recovery;
+    Timer keepAliveTimer(clock, 15000);
+    uint32_t keepAlives = 0;
+
+    Serial.println("🚗 Webasto W-Bus host build");
+    configManager.initialize();
+
+    int emulatorFd = -1;
+    bool opened = virtualTime ? busManager.openVirtual(emulator) : emulatedProfile ? busManager.openSocketPair(emulatorFd)
+                                                              : socketPath        ? busManager.openSocket(socketPath)
+                                                                                  : busManager.openPty();
+    if (!opened || !busManager.initialize())
+    {
+        Serial.println("❌ Cannot open bus: " + String(socketPath ? socketPath : "PTY"));
+        return 1;
+    }
+    Serial.println("🔌 Bus: " + busManager.getEndpoint());
+
+    if (emulatedProfile)
+    {
+        if (!virtualTime)
+            emulator.start(emulatorFd);
+        Serial.println("🔥 ECU emulator: " + emulator.getProfileName());
+    }
+
+    eventBus.subscribe(EventType::BUS_HEALTH_CHANGED, [&recovery, &clock](const Event &event)
+                       {
+        const auto &healthEvent = static_cast<const TypedEvent<BusHealthChangedEvent> &>(event);
+        recovery.onChanged(healthEvent.data.newState, clock.nowMs()); });
+
+    eventBus.subscribe(EventType::KEEP_ALLIVE_SENT, [&keepAlives](const Event &event)
+                       { keepAlives++; });
+
+    // На виртуальном времени задачи приема нет - кадры разбирает цикл
+    commandReceiver.initialize(!virtualTime);
+    commandManager.initialize();
+    heaterController.initialize();
+    keepAliveTimer.setInterval(configManager.getConfig().bus.keepAliveInterval);
+
+    busManager.connect();
+    if (connectOnStart)
+        heaterController.connect();
+
+    // Keep-alive активного режима - как WebastoApplication::processKeepAlive
+    auto processKeepAlive = [&]()
+    {
+        WBusFrame keepAliveCommand;
+        switch (heaterController.getStatus().state)
+        {
+        case WebastoState::PARKING_HEAT:
+            keepAliveCommand = WBusCommandBuilder::createKeepAliveParking();
+            break;
+        case WebastoState::VENTILATION:
+            keepAliveCommand = WBusCommandBuilder::createKeepAliveVentilation();
+            break;
+        case WebastoState::SUPP_HEAT:
+            keepAliveCommand = WBusCommandBuilder::createKeepAliveSupplemental();
+            break;
+        case WebastoState::CIRC_PUMP:
+            keepAliveCommand = WBusCommandBuilder::createKeepAliveCirculationPump();
+            break;
+        case WebastoState::BOOST:
+            keepAliveCommand = WBusCommandBuilder::createKeepAliveBoost();
+            break;
+        default:
+            return;
+        }
+
+        if (busManager.isConnected())
+        {
+            heaterController.checkWebastoStatus();
+            commandManager.addSafetyCommand(keepAliveCommand, [&eventBus](const PacketView &tx, const PacketView &rx)
+                                            { eventBus.publish(EventType::KEEP_ALLIVE_SENT); });
+        }
+    };
+
+    auto runLoop = [&]()
+    {
+        busManager.process();
+        commandReceiver.process();
+        commandManager.process();
+        heaterController.process();
+
+        if (keepAliveTimer.isReady())
+            processKeepAlive();
+
+        clock.idle(100);
+    };
+
+    auto runFor = [&](unsigned long ms)
+    {
+        unsigned long startedAt = clock.nowMs();
+        while (!stopRequested && clock.nowMs() - startedAt < ms)
+            runLoop();
+    };
+
+    auto stateName = [&]()
+    {
+        return HeaterStatus::getStateName(heaterController.getStatus().state);
+    };
+
+    // Нагрузочный прогон: каждый профиль - подключение, запуск на четверти
+    // времени, выключение на трех четвертях. Профили не зависят от порядка:
+    // перед каждым - отключение (очередь, опрос, адаптивные таймауты,
+    // групповое чтение сбрасываются), новый блок в эмуляторе, статистика с нуля
+    if (benchSeconds > 0)
+    {
+        const unsigned long SETTLE_MS = 1000; // Линия затихает после отключения
+        unsigned long profileMs = static_cast<unsigned long>(benchSeconds) * 1000UL;
+        for (size_t i = 0; i < profileCount && !stopRequested; i++)
+        {
+            heaterController.disconnect();
+            emulator.restart(profiles[i]);
+            runFor(SETTLE_MS);
+
+            // Старт с целой секунды: одинаковая фаза таймеров при любом порядке профилей
+            clock.sleepUs(static_cast<uint32_t>(1000000 - clock.nowUs() % 1000000));
+
+            commandManager.resetStatistics();
+            commandReceiver.resetFramerStats();
+            recovery = RecoveryStats();
+            keepAliveTimer.reset();
+            Serial.println("🧪 Profile: " + String(profiles[i].name));
+
+            unsigned long startedAt = clock.nowMs();
+            heaterController.connect();
+
+            runFor(profileMs / 4);
+            heaterController.startParkingHeat();
+            runFor(profileMs / 2);
+            String heatingState = stateName();
+            heaterController.shutdown();
+            runFor(profileMs - profileMs / 4 - profileMs / 2);
+
+            printBenchReport(profiles[i], clock.nowMs() - startedAt, commandManager, commandReceiver, recovery,
+                             heatingState, stateName(), emulator);
+        }
+
+        Serial.flush();
+        std::_Exit(0);
+    }
+
+    // Сценарий на виртуальном времени: подключение и паркинг-нагрев
+    // по 45 минут каждые 4 часа, начиная с первого часа
+    if (virtualTime)
+    {
+        const unsigned long HOUR_MS = 3600000UL;
+        const unsigned long CYCLE_MS = 4 * HOUR_MS;
+        const unsigned long HEAT_MS = 45 * 60000UL;
+
+        uint32_t heatCycles = 0;
+        unsigned long startedAt = clock.nowMs();
+        int64_t wallStartedUs = esp_timer_get_time();
+
+        heaterController.connect();
+        while (!stopRequested && (long)(clock.nowMs() - startedAt) < durationMs)
+        {
+            unsigned long elapsed = clock.nowMs() - startedAt;
+            unsigned long nextHeatAt = HOUR_MS + heatCycles * CYCLE_MS;
+
+            if (elapsed >= nextHeatAt)
+            {
+                heatCycles++;
+                heaterController.startParkingHeat();
+                runFor(HEAT_MS);
+                heaterController.shutdown();
+                continue;
+            }
+
+            runFor(nextHeatAt - elapsed < static_cast<unsigned long>(durationMs) - elapsed ? nextHeatAt - elapsed
+                                                                                          : durationMs - elapsed);
+        }
+
+        printSimulationReport(virtualClock, clock.nowMs() - startedAt, esp_timer_get_time() - wallStartedUs,
+                              commandManager, busManager, keepAlives, heatCycles, recovery, emulator);
+        Serial.flush();
+        std::_Exit(0);
+    }
+
+    unsigned long startedAt = millis();
+    while (!stopRequested && (durationMs <= 0 || (long)(millis() - startedAt) < durationMs))
+    {
+        runLoop();
+
+        String line;
+        if (readConsoleLine(line) && !line.isEmpty())
+        {
+            line.toLowerCase();
+            if (line == "connect" || line == "con")
+                heaterController.connect();
+            else if (line == "disconnect" || line == "dc")
+                heaterController.disconnect();
+            else if (line == "start")
+                heaterController.startParkingHeat();
+            else if (line == "stop")
+                heaterController.shutdown();
+            else if (line == "stats")
+                printStats(commandManager, commandReceiver);
+            else if (line == "ecu")
+                Serial.println(emulator.toJson());
+            else
+                commandManager.addPriorityCommand(WBusFrame::fromHexString(line));
+        }
+    }
+
+    printStats(commandManager, commandReceiver);
+    Serial.flush();
+
+    // Задача приема FreeRTOS (поток) не останавливается - выходим без деструкторов
+    std::_Exit(0);
+}
+
+#endif // PIO_UNIT_TESTING
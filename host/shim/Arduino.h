@@ -0,0 +1,523 @@
+// host/shim/Arduino.h
+#pragma once
+// Минимальная замена Arduino API для сборки стека протокола на Linux (env:native):
+// String, время (millis/micros/delay), Serial и HardwareSerial поверх
+// файлового дескриптора (PTY или UNIX сокет). GPIO - заглушки.
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <unistd.h>
+#include <poll.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include "esp_timer.h"
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define DEC 10
+#define HEX 16
+
+#define LED_BUILTIN 48
+#define RGB_BUILTIN LED_BUILTIN
+#define RGB_BRIGHTNESS 64
+
+// Значения как в ядре ESP32 (для BusConfig::getSerialConfig)
+#define SERIAL_8N1 0x800001c
+#define SERIAL_8E1 0x800001e
+#define SERIAL_8O1 0x800001f
+#define SERIAL_7E1 0x800001a
+#define SERIAL_7O1 0x800001b
+
+#define F(string_literal) (string_literal)
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// ==================== ВРЕМЯ ====================
+
+inline unsigned long micros()
+{
+    return static_cast<unsigned long>(esp_timer_get_time());
+}
+
+inline unsigned long millis()
+{
+    return static_cast<unsigned long>(esp_timer_get_time() / 1000);
+}
+
+inline void delay(unsigned long ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+inline void delayMicroseconds(unsigned int us)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+inline void yield()
+{
+    std::this_thread::yield();
+}
+
+// ==================== GPIO ====================
+
+inline void pinMode(uint8_t pin, uint8_t mode) {}
+inline void digitalWrite(uint8_t pin, uint8_t value) {}
+inline int digitalRead(uint8_t pin) { return HIGH; }
+inline void neopixelWrite(uint8_t pin, uint8_t red, uint8_t green, uint8_t blue) {}
+
+// ==================== STRING ====================
+
+class String
+{
+private:
+    std::string value;
+
+    void assignNumber(const char *format, ...) __attribute__((format(printf, 2, 3)))
+    {
+        char buffer[72];
+        va_list args;
+        va_start(args, format);
+        vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+        value = buffer;
+    }
+
+    void assignUnsigned(unsigned long long number, unsigned char base)
+    {
+        if (base == 10)
+        {
+            assignNumber("%llu", number);
+            return;
+        }
+
+        char buffer[72];
+        char *cursor = buffer + sizeof(buffer) - 1;
+        *cursor = '\0';
+        do
+        {
+            unsigned digit = number % base;
+            *--cursor = static_cast<char>(digit < 10 ? '0' + digit : 'a' + digit - 10);
+            number /= base;
+        } while (number);
+        value = cursor;
+    }
+
+    void assignSigned(long long number, unsigned char base)
+    {
+        if (base == 10)
+            assignNumber("%lld", number);
+        else
+            assignUnsigned(static_cast<unsigned long long>(number), base);
+    }
+
+public:
+    String() {}
+    String(const char *text) : value(text ? text : "") {}
+    String(const std::string &text) : value(text) {}
+    String(char c) : value(1, c) {}
+    String(unsigned char number, unsigned char base = DEC) { assignUnsigned(number, base); }
+    String(int number, unsigned char base = DEC) { assignSigned(number, base); }
+    String(unsigned int number, unsigned char base = DEC) { assignUnsigned(number, base); }
+    String(long number, unsigned char base = DEC) { assignSigned(number, base); }
+    String(unsigned long number, unsigned char base = DEC) { assignUnsigned(number, base); }
+    String(long long number, unsigned char base = DEC) { assignSigned(number, base); }
+    String(unsigned long long number, unsigned char base = DEC) { assignUnsigned(number, base); }
+    String(float number, unsigned int decimals = 2) { assignNumber("%.*f", decimals, number); }
+    String(double number, unsigned int decimals = 2) { assignNumber("%.*f", decimals, number); }
+
+    // size_t, как у String на ESP32 (там это unsigned int)
+    size_t length() const { return value.size(); }
+    const char *c_str() const { return value.c_str(); }
+    bool isEmpty() const { return value.empty(); }
+    bool reserve(unsigned int size)
+    {
+        value.reserve(size);
+        return true;
+    }
+
+    char charAt(unsigned int index) const { return index < value.size() ? value[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    char &operator[](unsigned int index) { return value[index]; }
+
+    bool concat(const String &other)
+    {
+        value += other.value;
+        return true;
+    }
+    bool concat(const char *text)
+    {
+        if (text)
+            value += text;
+        return true;
+    }
+    bool concat(const char *text, unsigned int length)
+    {
+        value.append(text, length);
+        return true;
+    }
+    bool concat(char c)
+    {
+        value += c;
+        return true;
+    }
+
+    // Числа и прочее через конструктор String; строки C (в том числе
+    // массивы char) - без временного объекта, как в ядре ESP32
+    template <typename T, typename = typename std::enable_if<!std::is_convertible<const T &, const char *>::value>::type>
+    String &operator+=(const T &other)
+    {
+        concat(String(other));
+        return *this;
+    }
+    String &operator+=(const String &other)
+    {
+        concat(other);
+        return *this;
+    }
+    String &operator+=(const char *text)
+    {
+        concat(text);
+        return *this;
+    }
+    String &operator+=(char c)
+    {
+        concat(c);
+        return *this;
+    }
+
+    friend String operator+(const String &left, const String &right) { return String(left.value + right.value); }
+    friend String operator+(const String &left, const char *right) { return String(left.value + (right ? right : "")); }
+    friend String operator+(const char *left, const String &right) { return String(std::string(left ? left : "") + right.value); }
+    friend String operator+(const String &left, char right) { return String(left.value + right); }
+    template <typename T>
+    friend String operator+(const String &left, const T &right) { return left + String(right); }
+
+    bool equals(const String &other) const { return value == other.value; }
+    bool operator==(const String &other) const { return value == other.value; }
+    bool operator==(const char *text) const { return value == (text ? text : ""); }
+    bool operator!=(const String &other) const { return value != other.value; }
+    bool operator!=(const char *text) const { return !(*this == text); }
+    bool operator<(const String &other) const { return value < other.value; }
+
+    int indexOf(char c, unsigned int from = 0) const
+    {
+        size_t position = value.find(c, from);
+        return position == std::string::npos ? -1 : static_cast<int>(position);
+    }
+    int indexOf(const String &text, unsigned int from = 0) const
+    {
+        size_t position = value.find(text.value, from);
+        return position == std::string::npos ? -1 : static_cast<int>(position);
+    }
+    int lastIndexOf(char c) const
+    {
+        size_t position = value.rfind(c);
+        return position == std::string::npos ? -1 : static_cast<int>(position);
+    }
+
+    bool startsWith(const String &prefix) const { return value.compare(0, prefix.value.size(), prefix.value) == 0; }
+    bool endsWith(const String &suffix) const
+    {
+        return value.size() >= suffix.value.size() &&
+               value.compare(value.size() - suffix.value.size(), suffix.value.size(), suffix.value) == 0;
+    }
+
+    String substring(unsigned int from) const { return from < value.size() ? String(value.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const
+    {
+        if (from > to)
+            std::swap(from, to);
+        if (from >= value.size())
+            return String();
+        return String(value.substr(from, to - from));
+    }
+
+    void replace(const String &find, const String &replacement)
+    {
+        if (find.value.empty())
+            return;
+        size_t position = 0;
+        while ((position = value.find(find.value, position)) != std::string::npos)
+        {
+            value.replace(position, find.value.size(), replacement.value);
+            position += replacement.value.size();
+        }
+    }
+
+    void remove(unsigned int index)
+    {
+        if (index < value.size())
+            value.erase(index);
+    }
+    void remove(unsigned int index, unsigned int count)
+    {
+        if (index < value.size())
+            value.erase(index, count);
+    }
+
+    void toLowerCase()
+    {
+        for (char &c : value)
+            c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    }
+    void toUpperCase()
+    {
+        for (char &c : value)
+            c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    }
+    void trim()
+    {
+        size_t first = value.find_first_not_of(" \t\r\n");
+        if (first == std::string::npos)
+        {
+            value.clear();
+            return;
+        }
+        size_t last = value.find_last_not_of(" \t\r\n");
+        value = value.substr(first, last - first + 1);
+    }
+
+    long toInt() const { return atol(value.c_str()); }
+    float toFloat() const { return static_cast<float>(atof(value.c_str())); }
+};
+
+// ==================== PRINT / STREAM ====================
+
+class Print
+{
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t byte) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size)
+    {
+        size_t written = 0;
+        while (size-- && write(*buffer++))
+            written++;
+        return written;
+    }
+    size_t write(const char *text) { return text ? write(reinterpret_cast<const uint8_t *>(text), strlen(text)) : 0; }
+    size_t write(const char *buffer, size_t size) { return write(reinterpret_cast<const uint8_t *>(buffer), size); }
+
+    size_t print(const String &text) { return write(text.c_str(), text.length()); }
+    size_t print(const char *text) { return write(text); }
+    size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+    template <typename T>
+    size_t print(const T &value) { return print(String(value)); }
+    template <typename T>
+    size_t print(const T &value, int format) { return print(String(value, format)); }
+
+    size_t println() { return write("\n"); }
+    template <typename T>
+    size_t println(const T &value) { return print(value) + println(); }
+    template <typename T>
+    size_t println(const T &value, int format) { return print(value, format) + println(); }
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)))
+    {
+        char buffer[256];
+        va_list args;
+        va_start(args, format);
+        int length = vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+        if (length < 0)
+            return 0;
+        return write(buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1));
+    }
+
+    virtual void flush() {}
+};
+
+// Сигнатуры String, Stream и Print, которые используют адаптеры ArduinoJson
+// (ARDUINOJSON_ENABLE_ARDUINO_STRING/STREAM/PRINT). Проверки лишь фиксируют
+// совпадение с ESP32: сборка с настоящей библиотекой не проверялась,
+// только с ее упрощенной заглушкой
+static_assert(std::is_same<decltype(std::declval<const String>().c_str()), const char *>::value, "ArduinoJson: String::c_str()");
+static_assert(std::is_same<decltype(std::declval<const String>().length()), size_t>::value, "ArduinoJson: String::length()");
+static_assert(std::is_convertible<decltype(std::declval<String>().concat(std::declval<const char *>())), bool>::value, "ArduinoJson: String::concat()");
+static_assert(std::is_same<decltype(std::declval<Print>().write(std::declval<uint8_t>())), size_t>::value, "ArduinoJson: Print::write()");
+
+class Stream : public Print
+{
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    size_t readBytes(char *buffer, size_t length)
+    {
+        size_t count = 0;
+        while (count < length && available() > 0)
+            buffer[count++] = static_cast<char>(read());
+        return count;
+    }
+    size_t readBytes(uint8_t *buffer, size_t length) { return readBytes(reinterpret_cast<char *>(buffer), length); }
+
+    String readString()
+    {
+        String text;
+        while (available() > 0)
+            text += static_cast<char>(read());
+        return text;
+    }
+};
+
+static_assert(std::is_same<decltype(std::declval<Stream>().readBytes(std::declval<char *>(), size_t())), size_t>::value, "ArduinoJson: Stream::readBytes()");
+
+// ==================== HARDWARE SERIAL ====================
+
+// UART на Linux: прием читает отдельный поток в буфер и вызывает onReceive.
+// Без подключенного дескриптора (Serial) вывод идет в stdout.
+// С localEcho переданные байты возвращаются в прием, как на однопроводной K-Line.
+class HardwareSerial : public Stream
+{
+private:
+    int uartNum;
+    int fd = -1;
+    bool localEcho = false;
+
+    std::deque<uint8_t> rxBuffer;
+    std::mutex rxMutex;
+    std::function<void(void)> receiveCallback;
+    std::thread readerThread;
+    std::atomic<bool> readerRunning{false};
+
+    void pushReceived(const uint8_t *data, size_t length)
+    {
+        {
+            std::lock_guard<std::mutex> lock(rxMutex);
+            rxBuffer.insert(rxBuffer.end(), data, data + length);
+        }
+        if (receiveCallback)
+            receiveCallback();
+    }
+
+    void readerLoop()
+    {
+        uint8_t buffer[256];
+        while (readerRunning)
+        {
+            pollfd descriptor = {fd, POLLIN, 0};
+            if (::poll(&descriptor, 1, 50) <= 0)
+                continue;
+
+            ssize_t count = ::read(fd, buffer, sizeof(buffer));
+            if (count > 0)
+                pushReceived(buffer, static_cast<size_t>(count));
+            else if (count == 0 || (descriptor.revents & (POLLHUP | POLLERR)))
+                std::this_thread::sleep_for(std::chrono::milliseconds(10)); // Другая сторона закрыта
+        }
+    }
+
+public:
+    explicit HardwareSerial(int uart) : uartNum(uart) {}
+
+    ~HardwareSerial()
+    {
+        detach();
+    }
+
+    // Скорость и формат задает сторона, открывшая PTY/сокет
+    void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int8_t rxPin = -1, int8_t txPin = -1) {}
+    void end() {}
+
+    void attach(int descriptor, bool echo)
+    {
+        detach();
+        fd = descriptor;
+        localEcho = echo;
+        readerRunning = true;
+        readerThread = std::thread(&HardwareSerial::readerLoop, this);
+    }
+
+    void detach()
+    {
+        readerRunning = false;
+        if (readerThread.joinable())
+            readerThread.join();
+        fd = -1;
+    }
+
+    // Прием без дескриптора: байты виртуальной линии (HostBusManager::openVirtual)
+    void inject(const uint8_t *data, size_t length)
+    {
+        pushReceived(data, length);
+    }
+
+    void onReceive(std::function<void(void)> callback, bool onlyOnTimeout = false)
+    {
+        receiveCallback = callback;
+    }
+
+    int available() override
+    {
+        std::lock_guard<std::mutex> lock(rxMutex);
+        return static_cast<int>(rxBuffer.size());
+    }
+
+    int read() override
+    {
+        std::lock_guard<std::mutex> lock(rxMutex);
+        if (rxBuffer.empty())
+            return -1;
+        uint8_t byte = rxBuffer.front();
+        rxBuffer.pop_front();
+        return byte;
+    }
+
+    int peek() override
+    {
+        std::lock_guard<std::mutex> lock(rxMutex);
+        return rxBuffer.empty() ? -1 : rxBuffer.front();
+    }
+
+    using Print::write;
+
+    size_t write(uint8_t byte) override
+    {
+        return write(&byte, 1);
+    }
+
+    size_t write(const uint8_t *buffer, size_t size) override
+    {
+        if (fd < 0)
+            return fwrite(buffer, 1, size, stdout);
+
+        size_t written = 0;
+        while (written < size)
+        {
+            ssize_t count = ::write(fd, buffer + written, size - written);
+            if (count <= 0)
+                break;
+            written += static_cast<size_t>(count);
+        }
+
+        if (localEcho && written > 0)
+            pushReceived(buffer, written);
+        return written;
+    }
+
+    void flush() override
+    {
+        if (fd < 0)
+            fflush(stdout);
+    }
+};
+
+extern HardwareSerial Serial;
@@ -0,0 +1,3 @@
+// host/shim/HardwareSerial.h
+#pragma once
+#include "Arduino.h"
@@ -0,0 +1,190 @@
+// host/shim/LittleFS.h
+#pragma once
+#include <Arduino.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <memory>
+#include <vector>
+
+// Файловая система устройства на Linux: каталог на диске (по умолчанию .pio/host_fs)
+class File : public Stream
+{
+private:
+    std::shared_ptr<FILE> handle;
+    String path;
+    bool directory = false;
+    std::vector<String> entries; // Содержимое каталога для openNextFile()
+    size_t nextEntry = 0;
+    String root;
+
+public:
+    File() {}
+
+    File(FILE *file, const String &filePath) : handle(file, fclose), path(filePath) {}
+
+    File(const String &dirPath, const String &fsRoot, std::vector<String> dirEntries)
+        : path(dirPath), directory(true), entries(std::move(dirEntries)), root(fsRoot) {}
+
+    explicit operator bool() const { return handle != nullptr || directory; }
+
+    void close()
+    {
+        handle.reset();
+        directory = false;
+    }
+
+    bool isDirectory() const { return directory; }
+
+    String name() const
+    {
+        int slash = path.lastIndexOf('/');
+        return slash >= 0 ? path.substring(slash + 1) : path;
+    }
+
+    size_t size()
+    {
+        if (!handle)
+            return 0;
+        long position = ftell(handle.get());
+        fseek(handle.get(), 0, SEEK_END);
+        long end = ftell(handle.get());
+        fseek(handle.get(), position, SEEK_SET);
+        return end > 0 ? static_cast<size_t>(end) : 0;
+    }
+
+    File openNextFile()
+    {
+        while (directory && nextEntry < entries.size())
+        {
+            String entryPath = path + (path.endsWith("/") ? "" : "/") + entries[nextEntry++];
+            FILE *file = fopen((root + entryPath).c_str(), "r");
+            if (file)
+                return File(file, entryPath);
+        }
+        return File();
+    }
+
+    int available() override
+    {
+        if (!handle)
+            return 0;
+        size_t position = static_cast<size_t>(ftell(handle.get()));
+        size_t total = size();
+        return total > position ? static_cast<int>(total - position) : 0;
+    }
+
+    int read() override
+    {
+        return handle ? fgetc(handle.get()) : -1;
+    }
+
+    int peek() override
+    {
+        if (!handle)
+            return -1;
+        int c = fgetc(handle.get());
+        if (c != EOF)
+            ungetc(c, handle.get());
+        return c;
+    }
+
+    using Print::write;
+
+    size_t write(uint8_t byte) override
+    {
+        return write(&byte, 1);
+    }
+
+    size_t write(const uint8_t *buffer, size_t length) override
+    {
+        return handle ? fwrite(buffer, 1, length, handle.get()) : 0;
+    }
+
+    void flush() override
+    {
+        if (handle)
+            fflush(handle.get());
+    }
+};
+
+class LittleFSFS
+{
+private:
+    String root = ".pio/host_fs";
+    bool mounted = false;
+
+    String fullPath(const char *path) const
+    {
+        return root + (path[0] == '/' ? "" : "/") + path;
+    }
+
+public:
+    // Только для host-сборки: каталог, в котором лежат файлы устройства
+    void setRoot(const String &directory)
+    {
+        root = directory;
+    }
+
+    bool begin(bool formatOnFail = false)
+    {
+        // Создаем каталог вместе с родительскими
+        String current;
+        for (unsigned int i = 0; i <= root.length(); i++)
+        {
+            if (i == root.length() || (root[i] == '/' && i > 0))
+                ::mkdir(current.c_str(), 0755);
+            if (i < root.length())
+                current += root[i];
+        }
+
+        struct stat info;
+        mounted = ::stat(root.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+        return mounted;
+    }
+
+    void end()
+    {
+        mounted = false;
+    }
+
+    File open(const char *path, const char *mode = "r")
+    {
+        String target = fullPath(path);
+
+        struct stat info;
+        if (strcmp(mode, "r") == 0 && ::stat(target.c_str(), &info) == 0 && S_ISDIR(info.st_mode))
+        {
+            std::vector<String> entries;
+            if (DIR *dir = ::opendir(target.c_str()))
+            {
+                while (dirent *entry = ::readdir(dir))
+                {
+                    if (entry->d_name[0] != '.')
+                        entries.push_back(entry->d_name);
+                }
+                ::closedir(dir);
+            }
+            return File(path, root, entries);
+        }
+
+        FILE *file = fopen(target.c_str(), mode);
+        return file ? File(file, path) : File();
+    }
+
+    bool exists(const char *path)
+    {
+        struct stat info;
+        return ::stat(fullPath(path).c_str(), &info) == 0;
+    }
+
+    bool remove(const char *path) { return ::remove(fullPath(path).c_str()) == 0; }
+    bool rename(const char *from, const char *to) { return ::rename(fullPath(from).c_str(), fullPath(to).c_str()) == 0; }
+    bool mkdir(const char *path) { return ::mkdir(fullPath(path).c_str(), 0755) == 0; }
+    bool rmdir(const char *path) { return ::rmdir(fullPath(path).c_str()) == 0; }
+    bool format() { return false; }
+
+    size_t totalBytes() { return 0; }
+    size_t usedBytes() { return 0; }
+};
+
+extern LittleFSFS LittleFS;
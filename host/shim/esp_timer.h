@@ -0,0 +1,11 @@
+// host/shim/esp_timer.h
+#pragma once
+#include <stdint.h>
+#include <chrono>
+
+// Монотонное время в микросекундах от первого вызова (как esp_timer от старта)
+inline int64_t esp_timer_get_time()
+{
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
@@ -0,0 +1,37 @@
+// host/shim/freertos/FreeRTOS.h
+#pragma once
+#include <stdint.h>
+#include <condition_variable>
+#include <mutex>
+
+// Задачи FreeRTOS на Linux - потоки std::thread, уведомления - счетчик
+// под мьютексом. Тик равен 1 мс.
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdPASS 1
+#define pdFAIL 0
+#define pdTRUE 1
+#define pdFALSE 0
+#define portMAX_DELAY 0xFFFFFFFFu
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+struct HostTask
+{
+    std::mutex mutex;
+    std::condition_variable notified;
+    uint32_t notifications = 0;
+};
+
+typedef HostTask *TaskHandle_t;
+
+// Критическая секция ESP32 (spinlock между ядрами) - мьютекс
+struct portMUX_TYPE
+{
+    std::mutex mutex;
+};
+
+#define portMUX_INITIALIZER_UNLOCKED {}
+#define portENTER_CRITICAL(mux) (mux)->mutex.lock()
+#define portEXIT_CRITICAL(mux) (mux)->mutex.unlock()
@@ -0,0 +1,68 @@
+// host/shim/freertos/task.h
+#pragma once
+#include <chrono>
+#include <thread>
+#include "FreeRTOS.h"
+
+typedef void (*TaskFunction_t)(void *);
+
+inline TaskHandle_t &hostCurrentTask()
+{
+    thread_local TaskHandle_t task = nullptr;
+    return task;
+}
+
+// Ядро и приоритет на Linux не задаются; задача живет до завершения процесса
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char *name, uint32_t stackDepth,
+                                          void *parameters, UBaseType_t priority, TaskHandle_t *createdTask,
+                                          BaseType_t coreId)
+{
+    TaskHandle_t task = new HostTask();
+    if (createdTask)
+        *createdTask = task;
+
+    std::thread([function, parameters, task]()
+                {
+                    hostCurrentTask() = task;
+                    function(parameters); })
+        .detach();
+    return pdPASS;
+}
+
+inline uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait)
+{
+    TaskHandle_t task = hostCurrentTask();
+    if (!task)
+        return 0;
+
+    std::unique_lock<std::mutex> lock(task->mutex);
+    if (ticksToWait == portMAX_DELAY)
+        task->notified.wait(lock, [task]()
+                            { return task->notifications > 0; });
+    else
+        task->notified.wait_for(lock, std::chrono::milliseconds(ticksToWait), [task]()
+                                { return task->notifications > 0; });
+
+    uint32_t value = task->notifications;
+    if (value > 0)
+        task->notifications = clearCountOnExit ? 0 : value - 1;
+    return value;
+}
+
+inline BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    if (!task)
+        return pdFAIL;
+
+    {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        task->notifications++;
+    }
+    task->notified.notify_one();
+    return pdPASS;
+}
+
+inline void vTaskDelay(TickType_t ticks)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
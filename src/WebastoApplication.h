@@ -3,6 +3,7 @@
 #include "core/EventBus.h"
 #include "core/ConfigManager.h"
 #include "core/FileSystemManager.h"
+#include "core/SystemClock.h"
 #include "infrastructure/hardware/TJA1020Driver.h"
 #include "infrastructure/network/AsyncWebServer.h"
 #include "infrastructure/network/WiFiManager.h"
@@ -20,6 +21,9 @@
 class WebastoApplication
 {
 private:
+    // Первым: таймеры и драйвер читают время уже в конструкторах
+    SystemClock systemClock;
+
     EventBus &eventBus;
     ConfigManager configManager;
     FileSystemManager fileSystemManager;
@@ -60,19 +64,19 @@ private:
 public:
     WebastoApplication() : eventBus(EventBus::getInstance()),
                            fileSystemManager(),
-                           configManager(eventBus, fileSystemManager), KLineSerial(1),
-                           wifiManager(configManager, eventBus),
-                           busDriver(configManager, KLineSerial, eventBus),
-                           commandReceiver(KLineSerial, eventBus),
-                           commandManager(configManager, eventBus, busDriver, commandReceiver),
+                           configManager(eventBus, fileSystemManager), KLineSerial(KLINE_UART_NUM),
+                           wifiManager(configManager, eventBus, systemClock),
+                           busDriver(configManager, KLineSerial, eventBus, systemClock),
+                           commandReceiver(KLineSerial, eventBus, configManager, systemClock),
+                           commandManager(configManager, eventBus, busDriver, commandReceiver, systemClock),
                            deviceInfoManager(eventBus, commandManager),
                            sensorManager(eventBus, commandManager),
                            errorsManager(eventBus, commandManager),
-                           heaterController(eventBus, commandManager, busDriver, deviceInfoManager, sensorManager, errorsManager),
+                           heaterController(eventBus, commandManager, busDriver, deviceInfoManager, sensorManager, errorsManager, systemClock),
                            snifferManager(eventBus, deviceInfoManager, sensorManager, errorsManager, heaterController),
-                           asyncWebServer(eventBus, fileSystemManager, configManager, deviceInfoManager, sensorManager, errorsManager, heaterController),
-                           keepAliveTimer(15000),
-                           blinkTimeout(500)
+                           asyncWebServer(eventBus, fileSystemManager, configManager, deviceInfoManager, sensorManager, errorsManager, heaterController, commandReceiver, commandManager, systemClock),
+                           keepAliveTimer(systemClock, 15000),
+                           blinkTimeout(systemClock, 500)
     {
         pinMode(BUTTON_PIN, INPUT_PULLUP);
     }
@@ -91,12 +95,13 @@ public:
         if (!wifiManager.initialize())
         {
             Serial.println("❌ WiFi initialization failed!");
-            delay(1000);
+            systemClock.sleepMs(1000);
             ESP.restart();
         }
 
         busDriver.initialize();
 
+        commandReceiver.initialize();
         commandManager.initialize();
         heaterController.initialize();
 
@@ -117,8 +122,10 @@ public:
 
         wifiManager.process();
 
+        busDriver.process();
         commandReceiver.process();
         commandManager.process();
+        heaterController.process();
 
         if (!isSnifferMode && keepAliveTimer.isReady())
         {
@@ -131,7 +138,7 @@ public:
         asyncWebServer.process();
 
         blinkLed();
-        delay(1);
+        systemClock.idle(1000);
     }
 
 private:
@@ -142,13 +149,13 @@ private:
         eventBus.subscribe(EventType::TX_RECEIVED,
                            [](const Event &event)
                            {
-                               // Serial.println("📤 TX: " + event.source);
+                               // Serial.println("📤 TX: " + static_cast<const TypedEvent<FrameReceivedEvent> &>(event).data.frame.toHexString());
                            });
 
         eventBus.subscribe(EventType::RX_RECEIVED,
                            [](const Event &event)
                            {
-                               // Serial.println("📨 RX: " + event.source);
+                               // Serial.println("📨 RX: " + static_cast<const TypedEvent<FrameReceivedEvent> &>(event).data.frame.toHexString());
                            });
 
         eventBus.subscribe(EventType::CONNECTION_STATE_CHANGED,
@@ -177,17 +184,17 @@ private:
     void processKeepAlive()
     {
         HeaterStatus status = heaterController.getStatus();
-        String keepAliveCommand = getKeepAliveCommandForState(status.state);
+        WBusFrame keepAliveCommand = getKeepAliveCommandForState(status.state);
 
         if (!keepAliveCommand.isEmpty() && busDriver.isConnected())
         {
             heaterController.checkWebastoStatus();
-            commandManager.addPriorityCommand(keepAliveCommand, false, [this](String tx, String rx)
-                                              { eventBus.publish(EventType::KEEP_ALLIVE_SENT); });
+            commandManager.addSafetyCommand(keepAliveCommand, [this](const PacketView &tx, const PacketView &rx)
+                                            { eventBus.publish(EventType::KEEP_ALLIVE_SENT); });
         }
     }
 
-    String getKeepAliveCommandForState(WebastoState state)
+    WBusFrame getKeepAliveCommandForState(WebastoState state)
     {
         switch (state)
         {
@@ -202,7 +209,7 @@ private:
         case WebastoState::BOOST:
             return WBusCommandBuilder::createKeepAliveBoost();
         default:
-            return "";
+            return WBusFrame();
         }
     }
 
@@ -213,14 +220,14 @@ private:
         // Фиксируем начало нажатия
         if (currentButtonState == LOW && lastButtonState == HIGH)
         {
-            lastButtonPressTime = millis();
+            lastButtonPressTime = systemClock.nowMs();
             buttonLongPressActivated = false; // Сбрасываем флаг при новом нажатии
         }
 
         // Проверяем длинное нажатие (после 3000 мс даже без отпускания)
         if (currentButtonState == LOW && !buttonLongPressActivated)
         {
-            unsigned long pressDuration = millis() - lastButtonPressTime;
+            unsigned long pressDuration = systemClock.nowMs() - lastButtonPressTime;
 
             if (pressDuration > 3000) // Долгое нажатие (>3 сек)
             {
@@ -249,7 +256,7 @@ private:
         // Обрабатываем отпускание кнопки (только если не было длинного нажатия)
         if (currentButtonState == HIGH && lastButtonState == LOW && !buttonLongPressActivated && !isSnifferMode)
         {
-            unsigned long pressDuration = millis() - lastButtonPressTime;
+            unsigned long pressDuration = systemClock.nowMs() - lastButtonPressTime;
 
             // Короткое нажатие (< сек)
             if (pressDuration < 2000)
@@ -311,10 +318,6 @@ private:
             {
                 heaterController.shutdown();
             }
-            else if (command == "test")
-            {
-                WBusCommandBuilder::generateAndPrintAllCommands();
-            }
             else if (command == "wake")
             {
                 busDriver.wakeUp();
@@ -336,7 +339,7 @@ private:
             {
                 // Прямая отправка команды в очередь
                 heaterController.breakIfNeeded();
-                commandManager.addPriorityCommand(command);
+                commandManager.addPriorityCommand(WBusFrame::fromHexString(command));
             }
         }
     }
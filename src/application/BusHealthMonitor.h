@@ -0,0 +1,123 @@
+// src/application/BusHealthMonitor.h
+#pragma once
+#include <Arduino.h>
+#include "../domain/Entities.h"
+
+// Автомат состояния шины (circuit breaker):
+//   HEALTHY  -> DEGRADED после первого отказа транзакции
+//   DEGRADED -> DOWN после busDownFailures отказов подряд
+//   DOWN     -> HEALTHY после ответа на пробный запрос
+// Любой ответ возвращает шину в HEALTHY. В DOWN очередь не обслуживается,
+// пробные запросы идут с экспоненциально растущим интервалом.
+class BusHealthMonitor
+{
+private:
+    BusHealth state = BusHealth::HEALTHY;
+    uint8_t consecutiveFailures = 0;
+
+    uint32_t probeIntervalMs = 0;
+    unsigned long nextProbeAt = 0;
+
+    uint32_t failures = 0;
+    uint32_t probes = 0;
+    uint32_t recoveries = 0;
+    unsigned long downSince = 0;
+
+public:
+    BusHealth getState() const { return state; }
+    bool isDown() const { return state == BusHealth::DOWN; }
+
+    // Допустимое число повторов: при деградации шины - не больше одного
+    uint8_t retryBudget(uint8_t commandRetries) const
+    {
+        if (state == BusHealth::DEGRADED && commandRetries > 1)
+            return 1;
+        return commandRetries;
+    }
+
+    void recordSuccess()
+    {
+        if (state == BusHealth::DOWN)
+            recoveries++;
+
+        state = BusHealth::HEALTHY;
+        consecutiveFailures = 0;
+    }
+
+    // Транзакция исчерпала повторы
+    void recordFailure(unsigned long now, const BusConfig &config)
+    {
+        failures++;
+        if (consecutiveFailures < 255)
+            consecutiveFailures++;
+
+        if (state == BusHealth::DOWN)
+            return;
+
+        if (consecutiveFailures >= config.busDownFailures)
+        {
+            state = BusHealth::DOWN;
+            downSince = now;
+            probeIntervalMs = config.busProbeInterval;
+            nextProbeAt = now + probeIntervalMs;
+        }
+        else
+        {
+            state = BusHealth::DEGRADED;
+        }
+    }
+
+    unsigned long getNextProbeAt() const
+    {
+        return nextProbeAt;
+    }
+
+    bool isProbeDue(unsigned long now) const
+    {
+        return state == BusHealth::DOWN && (long)(now - nextProbeAt) >= 0;
+    }
+
+    void onProbeSent()
+    {
+        probes++;
+    }
+
+    // Пробный запрос без ответа - следующая попытка через удвоенный интервал
+    void onProbeFailed(unsigned long now, const BusConfig &config)
+    {
+        probeIntervalMs = probeIntervalMs * 2;
+        if (probeIntervalMs > config.busProbeMaxInterval)
+            probeIntervalMs = config.busProbeMaxInterval;
+        if (probeIntervalMs == 0)
+            probeIntervalMs = config.busProbeInterval;
+
+        nextProbeAt = now + probeIntervalMs;
+    }
+
+    void reset()
+    {
+        state = BusHealth::HEALTHY;
+        consecutiveFailures = 0;
+        probeIntervalMs = 0;
+    }
+
+    String toJson(unsigned long now) const
+    {
+        String json = "{";
+        json += "\"state\":\"" + getBusHealthName(state) + "\",";
+        json += "\"consecutiveFailures\":" + String(consecutiveFailures) + ",";
+        json += "\"failures\":" + String(failures) + ",";
+        json += "\"probes\":" + String(probes) + ",";
+        json += "\"recoveries\":" + String(recoveries);
+
+        if (state == BusHealth::DOWN)
+        {
+            json += ",\"downForMs\":" + String(now - downSince);
+            json += ",\"probeIntervalMs\":" + String(probeIntervalMs);
+            json += ",\"nextProbeInMs\":" + String((long)(nextProbeAt - now));
+        }
+
+        json += "}";
+        return json;
+    }
+};
@@ -0,0 +1,290 @@
+// src/application/BusStatistics.h
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+#include "../infrastructure/protocol/WBusCommandBuilder.h"
+
+// Статистика обмена по каждой паре (команда, индекс).
+// Таблица фиксированного размера, без динамической памяти.
+struct OpcodeStats
+{
+    static const uint8_t MAX_NAK_CODES = 4;
+    static const uint8_t RTT_BUCKETS = 8;
+
+    bool used = false;
+    uint8_t command = 0;
+    uint8_t index = 0;
+
+    uint32_t requests = 0;
+    uint32_t responses = 0;
+    uint32_t timeouts = 0;
+    uint32_t retries = 0;
+    uint32_t naks = 0;
+    uint32_t mismatches = 0; // Чужие ответы, пришедшие во время ожидания
+
+    // Коды ошибок NAK (первые MAX_NAK_CODES различных кодов)
+    uint8_t nakCodes[MAX_NAK_CODES] = {};
+    uint32_t nakCodeCounts[MAX_NAK_CODES] = {};
+
+    // Время ответа: от конца передачи запроса до конца приема ответа
+    uint32_t rttHistogram[RTT_BUCKETS] = {};
+    uint32_t rttMinMs = 0;
+    uint32_t rttMaxMs = 0;
+    uint32_t rttSumMs = 0;
+
+    unsigned long lastSeen = 0; // Время последнего ответа (мс)
+};
+
+class BusStatistics
+{
+public:
+    static const size_t MAX_ENTRIES = 48;
+    static const size_t RTT_BUCKETS = OpcodeStats::RTT_BUCKETS;
+
+    // Верхние границы корзин гистограммы (мс), последняя корзина - все остальное
+    static uint32_t bucketLimitMs(size_t bucket)
+    {
+        static const uint32_t limits[RTT_BUCKETS - 1] = {25, 50, 100, 200, 400, 800, 1600};
+        return limits[bucket];
+    }
+
+private:
+    OpcodeStats entries[MAX_ENTRIES];
+    uint32_t untracked = 0; // События, не поместившиеся в таблицу
+    uint32_t mismatches = 0; // Всего ответов, не совпавших с запросом
+    std::atomic<bool> resetRequested{false};
+
+    // Индекс значим только для команд чтения/теста
+    static bool hasIndex(uint8_t command)
+    {
+        return WBusCommandBuilder::isIndexedCommand(command);
+    }
+
+    OpcodeStats *find(uint8_t command, uint8_t index)
+    {
+        if (!hasIndex(command))
+            index = 0;
+
+        for (size_t i = 0; i < MAX_ENTRIES; i++)
+        {
+            OpcodeStats &entry = entries[i];
+
+            if (!entry.used)
+            {
+                entry.used = true;
+                entry.command = command;
+                entry.index = index;
+                return &entry;
+            }
+
+            if (entry.command == command && entry.index == index)
+                return &entry;
+        }
+
+        untracked++;
+        return nullptr;
+    }
+
+    static size_t bucketFor(uint32_t rttMs)
+    {
+        for (size_t i = 0; i < RTT_BUCKETS - 1; i++)
+        {
+            if (rttMs < bucketLimitMs(i))
+                return i;
+        }
+        return RTT_BUCKETS - 1;
+    }
+
+public:
+    // Извлечение (команда, индекс) из кадра запроса: F4 len cmd [index] ... cs
+    static void extractKey(const uint8_t *frame, size_t length, uint8_t &command, uint8_t &index)
+    {
+        command = length > 2 ? frame[2] : 0;
+        index = length > 4 && hasIndex(command) ? frame[3] : 0;
+    }
+
+    void recordRequest(uint8_t command, uint8_t index)
+    {
+        if (OpcodeStats *entry = find(command, index))
+            entry->requests++;
+    }
+
+    void recordRetry(uint8_t command, uint8_t index)
+    {
+        if (OpcodeStats *entry = find(command, index))
+            entry->retries++;
+    }
+
+    void recordTimeout(uint8_t command, uint8_t index)
+    {
+        if (OpcodeStats *entry = find(command, index))
+            entry->timeouts++;
+    }
+
+    void recordResponse(uint8_t command, uint8_t index, uint32_t rttMs, unsigned long now)
+    {
+        OpcodeStats *entry = find(command, index);
+        if (!entry)
+            return;
+
+        if (entry->responses == 0 || rttMs < entry->rttMinMs)
+            entry->rttMinMs = rttMs;
+        if (rttMs > entry->rttMaxMs)
+            entry->rttMaxMs = rttMs;
+
+        entry->responses++;
+        entry->rttSumMs += rttMs;
+        entry->rttHistogram[bucketFor(rttMs)]++;
+        entry->lastSeen = now;
+    }
+
+    void recordMismatch(uint8_t command, uint8_t index)
+    {
+        mismatches++;
+        if (OpcodeStats *entry = find(command, index))
+            entry->mismatches++;
+    }
+
+    void recordNak(uint8_t command, uint8_t index, uint8_t errorCode, unsigned long now)
+    {
+        OpcodeStats *entry = find(command, index);
+        if (!entry)
+            return;
+
+        entry->naks++;
+        entry->lastSeen = now;
+
+        for (uint8_t i = 0; i < OpcodeStats::MAX_NAK_CODES; i++)
+        {
+            if (entry->nakCodeCounts[i] == 0)
+            {
+                entry->nakCodes[i] = errorCode;
+                entry->nakCodeCounts[i] = 1;
+                return;
+            }
+
+            if (entry->nakCodes[i] == errorCode)
+            {
+                entry->nakCodeCounts[i]++;
+                return;
+            }
+        }
+    }
+
+    // Сброс из другой задачи (HTTP) - выполняется в основном цикле
+    void requestReset()
+    {
+        resetRequested = true;
+    }
+
+    void applyPendingReset()
+    {
+        if (resetRequested.exchange(false))
+        {
+            for (size_t i = 0; i < MAX_ENTRIES; i++)
+                entries[i] = OpcodeStats();
+            untracked = 0;
+            mismatches = 0;
+        }
+    }
+
+    // Сумма по всем командам; command/index и коды NAK не заполняются
+    OpcodeStats getTotals() const
+    {
+        OpcodeStats totals;
+        for (size_t i = 0; i < MAX_ENTRIES && entries[i].used; i++)
+        {
+            const OpcodeStats &entry = entries[i];
+            totals.requests += entry.requests;
+            totals.timeouts += entry.timeouts;
+            totals.retries += entry.retries;
+            totals.naks += entry.naks;
+            totals.mismatches += entry.mismatches;
+            totals.rttSumMs += entry.rttSumMs;
+
+            if (entry.responses > 0 && (totals.responses == 0 || entry.rttMinMs < totals.rttMinMs))
+                totals.rttMinMs = entry.rttMinMs;
+            if (entry.rttMaxMs > totals.rttMaxMs)
+                totals.rttMaxMs = entry.rttMaxMs;
+            totals.responses += entry.responses;
+
+            for (size_t b = 0; b < RTT_BUCKETS; b++)
+                totals.rttHistogram[b] += entry.rttHistogram[b];
+            if (entry.lastSeen > totals.lastSeen)
+                totals.lastSeen = entry.lastSeen;
+        }
+        return totals;
+    }
+
+    String toJson(unsigned long now) const
+    {
+        String json = "{";
+        json += "\"uptime\":" + String(now) + ",";
+        json += "\"untracked\":" + String(untracked) + ",";
+        json += "\"mismatches\":" + String(mismatches) + ",";
+
+        json += "\"rttBucketsMs\":[";
+        for (size_t i = 0; i < RTT_BUCKETS - 1; i++)
+        {
+            if (i > 0)
+                json += ",";
+            json += String(bucketLimitMs(i));
+        }
+        json += "],";
+
+        json += "\"entries\":[";
+        bool first = true;
+        for (size_t i = 0; i < MAX_ENTRIES; i++)
+        {
+            const OpcodeStats &entry = entries[i];
+            if (!entry.used)
+                break;
+
+            if (!first)
+                json += ",";
+            first = false;
+
+            json += "{";
+            json += "\"command\":" + String(entry.command) + ",";
+            json += "\"index\":" + String(entry.index) + ",";
+            json += "\"name\":\"" + WBusCommandBuilder::getCommandName(entry.command) + "\",";
+            if (hasIndex(entry.command))
+                json += "\"indexName\":\"" + WBusCommandBuilder::getIndexName(entry.command, entry.index) + "\",";
+            json += "\"requests\":" + String(entry.requests) + ",";
+            json += "\"responses\":" + String(entry.responses) + ",";
+            json += "\"timeouts\":" + String(entry.timeouts) + ",";
+            json += "\"retries\":" + String(entry.retries) + ",";
+            json += "\"naks\":" + String(entry.naks) + ",";
+            json += "\"mismatches\":" + String(entry.mismatches) + ",";
+
+            json += "\"nakCodes\":[";
+            for (uint8_t c = 0; c < OpcodeStats::MAX_NAK_CODES && entry.nakCodeCounts[c] > 0; c++)
+            {
+                if (c > 0)
+                    json += ",";
+                json += "{\"code\":" + String(entry.nakCodes[c]) + ",\"count\":" + String(entry.nakCodeCounts[c]) + "}";
+            }
+            json += "],";
+
+            json += "\"rttMinMs\":" + String(entry.rttMinMs) + ",";
+            json += "\"rttMaxMs\":" + String(entry.rttMaxMs) + ",";
+            json += "\"rttAvgMs\":" + String(entry.responses > 0 ? entry.rttSumMs / entry.responses : 0) + ",";
+
+            json += "\"rttHistogram\":[";
+            for (size_t b = 0; b < RTT_BUCKETS; b++)
+            {
+                if (b > 0)
+                    json += ",";
+                json += String(entry.rttHistogram[b]);
+            }
+            json += "],";
+
+            json += "\"lastSeen\":" + String(entry.lastSeen);
+            json += "}";
+        }
+        json += "]";
+
+        json += "}";
+        return json;
+    }
+};
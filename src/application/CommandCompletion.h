@@ -0,0 +1,217 @@
+// src/application/CommandCompletion.h
+#pragma once
+#include <Arduino.h>
+#include "../domain/Entities.h"
+#include "../common/PacketView.h"
+#include "../common/ProtocolConstants.h"
+
+// Итог команды: ответ нагревателя (ACK), код отказа (NAK),
+// таймаут или отмена
+struct CommandResult
+{
+    CommandOutcome outcome = CommandOutcome::UNKNOWN;
+    uint8_t nakCode = 0;
+    uint8_t response[WBUS_MAX_FRAME_LENGTH] = {};
+    uint8_t responseLength = 0;
+    uint32_t elapsedMs = 0;
+
+    bool isDone() const
+    {
+        return outcome != CommandOutcome::PENDING && outcome != CommandOutcome::UNKNOWN;
+    }
+
+    PacketView getResponse() const
+    {
+        return PacketView(response, responseLength);
+    }
+
+    String toJson() const
+    {
+        String json = "{";
+        json += "\"outcome\":\"" + getCommandOutcomeName(outcome) + "\"";
+
+        if (outcome == CommandOutcome::ACK)
+            json += ",\"response\":\"" + getResponse().toHexString() + "\"";
+
+        if (outcome == CommandOutcome::NAK)
+            json += ",\"nakCode\":" + String(nakCode);
+
+        if (isDone())
+            json += ",\"elapsedMs\":" + String(elapsedMs);
+
+        json += "}";
+        return json;
+    }
+};
+
+// Таблица результатов команд фиксированного размера. Запись занимается
+// при постановке команды и хранит итог, пока ее не освободят или не
+// вытеснят: при нехватке места переиспользуется самая старая завершенная.
+// Если все записи ждут ответа, команда ставится без отслеживания.
+class CompletionTable
+{
+public:
+    static const size_t CAPACITY = 16;
+
+private:
+    struct Record
+    {
+        bool used = false;
+        bool released = false; // Итог никто не прочитает - освободить по завершении
+        uint16_t generation = 0;
+        unsigned long openedAt = 0;
+        unsigned long finishedAt = 0;
+        CommandResult result;
+    };
+
+    Record records[CAPACITY];
+    uint16_t nextGeneration = 1;
+
+    uint32_t opened = 0;
+    uint32_t untracked = 0;
+    uint32_t evicted = 0;
+
+    Record *find(const CommandHandle &handle)
+    {
+        if (!handle.isTracked() || handle.slot >= CAPACITY)
+            return nullptr;
+
+        Record &record = records[handle.slot];
+        return record.used && record.generation == handle.generation ? &record : nullptr;
+    }
+
+    const Record *find(const CommandHandle &handle) const
+    {
+        return const_cast<CompletionTable *>(this)->find(handle);
+    }
+
+    int freeSlot()
+    {
+        int oldest = -1;
+        for (size_t i = 0; i < CAPACITY; i++)
+        {
+            if (!records[i].used)
+                return i;
+
+            if (records[i].result.outcome != CommandOutcome::PENDING &&
+                (oldest < 0 || (long)(records[i].finishedAt - records[oldest].finishedAt) < 0))
+                oldest = i;
+        }
+
+        if (oldest >= 0)
+            evicted++;
+        return oldest;
+    }
+
+    void finish(Record &record, unsigned long now)
+    {
+        record.finishedAt = now;
+        record.result.elapsedMs = now - record.openedAt;
+        if (record.released)
+            record.used = false;
+    }
+
+public:
+    CommandHandle open(unsigned long now)
+    {
+        int slot = freeSlot();
+        if (slot < 0)
+        {
+            untracked++;
+            return CommandHandle::untracked(true);
+        }
+
+        Record &record = records[slot];
+        record = Record();
+        record.used = true;
+        record.generation = nextGeneration;
+        record.openedAt = now;
+        record.result.outcome = CommandOutcome::PENDING;
+
+        if (++nextGeneration == 0)
+            nextGeneration = 1;
+        opened++;
+
+        CommandHandle handle;
+        handle.slot = static_cast<uint8_t>(slot);
+        handle.generation = record.generation;
+        handle.accepted = true;
+        return handle;
+    }
+
+    // Ответ нагревателя: ACK с данными или NAK с кодом отказа
+    void complete(const CommandHandle &handle, const PacketView &rx, unsigned long now)
+    {
+        Record *record = find(handle);
+        if (!record || record->result.outcome != CommandOutcome::PENDING)
+            return;
+
+        if (rx.isNak())
+        {
+            record->result.outcome = CommandOutcome::NAK;
+            record->result.nakCode = rx.at(4);
+        }
+        else
+        {
+            size_t length = rx.size() < WBUS_MAX_FRAME_LENGTH ? rx.size() : WBUS_MAX_FRAME_LENGTH;
+            memcpy(record->result.response, rx.data(), length);
+            record->result.responseLength = static_cast<uint8_t>(length);
+            record->result.outcome = CommandOutcome::ACK;
+        }
+        finish(*record, now);
+    }
+
+    void fail(const CommandHandle &handle, CommandOutcome outcome, unsigned long now)
+    {
+        Record *record = find(handle);
+        if (!record || record->result.outcome != CommandOutcome::PENDING)
+            return;
+
+        record->result.outcome = outcome;
+        finish(*record, now);
+    }
+
+    CommandResult get(const CommandHandle &handle) const
+    {
+        const Record *record = find(handle);
+        return record ? record->result : CommandResult();
+    }
+
+    // Результат прочитан или не нужен - запись можно занять заново.
+    // Запись команды, которая еще ждет ответа, освобождается по ее завершении.
+    void release(const CommandHandle &handle)
+    {
+        Record *record = find(handle);
+        if (!record)
+            return;
+
+        if (record->result.outcome == CommandOutcome::PENDING)
+            record->released = true;
+        else
+            record->used = false;
+    }
+
+    String toJson() const
+    {
+        size_t pending = 0;
+        size_t used = 0;
+        for (size_t i = 0; i < CAPACITY; i++)
+        {
+            if (!records[i].used)
+                continue;
+            used++;
+            if (records[i].result.outcome == CommandOutcome::PENDING)
+                pending++;
+        }
+
+        String json = "{";
+        json += "\"used\":" + String(used) + ",";
+        json += "\"pending\":" + String(pending) + ",";
+        json += "\"capacity\":" + String(CAPACITY) + ",";
+        json += "\"opened\":" + String(opened) + ",";
+        json += "\"untracked\":" + String(untracked) + ",";
+        json += "\"evicted\":" + String(evicted);
+        json += "}";
+        return json;
+    }
+};
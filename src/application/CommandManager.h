@@ -1,71 +1,85 @@
 #pragma once
 #include <Arduino.h>
 #include <functional>
-#include <deque>
 #include <vector>
 #include "./CommandReceiver.h"
+#include "./CommandQueue.h"
+#include "./BusStatistics.h"
+#include "./PollScheduler.h"
+#include "./RttEstimator.h"
+#include "./BusHealthMonitor.h"
+#include "./CommandCompletion.h"
+#include "./RequestCoalescer.h"
 #include "../common/Timer.h"
+#include "../common/WBusFrame.h"
 #include "../core/EventBus.h"
 #include "../core/ConfigManager.h"
 #include "../infrastructure/protocol/WBusErrorsDecoder.h"
+#include "../infrastructure/protocol/WBusMultiReadDecoder.h"
 #include "../interfaces/IBusManager.h"
+#include "../interfaces/IClock.h"
 #include "../domain/Events.h"
 
 // Состояния обработки (аналог WBusQueueState из оригинала)
 enum class ProcessingState
 {
-    IDLE,       // Ожидание команды
-    SENDING,    // Команда отправлена, ждем ответ
-    RETRY,      // Повторная отправка
-    BREAK_SET,  // BREAK сигнал установлен
-    BREAK_RESET // BREAK сигнал сброшен
-};
-
-struct Command
-{
-    String data;
-    std::function<void(String tx, String rx)> callback;
-    bool loop = false;
-
-    Command() : data(""), callback(nullptr) {}
-    Command(const String &cmd, std::function<void(String, String)> cb = nullptr, bool lp = false)
-        : data(cmd), callback(cb), loop(lp) {}
+    IDLE,         // Ожидание команды
+    TRANSMITTING, // Кадр передается UART
+    SENDING,      // Команда отправлена, ждем ответ
+    BREAK_SET,    // Перед повтором запрашивается BREAK
+    RETRY         // Драйвер выполняет BREAK и паузу восстановления, затем повтор
 };
 
 class CommandManager
 {
 private:
-    std::deque<Command> priorityDeque; // Было priorityQueue
-    std::deque<Command> normalDeque;   // Было normalQueue
+    static const uint8_t MAX_MULTI_READ_FAILURES = 3;
+
+    CommandQueue commandQueue;
 
     ConfigManager &configManager;
 
     EventBus &eventBus;
     IBusManager &busManager;
     CommandReceiver &commandReceiver;
+    IClock &clock;
 
     WBusErrorsDecoder errorsDecoder;
-    PacketParser packetParser;
 
     Command processingCommand;
     ProcessingState state = ProcessingState::IDLE;
     uint8_t currentRetries = 0;
 
+    // Статистика по (команда, индекс) текущего запроса
+    BusStatistics busStatistics;
+    PollScheduler pollScheduler;
+    RttEstimator rttEstimator; // Адаптивные таймаут и пауза между командами
+    BusHealthMonitor busHealth;
+    bool multiReadSupported = false;
+    uint8_t multiReadFailures = 0; // Групповых чтений подряд без ответа при отвечающей шине
+    CompletionTable completions; // Итоги команд для вызывающих (ACK/NAK/таймаут/отмена)
+    RequestCoalescer coalescer;  // Повторные запросы ждут ответа на уже отправленный
+    unsigned long transactionStart = 0;
+    uint8_t currentCommand = 0;
+    uint8_t currentIndex = 0;
+    int64_t txEndUs = 0; // Конец передачи запроса (мкс)
+    uint32_t replyWireUs = 0; // Время приема страниц группового ответа (мкс), 0 - обычный запрос
+
     Timer queueTimer;
     Timer timeoutTimer;
-    Timer breakTimer;
 
     bool isSnifferMode = false;
 
 public:
-    CommandManager(ConfigManager &configMngr, EventBus &bus, IBusManager &busMngr, CommandReceiver &receiver)
+    CommandManager(ConfigManager &configMngr, EventBus &bus, IBusManager &busMngr, CommandReceiver &receiver, IClock &clk)
         : configManager(configMngr),
           eventBus(bus),
           commandReceiver(receiver),
           busManager(busMngr),
-          queueTimer(configMngr.getConfig().bus.queueInterval),
-          timeoutTimer(configMngr.getConfig().bus.commandTimeout, false),
-          breakTimer(configMngr.getConfig().bus.breakSignalDuration, false)
+          clock(clk),
+          coalescer(completions),
+          queueTimer(clk, configMngr.getConfig().bus.queueInterval),
+          timeoutTimer(clk, configMngr.getConfig().bus.commandTimeout, false)
     {
         eventBus.subscribe(EventType::APP_CONFIG_UPDATE,
                            [this](const Event &event)
@@ -75,7 +89,6 @@ public:
 
                                setInterval(configEvent.data.config.bus.queueInterval);
                                setTimeout(configEvent.data.config.bus.commandTimeout);
-                               setBreakTimeout(configEvent.data.config.bus.breakSignalDuration);
                            });
     }
 
@@ -88,126 +101,191 @@ public:
     {
         setInterval(configManager.getConfig().bus.queueInterval);
         setTimeout(configManager.getConfig().bus.commandTimeout);
-        setBreakTimeout(configManager.getConfig().bus.breakSignalDuration);
     }
 
-    bool addCommand(const String &command, bool loop = false, std::function<void(String, String)> callback = nullptr)
+    // Постановка команды в очередь класса commandClass.
+    // Итог команды - getResult(handle); для периодического опроса не отслеживается
+    CommandHandle addCommand(const WBusFrame &command, CommandClass commandClass, CommandCallback callback = nullptr)
     {
-        if (isSnifferMode)
-        {
-            Serial.println("⚠️  В режиме сниффера отправлять команды невозможно");
-            return false;
-        }
+        if (!canSend(command) || !acceptsCommands(command))
+            return CommandHandle();
 
-        if (!busManager.isConnected())
+        unsigned long now = clock.nowMs();
+        CommandHandle completion = completions.open(now);
+
+        if (coalesce(command, commandClass, callback, completion))
+            return completion;
+
+        Command queued = makeCommand(command, callback);
+        queued.completion = completion;
+
+        if (!commandQueue.push(commandClass, std::move(queued), now, configManager.getConfig().bus))
         {
-            Serial.println("⚠️  TJA1020 недоступен или находится в режиме сна");
-            return false;
+            completions.fail(completion, CommandOutcome::CANCELLED, now);
+            completions.release(completion);
+            return CommandHandle();
         }
 
-        if (getTotalQueueSize() >= configManager.getConfig().bus.maxQueueSize || containsCommand(command))
-            return false;
+        // Команду могли добавить после process() в этом проходе цикла
+        clock.wakeAt(now);
+        return completion;
+    }
 
-        normalDeque.push_back(Command(command, callback, loop));
-        return true;
+    CommandHandle addCommand(const WBusFrame &command, bool loop = false, CommandCallback callback = nullptr)
+    {
+        // Периодические запросы ведет планировщик опроса
+        if (loop)
+            return CommandHandle::untracked(addPolling(command, callback));
+
+        return addCommand(command, CommandClass::INTERACTIVE, callback);
     }
 
-    bool addPriorityCommand(const String &command, bool loop = false, std::function<void(String, String)> callback = nullptr)
+    CommandHandle addPriorityCommand(const WBusFrame &command, bool loop = false, CommandCallback callback = nullptr)
     {
-        if (isSnifferMode)
-        {
-            Serial.println("⚠️  В режиме сниффера отправлять команды невозможно");
-            return false;
-        }
+        if (loop)
+            return CommandHandle::untracked(addPolling(command, callback));
 
-        if (!busManager.isConnected())
-        {
-            Serial.println("⚠️  TJA1020 недоступен или находится в режиме сна");
-            return false;
-        }
+        return addCommand(command, CommandClass::CONTROL, callback);
+    }
+
+    // Keep-alive и выключение: отдельная очередь, не вытесняется остальными
+    CommandHandle addSafetyCommand(const WBusFrame &command, CommandCallback callback = nullptr)
+    {
+        return addCommand(command, CommandClass::SAFETY, callback);
+    }
 
-        if (getTotalQueueSize() >= configManager.getConfig().bus.maxPriorityQueueSize || containsPriorityCommand(command))
+    bool addPolling(const WBusFrame &command, CommandCallback callback = nullptr)
+    {
+        if (!canSend(command))
             return false;
 
-        priorityDeque.push_back(Command(command, callback, loop));
-        return true;
+        unsigned long now = clock.nowMs();
+        clock.wakeAt(now);
+        return pollScheduler.add(command, PollScheduler::groupFor(command), now, callback);
     }
 
     void process()
     {
+        busStatistics.applyPendingReset();
+        ProcessingState previousState = state;
+
         switch (state)
         {
         case ProcessingState::IDLE:
-            if (!isQueueEmpty() && queueTimer.isReady())
+        {
+            // Драйвер выполняет BREAK или пробуждение - линия занята
+            if (busManager.isBusy())
+                break;
+
+            unsigned long now = clock.nowMs();
+
+            // Шина недоступна: очередь не обслуживается, только пробные запросы
+            if (busHealth.isDown())
+            {
+                if (busHealth.isProbeDue(now))
+                    sendProbe();
+                else
+                    clock.wakeAt(busHealth.getNextProbeAt());
+                break;
+            }
+
+            // Опрос будит цикл к ближайшей странице, а не на каждом проходе
+            const BusConfig &config = configManager.getConfig().bus;
+            unsigned long pollAt = 0;
+            bool pollDue = false;
+            if (pollScheduler.nextDueAt(now, config, pollAt))
+            {
+                pollDue = (long)(now - pollAt) >= 0;
+                if (!pollDue)
+                    clock.wakeAt(pollAt);
+            }
+
+            if ((!commandQueue.isEmpty() || pollDue) && queueTimer.isReady())
             {
-                processingCommand = getNextCommand();
+                // Опрос подается в фоновый класс по одной странице за раз
+                if (commandQueue.size(CommandClass::BACKGROUND) == 0)
+                    enqueueDuePoll(now, config);
+
+                if (commandQueue.isEmpty())
+                    break;
+
+                processingCommand = commandQueue.pop(now, config);
+                transactionStart = now;
                 sendCurrentCommand();
             }
             break;
+        }
 
-        case ProcessingState::SENDING:
-            if (commandReceiver.isRxReceived())
+        case ProcessingState::TRANSMITTING:
+            if (busManager.isTxComplete())
             {
-                // ✅ Ответ получен
-                complete(commandReceiver.getRxData());
+                // Таймаут ответа отсчитывается от конца передачи
+                txEndUs = busManager.getTxCompleteUs();
+                timeoutTimer.setInterval(rttEstimator.getTimeoutMs(currentCommand, configManager.getConfig().bus, replyWireUs));
+                state = ProcessingState::SENDING;
+
+                // Ответ мог быть разобран в том же проходе цикла, что и конец передачи
+                if (commandReceiver.isRxReceived())
+                    handleResponse();
             }
             else if (timeoutTimer.isReady())
             {
-                // ⏰ Таймаут
+                // Передача не завершилась за commandTimeout - как потерянный кадр
                 handleTimeout();
             }
             break;
 
-        case ProcessingState::RETRY:
-            if (breakTimer.isReady())
+        case ProcessingState::SENDING:
+            if (commandReceiver.isRxReceived())
             {
-                sendCurrentCommand();
+                handleResponse();
+            }
+            else if (timeoutTimer.isReady())
+            {
+                // ⏰ Таймаут
+                handleTimeout();
             }
             break;
 
         case ProcessingState::BREAK_SET:
-            // BREAK set - удерживаем линию в LOW 50ms
-            busManager.sendBreakSignal(true);
-            breakTimer.reset();
-            state = ProcessingState::BREAK_RESET;
+            // Длительность LOW и паузу после него отсчитывает драйвер
+            busManager.sendBreak();
+            state = ProcessingState::RETRY;
             break;
 
-        case ProcessingState::BREAK_RESET:
-            if (breakTimer.isReady())
+        case ProcessingState::RETRY:
+            if (!busManager.isBusy())
             {
-                // BREAK reset - отпускаем линию и ждем 50ms
-                busManager.sendBreakSignal(false);
-                breakTimer.reset();
-                state = ProcessingState::RETRY;
+                sendCurrentCommand();
             }
             break;
         }
+
+        // Новое состояние обслуживается следующим проходом без ожидания
+        if (state != previousState)
+            clock.wakeAt(clock.nowMs());
     }
 
-    bool containsCommand(const String &command)
+    // Итог команды: PENDING, пока ответ не получен; UNKNOWN - не отслеживается
+    CommandResult getResult(const CommandHandle &handle) const
     {
-        for (const auto &cmd : normalDeque)
-        {
-            if (cmd.data == command)
-                return true;
-        }
-        return false;
+        return completions.get(handle);
     }
 
-    bool containsPriorityCommand(const String &command)
+    void releaseResult(const CommandHandle &handle)
     {
-        for (const auto &cmd : priorityDeque)
-        {
-            if (cmd.data == command)
-                return true;
-        }
-        return false;
+        completions.release(handle);
     }
 
     void clear()
     {
-        priorityDeque.clear();
-        normalDeque.clear();
+        cancelQueued();
+        unsigned long now = clock.nowMs();
+        completions.fail(processingCommand.completion, CommandOutcome::CANCELLED, now);
+        commandQueue.clear();
+        pollScheduler.clear();
+        coalescer.clear(now);
+        rttEstimator.reset(); // После отключения на шине может оказаться другой блок
 
         state = ProcessingState::IDLE;
         currentRetries = 0;
@@ -226,95 +304,462 @@ public:
         timeoutTimer.setInterval(timeout);
     }
 
-    void setBreakTimeout(unsigned long timeout)
+    bool isEmpty() const
     {
-        breakTimer.setInterval(timeout);
+        return commandQueue.isEmpty() && state == ProcessingState::IDLE;
     }
-    bool isEmpty() const
+
+    // Разовых команд нет: в очереди и в обработке только периодический опрос
+    bool isForegroundIdle() const
     {
-        return isQueueEmpty() && state == ProcessingState::IDLE;
+        if (commandQueue.size(CommandClass::SAFETY) > 0 ||
+            commandQueue.size(CommandClass::CONTROL) > 0 ||
+            commandQueue.size(CommandClass::INTERACTIVE) > 0)
+            return false;
+
+        return state == ProcessingState::IDLE || processingCommand.pollSlot >= 0 ||
+               processingCommand.pollBatch != 0 || processingCommand.probe;
     }
 
     size_t getTotalQueueSize() const
     {
-        return priorityDeque.size() + normalDeque.size();
+        return commandQueue.size();
     }
 
-private:
-    bool isQueueEmpty() const
+    String getQueueJson() const
+    {
+        String json = "{";
+        json += "\"queue\":" + commandQueue.toJson(clock.nowMs(), configManager.getConfig().bus) + ",";
+        json += "\"coalescing\":" + coalescer.toJson() + ",";
+        json += "\"completions\":" + completions.toJson();
+        json += "}";
+        return json;
+    }
+
+    const BusStatistics &getStatistics() const
+    {
+        return busStatistics;
+    }
+
+    String getStatisticsJson() const
+    {
+        return busStatistics.toJson(clock.nowMs());
+    }
+
+    void resetStatistics()
     {
-        return priorityDeque.empty() && normalDeque.empty();
+        busStatistics.requestReset();
     }
 
-    Command getNextCommand()
+    // Поддержка группового чтения 0x50 0x30 (проверяется при подключении)
+    void setMultiReadSupported(bool supported)
     {
-        if (!priorityDeque.empty())
+        if (multiReadSupported != supported)
+            Serial.println(supported ? "📦 Групповое чтение датчиков включено" : "📄 Опрос датчиков по одной странице");
+        multiReadSupported = supported;
+        multiReadFailures = 0;
+    }
+
+    bool isMultiReadSupported() const
+    {
+        return multiReadSupported;
+    }
+
+    BusHealth getBusHealth() const
+    {
+        return busHealth.getState();
+    }
+
+    // Измеренные длительности BREAK и импульса пробуждения
+    String getLineTimingJson() const
+    {
+        return busManager.getLineTimingJson();
+    }
+
+    String getHealthJson() const
+    {
+        return busHealth.toJson(clock.nowMs());
+    }
+
+    // Ручное подключение - шина снова считается исправной
+    void resetBusHealth()
+    {
+        BusHealth oldHealth = busHealth.getState();
+        busHealth.reset();
+        onHealthChanged(oldHealth);
+    }
+
+    String getTimingJson() const
+    {
+        return rttEstimator.toJson(configManager.getConfig().bus);
+    }
+
+    // Каждая страница периодического опроса получила ответ
+    bool isPollSnapshotComplete() const
+    {
+        return pollScheduler.isSnapshotComplete();
+    }
+
+    String getPollScheduleJson() const
+    {
+        return pollScheduler.toJson(configManager.getConfig().bus, clock.nowMs());
+    }
+
+private:
+    bool canSend(const WBusFrame &command) const
+    {
+        if (isSnifferMode)
         {
-            Command cmd = priorityDeque.front();
-            priorityDeque.pop_front();
-            return cmd;
+            Serial.println("⚠️  В режиме сниффера отправлять команды невозможно");
+            return false;
         }
-        else if (!normalDeque.empty())
+
+        if (!busManager.isConnected())
         {
-            Command cmd = normalDeque.front();
-            normalDeque.pop_front();
-            return cmd;
+            Serial.println("⚠️  TJA1020 недоступен или находится в режиме сна");
+            return false;
+        }
+
+        if (!command.isValid())
+        {
+            Serial.println("❌ Некорректная команда: " + command.toHexString());
+            return false;
         }
-        return Command();
+
+        return true;
     }
 
-    void sendCurrentCommand()
+    // Такой же кадр уже ждет ответа или стоит в очереди - присоединяемся к нему
+    bool coalesce(const WBusFrame &frame, CommandClass commandClass, CommandCallback &callback, const CommandHandle &completion)
+    {
+        bool inFlight = state != ProcessingState::IDLE && RequestCoalescer::covers(processingCommand.frame, frame);
+        if (!inFlight && !commandQueue.containsAny(frame))
+            return false;
+
+        if ((callback || completion.isTracked()) && !coalescer.attach(frame, callback, completion))
+            return false;
+
+        commandQueue.recordCoalesced(commandClass);
+        return true;
+    }
+
+    void enqueueDuePoll(unsigned long now, const BusConfig &config)
     {
-        if (packetParser.parseFromString(processingCommand.data))
+        int slot = pollScheduler.next(now, config);
+        if (slot < 0)
+            return;
+
+        Command command;
+        uint16_t batch = multiReadSupported ? pollScheduler.collectSensorBatch(slot, now, WBusMultiReadDecoder::MAX_RESPONSE_PAYLOAD) : 0;
+
+        if (batch & (batch - 1))
         {
-            if (busManager.sendCommand(packetParser.getData(), packetParser.getByteCounts()))
+            // Несколько страниц - одним групповым чтением
+            uint8_t indexes[PollScheduler::MAX_ENTRIES];
+            size_t count = 0;
+            for (size_t i = 0; i < PollScheduler::MAX_ENTRIES; i++)
             {
-                timeoutTimer.reset();
-                state = ProcessingState::SENDING;
+                if (batch & (1u << i))
+                    indexes[count++] = pollScheduler.getFrame(i).getIndex();
             }
-            else
+
+            command = Command(WBusCommandBuilder::createMultiReadSensor(indexes, count));
+            command.pollBatch = batch;
+        }
+        else
+        {
+            command = Command(pollScheduler.getFrame(slot), pollScheduler.getCallback(slot));
+            command.pollSlot = slot;
+        }
+        command.maxRetries = config.pollMaxRetries;
+
+        uint16_t batchSlots = command.pollBatch;
+        if (!commandQueue.push(CommandClass::BACKGROUND, std::move(command), now, config))
+        {
+            pollScheduler.release(slot);
+            for (size_t i = 0; i < PollScheduler::MAX_ENTRIES; i++)
             {
-                eventBus.publish(EventType::COMMAND_SENT_ERRROR, processingCommand.data);
-                clear();
+                if (batchSlots & (1u << i))
+                    pollScheduler.release(i);
             }
         }
     }
 
-    void complete(const String &response)
+    // Сброс очереди без потери страниц опроса: слоты снова доступны планировщику
+    void dropQueue()
+    {
+        commandQueue.forEachPollSlot([this](int slot)
+                                     { pollScheduler.release(slot); });
+        cancelQueued();
+        commandQueue.clear();
+        coalescer.clear(clock.nowMs());
+    }
+
+    // Команды из очереди так и не отправлены - вызывающим сообщается отмена
+    void cancelQueued()
+    {
+        unsigned long now = clock.nowMs();
+        commandQueue.forEachCommand([this, now](const Command &command)
+                                    { completions.fail(command.completion, CommandOutcome::CANCELLED, now); });
+    }
+
+    // Групповое чтение, не получившее ответа MAX_MULTI_READ_FAILURES раз подряд,
+    // выключается до следующего подключения: страницы снова опрашиваются по одной
+    void recordMultiReadFailure()
     {
-        if (processingCommand.callback)
+        if (++multiReadFailures >= MAX_MULTI_READ_FAILURES)
+            setMultiReadSupported(false);
+    }
+
+    // Время приема страниц группового ответа на tx (без заголовка и контрольной суммы)
+    static uint32_t replyWireTimeUs(const PacketView &tx, const BusConfig &config)
+    {
+        size_t payload = WBusMultiReadDecoder::expectedPayload(tx);
+        return static_cast<uint32_t>((uint64_t)payload * config.getBitsPerChar() * 1000000ULL / config.baudRate);
+    }
+
+    void sendCurrentCommand()
+    {
+        const WBusFrame &frame = processingCommand.frame;
+        BusStatistics::extractKey(frame.data(), frame.size(), currentCommand, currentIndex);
+        replyWireUs = replyWireTimeUs(frame.view(), configManager.getConfig().bus);
+
+        if (currentRetries == 0)
+            busStatistics.recordRequest(currentCommand, currentIndex);
+        else
+            busStatistics.recordRetry(currentCommand, currentIndex);
+
+        if (busManager.sendCommand(frame.data(), frame.size()))
+        {
+            // sendCommand только ставит кадр в UART, конец передачи ждем в TRANSMITTING
+            timeoutTimer.setInterval(configManager.getConfig().bus.commandTimeout);
+            state = ProcessingState::TRANSMITTING;
+        }
+        else
         {
-            processingCommand.callback(processingCommand.data, response);
+            failTransaction();
         }
+    }
+
+    // Ответ относится к текущему запросу: ACK (cmd | 0x80) с тем же индексом
+    // для команд чтения, либо NAK на эту команду (4F 04 7F cmd code cs)
+    bool isResponseToCurrent(const PacketView &rx) const
+    {
+        if (!rx.isValid())
+            return false;
+
+        if (rx.isNak())
+            return rx.at(3) == currentCommand;
+
+        if (rx.getCommand() != (currentCommand | 0x80))
+            return false;
 
-        else if (!Utils::isNakPacket(response))
+        // Индекс повторяется в ответе только у команд чтения
+        bool echoesIndex = currentCommand == WBusCommandBuilder::CMD_READ_SENSOR ||
+                           currentCommand == WBusCommandBuilder::CMD_READ_INFO ||
+                           currentCommand == WBusCommandBuilder::CMD_READ_ERRORS;
+
+        return !echoesIndex || rx.getIndex() == currentIndex;
+    }
+
+    void complete(const PacketView &rx)
+    {
+        // Копия кадра: обработчики ниже могут сбросить processingCommand
+        WBusFrame txFrame = processingCommand.frame;
+        PacketView tx = txFrame.view();
+        const BusConfig &config = configManager.getConfig().bus;
+        unsigned long now = clock.nowMs();
+        int64_t rttUs = commandReceiver.getLastRxTimestampUs() - txEndUs;
+
+        if (rx.isNak())
         {
-            if (processingCommand.loop)
+            busStatistics.recordNak(currentCommand, currentIndex, rx.at(4), now);
+        }
+        else
+        {
+            busStatistics.recordResponse(currentCommand, currentIndex, rttUs > 0 ? static_cast<uint32_t>(rttUs / 1000) : 0, now);
+        }
+
+        // После повтора неизвестно, на какую попытку пришел ответ - замер не берем
+        if (currentRetries == 0 && rttUs > 0)
+        {
+            rttEstimator.addSample(currentCommand, static_cast<uint32_t>(rttUs), replyWireUs);
+        }
+
+        // Пауза до следующей команды отсчитывается от получения ответа
+        queueTimer.setInterval(rttEstimator.getGapMs(currentCommand, config));
+
+        if (processingCommand.pollSlot >= 0)
+        {
+            pollScheduler.complete(processingCommand.pollSlot, transactionStart, now, config);
+
+            // NAK 0x33 - страница не поддерживается устройством, опрос прекращаем;
+            // остальные NAK (например, недопустимо в текущем состоянии) - откладываем опрос
+            if (rx.isNak() && rx.at(4) == NAK_CODE_UNSUPPORTED)
+                pollScheduler.remove(processingCommand.pollSlot);
+            else if (rx.isNak())
+                pollScheduler.recordNak(processingCommand.pollSlot, now, config);
+            else
+                pollScheduler.recordAnswer(1u << processingCommand.pollSlot);
+        }
+
+        if (processingCommand.pollBatch)
+        {
+            pollScheduler.completeBatch(processingCommand.pollBatch, transactionStart, now, config);
+
+            // NAK 0x33 на групповое чтение - дальше опрашиваем по одной странице
+            if (rx.isNak() && rx.at(4) == NAK_CODE_UNSUPPORTED)
+                setMultiReadSupported(false);
+            else if (rx.isNak())
+                recordMultiReadFailure();
+            else
             {
-                normalDeque.push_back(Command(processingCommand.data, processingCommand.callback, processingCommand.loop));
+                multiReadFailures = 0;
+                pollScheduler.recordAnswer(processingCommand.pollBatch);
             }
         }
 
+        completions.complete(processingCommand.completion, rx, now);
+
+        // Обработчик забираем из команды: он может сбросить очередь (disconnect)
+        CommandCallback callback = std::move(processingCommand.callback);
+        if (callback)
+        {
+            callback(tx, rx);
+        }
+
+        // Тот же ответ - всем присоединенным запросам
+        coalescer.resolve(tx, rx, now);
+
         state = ProcessingState::IDLE;
         currentRetries = 0;
         processingCommand = Command();
+
+        BusHealth oldHealth = busHealth.getState();
+        busHealth.recordSuccess();
+        onHealthChanged(oldHealth);
+    }
+
+    // Повторы исчерпаны: отбрасывается только эта транзакция,
+    // очередь сбрасывается лишь когда шина признана недоступной
+    void failTransaction()
+    {
+        const BusConfig &config = configManager.getConfig().bus;
+        unsigned long now = clock.nowMs();
+
+        eventBus.publish(EventType::COMMAND_SENT_ERRROR, processingCommand.frame.toHexString());
+        completions.fail(processingCommand.completion, CommandOutcome::TIMEOUT, now);
+        coalescer.drop(processingCommand.frame, now);
+
+        if (processingCommand.pollSlot >= 0)
+        {
+            pollScheduler.complete(processingCommand.pollSlot, transactionStart, now, config);
+        }
+
+        if (processingCommand.pollBatch)
+        {
+            pollScheduler.completeBatch(processingCommand.pollBatch, transactionStart, now, config);
+
+            // Шина отвечала до этого запроса - не отвечает именно групповое чтение
+            if (busHealth.getState() == BusHealth::HEALTHY)
+                recordMultiReadFailure();
+        }
+
+        bool wasProbe = processingCommand.probe;
+
+        state = ProcessingState::IDLE;
+        currentRetries = 0;
+        processingCommand = Command();
+
+        BusHealth oldHealth = busHealth.getState();
+        if (wasProbe)
+            busHealth.onProbeFailed(now, config);
+        else
+            busHealth.recordFailure(now, config);
+        onHealthChanged(oldHealth);
+    }
+
+    void sendProbe()
+    {
+        busHealth.onProbeSent();
+
+        processingCommand = Command(WBusCommandBuilder::createReadSensor(WBusCommandBuilder::SENSOR_STATUS_FLAGS));
+        processingCommand.probe = true;
+
+        transactionStart = clock.nowMs();
+        sendCurrentCommand();
+    }
+
+    void onHealthChanged(BusHealth oldHealth)
+    {
+        BusHealth newHealth = busHealth.getState();
+        if (newHealth == oldHealth)
+            return;
+
+        if (newHealth == BusHealth::DOWN)
+        {
+            dropQueue();
+            Serial.println("🔌 Шина не отвечает, очередь сброшена. Проверка каждые " + String(configManager.getConfig().bus.busProbeInterval) + "+ мс");
+        }
+        else if (oldHealth == BusHealth::DOWN)
+        {
+            Serial.println("✅ Шина снова отвечает");
+        }
+
+        eventBus.publish<BusHealthChangedEvent>(EventType::BUS_HEALTH_CHANGED, {oldHealth, newHealth});
+    }
+
+    bool acceptsCommands(const WBusFrame &command) const
+    {
+        if (busHealth.isDown())
+        {
+            Serial.println("⚠️  Шина недоступна, команда отклонена: " + command.toHexString());
+            return false;
+        }
+        return true;
+    }
+
+    Command makeCommand(const WBusFrame &frame, CommandCallback callback) const
+    {
+        Command command(frame, callback);
+        command.maxRetries = configManager.getConfig().bus.maxRetries;
+        return command;
+    }
+
+    void handleResponse()
+    {
+        const PacketView &rx = commandReceiver.getRxView();
+
+        if (isResponseToCurrent(rx))
+        {
+            // ✅ Ответ получен
+            complete(rx);
+        }
+        else
+        {
+            // Ответ на чужой запрос (другой контроллер на шине) - уже разобран
+            // пассивно через COMMAND_RECEIVED, продолжаем ждать свой
+            busStatistics.recordMismatch(currentCommand, currentIndex);
+        }
     }
 
     void handleTimeout()
     {
+        busStatistics.recordTimeout(currentCommand, currentIndex);
+        rttEstimator.onTimeout(currentCommand);
         currentRetries++;
 
-        uint8_t maxRetries = configManager.getConfig().bus.maxRetries;
+        uint8_t maxRetries = busHealth.retryBudget(processingCommand.maxRetries);
 
         if (currentRetries > maxRetries)
         {
-            eventBus.publish(EventType::COMMAND_SENT_ERRROR, processingCommand.data);
-            clear();
+            failTransaction();
         }
         else
         {
-            eventBus.publish<ConnectionTimeoutEvent>(EventType::COMMAND_SENT_TIMEOUT, {currentRetries, processingCommand.data});
-            Serial.println("🔄 Повторная отправка " + String(currentRetries) + "/" + String(maxRetries) + ": " + processingCommand.data);
+            String hex = processingCommand.frame.toHexString();
+            eventBus.publish<ConnectionTimeoutEvent>(EventType::COMMAND_SENT_TIMEOUT, {currentRetries, hex});
+            Serial.println("🔄 Повторная отправка " + String(currentRetries) + "/" + String(maxRetries) + ": " + hex);
 
             state = ProcessingState::BREAK_SET;
         }
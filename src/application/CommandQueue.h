@@ -0,0 +1,459 @@
+// src/application/CommandQueue.h
+#pragma once
+#include <Arduino.h>
+#include "../common/WBusFrame.h"
+#include "../common/PacketView.h"
+#include "../common/InlineFunction.h"
+#include "../domain/Entities.h"
+
+// Обработчик ответа: кадр запроса и кадр ответа (валидны только на время вызова).
+// Захват хранится внутри Command - без выделения памяти на каждую команду.
+using CommandCallback = InlineFunction<void(const PacketView &tx, const PacketView &rx), 4 * sizeof(void *)>;
+
+// Классы команд в порядке убывания приоритета
+enum class CommandClass : uint8_t
+{
+    SAFETY,      // Keep-alive, выключение
+    CONTROL,     // Команды управления от пользователя
+    INTERACTIVE, // Разовые чтения (API, подключение)
+    BACKGROUND,  // Периодический опрос
+    COUNT
+};
+
+struct Command
+{
+    WBusFrame frame;
+    CommandCallback callback;
+    int pollSlot = -1;      // Слот планировщика опроса, -1 - разовая команда
+    uint16_t pollBatch = 0; // Слоты страниц, упакованных в групповое чтение
+    uint8_t maxRetries = 0; // Бюджет повторов этой транзакции
+    bool probe = false;     // Пробный запрос недоступной шины
+    CommandHandle completion; // Запись результата для вызывающего
+    unsigned long enqueuedAt = 0;
+
+    Command() = default;
+    Command(const WBusFrame &cmd, CommandCallback cb = nullptr)
+        : frame(cmd), callback(std::move(cb)) {}
+
+    // Команда передается только перемещением: слот пула -> обработка
+    Command(Command &&) = default;
+    Command &operator=(Command &&) = default;
+    Command(const Command &) = delete;
+    Command &operator=(const Command &) = delete;
+};
+
+// Очередь команд по классам. У каждого класса своя емкость, поэтому
+// заполненный опрос не мешает keep-alive и командам пользователя.
+// Дубликаты ищутся по хешу кадра. Ожидание повышает класс команды
+// на одну ступень за каждые queueAgingStep мс - младшие классы не голодают.
+//
+// Память выделяется один раз: общий пул из POOL_SIZE слотов, у каждого
+// класса - кольцо индексов слотов, хеши кадров - в таблице с открытой адресацией.
+class CommandQueue
+{
+public:
+    static const size_t CLASS_COUNT = static_cast<size_t>(CommandClass::COUNT);
+    static const size_t POOL_SIZE = 64;
+
+private:
+    static const size_t HASH_CAPACITY = POOL_SIZE * 2; // Степень двойки, заполнение <= 50%
+
+    struct HashSlot
+    {
+        uint32_t hash = 0;
+        uint8_t commandClass = 0;
+        uint8_t count = 0; // 0 - свободно
+    };
+
+    struct ClassQueue
+    {
+        uint8_t ring[POOL_SIZE]; // Индексы слотов пула в порядке поступления
+        size_t head = 0;
+        size_t count = 0;
+
+        uint32_t enqueued = 0;
+        uint32_t dispatched = 0;
+        uint32_t duplicates = 0;
+        uint32_t rejected = 0; // Очередь класса заполнена
+        uint32_t aged = 0;     // Отправлено раньше старших классов за счет ожидания
+        uint32_t coalesced = 0; // Присоединено к уже ожидающему запросу
+        size_t maxDepth = 0;
+        uint64_t totalWaitMs = 0;
+        uint32_t maxWaitMs = 0;
+    };
+
+    ClassQueue queues[CLASS_COUNT];
+
+    Command pool[POOL_SIZE];
+    uint8_t freeSlots[POOL_SIZE];
+    size_t freeCount = 0;
+    uint32_t poolExhausted = 0;
+
+    HashSlot hashTable[HASH_CAPACITY];
+
+    static size_t homeSlot(uint32_t hash, uint8_t commandClass)
+    {
+        return (hash ^ (commandClass * 0x9E3779B9u)) & (HASH_CAPACITY - 1);
+    }
+
+    int findHash(uint32_t hash, uint8_t commandClass) const
+    {
+        size_t slot = homeSlot(hash, commandClass);
+        for (size_t probe = 0; probe < HASH_CAPACITY; probe++)
+        {
+            const HashSlot &entry = hashTable[slot];
+            if (entry.count == 0)
+                return -1;
+            if (entry.hash == hash && entry.commandClass == commandClass)
+                return slot;
+            slot = (slot + 1) & (HASH_CAPACITY - 1);
+        }
+        return -1;
+    }
+
+    void insertHash(uint32_t hash, uint8_t commandClass)
+    {
+        size_t slot = homeSlot(hash, commandClass);
+        for (size_t probe = 0; probe < HASH_CAPACITY; probe++)
+        {
+            HashSlot &entry = hashTable[slot];
+            if (entry.count == 0 || (entry.hash == hash && entry.commandClass == commandClass))
+            {
+                entry.hash = hash;
+                entry.commandClass = commandClass;
+                entry.count++;
+                return;
+            }
+            slot = (slot + 1) & (HASH_CAPACITY - 1);
+        }
+    }
+
+    // Удаление со сдвигом следующих записей цепочки - без "надгробий"
+    void eraseHash(uint32_t hash, uint8_t commandClass)
+    {
+        int found = findHash(hash, commandClass);
+        if (found < 0)
+            return;
+
+        if (--hashTable[found].count > 0)
+            return;
+
+        size_t hole = found;
+        size_t next = hole;
+        while (true)
+        {
+            next = (next + 1) & (HASH_CAPACITY - 1);
+            if (hashTable[next].count == 0)
+                break;
+
+            size_t home = homeSlot(hashTable[next].hash, hashTable[next].commandClass);
+            bool movable = hole <= next ? (home <= hole || home > next) : (home <= hole && home > next);
+            if (movable)
+            {
+                hashTable[hole] = hashTable[next];
+                hole = next;
+            }
+        }
+        hashTable[hole] = HashSlot();
+    }
+
+    Command &at(const ClassQueue &queue, size_t position)
+    {
+        return pool[queue.ring[(queue.head + position) % POOL_SIZE]];
+    }
+
+    const Command &at(const ClassQueue &queue, size_t position) const
+    {
+        return pool[queue.ring[(queue.head + position) % POOL_SIZE]];
+    }
+
+    static size_t indexOf(CommandClass commandClass)
+    {
+        return static_cast<size_t>(commandClass);
+    }
+
+    static size_t capacityFor(size_t index, const BusConfig &config)
+    {
+        switch (static_cast<CommandClass>(index))
+        {
+        case CommandClass::SAFETY:
+            return config.queueSafetySize;
+        case CommandClass::CONTROL:
+            return config.maxPriorityQueueSize;
+        case CommandClass::INTERACTIVE:
+            return config.maxQueueSize;
+        case CommandClass::BACKGROUND:
+            return config.queueBackgroundSize;
+        default:
+            return 0;
+        }
+    }
+
+    // Эффективный ранг: класс минус число шагов ожидания первой команды
+    size_t effectiveRank(size_t index, const ClassQueue &queue, unsigned long now, const BusConfig &config) const
+    {
+        if (config.queueAgingStep == 0)
+            return index;
+
+        size_t steps = (now - headEnqueuedAt(queue)) / config.queueAgingStep;
+        return steps >= index ? 0 : index - steps;
+    }
+
+    unsigned long headEnqueuedAt(const ClassQueue &queue) const
+    {
+        return at(queue, 0).enqueuedAt;
+    }
+
+public:
+    CommandQueue()
+    {
+        clear();
+    }
+
+    CommandQueue(const CommandQueue &) = delete;
+    CommandQueue &operator=(const CommandQueue &) = delete;
+
+    static const char *className(CommandClass commandClass)
+    {
+        switch (commandClass)
+        {
+        case CommandClass::SAFETY:
+            return "safety";
+        case CommandClass::CONTROL:
+            return "control";
+        case CommandClass::INTERACTIVE:
+            return "interactive";
+        case CommandClass::BACKGROUND:
+            return "background";
+        default:
+            return "unknown";
+        }
+    }
+
+    // Совпадение хеша проверяется сравнением кадров только при попадании
+    bool contains(CommandClass commandClass, const WBusFrame &frame) const
+    {
+        size_t index = indexOf(commandClass);
+        if (findHash(frame.hash(), index) < 0)
+            return false;
+
+        const ClassQueue &queue = queues[index];
+        for (size_t i = 0; i < queue.count; i++)
+        {
+            if (at(queue, i).frame == frame)
+                return true;
+        }
+        return false;
+    }
+
+    // Кадр стоит в очереди любого класса
+    bool containsAny(const WBusFrame &frame) const
+    {
+        for (size_t i = 0; i < CLASS_COUNT; i++)
+        {
+            if (contains(static_cast<CommandClass>(i), frame))
+                return true;
+        }
+        return false;
+    }
+
+    void recordCoalesced(CommandClass commandClass)
+    {
+        queues[indexOf(commandClass)].coalesced++;
+    }
+
+    bool push(CommandClass commandClass, Command &&command, unsigned long now, const BusConfig &config)
+    {
+        size_t index = indexOf(commandClass);
+        ClassQueue &queue = queues[index];
+
+        if (contains(commandClass, command.frame))
+        {
+            queue.duplicates++;
+            return false;
+        }
+
+        if (queue.count >= capacityFor(index, config))
+        {
+            queue.rejected++;
+            return false;
+        }
+
+        if (freeCount == 0)
+        {
+            poolExhausted++;
+            return false;
+        }
+
+        uint8_t slot = freeSlots[--freeCount];
+        pool[slot] = std::move(command);
+        pool[slot].enqueuedAt = now;
+
+        queue.ring[(queue.head + queue.count) % POOL_SIZE] = slot;
+        queue.count++;
+        insertHash(pool[slot].frame.hash(), index);
+        queue.enqueued++;
+
+        if (queue.count > queue.maxDepth)
+            queue.maxDepth = queue.count;
+        return true;
+    }
+
+    // Следующая команда: наименьший эффективный ранг, при равенстве - старший класс
+    Command pop(unsigned long now, const BusConfig &config)
+    {
+        int best = -1;
+        int highest = -1;
+        size_t bestRank = CLASS_COUNT;
+
+        for (size_t i = 0; i < CLASS_COUNT; i++)
+        {
+            if (queues[i].count == 0)
+                continue;
+
+            if (highest < 0)
+                highest = i;
+
+            size_t rank = effectiveRank(i, queues[i], now, config);
+            if (rank < bestRank)
+            {
+                bestRank = rank;
+                best = i;
+            }
+        }
+
+        if (best < 0)
+            return Command();
+
+        ClassQueue &queue = queues[best];
+        uint8_t slot = queue.ring[queue.head];
+        queue.head = (queue.head + 1) % POOL_SIZE;
+        queue.count--;
+
+        Command command = std::move(pool[slot]);
+        pool[slot] = Command();
+        freeSlots[freeCount++] = slot;
+        eraseHash(command.frame.hash(), best);
+
+        uint32_t waitMs = now - command.enqueuedAt;
+        queue.dispatched++;
+        queue.totalWaitMs += waitMs;
+        if (waitMs > queue.maxWaitMs)
+            queue.maxWaitMs = waitMs;
+        if (best != highest)
+            queue.aged++;
+
+        return command;
+    }
+
+    bool isEmpty() const
+    {
+        for (size_t i = 0; i < CLASS_COUNT; i++)
+        {
+            if (queues[i].count > 0)
+                return false;
+        }
+        return true;
+    }
+
+    size_t size(CommandClass commandClass) const
+    {
+        return queues[indexOf(commandClass)].count;
+    }
+
+    size_t size() const
+    {
+        size_t total = 0;
+        for (size_t i = 0; i < CLASS_COUNT; i++)
+            total += queues[i].count;
+        return total;
+    }
+
+    // Слоты опроса, ожидающие в очереди (для освобождения при сбросе)
+    template <typename Fn>
+    void forEachPollSlot(Fn fn) const
+    {
+        const ClassQueue &queue = queues[indexOf(CommandClass::BACKGROUND)];
+        for (size_t i = 0; i < queue.count; i++)
+        {
+            const Command &command = at(queue, i);
+            if (command.pollSlot >= 0)
+                fn(command.pollSlot);
+
+            for (int slot = 0; command.pollBatch >> slot; slot++)
+            {
+                if (command.pollBatch & (1u << slot))
+                    fn(slot);
+            }
+        }
+    }
+
+    template <typename Fn>
+    void forEachCommand(Fn fn) const
+    {
+        for (size_t i = 0; i < CLASS_COUNT; i++)
+        {
+            for (size_t position = 0; position < queues[i].count; position++)
+                fn(at(queues[i], position));
+        }
+    }
+
+    void clear()
+    {
+        for (size_t i = 0; i < CLASS_COUNT; i++)
+        {
+            queues[i].head = 0;
+            queues[i].count = 0;
+        }
+
+        for (size_t i = 0; i < POOL_SIZE; i++)
+        {
+            pool[i] = Command(); // Освобождаем захваты обработчиков
+            freeSlots[i] = static_cast<uint8_t>(POOL_SIZE - 1 - i);
+        }
+        freeCount = POOL_SIZE;
+
+        for (size_t i = 0; i < HASH_CAPACITY; i++)
+            hashTable[i] = HashSlot();
+    }
+
+    String toJson(unsigned long now, const BusConfig &config) const
+    {
+        String json = "{";
+        json += "\"agingStepMs\":" + String(config.queueAgingStep) + ",";
+        json += "\"poolSize\":" + String(POOL_SIZE) + ",";
+        json += "\"poolFree\":" + String(freeCount) + ",";
+        json += "\"poolExhausted\":" + String(poolExhausted) + ",";
+        json += "\"poolBytes\":" + String(sizeof(pool)) + ",";
+        json += "\"classes\":[";
+
+        for (size_t i = 0; i < CLASS_COUNT; i++)
+        {
+            const ClassQueue &queue = queues[i];
+            if (i > 0)
+                json += ",";
+
+            uint32_t headWaitMs = queue.count == 0 ? 0 : now - headEnqueuedAt(queue);
+            uint32_t avgWaitMs = queue.dispatched > 0 ? queue.totalWaitMs / queue.dispatched : 0;
+
+            json += "{";
+            json += "\"class\":\"" + String(className(static_cast<CommandClass>(i))) + "\",";
+            json += "\"depth\":" + String(queue.count) + ",";
+            json += "\"capacity\":" + String(capacityFor(i, config)) + ",";
+            json += "\"maxDepth\":" + String(queue.maxDepth) + ",";
+            json += "\"enqueued\":" + String(queue.enqueued) + ",";
+            json += "\"dispatched\":" + String(queue.dispatched) + ",";
+            json += "\"duplicates\":" + String(queue.duplicates) + ",";
+            json += "\"rejected\":" + String(queue.rejected) + ",";
+            json += "\"aged\":" + String(queue.aged) + ",";
+            json += "\"coalesced\":" + String(queue.coalesced) + ",";
+            json += "\"headWaitMs\":" + String(headWaitMs) + ",";
+            json += "\"avgWaitMs\":" + String(avgWaitMs) + ",";
+            json += "\"maxWaitMs\":" + String(queue.maxWaitMs);
+            json += "}";
+        }
+
+        json += "]}";
+        return json;
+    }
+};
@@ -2,9 +2,18 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
 #include "../common/Constants.h"
+#include "../common/SafeBuffer.h"
 #include "../common/Utils.h"
+#include "../common/PacketView.h"
 #include "../core/EventBus.h"
+#include "../core/ConfigManager.h"
+#include "../interfaces/IClock.h"
 #include "../infrastructure/protocol/WBusCommandBuilder.h"
+#include "../infrastructure/protocol/WBusFramer.h"
+#include "../infrastructure/hardware/KLineReceiverTask.h"
+
+// Буфер одного кадра K-Line (без динамических аллокаций)
+using KLineFrameBuffer = SafeBuffer<WBUS_MAX_FRAME_LENGTH>;
 
 enum class KLineReceptionStates
 {
@@ -15,63 +24,22 @@ enum class KLineReceptionStates
 
 struct KLineReceivedData
 {
-  String rxString = "";
-  String txString = "";
-  bool isReceivingRx = false;
-  bool isReceivingTx = false;
-  int bytesToRead = 0;
-  int bytesRead = 0;
+  KLineFrameBuffer rxFrame;
+  KLineFrameBuffer txFrame;
   KLineReceptionStates rx_reception_state = KLineReceptionStates::IDLE;
   KLineReceptionStates tx_reception_state = KLineReceptionStates::IDLE;
 
-  void startTxReception(uint8_t headerByte)
-  {
-    isReceivingTx = true;
-    txString = "";
-    bytesRead = 1;
-    txString += Utils::byteToHexString(headerByte) + " ";
-  }
-
-  void startRxReception(uint8_t headerByte)
-  {
-    isReceivingRx = true;
-    rxString = "";
-    bytesRead = 1;
-    rxString += Utils::byteToHexString(headerByte) + " ";
-  }
-
-  void addByte(uint8_t readByte)
-  {
-    if (bytesRead == 1)
-    {
-      bytesToRead = readByte;
-    }
-
-    String hexByte = Utils::byteToHexString(readByte);
-
-    if (isReceivingRx)
-      rxString += hexByte + " ";
-    if (isReceivingTx)
-      txString += hexByte + " ";
-    bytesRead++;
-  }
-
-  bool isPacketComplete()
+  void completeRxReception(const uint8_t *frame, size_t length)
   {
-    return bytesRead >= bytesToRead + 2;
-  }
-
-  void completeRxReception()
-  {
-    rxString.trim();
-    isReceivingRx = false;
+    rxFrame.clear();
+    rxFrame.append(frame, length);
     rx_reception_state = KLineReceptionStates::RX_RECEIVED;
   }
 
-  void completeTxReception()
+  void completeTxReception(const uint8_t *frame, size_t length)
   {
-    txString.trim();
-    isReceivingTx = false;
+    txFrame.clear();
+    txFrame.append(frame, length);
     tx_reception_state = KLineReceptionStates::TX_RECEIVED;
   }
 
@@ -89,22 +57,16 @@ struct KLineReceivedData
 
   void resetRx()
   {
-    rxString = "";
-    isReceivingRx = false;
+    rxFrame.clear();
     rx_reception_state = KLineReceptionStates::IDLE;
   }
 
   void resetTx()
   {
-    txString = "";
-    isReceivingTx = false;
+    txFrame.clear();
     tx_reception_state = KLineReceptionStates::IDLE;
   }
 
-  bool isReceiving() const
-  {
-    return isReceivingRx || isReceivingTx;
-  }
   bool isRxReceived() const
   {
     return rx_reception_state == KLineReceptionStates::RX_RECEIVED;
@@ -113,87 +75,102 @@ struct KLineReceivedData
   {
     return tx_reception_state == KLineReceptionStates::TX_RECEIVED;
   }
-  String getRxData() const
+  const KLineFrameBuffer &getRxFrame() const
   {
-    return rxString;
+    return rxFrame;
   }
-  String getTxData() const
+  const KLineFrameBuffer &getTxFrame() const
   {
-    return txString;
+    return txFrame;
   }
 };
 
 class CommandReceiver
 {
 private:
-  HardwareSerial &serial;
   EventBus &eventBus;
+  ConfigManager &configManager;
+  KLineReceiverTask receiverTask;
   KLineReceivedData receivedData;
-  String currentTx;
+  KLineFrameBuffer currentTx;
+  PacketView rxView; // Последний ответ, проверенный при приеме
+  int64_t lastRxTimestampUs = 0;
+  int64_t lastTxTimestampUs = 0;
+  bool inlineReceive = false; // Нет задачи приема: байты разбирает process()
+
+  void handleFrame(const WBusRawFrame &rawFrame)
+  {
+    const uint8_t *frame = rawFrame.data;
+    size_t length = rawFrame.length;
+
+    if (frame[0] == TXHEADER)
+    {
+      lastTxTimestampUs = rawFrame.timestampUs;
+      receivedData.completeTxReception(frame, length);
+      currentTx.clear();
+      currentTx.copyFrom(receivedData.getTxFrame());
+
+      eventBus.publish<FrameReceivedEvent>(EventType::TX_RECEIVED, {PacketView(currentTx.data(), currentTx.size())});
+      return;
+    }
+
+    lastRxTimestampUs = rawFrame.timestampUs;
+    receivedData.completeRxReception(frame, length);
+
+    const KLineFrameBuffer &rxFrame = receivedData.getRxFrame();
+    PacketView txView(currentTx.data(), currentTx.size());
+    rxView = PacketView(rxFrame.data(), rxFrame.size());
+
+    eventBus.publish<FrameReceivedEvent>(EventType::RX_RECEIVED, {rxView});
+
+    if (rxView.isNak())
+    {
+      uint8_t command = txView.getCommand();
+      uint8_t errorCode = rxView.at(4);
+      String commandName = WBusCommandBuilder::getCommandName(command);
+      eventBus.publish<NakResponseEvent>(EventType::COMMAND_NAK_RESPONSE, {txView.toHexString(), commandName, errorCode});
+    }
+    else
+    {
+      eventBus.publish<CommandReceivedEvent>(EventType::COMMAND_RECEIVED, {txView, rxView});
+    }
+  }
 
 public:
-  CommandReceiver(HardwareSerial &serialRef, EventBus &bus) : serial(serialRef),
-                                                              eventBus(bus) {}
+  CommandReceiver(HardwareSerial &serialRef, EventBus &bus, ConfigManager &configMngr, IClock &clock) : eventBus(bus),
+                                                                                                      configManager(configMngr),
+                                                                                                      receiverTask(serialRef, clock)
+  {
+    eventBus.subscribe(EventType::APP_CONFIG_UPDATE,
+                       [this](const Event &event)
+                       {
+                         const auto &configEvent = static_cast<
+                             const TypedEvent<AppConfigUpdateEvent> &>(event);
+
+                         receiverTask.setGapTimeout(configEvent.data.config.bus.frameGapTimeout);
+                       });
+  }
 
+  // receiveTask = false - без отдельной задачи (детерминированное виртуальное время)
+  void initialize(bool receiveTask = true)
+  {
+    inlineReceive = !receiveTask;
+    receiverTask.begin(configManager.getConfig().bus.frameGapTimeout, receiveTask);
+  }
+
+  // Разбор кадров, накопленных задачей приема
   void process()
   {
     receivedData.resetState();
 
-    while (serial.available())
+    if (inlineReceive)
+      receiverTask.poll();
+
+    // Не более одного ответа за вызов, чтобы CommandManager успел его обработать
+    WBusRawFrame rawFrame;
+    while (!receivedData.isRxReceived() && receiverTask.popFrame(rawFrame))
     {
-      uint8_t readByte = serial.read();
-
-      if (!receivedData.isReceiving())
-      {
-        if (readByte == RXHEADER)
-        {
-          receivedData.startRxReception(readByte);
-        }
-        else if (readByte == TXHEADER)
-        {
-          receivedData.startTxReception(readByte);
-          currentTx = "";
-        }
-      }
-      else
-      {
-        receivedData.addByte(readByte);
-
-        if (receivedData.isPacketComplete())
-        {
-          if (receivedData.isReceivingTx)
-          {
-            receivedData.completeTxReception();
-            currentTx = getTxData();
-
-            eventBus.publish(EventType::TX_RECEIVED, getTxData());
-          }
-
-          if (receivedData.isReceivingRx)
-          {
-            receivedData.completeRxReception();
-
-            String response = getRxData();
-
-            eventBus.publish(EventType::RX_RECEIVED, response);
-
-            if (Utils::isNakPacket(response))
-            {
-              uint8_t command = Utils::extractByteFromString(currentTx, 2);
-              uint8_t errorCode = Utils::extractByteFromString(response, 4);
-              String commandName = WBusCommandBuilder::getCommandName(command);
-              eventBus.publish<NakResponseEvent>(EventType::COMMAND_NAK_RESPONSE, {currentTx, commandName, errorCode});
-            }
-            else
-            {
-              eventBus.publish<CommandReceivedEvent>(EventType::COMMAND_RECEIVED, {currentTx, response});
-            }
-          }
-
-          receivedData.bytesToRead = 0;
-          receivedData.bytesRead = 0;
-        }
-      }
+      handleFrame(rawFrame);
     }
   }
 
@@ -205,16 +182,64 @@ public:
   {
     return receivedData.isTxReceived();
   }
+
+  // Бинарные кадры (без преобразования в текст)
+  const KLineFrameBuffer &getRxFrame() const
+  {
+    return receivedData.getRxFrame();
+  }
+  const KLineFrameBuffer &getTxFrame() const
+  {
+    return receivedData.getTxFrame();
+  }
+  const KLineFrameBuffer &getCurrentTxFrame() const
+  {
+    return currentTx;
+  }
+
+  // Представление последнего ответа (валидно до приема следующего кадра)
+  const PacketView &getRxView() const
+  {
+    return rxView;
+  }
+
+  // HEX представление формируется только по запросу
   String getRxData() const
   {
-    return receivedData.getRxData();
+    return Utils::bytesToHexString(getRxFrame().data(), getRxFrame().size());
   }
   String getTxData() const
   {
-    return receivedData.getTxData();
+    return Utils::bytesToHexString(getTxFrame().data(), getTxFrame().size());
   }
   String getCurrentTx() const
   {
-    return currentTx;
+    return Utils::bytesToHexString(currentTx.data(), currentTx.size());
+  }
+
+  // Время завершения приема последних кадров (мкс, IClock::nowUs)
+  int64_t getLastRxTimestampUs() const
+  {
+    return lastRxTimestampUs;
   }
-};
\ No newline at end of file
+  int64_t getLastTxTimestampUs() const
+  {
+    return lastTxTimestampUs;
+  }
+
+  // Статистика приема кадров (копия, задача приема продолжает счет)
+  WBusFramerStats getFramerStats() const
+  {
+    return receiverTask.getStats();
+  }
+
+  uint32_t getQueueOverflows() const
+  {
+    return receiverTask.getQueueOverflows();
+  }
+
+  void resetFramerStats()
+  {
+    receiverTask.resetStats();
+  }
+};
@@ -0,0 +1,109 @@
+// src/application/DecoderRegistry.h
+#pragma once
+#include <Arduino.h>
+#include <functional>
+#include "../common/PacketView.h"
+#include "../infrastructure/protocol/WBusCommandBuilder.h"
+
+// Обработчик ответа: кадр запроса и уже проверенный кадр ответа
+using ResponseHandler = std::function<void(const PacketView &tx, const PacketView &rx)>;
+
+// Таблица обработчиков ответов по ключу (команда, индекс).
+// Открытая адресация фиксированного размера: поиск - одно вычисление слота,
+// новый датчик добавляется одной регистрацией без правки switch.
+class DecoderRegistry
+{
+public:
+    static const size_t CAPACITY = 64; // Степень двойки
+
+private:
+    struct Entry
+    {
+        bool used = false;
+        uint16_t key = 0;
+        ResponseHandler handler;
+    };
+
+    Entry entries[CAPACITY];
+    size_t count = 0;
+
+    static uint16_t makeKey(uint8_t command, uint8_t index)
+    {
+        if (!WBusCommandBuilder::isIndexedCommand(command))
+            index = 0;
+        return static_cast<uint16_t>((command & 0x7F) << 8) | index;
+    }
+
+    static size_t slotFor(uint16_t key)
+    {
+        // Перемешивание: индексы датчиков идут подряд, команды различаются старшим байтом
+        return ((key * 40503u) >> 4) & (CAPACITY - 1);
+    }
+
+    const Entry *find(uint16_t key) const
+    {
+        size_t slot = slotFor(key);
+        for (size_t probe = 0; probe < CAPACITY; probe++)
+        {
+            const Entry &entry = entries[(slot + probe) & (CAPACITY - 1)];
+            if (!entry.used)
+                return nullptr;
+            if (entry.key == key)
+                return &entry;
+        }
+        return nullptr;
+    }
+
+public:
+    // Регистрация обработчика; индекс учитывается только для команд с индексом
+    bool add(uint8_t command, uint8_t index, ResponseHandler handler)
+    {
+        uint16_t key = makeKey(command, index);
+        size_t slot = slotFor(key);
+
+        for (size_t probe = 0; probe < CAPACITY; probe++)
+        {
+            Entry &entry = entries[(slot + probe) & (CAPACITY - 1)];
+
+            if (entry.used && entry.key != key)
+                continue;
+
+            if (!entry.used)
+                count++;
+
+            entry.used = true;
+            entry.key = key;
+            entry.handler = handler;
+            return true;
+        }
+
+        Serial.println("❌ Таблица декодеров заполнена: " + WBusCommandBuilder::getCommandName(command));
+        return false;
+    }
+
+    bool add(uint8_t command, ResponseHandler handler)
+    {
+        return add(command, 0, handler);
+    }
+
+    // Ключ берется из кадра запроса: F4 len cmd [index] ...
+    bool dispatch(const PacketView &tx, const PacketView &rx) const
+    {
+        const Entry *entry = find(makeKey(tx.getCommand(), tx.getIndex()));
+        if (!entry || !entry->handler)
+            return false;
+
+        entry->handler(tx, rx);
+        return true;
+    }
+
+    bool contains(uint8_t command, uint8_t index = 0) const
+    {
+        return find(makeKey(command, index)) != nullptr;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+};
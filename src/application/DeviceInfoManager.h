@@ -4,6 +4,7 @@
 #include "../infrastructure/protocol/WBusCommandBuilder.h"
 #include "../infrastructure/protocol/WBusInfoDecoder.h"
 #include "../application/CommandManager.h"
+#include "../application/DecoderRegistry.h"
 
 class DeviceInfoManager : public IDeviceInfoManager
 {
@@ -81,51 +82,74 @@ public:
 
   // =========================================================================
 
-  void handleWBusVersionResponse(String tx, String rx, std::function<void(String, String, String *)> callback = nullptr)
+  // Декодеры ответов 0x51 по индексу информации
+  void registerDecoders(DecoderRegistry &registry)
+  {
+    const uint8_t cmd = WBusCommandBuilder::CMD_READ_INFO;
+
+    registry.add(cmd, WBusCommandBuilder::INFO_WBUS_VERSION, [this](const PacketView &tx, const PacketView &rx)
+                 { handleWBusVersionResponse(tx, rx); });
+    registry.add(cmd, WBusCommandBuilder::INFO_DEVICE_NAME, [this](const PacketView &tx, const PacketView &rx)
+                 { handleDeviceNameResponse(tx, rx); });
+    registry.add(cmd, WBusCommandBuilder::INFO_WBUS_CODE, [this](const PacketView &tx, const PacketView &rx)
+                 { handleWBusCodeResponse(tx, rx); });
+    registry.add(cmd, WBusCommandBuilder::INFO_DEVICE_ID, [this](const PacketView &tx, const PacketView &rx)
+                 { handleDeviceIDResponse(tx, rx); });
+    registry.add(cmd, WBusCommandBuilder::INFO_CTRL_MFG_DATE, [this](const PacketView &tx, const PacketView &rx)
+                 { handleControllerManufactureDateResponse(tx, rx); });
+    registry.add(cmd, WBusCommandBuilder::INFO_HEATER_MFG_DATE, [this](const PacketView &tx, const PacketView &rx)
+                 { handleHeaterManufactureDateResponse(tx, rx); });
+    registry.add(cmd, WBusCommandBuilder::INFO_CUSTOMER_ID, [this](const PacketView &tx, const PacketView &rx)
+                 { handleCustomerIDResponse(tx, rx); });
+    registry.add(cmd, WBusCommandBuilder::INFO_SERIAL_NUMBER, [this](const PacketView &tx, const PacketView &rx)
+                 { handleSerialNumberResponse(tx, rx); });
+  }
+
+  void handleWBusVersionResponse(const PacketView &tx, const PacketView &rx, std::function<void(const PacketView &, const PacketView &, String *)> callback = nullptr)
   {
     wbusVersion = WBusInfoDecoder::decodeWBusVersion(rx);
     eventBus.publish(EventType::WBUS_VERSION, wbusVersion);
   }
 
-  void handleDeviceNameResponse(String tx, String rx)
+  void handleDeviceNameResponse(const PacketView &tx, const PacketView &rx)
   {
     deviceName = WBusInfoDecoder::decodeDeviceName(rx);
     eventBus.publish(EventType::DEVICE_NAME, deviceName);
   }
 
-  void handleWBusCodeResponse(String tx, String rx)
+  void handleWBusCodeResponse(const PacketView &tx, const PacketView &rx)
   {
     wBusCode = WBusInfoDecoder::decodeWBusCode(rx);
     eventBus.publish<DecodedWBusCode>(EventType::WBUS_CODE, wBusCode);
   }
 
-  void handleDeviceIDResponse(String tx, String rx)
+  void handleDeviceIDResponse(const PacketView &tx, const PacketView &rx)
   {
     deviceID = WBusInfoDecoder::decodeDeviceID(rx);
     eventBus.publish(EventType::DEVICE_ID, deviceID);
   }
 
-  void handleControllerManufactureDateResponse(String tx, String rx)
+  void handleControllerManufactureDateResponse(const PacketView &tx, const PacketView &rx)
   {
     DecodedManufactureDate date = WBusInfoDecoder::decodeControllerManufactureDate(rx);
     controllerManufactureDate = date.dateString;
     eventBus.publish<DecodedManufactureDate>(EventType::CONTRALLER_MANUFACTURE_DATE, date);
   }
 
-  void handleHeaterManufactureDateResponse(String tx, String rx)
+  void handleHeaterManufactureDateResponse(const PacketView &tx, const PacketView &rx)
   {
     DecodedManufactureDate date = WBusInfoDecoder::decodeHeaterManufactureDate(rx);
     heaterManufactureDate = date.dateString;
     eventBus.publish<DecodedManufactureDate>(EventType::HEATER_MANUFACTURE_DATE, date);
   }
 
-  void handleCustomerIDResponse(String tx, String rx)
+  void handleCustomerIDResponse(const PacketView &tx, const PacketView &rx)
   {
     customerID = WBusInfoDecoder::decodeCustomerID(rx);
     eventBus.publish(EventType::CUSTOMER_ID, customerID);
   }
 
-  void handleSerialNumberResponse(String tx, String rx)
+  void handleSerialNumberResponse(const PacketView &tx, const PacketView &rx)
   {
     serialNumber = WBusInfoDecoder::decodeSerialNumber(rx);
     eventBus.publish(EventType::SERIAL_NUMBER, serialNumber);
@@ -6,6 +6,7 @@
 #include "../infrastructure/protocol/WBusErrorDetailsDecoder.h"
 #include "../infrastructure/protocol/WBusCommandBuilder.h"
 #include "../application/CommandManager.h"
+#include "../application/DecoderRegistry.h"
 
 class ErrorsManager : public IErrorsManager
 {
@@ -28,7 +29,7 @@ public:
 
   void resetErrors() override
   {
-    commandManager.addPriorityCommand(WBusCommandBuilder::createClearErrors(), false, [this](String tx, String rx)
+    commandManager.addPriorityCommand(WBusCommandBuilder::createClearErrors(), false, [this](const PacketView &tx, const PacketView &rx)
                                       { commandManager.addPriorityCommand(WBusCommandBuilder::createReadErrors()); });
   }
 
@@ -39,7 +40,20 @@ public:
 
   // =========================================================================
 
-  void handleCheckErrorsResponse(String tx, String rx, bool needReadDetails = false)
+  // Декодеры ответов 0x56; readDetails - запрашивать ли детали найденных ошибок
+  void registerDecoders(DecoderRegistry &registry, std::function<bool()> readDetails)
+  {
+    const uint8_t cmd = WBusCommandBuilder::CMD_READ_ERRORS;
+
+    registry.add(cmd, WBusCommandBuilder::ERROR_READ_LIST, [this, readDetails](const PacketView &tx, const PacketView &rx)
+                 { handleCheckErrorsResponse(tx, rx, readDetails && readDetails()); });
+    registry.add(cmd, WBusCommandBuilder::ERROR_READ_DETAILS, [this](const PacketView &tx, const PacketView &rx)
+                 { handleErrorDetailsResponse(tx, rx, rx.at(4)); });
+    registry.add(cmd, WBusCommandBuilder::ERROR_CLEAR, [this](const PacketView &tx, const PacketView &rx)
+                 { handleResetErrorsResponse(tx, rx); });
+  }
+
+  void handleCheckErrorsResponse(const PacketView &tx, const PacketView &rx, bool needReadDetails = false)
   {
     currentErrors = errorsDecoder.decodeErrorPacket(rx);
     eventBus.publish<ErrorCollection>(EventType::WBUS_ERRORS, currentErrors);
@@ -59,13 +73,13 @@ public:
     }
   }
 
-  void handleResetErrorsResponse(String tx, String rx)
+  void handleResetErrorsResponse(const PacketView &tx, const PacketView &rx)
   {
     currentErrors.clear();
     eventBus.publish<ErrorCollection>(EventType::WBUS_ERRORS, currentErrors);
   }
 
-  void handleErrorDetailsResponse(String tx, String rx, uint8_t errorCode, std::function<void(String, String, ErrorDetails *)> callback = nullptr)
+  void handleErrorDetailsResponse(const PacketView &tx, const PacketView &rx, uint8_t errorCode, std::function<void(const PacketView &, const PacketView &, ErrorDetails *)> callback = nullptr)
   {
     ErrorDetails details = errorDetailsDecoder.decode(rx, errorCode);
     eventBus.publish<ErrorDetails>(EventType::WBUS_DETAILS_ERROR, details);
@@ -7,6 +7,8 @@
 #include "../application/DeviceInfoManager.h"
 #include "../application/SensorManager.h"
 #include "../application/ErrorsManager.h"
+#include "../application/DecoderRegistry.h"
+#include "../application/SequenceRunner.h"
 #include "../interfaces/IBusManager.h"
 #include "../domain/Events.h"
 
@@ -21,16 +23,26 @@ private:
     ErrorsManager &errorsManager;
 
     HeaterStatus currentStatus;
+    bool reconnectOnRecovery = false; // Подключение потеряно из-за недоступности шины
+
+    SequenceRunner sequenceRunner; // Подключение, самотест, чтение ошибок
+
+    static const uint32_t SNAPSHOT_TIMEOUT_MS = 30000;   // Первый полный снимок датчиков после подключения
+    static const uint32_t SELF_TEST_TIMEOUT_MS = 120000; // Весь самотест
+    static const uint32_t DRAIN_TIMEOUT_MS = 15000;      // Дочитывание деталей ошибок
+    static const uint8_t SELF_TEST_SECONDS = 5;          // Работа каждого компонента при самотесте
 
 public:
     HeaterController(
-        EventBus &bus, CommandManager &cmdManager, IBusManager &busMgr, DeviceInfoManager &deviceInfoMngr, SensorManager &sensorMngr, ErrorsManager &errorsMngr)
+        EventBus &bus, CommandManager &cmdManager, IBusManager &busMgr, DeviceInfoManager &deviceInfoMngr, SensorManager &sensorMngr, ErrorsManager &errorsMngr,
+        IClock &clock)
         : eventBus(bus),
           commandManager(cmdManager),
           busManager(busMgr),
           deviceInfoManager(deviceInfoMngr),
           sensorManager(sensorMngr),
-          errorsManager(errorsMngr)
+          errorsManager(errorsMngr),
+          sequenceRunner(cmdManager, busMgr, clock)
     {
         currentStatus.state = WebastoState::OFF;
         currentStatus.connection = ConnectionState::DISCONNECTED;
@@ -40,10 +52,11 @@ public:
     {
         neopixelWrite(RGB_PIN, 0, 0, 0);
 
-        eventBus.subscribe(EventType::COMMAND_SENT_ERRROR, [this](const Event &event)
+        // Отказ одной команды не разрывает подключение - только недоступность шины
+        eventBus.subscribe(EventType::BUS_HEALTH_CHANGED, [this](const Event &event)
                            {
-        setState(WebastoState::OFF);
-        setConnectionState(ConnectionState::DISCONNECTED); });
+        const auto &healthEvent = static_cast<const TypedEvent<BusHealthChangedEvent> &>(event);
+        handleBusHealthChanged(healthEvent.data.oldState, healthEvent.data.newState); });
 
         eventBus.subscribe(EventType::SENSOR_STATUS_FLAGS, [this](const Event &event)
                            {
@@ -59,29 +72,43 @@ public:
     // УПРАВЛЕНИЕ ПОДКЛЮЧЕНИЕМ
     // =========================================================================
 
-    void connect() override
+    CommandHandle connect() override
     {
         if (currentStatus.connection == ConnectionState::CONNECTING)
         {
             Serial.println("⚠️  Подключение уже выполняется...");
-            return;
+            return CommandHandle();
         }
 
-        setConnectionState(ConnectionState::CONNECTING);
+        reconnectOnRecovery = false;
+        commandManager.resetBusHealth();
 
-        busManager.sendBreak();
-
-        // Запрашиваем основную информацию об устройстве
-        deviceInfoManager.requestWBusVersion();
-        deviceInfoManager.requestDeviceName();
-        deviceInfoManager.requestWBusCode();
+        setConnectionState(ConnectionState::CONNECTING);
 
-        // Запускаем диагностику
-        if (!commandManager.addCommand(WBusCommandBuilder::createDiagnostic(), false, [this](String tx, String rx)
-                                       { handleDiagnosticResponse(tx, rx); }))
-        {
-            setConnectionState(ConnectionState::DISCONNECTED);
-        }
+        // Основная информация и диагностика -> остальная информация и опрос -> первый полный снимок
+        sequenceRunner.prepare("connect")
+            .breakSignal()
+            .send("wbus_version", WBusCommandBuilder::createReadInfo(WBusCommandBuilder::INFO_WBUS_VERSION))
+            .send("device_name", WBusCommandBuilder::createReadInfo(WBusCommandBuilder::INFO_DEVICE_NAME))
+            .send("wbus_code", WBusCommandBuilder::createReadInfo(WBusCommandBuilder::INFO_WBUS_CODE))
+            .send("diagnostic", WBusCommandBuilder::createDiagnostic(), true)
+            .stage()
+            .call("connected", [this]()
+                  { setConnectionState(ConnectionState::CONNECTED); })
+            .send("device_id", WBusCommandBuilder::createReadInfo(WBusCommandBuilder::INFO_DEVICE_ID))
+            .send("controller_date", WBusCommandBuilder::createReadInfo(WBusCommandBuilder::INFO_CTRL_MFG_DATE))
+            .send("heater_date", WBusCommandBuilder::createReadInfo(WBusCommandBuilder::INFO_HEATER_MFG_DATE))
+            .send("customer_id", WBusCommandBuilder::createReadInfo(WBusCommandBuilder::INFO_CUSTOMER_ID))
+            .send("serial_number", WBusCommandBuilder::createReadInfo(WBusCommandBuilder::INFO_SERIAL_NUMBER))
+            .call("polling", [this]()
+                  { startPolling(); })
+            .stage()
+            .snapshot(SNAPSHOT_TIMEOUT_MS);
+
+        sequenceRunner.start([this](const SequenceReport &report)
+                             { handleConnectFinished(report); });
+
+        return sequenceRunner.getStepHandle("diagnostic");
     }
 
     bool isConnected()
@@ -91,6 +118,8 @@ public:
 
     void disconnect() override
     {
+        reconnectOnRecovery = false;
+        sequenceRunner.cancel();
         commandManager.clear();
         setConnectionState(ConnectionState::DISCONNECTED);
     }
@@ -99,147 +128,220 @@ public:
     // ОСНОВНЫЕ КОМАНДЫ УПРАВЛЕНИЯ
     // =========================================================================
 
-    void startParkingHeat(int minutes = 59) override
+    CommandHandle startParkingHeat(int minutes = 59) override
     {
         breakIfNeeded();
 
-        commandManager.addPriorityCommand(WBusCommandBuilder::createParkHeat(minutes), false, [this](String tx, String rx)
+        return commandManager.addPriorityCommand(WBusCommandBuilder::createParkHeat(minutes), false, [this](const PacketView &tx, const PacketView &rx)
                                           { sensorManager.requestStatusFlags(); });
     }
 
-    void startVentilation(int minutes = 59) override
+    CommandHandle startVentilation(int minutes = 59) override
     {
         breakIfNeeded();
 
-        commandManager.addPriorityCommand(WBusCommandBuilder::createVentilation(minutes), false, [this](String tx, String rx)
+        return commandManager.addPriorityCommand(WBusCommandBuilder::createVentilation(minutes), false, [this](const PacketView &tx, const PacketView &rx)
                                           { sensorManager.requestStatusFlags(); });
     }
 
-    void startSupplementalHeat(int minutes = 59) override
+    CommandHandle startSupplementalHeat(int minutes = 59) override
     {
         breakIfNeeded();
 
-        commandManager.addPriorityCommand(WBusCommandBuilder::createSupplementalHeat(minutes), false, [this](String tx, String rx)
+        return commandManager.addPriorityCommand(WBusCommandBuilder::createSupplementalHeat(minutes), false, [this](const PacketView &tx, const PacketView &rx)
                                           { sensorManager.requestStatusFlags(); });
     }
 
-    void startBoostMode(int minutes = 59) override
+    CommandHandle startBoostMode(int minutes = 59) override
     {
         breakIfNeeded();
 
-        commandManager.addPriorityCommand(WBusCommandBuilder::createBoostMode(minutes), false, [this](String tx, String rx)
+        return commandManager.addPriorityCommand(WBusCommandBuilder::createBoostMode(minutes), false, [this](const PacketView &tx, const PacketView &rx)
                                           { sensorManager.requestStatusFlags(); });
     }
 
-    void controlCirculationPump(bool enable) override
+    CommandHandle controlCirculationPump(bool enable) override
     {
         breakIfNeeded();
 
-        commandManager.addPriorityCommand(WBusCommandBuilder::createCirculationPumpControl(enable), false, [this](String tx, String rx)
+        return commandManager.addPriorityCommand(WBusCommandBuilder::createCirculationPumpControl(enable), false, [this](const PacketView &tx, const PacketView &rx)
                                           { sensorManager.requestStatusFlags(); });
     }
 
-    void fuelCirculation(int seconds) override
+    CommandHandle fuelCirculation(int seconds) override
     {
         breakIfNeeded();
 
-        commandManager.addPriorityCommand(WBusCommandBuilder::createFuelCirculation(seconds), false, [this](String tx, String rx)
+        return commandManager.addPriorityCommand(WBusCommandBuilder::createFuelCirculation(seconds), false, [this](const PacketView &tx, const PacketView &rx)
                                           { sensorManager.requestStatusFlags(); });
     }
 
-    void shutdown() override
+    CommandHandle shutdown() override
     {
         breakIfNeeded();
 
-        commandManager.addPriorityCommand(WBusCommandBuilder::createShutdown(), false);
+        return commandManager.addSafetyCommand(WBusCommandBuilder::createShutdown());
     }
 
     // =========================================================================
     // ТЕСТИРОВАНИЕ КОМПОНЕНТОВ
     // =========================================================================
 
-    void testCombustionFan(int seconds, int powerPercent) override
+    CommandHandle testCombustionFan(int seconds, int powerPercent) override
     {
         breakIfNeeded();
 
-        commandManager.addPriorityCommand(WBusCommandBuilder::createTestCombustionFan(seconds, powerPercent), false,
-                                          [this](String tx, String rx)
+        return commandManager.addPriorityCommand(WBusCommandBuilder::createTestCombustionFan(seconds, powerPercent), false,
+                                          [this](const PacketView &tx, const PacketView &rx)
                                           {
                                               sensorManager.requestStatusFlags();
                                           });
     }
 
-    void testFuelPump(int seconds, int frequencyHz) override
+    CommandHandle testFuelPump(int seconds, int frequencyHz) override
     {
         breakIfNeeded();
 
-        commandManager.addPriorityCommand(WBusCommandBuilder::createTestFuelPump(seconds, frequencyHz), false,
-                                          [this](String tx, String rx)
+        return commandManager.addPriorityCommand(WBusCommandBuilder::createTestFuelPump(seconds, frequencyHz), false,
+                                          [this](const PacketView &tx, const PacketView &rx)
                                           {
                                               sensorManager.requestStatusFlags();
                                           });
     }
 
-    void testGlowPlug(int seconds, int powerPercent) override
+    CommandHandle testGlowPlug(int seconds, int powerPercent) override
     {
         breakIfNeeded();
 
-        commandManager.addPriorityCommand(WBusCommandBuilder::createTestGlowPlug(seconds, powerPercent),
+        return commandManager.addPriorityCommand(WBusCommandBuilder::createTestGlowPlug(seconds, powerPercent),
                                           false,
-                                          [this](String tx, String rx)
+                                          [this](const PacketView &tx, const PacketView &rx)
                                           {
                                               sensorManager.requestStatusFlags();
                                           });
     }
 
-    void testCirculationPump(int seconds) override
+    CommandHandle testCirculationPump(int seconds) override
     {
         breakIfNeeded();
 
-        commandManager.addPriorityCommand(WBusCommandBuilder::createTestCirculationPump(seconds), false,
+        return commandManager.addPriorityCommand(WBusCommandBuilder::createTestCirculationPump(seconds), false,
 
-                                          [this](String tx, String rx)
+                                          [this](const PacketView &tx, const PacketView &rx)
                                           {
                                               sensorManager.requestStatusFlags();
                                           });
     }
 
-    void testVehicleFan(int seconds) override
+    CommandHandle testVehicleFan(int seconds) override
     {
         breakIfNeeded();
 
-        commandManager.addPriorityCommand(WBusCommandBuilder::createTestVehicleFan(seconds),
+        return commandManager.addPriorityCommand(WBusCommandBuilder::createTestVehicleFan(seconds),
                                           false,
-                                          [this](String tx, String rx)
+                                          [this](const PacketView &tx, const PacketView &rx)
                                           {
                                               sensorManager.requestStatusFlags();
                                           });
     }
 
-    void testSolenoidValve(int seconds) override
+    CommandHandle testSolenoidValve(int seconds) override
     {
         breakIfNeeded();
 
-        commandManager.addPriorityCommand(WBusCommandBuilder::createTestSolenoidValve(seconds),
+        return commandManager.addPriorityCommand(WBusCommandBuilder::createTestSolenoidValve(seconds),
                                           false,
-                                          [this](String tx, String rx)
+                                          [this](const PacketView &tx, const PacketView &rx)
                                           {
                                               sensorManager.requestStatusFlags();
                                           });
     }
 
-    void testFuelPreheating(int seconds, int powerPercent) override
+    CommandHandle testFuelPreheating(int seconds, int powerPercent) override
     {
         breakIfNeeded();
 
-        commandManager.addPriorityCommand(WBusCommandBuilder::createTestFuelPreheating(seconds, powerPercent),
+        return commandManager.addPriorityCommand(WBusCommandBuilder::createTestFuelPreheating(seconds, powerPercent),
                                           false,
-                                          [this](String tx, String rx)
+                                          [this](const PacketView &tx, const PacketView &rx)
                                           {
                                               sensorManager.requestStatusFlags();
                                           });
     }
 
+    // =========================================================================
+    // ПОСЛЕДОВАТЕЛЬНОСТИ
+    // =========================================================================
+
+    // Поочередная проверка компонентов (кроме топливного насоса: без горения
+    // он заливает камеру) с последующим чтением статуса и ошибок
+    bool runSelfTest()
+    {
+        if (sequenceRunner.isRunning())
+        {
+            Serial.println("⚠️  Последовательность уже выполняется");
+            return false;
+        }
+
+        Sequence &sequence = sequenceRunner.prepare("self-test", SELF_TEST_TIMEOUT_MS);
+        if (!isConnected())
+            sequence.breakSignal();
+
+        const CommandClass control = CommandClass::CONTROL;
+        const uint32_t runMs = SELF_TEST_SECONDS * 1000UL;
+
+        sequence.send("combustion_fan", WBusCommandBuilder::createTestCombustionFan(SELF_TEST_SECONDS, 30), false, 0, control)
+            .delay("combustion_fan_run", runMs)
+            .send("glow_plug", WBusCommandBuilder::createTestGlowPlug(SELF_TEST_SECONDS, 50), false, 0, control)
+            .delay("glow_plug_run", runMs)
+            .send("circulation_pump", WBusCommandBuilder::createTestCirculationPump(SELF_TEST_SECONDS), false, 0, control)
+            .delay("circulation_pump_run", runMs)
+            .send("vehicle_fan", WBusCommandBuilder::createTestVehicleFan(SELF_TEST_SECONDS), false, 0, control)
+            .delay("vehicle_fan_run", runMs)
+            .send("solenoid", WBusCommandBuilder::createTestSolenoidValve(SELF_TEST_SECONDS), false, 0, control)
+            .delay("solenoid_run", runMs)
+            .send("fuel_preheating", WBusCommandBuilder::createTestFuelPreheating(SELF_TEST_SECONDS, 50), false, 0, control)
+            .delay("fuel_preheating_run", runMs)
+            .send("status_flags", WBusCommandBuilder::createReadSensor(WBusCommandBuilder::SENSOR_STATUS_FLAGS), false, 0, control)
+            .send("errors", WBusCommandBuilder::createReadErrors(), true, 0, control)
+            .stage()
+            .drain(DRAIN_TIMEOUT_MS);
+
+        sequenceRunner.start();
+        return true;
+    }
+
+    // Чтение ошибок вместе с деталями каждой (детали запрашивает декодер)
+    bool runErrorReadout()
+    {
+        if (sequenceRunner.isRunning())
+        {
+            Serial.println("⚠️  Последовательность уже выполняется");
+            return false;
+        }
+
+        Sequence &sequence = sequenceRunner.prepare("errors");
+        if (!isConnected())
+            sequence.breakSignal();
+
+        sequence.send("errors", WBusCommandBuilder::createReadErrors(), true, 0, CommandClass::CONTROL)
+            .stage()
+            .drain(DRAIN_TIMEOUT_MS);
+
+        sequenceRunner.start();
+        return true;
+    }
+
+    void process()
+    {
+        sequenceRunner.process();
+    }
+
+    String getSequencesJson() const
+    {
+        return sequenceRunner.toJson();
+    }
+
     void checkWebastoStatus()
     {
         breakIfNeeded();
@@ -261,30 +363,74 @@ public:
 
     // =========================================================================
 
-    void handleDiagnosticResponse(String tx, String rx)
-    {
-        if (!rx.isEmpty())
-        {
-            setConnectionState(ConnectionState::CONNECTED);
-
-            // Успешное подключение - запрашиваем остальную информацию
-            deviceInfoManager.requestDeviceID();
-            deviceInfoManager.requestControllerManufactureDate();
-            deviceInfoManager.requestHeaterManufactureDate();
-            deviceInfoManager.requestCustomerID();
-            deviceInfoManager.requestSerialNumber();
+    // Декодеры ответов на команды управления и тестирования.
+    // Параметры (минуты, секунды, величина) берутся из кадра запроса.
+    void registerDecoders(DecoderRegistry &registry)
+    {
+        registry.add(WBusCommandBuilder::CMD_SHUTDOWN, [this](const PacketView &tx, const PacketView &rx)
+                     { handleShutdownResponse(tx, rx); });
+        registry.add(WBusCommandBuilder::CMD_PARK_HEAT, [this](const PacketView &tx, const PacketView &rx)
+                     { handleStartParkingHeatResponse(tx, rx, tx.at(3)); });
+        registry.add(WBusCommandBuilder::CMD_VENTILATE, [this](const PacketView &tx, const PacketView &rx)
+                     { handleStartVentilationResponse(tx, rx, tx.at(3)); });
+        registry.add(WBusCommandBuilder::CMD_SUPP_HEAT, [this](const PacketView &tx, const PacketView &rx)
+                     { handleStartSupplementalHeatResponse(tx, rx, tx.at(3)); });
+        registry.add(WBusCommandBuilder::CMD_BOOST_MODE, [this](const PacketView &tx, const PacketView &rx)
+                     { handleStartBoostModeResponse(tx, rx, tx.at(3)); });
+        registry.add(WBusCommandBuilder::CMD_CIRC_PUMP_CTRL, [this](const PacketView &tx, const PacketView &rx)
+                     { handleControlCirculationPumpResponse(tx, rx, tx.at(3) != 0x00); });
+        registry.add(WBusCommandBuilder::CMD_FUEL_CIRCULATION, [this](const PacketView &tx, const PacketView &rx)
+                     { handleFuelCirculation(tx, rx, tx.at(5) * 2 + 1); });
+
+        // Тестирование компонентов (0x45) - по индексу компонента
+        const uint8_t test = WBusCommandBuilder::CMD_TEST_COMPONENT;
+
+        registry.add(test, WBusCommandBuilder::TEST_COMBUSTION_FAN, [this](const PacketView &tx, const PacketView &rx)
+                     {
+                         auto info = TestComponentConverter::decodeTestCommand(tx);
+                         handleTestCombustionFanResponse(tx, rx, info.seconds, TestComponentConverter::combustionFanMagnitudeToPercent(info.magnitude)); });
+        registry.add(test, WBusCommandBuilder::TEST_FUEL_PUMP, [this](const PacketView &tx, const PacketView &rx)
+                     {
+                         auto info = TestComponentConverter::decodeTestCommand(tx);
+                         handleTestFuelPumpResponse(tx, rx, info.seconds, TestComponentConverter::fuelPumpMagnitudeToHz(info.magnitude)); });
+        registry.add(test, WBusCommandBuilder::TEST_GLOW_PLUG, [this](const PacketView &tx, const PacketView &rx)
+                     {
+                         auto info = TestComponentConverter::decodeTestCommand(tx);
+                         handleTestGlowPlugResponse(tx, rx, info.seconds, TestComponentConverter::glowPlugMagnitudeToPercent(info.magnitude)); });
+        registry.add(test, WBusCommandBuilder::TEST_CIRCULATION_PUMP, [this](const PacketView &tx, const PacketView &rx)
+                     { handleTestCirculationPumpResponse(tx, rx, TestComponentConverter::decodeTestCommand(tx).seconds); });
+        registry.add(test, WBusCommandBuilder::TEST_VEHICLE_FAN, [this](const PacketView &tx, const PacketView &rx)
+                     { handleTestVehicleFanResponse(tx, rx, TestComponentConverter::decodeTestCommand(tx).seconds); });
+        registry.add(test, WBusCommandBuilder::TEST_SOLENOID_VALVE, [this](const PacketView &tx, const PacketView &rx)
+                     { handleTestSolenoidValveResponse(tx, rx, TestComponentConverter::decodeTestCommand(tx).seconds); });
+        registry.add(test, WBusCommandBuilder::TEST_FUEL_PREHEATING, [this](const PacketView &tx, const PacketView &rx)
+                     {
+                         auto info = TestComponentConverter::decodeTestCommand(tx);
+                         handleTestFuelPreheatingResponse(tx, rx, info.seconds, TestComponentConverter::fuelPreheatingMagnitudeToPercent(info.magnitude)); });
+    }
+
+    // Запускаем периодический опрос сенсоров
+    void startPolling()
+    {
+        sensorManager.probeMultiRead();
+        errorsManager.checkErrors(true);
+        sensorManager.requestAllSensorData(true);
+    }
+
+    void handleConnectFinished(const SequenceReport &report)
+    {
+        // Отключение и недоступность шины меняют состояние сами
+        if (currentStatus.connection != ConnectionState::CONNECTING || report.state != SequenceState::ABORTED)
+            return;
 
-            // Запускаем периодический опрос сенсоров
-            errorsManager.checkErrors(true);
-            sensorManager.requestAllSensorData(true);
-        }
+        // Диагностика не принята в очередь - как и раньше, просто не подключены
+        if (report.abort == SequenceAbort::STEP_REJECTED)
+            setConnectionState(ConnectionState::DISCONNECTED);
         else
-        {
             setConnectionState(ConnectionState::CONNECTION_FAILED);
-        }
     }
 
-    void handleStartParkingHeatResponse(String tx, String rx, int minutes)
+    void handleStartParkingHeatResponse(const PacketView &tx, const PacketView &rx, int minutes)
     {
         if (!rx.isEmpty())
         {
@@ -301,7 +447,7 @@ public:
         }
     }
 
-    void handleStartVentilationResponse(String tx, String rx, int minutes)
+    void handleStartVentilationResponse(const PacketView &tx, const PacketView &rx, int minutes)
     {
         if (!rx.isEmpty())
         {
@@ -318,7 +464,7 @@ public:
         }
     }
 
-    void handleStartSupplementalHeatResponse(String tx, String rx, int minutes)
+    void handleStartSupplementalHeatResponse(const PacketView &tx, const PacketView &rx, int minutes)
     {
         if (!rx.isEmpty())
         {
@@ -335,7 +481,7 @@ public:
         }
     }
 
-    void handleStartBoostModeResponse(String tx, String rx, int minutes)
+    void handleStartBoostModeResponse(const PacketView &tx, const PacketView &rx, int minutes)
     {
         if (!rx.isEmpty())
         {
@@ -352,7 +498,7 @@ public:
         }
     }
 
-    void handleControlCirculationPumpResponse(String tx, String rx, bool enable)
+    void handleControlCirculationPumpResponse(const PacketView &tx, const PacketView &rx, bool enable)
     {
         if (!rx.isEmpty())
         {
@@ -369,7 +515,7 @@ public:
         }
     }
 
-    void handleShutdownResponse(String tx, String rx)
+    void handleShutdownResponse(const PacketView &tx, const PacketView &rx)
     {
         if (!rx.isEmpty())
         {
@@ -381,7 +527,7 @@ public:
         }
     }
 
-    void handleFuelCirculation(String tx, String rx, int seconds)
+    void handleFuelCirculation(const PacketView &tx, const PacketView &rx, int seconds)
     {
         if (!rx.isEmpty())
         {
@@ -394,7 +540,7 @@ public:
         }
     }
 
-    void handleTestCombustionFanResponse(String tx, String rx, int seconds, int powerPercent)
+    void handleTestCombustionFanResponse(const PacketView &tx, const PacketView &rx, int seconds, int powerPercent)
     {
         if (!rx.isEmpty())
         {
@@ -409,7 +555,7 @@ public:
         }
     }
 
-    void handleTestFuelPumpResponse(String tx, String rx, int seconds, int frequencyHz)
+    void handleTestFuelPumpResponse(const PacketView &tx, const PacketView &rx, int seconds, int frequencyHz)
     {
         if (!rx.isEmpty())
         {
@@ -423,7 +569,7 @@ public:
         }
     }
 
-    void handleTestGlowPlugResponse(String tx, String rx, int seconds, int powerPercent)
+    void handleTestGlowPlugResponse(const PacketView &tx, const PacketView &rx, int seconds, int powerPercent)
     {
         if (!rx.isEmpty())
         {
@@ -437,7 +583,7 @@ public:
         }
     }
 
-    void handleTestCirculationPumpResponse(String tx, String rx, int seconds)
+    void handleTestCirculationPumpResponse(const PacketView &tx, const PacketView &rx, int seconds)
     {
         if (!rx.isEmpty())
         {
@@ -451,7 +597,7 @@ public:
         }
     }
 
-    void handleTestVehicleFanResponse(String tx, String rx, int seconds)
+    void handleTestVehicleFanResponse(const PacketView &tx, const PacketView &rx, int seconds)
     {
         if (!rx.isEmpty())
         {
@@ -465,7 +611,7 @@ public:
         }
     }
 
-    void handleTestSolenoidValveResponse(String tx, String rx, int seconds)
+    void handleTestSolenoidValveResponse(const PacketView &tx, const PacketView &rx, int seconds)
     {
         if (!rx.isEmpty())
         {
@@ -479,7 +625,7 @@ public:
         }
     }
 
-    void handleTestFuelPreheatingResponse(String tx, String rx, int seconds, int powerPercent)
+    void handleTestFuelPreheatingResponse(const PacketView &tx, const PacketView &rx, int seconds, int powerPercent)
     {
         if (!rx.isEmpty())
         {
@@ -494,6 +640,22 @@ public:
     }
 
 private:
+    void handleBusHealthChanged(BusHealth oldHealth, BusHealth newHealth)
+    {
+        if (newHealth == BusHealth::DOWN)
+        {
+            reconnectOnRecovery = currentStatus.connection == ConnectionState::CONNECTED;
+            setState(WebastoState::OFF);
+            setConnectionState(ConnectionState::DISCONNECTED);
+        }
+        else if (oldHealth == BusHealth::DOWN && reconnectOnRecovery)
+        {
+            // Шина восстановилась сама - подключаемся заново
+            reconnectOnRecovery = false;
+            connect();
+        }
+    }
+
     void updateHeaterStateFromStatusFlags(StatusFlags *status)
     {
         WebastoState newState = determineStateFromFlags(status);
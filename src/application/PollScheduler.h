@@ -0,0 +1,442 @@
+// src/application/PollScheduler.h
+#pragma once
+#include <Arduino.h>
+#include "./CommandQueue.h"
+#include "../common/WBusFrame.h"
+#include "../common/PacketView.h"
+#include "../domain/Entities.h"
+#include "../infrastructure/protocol/WBusCommandBuilder.h"
+#include "../infrastructure/protocol/WBusMultiReadDecoder.h"
+
+// Группы периодического опроса, период каждой задается в BusConfig
+enum class PollGroup
+{
+    STATUS,   // Статус-флаги - определение состояния нагревателя
+    FAST,     // Рабочие измерения, состояние, подсистемы
+    SLOW,     // Ошибки, подогрев топлива
+    COUNTERS  // Счетчики запусков, наработка
+};
+
+// Планировщик периодического опроса: ближайший дедлайн первым (EDF)
+// с ограничением доли времени шины, отдаваемой опросу.
+class PollScheduler
+{
+public:
+    static const size_t MAX_ENTRIES = 16;
+    static const uint32_t MAX_BURST_MS = 2000; // Максимальный запас бюджета
+    static const uint8_t MAX_CONSECUTIVE_NAKS = 8; // NAK подряд, после которых страница снимается с опроса
+    static const uint8_t MAX_NAK_BACKOFF_SHIFT = 3; // Период после NAK растет не больше чем в 8 раз
+
+    using PollCallback = CommandCallback;
+
+private:
+    struct Entry
+    {
+        bool used = false;
+        bool inFlight = false;
+        WBusFrame frame;
+        PollGroup group = PollGroup::FAST;
+        PollCallback callback;
+        unsigned long nextDue = 0;
+
+        uint32_t polls = 0;
+        uint32_t answers = 0;       // Получено ответов на страницу
+        uint8_t naks = 0;           // NAK подряд (сбрасывается ответом)
+        uint32_t maxLatenessMs = 0; // Максимальное опоздание относительно дедлайна
+    };
+
+    Entry entries[MAX_ENTRIES];
+
+    // Бюджет шины (мс): пополняется на budget% прошедшего времени,
+    // расходуется на фактическую длительность транзакций опроса
+    int32_t budgetMs = 0;
+    unsigned long lastBudgetUpdate = 0;
+    uint32_t budgetSkips = 0;
+
+    // В групповое чтение попадают страницы 0x50 с известной длиной и без своего обработчика
+    static bool isBatchable(const Entry &entry)
+    {
+        return !entry.callback &&
+               entry.frame.getCommand() == WBusCommandBuilder::CMD_READ_SENSOR &&
+               WBusMultiReadDecoder::pageCost(entry.frame.getIndex()) > 0;
+    }
+
+    uint32_t periodFor(PollGroup group, const BusConfig &config) const
+    {
+        switch (group)
+        {
+        case PollGroup::STATUS:
+            return config.pollStatusPeriod;
+        case PollGroup::FAST:
+            return config.pollFastPeriod;
+        case PollGroup::SLOW:
+            return config.pollSlowPeriod;
+        case PollGroup::COUNTERS:
+            return config.pollCountersPeriod;
+        }
+        return config.pollFastPeriod;
+    }
+
+    static const char *groupName(PollGroup group)
+    {
+        switch (group)
+        {
+        case PollGroup::STATUS:
+            return "status";
+        case PollGroup::FAST:
+            return "fast";
+        case PollGroup::SLOW:
+            return "slow";
+        case PollGroup::COUNTERS:
+            return "counters";
+        }
+        return "unknown";
+    }
+
+    // Бюджет через elapsed мс. Ограничен только запас сверху: долг любой
+    // величины гасится за конечное время, и nextDueAt() не ждет вечно
+    int32_t budgetAfter(unsigned long elapsed, uint8_t budgetPercent) const
+    {
+        int64_t budget = budgetMs + static_cast<int64_t>(elapsed) * budgetPercent / 100;
+        return budget > (int64_t)MAX_BURST_MS ? (int32_t)MAX_BURST_MS : static_cast<int32_t>(budget);
+    }
+
+    void refillBudget(unsigned long now, uint8_t budgetPercent)
+    {
+        budgetMs = budgetAfter(now - lastBudgetUpdate, budgetPercent);
+        lastBudgetUpdate = now;
+    }
+
+public:
+    // Группа по умолчанию для страницы опроса
+    static PollGroup groupFor(const WBusFrame &frame)
+    {
+        uint8_t command = frame.getCommand();
+        uint8_t index = frame.getIndex();
+
+        if (command == WBusCommandBuilder::CMD_READ_ERRORS)
+            return PollGroup::SLOW;
+
+        if (command != WBusCommandBuilder::CMD_READ_SENSOR)
+            return PollGroup::FAST;
+
+        switch (index)
+        {
+        case WBusCommandBuilder::SENSOR_STATUS_FLAGS:
+            return PollGroup::STATUS;
+        case WBusCommandBuilder::SENSOR_FUEL_PREWARMING:
+            return PollGroup::SLOW;
+        case WBusCommandBuilder::SENSOR_FUEL_SETTINGS:
+        case WBusCommandBuilder::SENSOR_OPERATING_TIMES:
+        case WBusCommandBuilder::SENSOR_BURNING_DURATION:
+        case WBusCommandBuilder::SENSOR_START_COUNTERS:
+            return PollGroup::COUNTERS;
+        default:
+            return PollGroup::FAST;
+        }
+    }
+
+    // Добавление (или обновление) периодического запроса; первый опрос - сразу
+    bool add(const WBusFrame &frame, PollGroup group, unsigned long now, PollCallback callback = nullptr)
+    {
+        Entry *freeEntry = nullptr;
+
+        for (size_t i = 0; i < MAX_ENTRIES; i++)
+        {
+            Entry &entry = entries[i];
+            if (entry.used && entry.frame == frame)
+            {
+                entry.group = group;
+                entry.callback = callback;
+                return true;
+            }
+            if (!entry.used && !freeEntry)
+                freeEntry = &entry;
+        }
+
+        if (!freeEntry)
+        {
+            Serial.println("⚠️  Планировщик опроса заполнен: " + frame.toHexString());
+            return false;
+        }
+
+        *freeEntry = Entry();
+        freeEntry->used = true;
+        freeEntry->frame = frame;
+        freeEntry->group = group;
+        freeEntry->callback = callback;
+        freeEntry->nextDue = now;
+        return true;
+    }
+
+    // Когда next() сможет выдать страницу: ближайший дедлайн, но не раньше
+    // восстановления бюджета. false - опрашивать нечего (все в полете или пусто)
+    bool nextDueAt(unsigned long now, const BusConfig &config, unsigned long &at) const
+    {
+        bool found = false;
+        for (size_t i = 0; i < MAX_ENTRIES; i++)
+        {
+            const Entry &entry = entries[i];
+            if (!entry.used || entry.inFlight)
+                continue;
+
+            if (!found || (long)(entry.nextDue - at) < 0)
+                at = entry.nextDue;
+            found = true;
+        }
+
+        // Без бюджета next() ничего не выдает
+        if (!found || config.pollBusBudget == 0)
+            return false;
+
+        // Бюджет на момент now (как в refillBudget, без изменения состояния)
+        int32_t budget = budgetAfter(now - lastBudgetUpdate, config.pollBusBudget);
+
+        // Округление вверх: refillBudget отбрасывает дробную часть, раннее пробуждение ничего не выдаст
+        if (budget <= 0)
+        {
+            unsigned long deficit = static_cast<unsigned long>(1 - budget);
+            unsigned long refilledAt = now + (deficit * 100 + config.pollBusBudget - 1) / config.pollBusBudget;
+            if ((long)(refilledAt - at) > 0)
+                at = refilledAt;
+        }
+        return true;
+    }
+
+    // Ближайший просроченный запрос с учетом бюджета шины, -1 если опрашивать нечего
+    int next(unsigned long now, const BusConfig &config)
+    {
+        refillBudget(now, config.pollBusBudget);
+
+        int best = -1;
+        for (size_t i = 0; i < MAX_ENTRIES; i++)
+        {
+            const Entry &entry = entries[i];
+            if (!entry.used || entry.inFlight || (long)(now - entry.nextDue) < 0)
+                continue;
+
+            if (best < 0 || (long)(entry.nextDue - entries[best].nextDue) < 0)
+                best = i;
+        }
+
+        if (best < 0)
+            return -1;
+
+        if (budgetMs <= 0)
+        {
+            budgetSkips++;
+            return -1;
+        }
+
+        Entry &entry = entries[best];
+        entry.inFlight = true;
+        entry.polls++;
+        uint32_t lateness = now - entry.nextDue;
+        if (lateness > entry.maxLatenessMs)
+            entry.maxLatenessMs = lateness;
+        return best;
+    }
+
+    // Групповое чтение: к уже выбранной странице first добавляются другие
+    // просроченные страницы 0x50 (по дедлайну), пока ответ помещается в payloadBudget байт.
+    // Возвращает маску слотов; 0 - страница first для группового чтения не подходит.
+    uint16_t collectSensorBatch(int first, unsigned long now, size_t payloadBudget)
+    {
+        if (!isBatchable(entries[first]))
+            return 0;
+
+        uint16_t mask = 1u << first;
+        size_t used = WBusMultiReadDecoder::pageCost(entries[first].frame.getIndex());
+
+        while (true)
+        {
+            int best = -1;
+            for (size_t i = 0; i < MAX_ENTRIES; i++)
+            {
+                const Entry &entry = entries[i];
+                if (!entry.used || entry.inFlight || (long)(now - entry.nextDue) < 0 || !isBatchable(entry))
+                    continue;
+
+                if (used + WBusMultiReadDecoder::pageCost(entry.frame.getIndex()) > payloadBudget)
+                    continue;
+
+                if (best < 0 || (long)(entry.nextDue - entries[best].nextDue) < 0)
+                    best = i;
+            }
+
+            if (best < 0)
+                break;
+
+            Entry &entry = entries[best];
+            entry.inFlight = true;
+            entry.polls++;
+            uint32_t lateness = now - entry.nextDue;
+            if (lateness > entry.maxLatenessMs)
+                entry.maxLatenessMs = lateness;
+
+            used += WBusMultiReadDecoder::pageCost(entry.frame.getIndex());
+            mask |= 1u << best;
+        }
+
+        return mask;
+    }
+
+    const WBusFrame &getFrame(int slot) const { return entries[slot].frame; }
+    const PollCallback &getCallback(int slot) const { return entries[slot].callback; }
+
+    // Транзакция завершена (ответ, NAK или отказ после повторов)
+    void complete(int slot, unsigned long startedAt, unsigned long now, const BusConfig &config)
+    {
+        if (slot < 0 || slot >= (int)MAX_ENTRIES || !entries[slot].used)
+            return;
+
+        Entry &entry = entries[slot];
+        entry.inFlight = false;
+
+        // Период отсчитывается от дедлайна, без накопления дрейфа;
+        // после долгого простоя - от текущего момента
+        uint32_t period = periodFor(entry.group, config);
+        entry.nextDue += period;
+        if ((long)(now - entry.nextDue) > 0)
+            entry.nextDue = now + period;
+
+        budgetMs -= static_cast<int32_t>(now - startedAt);
+    }
+
+    // Запрос не отправлен (очередь сброшена) - дедлайн не сдвигается
+    void release(int slot)
+    {
+        if (slot >= 0 && slot < (int)MAX_ENTRIES)
+            entries[slot].inFlight = false;
+    }
+
+    void remove(int slot)
+    {
+        if (slot >= 0 && slot < (int)MAX_ENTRIES)
+            entries[slot] = Entry();
+    }
+
+    // Групповое чтение завершено: каждая страница переносится на свой следующий дедлайн,
+    // бюджет расходуется один раз на всю транзакцию
+    void completeBatch(uint16_t mask, unsigned long startedAt, unsigned long now, const BusConfig &config)
+    {
+        for (size_t i = 0; i < MAX_ENTRIES; i++)
+        {
+            if (!(mask & (1u << i)) || !entries[i].used)
+                continue;
+
+            Entry &entry = entries[i];
+            entry.inFlight = false;
+
+            uint32_t period = periodFor(entry.group, config);
+            entry.nextDue += period;
+            if ((long)(now - entry.nextDue) > 0)
+                entry.nextDue = now + period;
+        }
+
+        budgetMs -= static_cast<int32_t>(now - startedAt);
+    }
+
+    // Ответ на страницу получен (для группового чтения - на каждую из mask)
+    void recordAnswer(uint16_t mask)
+    {
+        for (size_t i = 0; i < MAX_ENTRIES; i++)
+        {
+            if ((mask & (1u << i)) && entries[i].used)
+            {
+                entries[i].answers++;
+                entries[i].naks = 0;
+            }
+        }
+    }
+
+    // NAK на страницу, которую устройство в целом поддерживает (например,
+    // недопустима в текущем состоянии): следующий опрос откладывается,
+    // период удваивается на каждый NAK подряд. После MAX_CONSECUTIVE_NAKS
+    // страница снимается с опроса. Вызывается после complete(). true - снята
+    bool recordNak(int slot, unsigned long now, const BusConfig &config)
+    {
+        if (slot < 0 || slot >= (int)MAX_ENTRIES || !entries[slot].used)
+            return false;
+
+        Entry &entry = entries[slot];
+        if (++entry.naks >= MAX_CONSECUTIVE_NAKS)
+        {
+            remove(slot);
+            return true;
+        }
+
+        uint8_t shift = entry.naks < MAX_NAK_BACKOFF_SHIFT ? entry.naks : MAX_NAK_BACKOFF_SHIFT;
+        entry.nextDue = now + (periodFor(entry.group, config) << shift);
+        return false;
+    }
+
+    // Полный снимок: каждая страница опроса получила хотя бы один ответ
+    bool isSnapshotComplete() const
+    {
+        bool any = false;
+        for (size_t i = 0; i < MAX_ENTRIES; i++)
+        {
+            if (!entries[i].used)
+                continue;
+            if (entries[i].answers == 0)
+                return false;
+            any = true;
+        }
+        return any;
+    }
+
+    bool hasEntries() const
+    {
+        for (size_t i = 0; i < MAX_ENTRIES; i++)
+        {
+            if (entries[i].used)
+                return true;
+        }
+        return false;
+    }
+
+    void clear()
+    {
+        for (size_t i = 0; i < MAX_ENTRIES; i++)
+            entries[i] = Entry();
+        budgetMs = 0;
+        budgetSkips = 0;
+    }
+
+    String toJson(const BusConfig &config, unsigned long now) const
+    {
+        String json = "{";
+        json += "\"budgetPercent\":" + String(config.pollBusBudget) + ",";
+        json += "\"budgetMs\":" + String(budgetMs) + ",";
+        json += "\"budgetSkips\":" + String(budgetSkips) + ",";
+        json += "\"entries\":[";
+
+        bool first = true;
+        for (size_t i = 0; i < MAX_ENTRIES; i++)
+        {
+            const Entry &entry = entries[i];
+            if (!entry.used)
+                continue;
+
+            if (!first)
+                json += ",";
+            first = false;
+
+            json += "{";
+            json += "\"frame\":\"" + entry.frame.toHexString() + "\",";
+            json += "\"name\":\"" + WBusCommandBuilder::getIndexName(entry.frame.getCommand(), entry.frame.getIndex()) + "\",";
+            json += "\"group\":\"" + String(groupName(entry.group)) + "\",";
+            json += "\"periodMs\":" + String(periodFor(entry.group, config)) + ",";
+            json += "\"dueInMs\":" + String((long)(entry.nextDue - now)) + ",";
+            json += "\"polls\":" + String(entry.polls) + ",";
+            json += "\"answers\":" + String(entry.answers) + ",";
+            json += "\"naks\":" + String(entry.naks) + ",";
+            json += "\"maxLatenessMs\":" + String(entry.maxLatenessMs);
+            json += "}";
+        }
+
+        json += "]}";
+        return json;
+    }
+};
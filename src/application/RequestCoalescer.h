@@ -0,0 +1,162 @@
+// src/application/RequestCoalescer.h
+#pragma once
+#include <Arduino.h>
+#include "./CommandQueue.h"
+#include "./CommandCompletion.h"
+#include "../common/WBusFrame.h"
+#include "../common/PacketView.h"
+#include "../infrastructure/protocol/WBusMultiReadDecoder.h"
+
+// Объединение одинаковых запросов: повторный запрос кадра, который уже стоит
+// в очереди или ждет ответа, не отправляется - его обработчик ждет здесь
+// и получает тот же ответ. Страница 0x50 ждет и в групповом чтении,
+// где она запрошена вместе с другими.
+class RequestCoalescer
+{
+public:
+    static const size_t CAPACITY = 16;
+
+private:
+    struct Waiter
+    {
+        bool used = false;
+        WBusFrame frame;
+        CommandCallback callback;
+        CommandHandle completion;
+    };
+
+    CompletionTable &completions;
+    Waiter waiters[CAPACITY];
+
+    uint32_t attached = 0;
+    uint32_t resolved = 0;
+    uint32_t dropped = 0;
+    uint32_t overflows = 0;
+
+    static bool sameFrame(const WBusFrame &frame, const PacketView &view)
+    {
+        return frame.size() == view.size() && memcmp(frame.data(), view.data(), frame.size()) == 0;
+    }
+
+    // Групповое чтение batch содержит страницу page (F4 03 50 idx cs)
+    static bool batchCovers(const WBusFrame &batch, const WBusFrame &page)
+    {
+        if (!WBusMultiReadDecoder::isMultiRead(batch.view()) ||
+            page.getCommand() != WBusCommandBuilder::CMD_READ_SENSOR || page.size() != 5)
+            return false;
+
+        for (size_t i = 4; i + 1 < batch.size(); i++)
+        {
+            if (batch.data()[i] == page.getIndex())
+                return true;
+        }
+        return false;
+    }
+
+    void resolveExact(const PacketView &tx, const PacketView &rx, unsigned long now)
+    {
+        for (size_t i = 0; i < CAPACITY; i++)
+        {
+            Waiter &waiter = waiters[i];
+            if (!waiter.used || !sameFrame(waiter.frame, tx))
+                continue;
+
+            // Слот освобождается до вызова: обработчик может добавить новый запрос
+            CommandCallback callback = std::move(waiter.callback);
+            completions.complete(waiter.completion, rx, now);
+            waiter = Waiter();
+            resolved++;
+
+            if (callback)
+                callback(tx, rx);
+        }
+    }
+
+public:
+    RequestCoalescer(CompletionTable &completionTable) : completions(completionTable) {}
+
+    // Ответ на pending покрывает запрос frame
+    static bool covers(const WBusFrame &pending, const WBusFrame &frame)
+    {
+        return pending == frame || batchCovers(pending, frame);
+    }
+
+    // Обработчик забирается только при успехе; при переполнении остается у вызывающего
+    bool attach(const WBusFrame &frame, CommandCallback &callback, const CommandHandle &completion)
+    {
+        for (size_t i = 0; i < CAPACITY; i++)
+        {
+            if (waiters[i].used)
+                continue;
+
+            waiters[i].used = true;
+            waiters[i].frame = frame;
+            waiters[i].callback = std::move(callback);
+            waiters[i].completion = completion;
+            attached++;
+            return true;
+        }
+
+        overflows++;
+        return false;
+    }
+
+    // Раздача ответа всем ожидающим, для группового чтения - по страницам
+    void resolve(const PacketView &tx, const PacketView &rx, unsigned long now)
+    {
+        resolveExact(tx, rx, now);
+
+        if (WBusMultiReadDecoder::isMultiRead(tx) && !rx.isNak())
+        {
+            WBusMultiReadDecoder::split(tx, rx, [this, now](const PacketView &pageTx, const PacketView &pageRx)
+                                        { resolveExact(pageTx, pageRx, now); });
+        }
+    }
+
+    // Транзакция не удалась: ожидающие ее запросы отбрасываются, как и сама команда
+    void drop(const WBusFrame &tx, unsigned long now)
+    {
+        for (size_t i = 0; i < CAPACITY; i++)
+        {
+            if (waiters[i].used && covers(tx, waiters[i].frame))
+            {
+                completions.fail(waiters[i].completion, CommandOutcome::TIMEOUT, now);
+                waiters[i] = Waiter();
+                dropped++;
+            }
+        }
+    }
+
+    void clear(unsigned long now)
+    {
+        for (size_t i = 0; i < CAPACITY; i++)
+        {
+            completions.fail(waiters[i].completion, CommandOutcome::CANCELLED, now);
+            waiters[i] = Waiter();
+        }
+    }
+
+    size_t size() const
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < CAPACITY; i++)
+        {
+            if (waiters[i].used)
+                count++;
+        }
+        return count;
+    }
+
+    String toJson() const
+    {
+        String json = "{";
+        json += "\"waiting\":" + String(size()) + ",";
+        json += "\"capacity\":" + String(CAPACITY) + ",";
+        json += "\"attached\":" + String(attached) + ",";
+        json += "\"resolved\":" + String(resolved) + ",";
+        json += "\"dropped\":" + String(dropped) + ",";
+        json += "\"overflows\":" + String(overflows);
+        json += "}";
+        return json;
+    }
+};
@@ -0,0 +1,200 @@
+// src/application/RttEstimator.h
+#pragma once
+#include <Arduino.h>
+#include "../domain/Entities.h"
+#include "../infrastructure/protocol/WBusCommandBuilder.h"
+
+// Классы команд с разным временем ответа: длина ответа и время
+// обработки на стороне нагревателя у них заметно различаются
+enum class RttClass : uint8_t
+{
+    SENSOR,  // 0x50 - чтение датчиков
+    INFO,    // 0x51 - информация об устройстве
+    ERRORS,  // 0x56 - ошибки
+    CONTROL, // Управление, keep-alive, тесты
+    COUNT
+};
+
+// Оценка времени ответа по классам команд (как RTO в TCP, RFC 6298):
+//   SRTT   = 7/8 SRTT + 1/8 R
+//   RTTVAR = 3/4 RTTVAR + 1/4 |SRTT - R|
+//   таймаут = SRTT + 4 * RTTVAR, удваивается после каждого таймаута.
+// Замеры повторных отправок не учитываются (алгоритм Карна).
+// Для ответа переменной длины (групповое чтение) время приема его данных
+// replyWireUs вычитается из замера и добавляется к таймауту сверх границ,
+// чтобы длинные ответы не раздували оценку короткого одиночного чтения.
+class RttEstimator
+{
+public:
+    static const uint8_t MAX_BACKOFF_SHIFT = 4;
+
+private:
+    struct State
+    {
+        bool primed = false;
+        uint32_t srttUs = 0;
+        uint32_t rttvarUs = 0;
+        uint32_t lastUs = 0;
+        uint32_t samples = 0;
+        uint32_t timeouts = 0;
+        uint8_t backoffShift = 0;
+    };
+
+    State states[static_cast<size_t>(RttClass::COUNT)];
+
+    static uint32_t clampMs(uint32_t value, uint32_t low, uint32_t high)
+    {
+        if (high < low)
+            high = low;
+        if (value < low)
+            return low;
+        if (value > high)
+            return high;
+        return value;
+    }
+
+    State &stateFor(uint8_t command)
+    {
+        return states[static_cast<size_t>(classFor(command))];
+    }
+
+    const State &stateFor(uint8_t command) const
+    {
+        return states[static_cast<size_t>(classFor(command))];
+    }
+
+    static uint32_t timeoutFor(const State &state, const BusConfig &config)
+    {
+        if (!state.primed)
+            return config.commandTimeout;
+
+        uint32_t rtoUs = state.srttUs + 4 * state.rttvarUs;
+        uint32_t rtoMs = (rtoUs + 999) / 1000;
+        return clampMs(rtoMs << state.backoffShift, config.minCommandTimeout, config.commandTimeout);
+    }
+
+    // Пауза после ответа: половина SRTT - нагреватель, отвечающий медленно,
+    // получает больше времени на обработку перед следующим запросом
+    static uint32_t gapFor(const State &state, const BusConfig &config)
+    {
+        if (!state.primed)
+            return config.queueInterval;
+
+        return clampMs(state.srttUs / 2000, config.minQueueInterval, config.queueInterval);
+    }
+
+    static const char *className(size_t index)
+    {
+        switch (static_cast<RttClass>(index))
+        {
+        case RttClass::SENSOR:
+            return "sensor";
+        case RttClass::INFO:
+            return "info";
+        case RttClass::ERRORS:
+            return "errors";
+        case RttClass::CONTROL:
+            return "control";
+        default:
+            return "unknown";
+        }
+    }
+
+public:
+    static RttClass classFor(uint8_t command)
+    {
+        switch (command & 0x7F)
+        {
+        case WBusCommandBuilder::CMD_READ_SENSOR:
+            return RttClass::SENSOR;
+        case WBusCommandBuilder::CMD_READ_INFO:
+            return RttClass::INFO;
+        case WBusCommandBuilder::CMD_READ_ERRORS:
+            return RttClass::ERRORS;
+        default:
+            return RttClass::CONTROL;
+        }
+    }
+
+    // Замер времени от конца передачи запроса до конца приема ответа
+    void addSample(uint8_t command, uint32_t rttUs, uint32_t replyWireUs = 0)
+    {
+        State &state = stateFor(command);
+        rttUs = rttUs > replyWireUs ? rttUs - replyWireUs : 0;
+
+        if (!state.primed)
+        {
+            state.srttUs = rttUs;
+            state.rttvarUs = rttUs / 2;
+            state.primed = true;
+        }
+        else
+        {
+            uint32_t delta = state.srttUs > rttUs ? state.srttUs - rttUs : rttUs - state.srttUs;
+            state.rttvarUs = state.rttvarUs - state.rttvarUs / 4 + delta / 4;
+            state.srttUs = state.srttUs - state.srttUs / 8 + rttUs / 8;
+        }
+
+        state.lastUs = rttUs;
+        state.samples++;
+        state.backoffShift = 0;
+    }
+
+    // Таймаут без ответа - следующая попытка ждет вдвое дольше
+    void onTimeout(uint8_t command)
+    {
+        State &state = stateFor(command);
+        state.timeouts++;
+        if (state.backoffShift < MAX_BACKOFF_SHIFT)
+            state.backoffShift++;
+    }
+
+    uint32_t getTimeoutMs(uint8_t command, const BusConfig &config, uint32_t replyWireUs = 0) const
+    {
+        return timeoutFor(stateFor(command), config) + (replyWireUs + 999) / 1000;
+    }
+
+    uint32_t getGapMs(uint8_t command, const BusConfig &config) const
+    {
+        return gapFor(stateFor(command), config);
+    }
+
+    void reset()
+    {
+        for (size_t i = 0; i < static_cast<size_t>(RttClass::COUNT); i++)
+            states[i] = State();
+    }
+
+    String toJson(const BusConfig &config) const
+    {
+        String json = "{";
+        json += "\"bounds\":{";
+        json += "\"minTimeoutMs\":" + String(config.minCommandTimeout) + ",";
+        json += "\"maxTimeoutMs\":" + String(config.commandTimeout) + ",";
+        json += "\"minGapMs\":" + String(config.minQueueInterval) + ",";
+        json += "\"maxGapMs\":" + String(config.queueInterval);
+        json += "},\"classes\":[";
+
+        for (size_t i = 0; i < static_cast<size_t>(RttClass::COUNT); i++)
+        {
+            const State &state = states[i];
+            if (i > 0)
+                json += ",";
+
+            json += "{";
+            json += "\"class\":\"" + String(className(i)) + "\",";
+            json += "\"samples\":" + String(state.samples) + ",";
+            json += "\"timeouts\":" + String(state.timeouts) + ",";
+            json += "\"srttMs\":" + String(state.srttUs / 1000.0f, 1) + ",";
+            json += "\"rttvarMs\":" + String(state.rttvarUs / 1000.0f, 1) + ",";
+            json += "\"lastMs\":" + String(state.lastUs / 1000.0f, 1) + ",";
+            json += "\"backoff\":" + String(1 << state.backoffShift) + ",";
+            json += "\"timeoutMs\":" + String(timeoutFor(state, config)) + ",";
+            json += "\"gapMs\":" + String(gapFor(state, config));
+            json += "}";
+        }
+
+        json += "]}";
+        return json;
+    }
+};
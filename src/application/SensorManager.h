@@ -12,7 +12,9 @@
 #include "../infrastructure/protocol/WBusFuelPrewarmingDecoder.h"
 #include "../infrastructure/protocol/WBusBurningDurationDecoder.h"
 #include "../infrastructure/protocol/WBusStartCountersDecoder.h"
+#include "../infrastructure/protocol/WBusMultiReadDecoder.h"
 #include "../application/CommandManager.h"
+#include "../application/DecoderRegistry.h"
 #include "../domain/Events.h"
 
 class SensorManager : public ISensorManager
@@ -32,6 +34,8 @@ private:
     SubsystemsStatus subsystemsStatus;
     FuelPrewarming fuelPrewarming;
 
+    bool multiReadProbed = false;
+
 public:
     SensorManager(EventBus &bus, CommandManager &cmdManager)
         : eventBus(bus), commandManager(cmdManager)
@@ -44,10 +48,10 @@ public:
         requestOnOffFlags(loop);
         requestFuelSettings();
         requestOperationalInfo(loop);
-        requestOperatingTimes();
+        requestOperatingTimes(loop);
         requestOperatingState(loop);
-        requestBurningDuration();
-        requestStartCounters();
+        requestBurningDuration(loop);
+        requestStartCounters(loop);
         requestSubsystemsStatus(loop);
         requestFuelPrewarming(loop);
     }
@@ -129,62 +133,123 @@ public:
 
     // =========================================================================
 
-    void handleStatusFlagsResponse(String tx, String rx)
+    // Декодеры ответов 0x50 по индексу датчика
+    void registerDecoders(DecoderRegistry &registry)
+    {
+        const uint8_t cmd = WBusCommandBuilder::CMD_READ_SENSOR;
+
+        registry.add(cmd, WBusCommandBuilder::SENSOR_STATUS_FLAGS, [this](const PacketView &tx, const PacketView &rx)
+                     { handleStatusFlagsResponse(tx, rx); });
+        registry.add(cmd, WBusCommandBuilder::SENSOR_ON_OFF_FLAGS, [this](const PacketView &tx, const PacketView &rx)
+                     { handleOnOffFlagsResponse(tx, rx); });
+        registry.add(cmd, WBusCommandBuilder::SENSOR_FUEL_SETTINGS, [this](const PacketView &tx, const PacketView &rx)
+                     { handleFuelSettingsResponse(tx, rx); });
+        registry.add(cmd, WBusCommandBuilder::SENSOR_OPERATIONAL, [this](const PacketView &tx, const PacketView &rx)
+                     { handleOperationalInfoResponse(tx, rx); });
+        registry.add(cmd, WBusCommandBuilder::SENSOR_OPERATING_TIMES, [this](const PacketView &tx, const PacketView &rx)
+                     { handleOperatingTimesResponse(tx, rx); });
+        registry.add(cmd, WBusCommandBuilder::SENSOR_OPERATING_STATE, [this](const PacketView &tx, const PacketView &rx)
+                     { handleOperatingStateResponse(tx, rx); });
+        registry.add(cmd, WBusCommandBuilder::SENSOR_BURNING_DURATION, [this](const PacketView &tx, const PacketView &rx)
+                     { handleBurningDurationResponse(tx, rx); });
+        registry.add(cmd, WBusCommandBuilder::SENSOR_START_COUNTERS, [this](const PacketView &tx, const PacketView &rx)
+                     { handleStartCountersResponse(tx, rx); });
+        registry.add(cmd, WBusCommandBuilder::SENSOR_SUBSYSTEMS_STATUS, [this](const PacketView &tx, const PacketView &rx)
+                     { handleSubsystemsStatusResponse(tx, rx); });
+        registry.add(cmd, WBusCommandBuilder::SENSOR_FUEL_PREWARMING, [this](const PacketView &tx, const PacketView &rx)
+                     { handleFuelPrewarmingResponse(tx, rx); });
+
+        // Групповое чтение раскладывается по обработчикам страниц
+        registry.add(cmd, WBusCommandBuilder::SENSOR_MULTI_READ, [this, &registry](const PacketView &tx, const PacketView &rx)
+                     { handleMultiReadResponse(tx, rx, registry); });
+    }
+
+    // Проверка поддержки группового чтения - один раз за подключение.
+    // До ответа (и при его отсутствии) опрос идет по одной странице.
+    void probeMultiRead()
+    {
+        if (multiReadProbed)
+            return;
+
+        multiReadProbed = true;
+        commandManager.setMultiReadSupported(false);
+
+        static const uint8_t probePages[] = {WBusCommandBuilder::SENSOR_STATUS_FLAGS, WBusCommandBuilder::SENSOR_OPERATIONAL};
+        commandManager.addCommand(WBusCommandBuilder::createMultiReadSensor(probePages, sizeof(probePages)), false,
+                                  [this](const PacketView &tx, const PacketView &rx)
+                                  { commandManager.setMultiReadSupported(WBusMultiReadDecoder::isValidResponse(tx, rx)); });
+    }
+
+    void handleMultiReadResponse(const PacketView &tx, const PacketView &rx, const DecoderRegistry &registry)
+    {
+        if (rx.isNak())
+            return;
+
+        bool parsed = WBusMultiReadDecoder::split(tx, rx, [&registry](const PacketView &pageTx, const PacketView &pageRx)
+                                                  { registry.dispatch(pageTx, pageRx); });
+        if (!parsed)
+        {
+            Serial.println("⚠️  Ответ группового чтения не разобран: " + rx.toHexString());
+            commandManager.setMultiReadSupported(false);
+        }
+    }
+
+    void handleStatusFlagsResponse(const PacketView &tx, const PacketView &rx)
     {
         if (!rx.isEmpty())
             statusFlags = WBusStatusFlagsDecoder::decode(rx);
         eventBus.publish<StatusFlags>(EventType::SENSOR_STATUS_FLAGS, statusFlags);
     }
 
-    void handleOnOffFlagsResponse(String tx, String rx)
+    void handleOnOffFlagsResponse(const PacketView &tx, const PacketView &rx)
     {
         onOffFlags = WBusOnOffFlagsDecoder::decode(rx);
         eventBus.publish<OnOffFlags>(EventType::SENSOR_ON_OFF_FLAGS, onOffFlags);
     }
 
-    void handleFuelSettingsResponse(String tx, String rx)
+    void handleFuelSettingsResponse(const PacketView &tx, const PacketView &rx)
     {
         fuelSettings = WBusFuelSettingsDecoder::decode(rx);
         eventBus.publish<FuelSettings>(EventType::FUEL_SETTINGS, fuelSettings);
     }
 
-    void handleOperationalInfoResponse(String tx, String rx)
+    void handleOperationalInfoResponse(const PacketView &tx, const PacketView &rx)
     {
         operationalMeasurements = WBusOperationalInfoDecoder::decode(rx);
         eventBus.publish<OperationalMeasurements>(EventType::SENSOR_OPERATIONAL_INFO, operationalMeasurements);
     }
 
-    void handleOperatingTimesResponse(String tx, String rx)
+    void handleOperatingTimesResponse(const PacketView &tx, const PacketView &rx)
     {
         operatingTimes = WBusOperatingTimesDecoder::decode(rx);
         eventBus.publish<OperatingTimes>(EventType::SENSOR_OPERATING_TIMES, operatingTimes);
     }
 
-    void handleOperatingStateResponse(String tx, String rx)
+    void handleOperatingStateResponse(const PacketView &tx, const PacketView &rx)
     {
         operatingState = WBusOperatingStateDecoder::decode(rx);
         eventBus.publish<OperatingState>(EventType::SENSOR_OPERATING_STATE, operatingState);
     }
 
-    void handleBurningDurationResponse(String tx, String rx)
+    void handleBurningDurationResponse(const PacketView &tx, const PacketView &rx)
     {
         burningDuration = WBusBurningDurationDecoder::decode(rx);
         eventBus.publish<BurningDuration>(EventType::BURNING_DURATION_STATS, burningDuration);
     }
 
-    void handleStartCountersResponse(String tx, String rx)
+    void handleStartCountersResponse(const PacketView &tx, const PacketView &rx)
     {
         startCounters = WBusStartCountersDecoder::decode(rx);
         eventBus.publish<StartCounters>(EventType::START_COUNTERS, startCounters);
     }
 
-    void handleSubsystemsStatusResponse(String tx, String rx)
+    void handleSubsystemsStatusResponse(const PacketView &tx, const PacketView &rx)
     {
         subsystemsStatus = WBusSubSystemsDecoder::decode(rx);
         eventBus.publish<SubsystemsStatus>(EventType::SENSOR_SUBSYSTEM_STATE, subsystemsStatus);
     }
 
-    void handleFuelPrewarmingResponse(String tx, String rx)
+    void handleFuelPrewarmingResponse(const PacketView &tx, const PacketView &rx)
     {
         fuelPrewarming = WBusFuelPrewarmingDecoder::decode(rx);
         eventBus.publish<FuelPrewarming>(EventType::FUEL_PREWARMING, fuelPrewarming);
@@ -230,5 +295,8 @@ public:
         startCounters = StartCounters{};
         subsystemsStatus = SubsystemsStatus{};
         fuelPrewarming = FuelPrewarming{};
+
+        multiReadProbed = false;
+        commandManager.setMultiReadSupported(false);
     }
 };
\ No newline at end of file
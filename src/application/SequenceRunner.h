@@ -0,0 +1,709 @@
+// src/application/SequenceRunner.h
+#pragma once
+#include <Arduino.h>
+#include "./CommandManager.h"
+#include "../common/InlineFunction.h"
+#include "../common/WBusFrame.h"
+#include "../interfaces/IBusManager.h"
+#include "../interfaces/IClock.h"
+
+// Вид шага последовательности
+enum class StepKind : uint8_t
+{
+    BREAK,    // BREAK на шине перед обменом
+    SEND,     // Разовая команда, ждем ее итог
+    POLL,     // Постановка страницы в периодический опрос
+    CALL,     // Действие контроллера (смена состояния, запуск опроса)
+    DELAY,    // Пауза timeoutMs
+    SNAPSHOT, // Ждем ответа на каждую страницу опроса
+    DRAIN     // Ждем, пока будут отправлены все разовые команды (опрос не учитывается)
+};
+
+enum class StepState : uint8_t
+{
+    WAITING,
+    RUNNING,
+    DONE,
+    FAILED,
+    SKIPPED
+};
+
+enum class SequenceState : uint8_t
+{
+    IDLE,
+    RUNNING,
+    COMPLETED,
+    ABORTED
+};
+
+// Причина прерывания последовательности
+enum class SequenceAbort : uint8_t
+{
+    NONE,
+    STEP_FAILED,   // Обязательный шаг получил NAK/таймаут/отмену
+    STEP_REJECTED, // Обязательная команда не принята в очередь
+    STEP_TIMEOUT,  // Обязательный шаг не уложился в свой таймаут
+    BUS_DOWN,      // Шина признана недоступной
+    CANCELLED      // Прервана вызывающим (отключение, новая последовательность)
+};
+
+using SequenceCall = InlineFunction<void(), 2 * sizeof(void *)>;
+
+// Шаг последовательности. Шаги одного этапа (stage) запускаются вместе,
+// следующий этап начинается, когда завершены все шаги текущего.
+struct SequenceStep
+{
+    const char *name = "";
+    StepKind kind = StepKind::SEND;
+    uint8_t stage = 0;
+    bool required = false;  // Отказ шага прерывает последовательность
+    uint32_t timeoutMs = 0; // 0 - без собственного таймаута; для DELAY - длительность
+    WBusFrame frame;
+    CommandClass commandClass = CommandClass::INTERACTIVE;
+    SequenceCall call;
+
+    StepState state = StepState::WAITING;
+    CommandOutcome outcome = CommandOutcome::PENDING;
+    CommandHandle handle;
+    unsigned long startedAt = 0;
+    unsigned long finishedAt = 0;
+};
+
+// Описание многошагового обмена (подключение, самотест, чтение ошибок).
+// Заполняется цепочкой вызовов:
+//   sequence.breakSignal().send("diagnostic", frame, true).stage().call("connected", fn);
+class Sequence
+{
+public:
+    static const size_t MAX_STEPS = 24;
+
+private:
+    const char *name = "";
+    SequenceStep steps[MAX_STEPS];
+    size_t count = 0;
+    uint8_t currentStage = 0;
+    uint32_t timeoutMs = 0;
+
+    SequenceStep *append(const char *stepName, StepKind kind)
+    {
+        if (count >= MAX_STEPS)
+        {
+            Serial.println("❌ Последовательность " + String(name) + ": превышено число шагов");
+            return nullptr;
+        }
+
+        SequenceStep &step = steps[count++];
+        step = SequenceStep();
+        step.name = stepName;
+        step.kind = kind;
+        step.stage = currentStage;
+        return &step;
+    }
+
+    friend class SequenceRunner;
+
+public:
+    void reset(const char *sequenceName, uint32_t sequenceTimeoutMs)
+    {
+        name = sequenceName;
+        count = 0;
+        currentStage = 0;
+        timeoutMs = sequenceTimeoutMs;
+    }
+
+    // Следующие шаги начнутся после завершения всех предыдущих
+    Sequence &stage()
+    {
+        if (count > 0 && steps[count - 1].stage == currentStage)
+            currentStage++;
+        return *this;
+    }
+
+    Sequence &breakSignal()
+    {
+        append("break", StepKind::BREAK);
+        return stage();
+    }
+
+    Sequence &send(const char *stepName, const WBusFrame &frame, bool required = false,
+                   uint32_t stepTimeoutMs = 0, CommandClass commandClass = CommandClass::INTERACTIVE)
+    {
+        SequenceStep *step = append(stepName, StepKind::SEND);
+        if (step)
+        {
+            step->frame = frame;
+            step->required = required;
+            step->timeoutMs = stepTimeoutMs;
+            step->commandClass = commandClass;
+        }
+        return *this;
+    }
+
+    Sequence &poll(const char *stepName, const WBusFrame &frame)
+    {
+        SequenceStep *step = append(stepName, StepKind::POLL);
+        if (step)
+            step->frame = frame;
+        return *this;
+    }
+
+    Sequence &call(const char *stepName, SequenceCall function)
+    {
+        SequenceStep *step = append(stepName, StepKind::CALL);
+        if (step)
+            step->call = std::move(function);
+        return *this;
+    }
+
+    Sequence &delay(const char *stepName, uint32_t durationMs)
+    {
+        SequenceStep *step = append(stepName, StepKind::DELAY);
+        if (step)
+            step->timeoutMs = durationMs;
+        return stage();
+    }
+
+    Sequence &snapshot(uint32_t stepTimeoutMs, bool required = false)
+    {
+        SequenceStep *step = append("snapshot", StepKind::SNAPSHOT);
+        if (step)
+        {
+            step->timeoutMs = stepTimeoutMs;
+            step->required = required;
+        }
+        return stage();
+    }
+
+    Sequence &drain(uint32_t stepTimeoutMs)
+    {
+        SequenceStep *step = append("drain", StepKind::DRAIN);
+        if (step)
+            step->timeoutMs = stepTimeoutMs;
+        return stage();
+    }
+
+    const char *getName() const { return name; }
+    size_t size() const { return count; }
+};
+
+// Краткий итог выполненной последовательности для /api/sequences
+struct SequenceReport
+{
+    struct Step
+    {
+        const char *name = "";
+        StepKind kind = StepKind::SEND;
+        uint8_t stage = 0;
+        StepState state = StepState::WAITING;
+        CommandOutcome outcome = CommandOutcome::PENDING;
+        uint32_t startMs = 0;
+        uint32_t durationMs = 0;
+    };
+
+    const char *name = "";
+    SequenceState state = SequenceState::IDLE;
+    SequenceAbort abort = SequenceAbort::NONE;
+    const char *abortStep = "";
+    uint32_t durationMs = 0;
+    unsigned long finishedAt = 0;
+    Step steps[Sequence::MAX_STEPS];
+    size_t count = 0;
+};
+
+// Выполнение последовательностей: одна активная, шаги ведутся из process().
+// Итоги команд берутся по дескрипторам CommandManager, длительность шагов
+// и всей последовательности замеряется. Отдельно учитывается время
+// от начала подключения до первого полного снимка датчиков.
+class SequenceRunner
+{
+public:
+    static const size_t MAX_REPORTS = 4;
+
+    using FinishedCallback = InlineFunction<void(const SequenceReport &), 2 * sizeof(void *)>;
+
+private:
+    CommandManager &commandManager;
+    IBusManager &busManager;
+    IClock &clock;
+
+    Sequence sequence;
+    SequenceState state = SequenceState::IDLE;
+    SequenceAbort abortReason = SequenceAbort::NONE;
+    const char *abortStep = "";
+    uint8_t stage = 0;
+    unsigned long startedAt = 0;
+    FinishedCallback onFinished;
+
+    SequenceReport reports[MAX_REPORTS];
+
+    // Время до первого полного снимка датчиков (шаг SNAPSHOT)
+    uint32_t snapshotLastMs = 0;
+    uint32_t snapshotBestMs = 0;
+    uint32_t snapshotWorstMs = 0;
+    uint32_t snapshotSamples = 0;
+
+    static String stepKindName(StepKind kind)
+    {
+        switch (kind)
+        {
+        case StepKind::BREAK:
+            return "BREAK";
+        case StepKind::SEND:
+            return "SEND";
+        case StepKind::POLL:
+            return "POLL";
+        case StepKind::CALL:
+            return "CALL";
+        case StepKind::DELAY:
+            return "DELAY";
+        case StepKind::SNAPSHOT:
+            return "SNAPSHOT";
+        default:
+            return "DRAIN";
+        }
+    }
+
+    static String stepStateName(StepState stepState)
+    {
+        switch (stepState)
+        {
+        case StepState::RUNNING:
+            return "RUNNING";
+        case StepState::DONE:
+            return "DONE";
+        case StepState::FAILED:
+            return "FAILED";
+        case StepState::SKIPPED:
+            return "SKIPPED";
+        default:
+            return "WAITING";
+        }
+    }
+
+    static String sequenceStateName(SequenceState sequenceState)
+    {
+        switch (sequenceState)
+        {
+        case SequenceState::RUNNING:
+            return "RUNNING";
+        case SequenceState::COMPLETED:
+            return "COMPLETED";
+        case SequenceState::ABORTED:
+            return "ABORTED";
+        default:
+            return "IDLE";
+        }
+    }
+
+    static String abortName(SequenceAbort reason)
+    {
+        switch (reason)
+        {
+        case SequenceAbort::STEP_FAILED:
+            return "STEP_FAILED";
+        case SequenceAbort::STEP_REJECTED:
+            return "STEP_REJECTED";
+        case SequenceAbort::STEP_TIMEOUT:
+            return "STEP_TIMEOUT";
+        case SequenceAbort::BUS_DOWN:
+            return "BUS_DOWN";
+        case SequenceAbort::CANCELLED:
+            return "CANCELLED";
+        default:
+            return "NONE";
+        }
+    }
+
+    void finishStep(SequenceStep &step, StepState stepState, CommandOutcome outcome, unsigned long now)
+    {
+        step.state = stepState;
+        step.outcome = outcome;
+        step.finishedAt = now;
+
+        if (step.kind == StepKind::SNAPSHOT && stepState == StepState::DONE)
+            recordSnapshot(now - startedAt);
+
+        if (stepState == StepState::FAILED && step.required)
+        {
+            SequenceAbort reason = SequenceAbort::STEP_FAILED;
+            if (outcome == CommandOutcome::UNKNOWN)
+                reason = SequenceAbort::STEP_REJECTED;
+            else if (outcome == CommandOutcome::PENDING)
+                reason = SequenceAbort::STEP_TIMEOUT;
+            finish(SequenceState::ABORTED, reason, step.name, now);
+        }
+    }
+
+    void startStep(SequenceStep &step, unsigned long now)
+    {
+        step.state = StepState::RUNNING;
+        step.startedAt = now;
+
+        switch (step.kind)
+        {
+        case StepKind::BREAK:
+            // Выполняется драйвером из process(), шаг ждет его завершения
+            busManager.sendBreak();
+            break;
+
+        case StepKind::SEND:
+            step.handle = commandManager.addCommand(step.frame, step.commandClass);
+            if (!step.handle)
+                finishStep(step, StepState::FAILED, CommandOutcome::UNKNOWN, now);
+            break;
+
+        case StepKind::POLL:
+            if (commandManager.addPolling(step.frame))
+                finishStep(step, StepState::DONE, CommandOutcome::ACK, now);
+            else
+                finishStep(step, StepState::FAILED, CommandOutcome::UNKNOWN, now);
+            break;
+
+        case StepKind::CALL:
+            if (step.call)
+                step.call();
+            finishStep(step, StepState::DONE, CommandOutcome::ACK, clock.nowMs());
+            break;
+
+        default:
+            // BREAK, DELAY, SNAPSHOT, DRAIN проверяются в pollStep
+            break;
+        }
+    }
+
+    void pollStep(SequenceStep &step, unsigned long now)
+    {
+        bool expired = step.timeoutMs > 0 && (long)(now - step.startedAt - step.timeoutMs) >= 0;
+        if (step.timeoutMs > 0 && !expired)
+            clock.wakeAt(step.startedAt + step.timeoutMs);
+
+        switch (step.kind)
+        {
+        case StepKind::SEND:
+        {
+            CommandResult result = commandManager.getResult(step.handle);
+            if (result.outcome == CommandOutcome::ACK || result.outcome == CommandOutcome::UNKNOWN)
+            {
+                // UNKNOWN - итог не отслеживается (таблица результатов занята)
+                commandManager.releaseResult(step.handle);
+                finishStep(step, StepState::DONE, result.outcome, now);
+            }
+            else if (result.isDone())
+            {
+                commandManager.releaseResult(step.handle);
+                finishStep(step, StepState::FAILED, result.outcome, now);
+            }
+            else if (expired)
+            {
+                finishStep(step, StepState::FAILED, CommandOutcome::PENDING, now);
+            }
+            break;
+        }
+
+        case StepKind::BREAK:
+            if (!busManager.isBusy())
+                finishStep(step, StepState::DONE, CommandOutcome::ACK, now);
+            break;
+
+        case StepKind::DELAY:
+            if (expired)
+                finishStep(step, StepState::DONE, CommandOutcome::ACK, now);
+            break;
+
+        case StepKind::SNAPSHOT:
+            if (commandManager.isPollSnapshotComplete())
+                finishStep(step, StepState::DONE, CommandOutcome::ACK, now);
+            else if (expired)
+                finishStep(step, StepState::FAILED, CommandOutcome::PENDING, now);
+            break;
+
+        case StepKind::DRAIN:
+            if (commandManager.isForegroundIdle())
+                finishStep(step, StepState::DONE, CommandOutcome::ACK, now);
+            else if (expired)
+                finishStep(step, StepState::FAILED, CommandOutcome::PENDING, now);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    // Запуск шагов текущего этапа; пустые этапы пропускаются
+    void startStage(unsigned long now)
+    {
+        for (size_t i = 0; i < sequence.count && state == SequenceState::RUNNING; i++)
+        {
+            SequenceStep &step = sequence.steps[i];
+            if (step.stage == stage && step.state == StepState::WAITING)
+                startStep(step, now);
+        }
+    }
+
+    bool isStageDone() const
+    {
+        for (size_t i = 0; i < sequence.count; i++)
+        {
+            const SequenceStep &step = sequence.steps[i];
+            if (step.stage == stage && (step.state == StepState::WAITING || step.state == StepState::RUNNING))
+                return false;
+        }
+        return true;
+    }
+
+    bool hasStage(uint8_t index) const
+    {
+        for (size_t i = 0; i < sequence.count; i++)
+        {
+            if (sequence.steps[i].stage == index)
+                return true;
+        }
+        return false;
+    }
+
+    void advance(unsigned long now)
+    {
+        while (state == SequenceState::RUNNING && isStageDone())
+        {
+            if (!hasStage(stage + 1))
+            {
+                finish(SequenceState::COMPLETED, SequenceAbort::NONE, "", now);
+                return;
+            }
+
+            stage++;
+            startStage(now);
+        }
+    }
+
+    void recordSnapshot(uint32_t elapsedMs)
+    {
+        snapshotLastMs = elapsedMs;
+        if (snapshotSamples == 0 || elapsedMs < snapshotBestMs)
+            snapshotBestMs = elapsedMs;
+        if (elapsedMs > snapshotWorstMs)
+            snapshotWorstMs = elapsedMs;
+        snapshotSamples++;
+    }
+
+    void finish(SequenceState finalState, SequenceAbort reason, const char *stepName, unsigned long now)
+    {
+        state = finalState;
+        abortReason = reason;
+        abortStep = stepName;
+
+        for (size_t i = 0; i < sequence.count; i++)
+        {
+            SequenceStep &step = sequence.steps[i];
+            if (step.state == StepState::WAITING || step.state == StepState::RUNNING)
+            {
+                step.state = StepState::SKIPPED;
+                step.finishedAt = now;
+            }
+        }
+
+        SequenceReport &report = storeReport(now);
+
+        if (finalState == SequenceState::COMPLETED)
+            Serial.println("⏱️  Последовательность " + String(sequence.name) + ": " + String(report.durationMs) + " мс");
+        else
+            Serial.println("⛔ Последовательность " + String(sequence.name) + " прервана (" + abortName(reason) + "): " + String(stepName));
+
+        FinishedCallback callback = std::move(onFinished);
+        if (callback)
+            callback(report);
+    }
+
+    SequenceReport &storeReport(unsigned long now)
+    {
+        // Итог хранится по имени последовательности, новое имя вытесняет самый старый
+        size_t slot = 0;
+        for (size_t i = 0; i < MAX_REPORTS; i++)
+        {
+            if (strcmp(reports[i].name, sequence.name) == 0)
+            {
+                slot = i;
+                break;
+            }
+            if ((long)(reports[i].finishedAt - reports[slot].finishedAt) < 0)
+                slot = i;
+        }
+
+        SequenceReport &report = reports[slot];
+        fillReport(report, now);
+        report.finishedAt = now;
+        return report;
+    }
+
+    void fillReport(SequenceReport &report, unsigned long now) const
+    {
+        report.name = sequence.name;
+        report.state = state;
+        report.abort = abortReason;
+        report.abortStep = abortStep;
+        report.durationMs = now - startedAt;
+        report.count = sequence.count;
+
+        for (size_t i = 0; i < sequence.count; i++)
+        {
+            const SequenceStep &step = sequence.steps[i];
+            SequenceReport::Step &item = report.steps[i];
+            item.name = step.name;
+            item.kind = step.kind;
+            item.stage = step.stage;
+            item.state = step.state;
+            item.outcome = step.outcome;
+
+            bool started = step.state != StepState::WAITING && step.startedAt != 0;
+            unsigned long end = step.state == StepState::RUNNING ? now : step.finishedAt;
+            item.startMs = started ? step.startedAt - startedAt : 0;
+            item.durationMs = started && end >= step.startedAt ? end - step.startedAt : 0;
+        }
+    }
+
+    static String reportToJson(const SequenceReport &report)
+    {
+        String json = "{";
+        json += "\"name\":\"" + String(report.name) + "\",";
+        json += "\"state\":\"" + sequenceStateName(report.state) + "\",";
+        json += "\"abort\":\"" + abortName(report.abort) + "\",";
+        json += "\"abortStep\":\"" + String(report.abortStep) + "\",";
+        json += "\"durationMs\":" + String(report.durationMs) + ",";
+        json += "\"steps\":[";
+
+        for (size_t i = 0; i < report.count; i++)
+        {
+            const SequenceReport::Step &step = report.steps[i];
+            if (i > 0)
+                json += ",";
+
+            json += "{";
+            json += "\"name\":\"" + String(step.name) + "\",";
+            json += "\"kind\":\"" + stepKindName(step.kind) + "\",";
+            json += "\"stage\":" + String(step.stage) + ",";
+            json += "\"state\":\"" + stepStateName(step.state) + "\",";
+            json += "\"outcome\":\"" + getCommandOutcomeName(step.outcome) + "\",";
+            json += "\"startMs\":" + String(step.startMs) + ",";
+            json += "\"durationMs\":" + String(step.durationMs);
+            json += "}";
+        }
+
+        json += "]}";
+        return json;
+    }
+
+public:
+    SequenceRunner(CommandManager &cmdManager, IBusManager &busMgr, IClock &clk)
+        : commandManager(cmdManager), busManager(busMgr), clock(clk) {}
+
+    bool isRunning() const { return state == SequenceState::RUNNING; }
+
+    // Новая последовательность заполняется на месте (без копирования шагов).
+    // Активная при этом прерывается.
+    Sequence &prepare(const char *name, uint32_t timeoutMs = 0)
+    {
+        if (isRunning())
+            cancel();
+
+        sequence.reset(name, timeoutMs);
+        return sequence;
+    }
+
+    void start(FinishedCallback callback = nullptr)
+    {
+        onFinished = std::move(callback);
+        state = SequenceState::RUNNING;
+        abortReason = SequenceAbort::NONE;
+        abortStep = "";
+        stage = 0;
+        startedAt = clock.nowMs();
+
+        startStage(startedAt);
+        advance(clock.nowMs());
+    }
+
+    void cancel()
+    {
+        if (isRunning())
+            finish(SequenceState::ABORTED, SequenceAbort::CANCELLED, "", clock.nowMs());
+    }
+
+    // Дескриптор команды шага (например, диагностики при подключении)
+    CommandHandle getStepHandle(const char *stepName) const
+    {
+        for (size_t i = 0; i < sequence.count; i++)
+        {
+            if (strcmp(sequence.steps[i].name, stepName) == 0)
+                return sequence.steps[i].handle;
+        }
+        return CommandHandle();
+    }
+
+    void process()
+    {
+        if (!isRunning())
+            return;
+
+        unsigned long now = clock.nowMs();
+
+        if (commandManager.getBusHealth() == BusHealth::DOWN)
+        {
+            finish(SequenceState::ABORTED, SequenceAbort::BUS_DOWN, "", now);
+            return;
+        }
+
+        if (sequence.timeoutMs > 0 && (long)(now - startedAt - sequence.timeoutMs) >= 0)
+        {
+            finish(SequenceState::ABORTED, SequenceAbort::STEP_TIMEOUT, "sequence", now);
+            return;
+        }
+        if (sequence.timeoutMs > 0)
+            clock.wakeAt(startedAt + sequence.timeoutMs);
+
+        for (size_t i = 0; i < sequence.count && isRunning(); i++)
+        {
+            SequenceStep &step = sequence.steps[i];
+            if (step.stage == stage && step.state == StepState::RUNNING)
+                pollStep(step, now);
+        }
+
+        advance(now);
+    }
+
+    String toJson() const
+    {
+        String json = "{";
+
+        if (isRunning())
+        {
+            SequenceReport active;
+            fillReport(active, clock.nowMs());
+            json += "\"active\":" + reportToJson(active) + ",";
+        }
+        else
+        {
+            json += "\"active\":null,";
+        }
+
+        json += "\"snapshot\":{";
+        json += "\"samples\":" + String(snapshotSamples) + ",";
+        json += "\"lastMs\":" + String(snapshotLastMs) + ",";
+        json += "\"bestMs\":" + String(snapshotBestMs) + ",";
+        json += "\"worstMs\":" + String(snapshotWorstMs);
+        json += "},\"reports\":[";
+
+        bool first = true;
+        for (size_t i = 0; i < MAX_REPORTS; i++)
+        {
+            if (reports[i].state == SequenceState::IDLE)
+                continue;
+            if (!first)
+                json += ",";
+            json += reportToJson(reports[i]);
+            first = false;
+        }
+
+        json += "]}";
+        return json;
+    }
+};
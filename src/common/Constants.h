@@ -2,10 +2,10 @@
 #pragma once
 #include <Arduino.h>
 #include <HardwareSerial.h>
-
-// Конфигурация Webasto W-Bus
-constexpr uint8_t TXHEADER = 0xF4;  // WTT -> Нагреватель
-constexpr uint8_t RXHEADER = 0x4F;  // Нагреватель -> WTT 
+#include "./ProtocolConstants.h"
 
 // RGB LED
-constexpr int RGB_PIN = LED_BUILTIN;
\ No newline at end of file
+constexpr int RGB_PIN = LED_BUILTIN;
+
+// UART, к которому подключен TJA1020 (HardwareSerial KLineSerial)
+constexpr int KLINE_UART_NUM = 1;
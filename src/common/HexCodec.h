@@ -0,0 +1,173 @@
+// src/common/HexCodec.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Табличное HEX кодирование/декодирование без динамической памяти.
+// Результат пишется в буфер вызывающего, строки не создаются.
+class HexCodec
+{
+private:
+    static const char *digits(bool upperCase)
+    {
+        return upperCase ? "0123456789ABCDEF" : "0123456789abcdef";
+    }
+
+    // Значение полубайта для каждого символа, 0xFF - не HEX символ
+    static const uint8_t *nibbleTable()
+    {
+        static const uint8_t table[256] = {
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+        return table;
+    }
+
+public:
+    static const uint8_t INVALID_NIBBLE = 0xFF;
+
+    // Размер буфера (с завершающим нулем) для length байт
+    static constexpr size_t encodedSize(size_t length, char separator = ' ')
+    {
+        if (length == 0)
+            return 1;
+        return length * 2 + (separator != '\0' ? length - 1 : 0) + 1;
+    }
+
+    // =========================================================================
+    // КОДИРОВАНИЕ
+    // =========================================================================
+
+    // Два символа без завершающего нуля
+    static void encodeByte(uint8_t value, char *out, bool upperCase = false)
+    {
+        const char *table = digits(upperCase);
+        out[0] = table[value >> 4];
+        out[1] = table[value & 0x0F];
+    }
+
+    // "f4 03 50 ..." в out, всегда завершается нулем.
+    // Возвращает количество записанных символов без нуля,
+    // при нехватке места кодирует только помещающиеся байты.
+    static size_t encode(const uint8_t *data, size_t length, char *out, size_t capacity,
+                         char separator = ' ', bool upperCase = false)
+    {
+        if (out == nullptr || capacity == 0)
+            return 0;
+
+        const char *table = digits(upperCase);
+        size_t pos = 0;
+
+        for (size_t i = 0; i < length; i++)
+        {
+            size_t needed = (i > 0 && separator != '\0') ? 3 : 2;
+            if (pos + needed >= capacity)
+                break;
+
+            if (i > 0 && separator != '\0')
+                out[pos++] = separator;
+
+            out[pos++] = table[data[i] >> 4];
+            out[pos++] = table[data[i] & 0x0F];
+        }
+
+        out[pos] = '\0';
+        return pos;
+    }
+
+    // =========================================================================
+    // ДЕКОДИРОВАНИЕ
+    // =========================================================================
+
+    static uint8_t nibble(char c)
+    {
+        return nibbleTable()[static_cast<uint8_t>(c)];
+    }
+
+    static bool isHexChar(char c)
+    {
+        return nibble(c) != INVALID_NIBBLE;
+    }
+
+    // Разбор "f4 03 50" или "f40350" в out. Пробелы пропускаются.
+    // Возвращает количество байт или 0 при ошибке (неверный символ,
+    // нечетное число цифр, нехватка места).
+    static size_t decode(const char *str, size_t length, uint8_t *out, size_t capacity)
+    {
+        if (str == nullptr || out == nullptr)
+            return 0;
+
+        const uint8_t *table = nibbleTable();
+        size_t count = 0;
+        uint8_t high = INVALID_NIBBLE;
+
+        for (size_t i = 0; i < length; i++)
+        {
+            char c = str[i];
+            if (c == ' ')
+                continue;
+
+            uint8_t value = table[static_cast<uint8_t>(c)];
+            if (value == INVALID_NIBBLE)
+                return 0;
+
+            if (high == INVALID_NIBBLE)
+            {
+                high = value;
+                continue;
+            }
+
+            if (count >= capacity)
+                return 0;
+
+            out[count++] = static_cast<uint8_t>((high << 4) | value);
+            high = INVALID_NIBBLE;
+        }
+
+        return high == INVALID_NIBBLE ? count : 0;
+    }
+
+    // Байт на позиции bytePosition без копирования строки (пробелы пропускаются)
+    static bool byteAt(const char *str, size_t length, size_t bytePosition, uint8_t &value)
+    {
+        const uint8_t *table = nibbleTable();
+        size_t digit = 0;
+        uint8_t high = 0;
+
+        for (size_t i = 0; i < length; i++)
+        {
+            if (str[i] == ' ')
+                continue;
+
+            uint8_t n = table[static_cast<uint8_t>(str[i])];
+            if (n == INVALID_NIBBLE)
+                return false;
+
+            if (digit == bytePosition * 2)
+            {
+                high = n;
+            }
+            else if (digit == bytePosition * 2 + 1)
+            {
+                value = static_cast<uint8_t>((high << 4) | n);
+                return true;
+            }
+            digit++;
+        }
+
+        return false;
+    }
+};
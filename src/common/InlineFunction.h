@@ -0,0 +1,133 @@
+// src/common/InlineFunction.h
+#pragma once
+#include <stddef.h>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename Signature, size_t Capacity>
+class InlineFunction;
+
+// Замена std::function без динамической памяти: захват лямбды хранится
+// во встроенном буфере Capacity байт. Захват, который не помещается,
+// отклоняется при компиляции (static_assert), а не уходит в heap.
+template <typename R, typename... Args, size_t Capacity>
+class InlineFunction<R(Args...), Capacity>
+{
+private:
+    struct Ops
+    {
+        R (*invoke)(void *target, Args... args);
+        void (*copy)(void *destination, const void *source);
+        void (*move)(void *destination, void *source);
+        void (*destroy)(void *target);
+    };
+
+    template <typename Callable>
+    static const Ops *opsFor()
+    {
+        static const Ops ops = {
+            [](void *target, Args... args) -> R
+            { return (*static_cast<Callable *>(target))(std::forward<Args>(args)...); },
+            [](void *destination, const void *source)
+            { new (destination) Callable(*static_cast<const Callable *>(source)); },
+            [](void *destination, void *source)
+            { new (destination) Callable(std::move(*static_cast<Callable *>(source))); },
+            [](void *target)
+            { static_cast<Callable *>(target)->~Callable(); }};
+        return &ops;
+    }
+
+    typename std::aligned_storage<Capacity, alignof(void *)>::type storage;
+    const Ops *ops = nullptr;
+
+    void reset()
+    {
+        if (ops)
+        {
+            ops->destroy(&storage);
+            ops = nullptr;
+        }
+    }
+
+public:
+    static const size_t CAPACITY = Capacity;
+
+    InlineFunction() = default;
+    InlineFunction(std::nullptr_t) {}
+
+    template <typename Callable,
+              typename Fn = typename std::decay<Callable>::type,
+              typename = typename std::enable_if<!std::is_same<Fn, InlineFunction>::value>::type>
+    InlineFunction(Callable &&function)
+    {
+        static_assert(sizeof(Fn) <= Capacity, "Захват лямбды не помещается во встроенный буфер InlineFunction");
+        static_assert(alignof(Fn) <= alignof(void *), "Неподдерживаемое выравнивание захвата InlineFunction");
+
+        new (&storage) Fn(std::forward<Callable>(function));
+        ops = opsFor<Fn>();
+    }
+
+    InlineFunction(const InlineFunction &other) : ops(other.ops)
+    {
+        if (ops)
+            ops->copy(&storage, &other.storage);
+    }
+
+    InlineFunction(InlineFunction &&other) : ops(other.ops)
+    {
+        if (ops)
+        {
+            ops->move(&storage, &other.storage);
+            other.reset();
+        }
+    }
+
+    ~InlineFunction()
+    {
+        reset();
+    }
+
+    InlineFunction &operator=(const InlineFunction &other)
+    {
+        if (this != &other)
+        {
+            reset();
+            ops = other.ops;
+            if (ops)
+                ops->copy(&storage, &other.storage);
+        }
+        return *this;
+    }
+
+    InlineFunction &operator=(InlineFunction &&other)
+    {
+        if (this != &other)
+        {
+            reset();
+            ops = other.ops;
+            if (ops)
+            {
+                ops->move(&storage, &other.storage);
+                other.reset();
+            }
+        }
+        return *this;
+    }
+
+    InlineFunction &operator=(std::nullptr_t)
+    {
+        reset();
+        return *this;
+    }
+
+    explicit operator bool() const
+    {
+        return ops != nullptr;
+    }
+
+    R operator()(Args... args) const
+    {
+        return ops->invoke(const_cast<void *>(static_cast<const void *>(&storage)), std::forward<Args>(args)...);
+    }
+};
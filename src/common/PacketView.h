@@ -0,0 +1,130 @@
+// src/common/PacketView.h
+#pragma once
+#include <Arduino.h>
+#include "./Utils.h"
+#include "./ProtocolConstants.h"
+
+// Невладеющее представление кадра W-Bus: указатель + длина.
+// Структура (длина, контрольная сумма) проверяется один раз при создании,
+// дальше представление передается во все декодеры без копирования данных.
+// Время жизни ограничено буфером, на который указывает представление.
+class PacketView
+{
+private:
+    const uint8_t *bytes = nullptr;
+    size_t length = 0;
+    bool valid = false;
+
+    bool validate() const
+    {
+        return bytes != nullptr &&
+               length >= 4 &&
+               length == static_cast<size_t>(bytes[1]) + 2 &&
+               Utils::validateChecksum(bytes, length);
+    }
+
+    bool matches(uint8_t expectedCommand, int expectedIndex, size_t minLength) const
+    {
+        if (!valid)
+        {
+            if (length > 0)
+                Serial.println("Некорректный пакет: " + toHexString());
+            return false;
+        }
+
+        if (minLength > 0 && length < minLength)
+        {
+            Serial.println("Неверная длинна пакета, ожидалась: " + String(minLength) + " | получена: " + String(length));
+            return false;
+        }
+
+        // Для ACK ответов сравниваем без бита ACK
+        uint8_t actualCommand = isAck() ? getCommandWithoutAck() : getCommand();
+        if (actualCommand != expectedCommand)
+        {
+            Serial.println("Неверная ACK бит, ожидалась: " + Utils::byteToHexString(expectedCommand) + " | получена: " + Utils::byteToHexString(actualCommand));
+            return false;
+        }
+
+        if (expectedIndex >= 0 && (length < 5 || bytes[3] != expectedIndex))
+        {
+            Serial.println("Неверная индекс, ожидалась: " + Utils::byteToHexString(expectedIndex) + " | получена: " + Utils::byteToHexString(at(3)));
+            return false;
+        }
+
+        return true;
+    }
+
+public:
+    struct WithIndex
+    {
+        uint8_t value;
+        explicit WithIndex(uint8_t idx) : value(idx) {}
+    };
+
+    struct WithMinLength
+    {
+        size_t value;
+        explicit WithMinLength(size_t len) : value(len) {}
+    };
+
+    PacketView() = default;
+    PacketView(const uint8_t *data, size_t size) : bytes(data), length(size), valid(validate()) {}
+
+    // =========================================================================
+    // ПРОВЕРКА КОМАНДЫ / ИНДЕКСА / ДЛИНЫ
+    // =========================================================================
+
+    bool matches(uint8_t expectedCommand) const
+    {
+        return matches(expectedCommand, -1, 0);
+    }
+
+    bool matches(uint8_t expectedCommand, WithIndex idx) const
+    {
+        return matches(expectedCommand, idx.value, 0);
+    }
+
+    bool matches(uint8_t expectedCommand, WithMinLength minLen) const
+    {
+        return matches(expectedCommand, -1, minLen.value);
+    }
+
+    bool matches(uint8_t expectedCommand, WithIndex idx, WithMinLength minLen) const
+    {
+        return matches(expectedCommand, idx.value, minLen.value);
+    }
+
+    // =========================================================================
+    // ДОСТУП К ДАННЫМ
+    // =========================================================================
+
+    bool isValid() const { return valid; }
+    bool isEmpty() const { return length == 0; }
+    size_t size() const { return length; }
+    const uint8_t *data() const { return bytes; }
+
+    // Без проверки границ - только после matches(..., WithMinLength)
+    uint8_t operator[](size_t i) const { return bytes[i]; }
+
+    // С проверкой границ, за пределами кадра возвращает 0
+    uint8_t at(size_t i) const { return i < length ? bytes[i] : 0; }
+
+    uint8_t getHeader() const { return at(0); }
+    uint8_t getLength() const { return at(1); }
+    uint8_t getCommand() const { return at(2); }
+    uint8_t getIndex() const { return at(3); }
+    uint8_t getChecksum() const { return length > 0 ? bytes[length - 1] : 0; }
+
+    uint8_t getCommandWithoutAck() const { return at(2) & 0x7F; }
+
+    bool isResponse() const { return getHeader() == RXHEADER; }
+    bool isNak() const { return isResponse() && length >= 6 && bytes[2] == 0x7F; }
+    bool isAck() const { return isResponse() && !isNak(); }
+
+    // HEX представление формируется только по запросу
+    String toHexString() const
+    {
+        return bytes != nullptr ? Utils::bytesToHexString(bytes, length) : String();
+    }
+};
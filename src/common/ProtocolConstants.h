@@ -0,0 +1,14 @@
+// src/common/ProtocolConstants.h
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// Конфигурация Webasto W-Bus (без зависимостей от Arduino)
+constexpr uint8_t TXHEADER = 0xF4;  // WTT -> Нагреватель
+constexpr uint8_t RXHEADER = 0x4F;  // Нагреватель -> WTT 
+
+// Максимальный размер кадра W-Bus (header + length + данные + checksum)
+constexpr size_t WBUS_MAX_FRAME_LENGTH = 64;
+
+// Код NAK (4F 04 7F cmd code cs): команда или страница не поддерживается устройством
+constexpr uint8_t NAK_CODE_UNSUPPORTED = 0x33;
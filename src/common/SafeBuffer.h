@@ -1,6 +1,7 @@
 // src/common/SafeBuffer.h
 #pragma once
 #include <Arduino.h>
+#include "./HexCodec.h"
 
 template<size_t N>
 class SafeBuffer
@@ -107,15 +108,14 @@ public:
         String result;
         if (used == 0) return result;
         
-        result.reserve(used * 3); // "FF " для каждого байта
-        
+        result.reserve(HexCodec::encodedSize(used));
+
+        char hex[4] = {' ', 0, 0, 0}; // " FF"
         for (size_t i = 0; i < used; i++)
         {
-            if (i > 0) result += " ";
-            if (buffer[i] < 0x10) result += "0";
-            result += String(buffer[i], HEX);
+            HexCodec::encodeByte(buffer[i], hex + 1, true);
+            result += (i > 0) ? hex : hex + 1;
         }
-        result.toUpperCase();
         return result;
     }
 
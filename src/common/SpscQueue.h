@@ -0,0 +1,70 @@
+// src/common/SpscQueue.h
+#pragma once
+#include <atomic>
+#include <stddef.h>
+
+// Lock-free очередь для одного производителя и одного потребителя.
+// push() вызывается только из одной задачи, pop() - только из другой.
+// Одна ячейка всегда остается пустой, поэтому вмещает N - 1 элементов.
+template <typename T, size_t N>
+class SpscQueue
+{
+private:
+    static_assert(N >= 2, "SpscQueue requires at least 2 slots");
+
+    T items[N];
+    std::atomic<size_t> head{0}; // Следующая ячейка для чтения (потребитель)
+    std::atomic<size_t> tail{0}; // Следующая ячейка для записи (производитель)
+
+    static size_t next(size_t index)
+    {
+        return (index + 1) % N;
+    }
+
+public:
+    SpscQueue() = default;
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    bool push(const T &item)
+    {
+        size_t currentTail = tail.load(std::memory_order_relaxed);
+        size_t nextTail = next(currentTail);
+
+        if (nextTail == head.load(std::memory_order_acquire))
+            return false; // Очередь заполнена
+
+        items[currentTail] = item;
+        tail.store(nextTail, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T &item)
+    {
+        size_t currentHead = head.load(std::memory_order_relaxed);
+
+        if (currentHead == tail.load(std::memory_order_acquire))
+            return false; // Очередь пуста
+
+        item = items[currentHead];
+        head.store(next(currentHead), std::memory_order_release);
+        return true;
+    }
+
+    bool isEmpty() const
+    {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    size_t size() const
+    {
+        size_t h = head.load(std::memory_order_acquire);
+        size_t t = tail.load(std::memory_order_acquire);
+        return (t + N - h) % N;
+    }
+
+    size_t capacity() const
+    {
+        return N - 1;
+    }
+};
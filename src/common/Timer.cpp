@@ -1,10 +1,10 @@
 #include "./Timer.h"
 
-Timer::Timer(unsigned long intervalMs, bool autoReset)
+Timer::Timer(IClock &clock, unsigned long intervalMs, bool autoReset) : _clock(clock)
 {
     _interval = intervalMs;
     _autoReset = autoReset;
-    _lastExecution = millis();
+    _lastExecution = _clock.nowMs();
 }
 
 void Timer::setInterval(unsigned long intervalMs)
@@ -15,12 +15,12 @@ void Timer::setInterval(unsigned long intervalMs)
 
 void Timer::reset()
 {
-    _lastExecution = millis();
+    _lastExecution = _clock.nowMs();
 }
 
 bool Timer::isReady()
 {
-    unsigned long currentTime = millis();
+    unsigned long currentTime = _clock.nowMs();
     unsigned long elapsed = currentTime - _lastExecution;
 
     if (elapsed >= _interval)
@@ -31,17 +31,20 @@ bool Timer::isReady()
         }
         return true;
     }
+
+    // Проверяющему нужно управление к моменту срабатывания
+    _clock.wakeAt(_lastExecution + _interval);
     return false;
 }
 
 void Timer::forceReady()
 {
-    _lastExecution = millis() - _interval;
+    _lastExecution = _clock.nowMs() - _interval;
 }
 
 unsigned long Timer::getRemainingTime()
 {
-    unsigned long currentTime = millis();
+    unsigned long currentTime = _clock.nowMs();
     unsigned long elapsed = currentTime - _lastExecution;
 
     if (elapsed >= _interval)
@@ -53,7 +56,7 @@ unsigned long Timer::getRemainingTime()
 
 unsigned long Timer::getElapsedTime()
 {
-    return millis() - _lastExecution;
+    return _clock.nowMs() - _lastExecution;
 }
 
 unsigned long Timer::getCurrentInterval()
@@ -2,17 +2,19 @@
 #define TIMER_H
 
 #include <Arduino.h>
+#include "../interfaces/IClock.h"
 
 class Timer
 {
 private:
+    IClock &_clock;
     unsigned long _interval;      // Интервал в миллисекундах
     unsigned long _lastExecution; // Время последнего выполнения
     bool _autoReset;              // Автоматически сбрасывать таймер
 
 public:
-    // Конструктор с интервалом и автосбросом
-    Timer(unsigned long intervalMs, bool autoReset = true);
+    // Конструктор с интервалом и автосбросом; часы должны быть уже созданы
+    Timer(IClock &clock, unsigned long intervalMs, bool autoReset = true);
 
     void setInterval(unsigned long intervalMs);
     void reset();
@@ -23,4 +25,4 @@ public:
     unsigned long getCurrentInterval();
 };
 
-#endif // TIMER_H
\ No newline at end of file
+#endif // TIMER_H
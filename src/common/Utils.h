@@ -1,6 +1,7 @@
 // src/common/Utils.h
 #pragma once
 #include <Arduino.h>
+#include "./HexCodec.h"
 
 class Utils
 {
@@ -15,12 +16,11 @@ public:
         return checksum;
     }
 
-    static bool isHexString(String str)
+    static bool isHexString(const String &str)
     {
         for (unsigned int i = 0; i < str.length(); i++)
         {
-            char c = str[i];
-            if (!((c >= '0' && c <= '9') || (c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f')))
+            if (!HexCodec::isHexChar(str[i]))
             {
                 return false;
             }
@@ -30,7 +30,10 @@ public:
 
     static String byteToHexString(uint8_t b)
     {
-        return (b < 0x10) ? "0" + String(b, HEX) : String(b, HEX);
+        char hex[3];
+        HexCodec::encodeByte(b, hex);
+        hex[2] = '\0';
+        return String(hex);
     }
 
     static String formatHexString(uint8_t b)
@@ -43,23 +46,41 @@ public:
         return "0x" + str;
     }
 
-    static String bytesToHexString(const uint8_t *data, size_t length)
+    // Кадр W-Bus укладывается в один проход через стековый буфер,
+    // String выделяется один раз нужного размера
+    static String bytesToHexString(const uint8_t *data, size_t length, char separator = ' ', bool upperCase = false)
     {
-        String result = "";
-        for (size_t i = 0; i < length; i++)
+        static const size_t CHUNK_BYTES = 64;
+        char hex[CHUNK_BYTES * 3 + 1];
+
+        String result;
+        result.reserve(HexCodec::encodedSize(length, separator));
+
+        for (size_t offset = 0; offset < length; offset += CHUNK_BYTES)
         {
-            if (i > 0)
-                result += " ";
+            size_t chunk = (length - offset < CHUNK_BYTES) ? length - offset : CHUNK_BYTES;
+            if (offset > 0 && separator != '\0')
+                result += separator;
 
-            result += byteToHexString(data[i]);
+            HexCodec::encode(data + offset, chunk, hex, sizeof(hex), separator, upperCase);
+            result += hex;
         }
-        result.toLowerCase();
+
         return result;
     }
 
     static uint8_t hexStringToByte(const String &hexStr)
     {
-        return (uint8_t)strtol(hexStr.c_str(), NULL, 16);
+        uint8_t value = 0;
+        HexCodec::decode(hexStr.c_str(), hexStr.length(), &value, 1);
+        return value;
+    }
+
+    // Разбор HEX строки ("f4 03 50 ..." или "f40350...") в буфер без промежуточных строк.
+    // Возвращает количество байт или 0 при ошибке.
+    static size_t hexStringToBytes(const String &hexStr, uint8_t *out, size_t capacity)
+    {
+        return HexCodec::decode(hexStr.c_str(), hexStr.length(), out, capacity);
     }
 
     static bool validateChecksum(const uint8_t *data, size_t length)
@@ -71,26 +92,29 @@ public:
         return calculatedChecksum == data[length - 1];
     }
 
-    static uint8_t extractByteFromString(String response, int bytePosition)
+    // Байт по позиции без копирования строки, 0 если байта нет
+    static uint8_t extractByteFromString(const String &response, int bytePosition)
     {
-        String cleanTx = response;
-        cleanTx.replace(" ", "");
+        uint8_t value = 0;
+        if (bytePosition < 0 || !HexCodec::byteAt(response.c_str(), response.length(), bytePosition, value))
+            return 0;
+        return value;
+    }
 
-        if (cleanTx.length() >= (bytePosition + 1) * 2)
+    static bool isNakPacket(const String &response)
+    {
+        uint8_t header[3];
+        for (uint8_t i = 0; i < 3; i++)
         {
-            String byteStr = cleanTx.substring(bytePosition * 2, bytePosition * 2 + 2);
-            return hexStringToByte(byteStr);
+            if (!HexCodec::byteAt(response.c_str(), response.length(), i, header[i]))
+                return false;
         }
-
-        return 0;
+        return header[0] == 0x4F && header[1] == 0x04 && header[2] == 0x7F;
     }
 
-    static bool isNakPacket(const String &response)
+    static bool isNakPacket(const uint8_t *data, size_t length)
     {
-        String cleanData = response;
-        cleanData.toLowerCase();
-        cleanData.replace(" ", "");
-        return cleanData.startsWith("4f047f");
+        return length >= 5 && data[0] == 0x4F && data[1] == 0x04 && data[2] == 0x7F;
     }
 
     static String formatSizeBytes(size_t bytes)
@@ -0,0 +1,143 @@
+// src/common/WBusFrame.h
+#pragma once
+#include <Arduino.h>
+#include "./Utils.h"
+#include "./HexCodec.h"
+#include "./PacketView.h"
+#include "./ProtocolConstants.h"
+
+// Кадр, формируемый на этапе компиляции (constexpr) для команд без параметров.
+// Хранится во flash, в WBusFrame копируется без пересчета контрольной суммы и хеша.
+struct WBusConstFrame
+{
+    static const size_t CAPACITY = 8;
+
+    uint8_t bytes[CAPACITY];
+    uint8_t length;
+    uint32_t hash;
+
+    // FNV-1a по байтам кадра - для быстрого поиска дубликатов в очереди
+    static constexpr uint32_t computeHash(const uint8_t *data, size_t size)
+    {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= data[i];
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    // F4 len cmd [index] [data0..data3] checksum
+    static constexpr WBusConstFrame build(uint8_t command, uint8_t index = 0, uint8_t dataLength = 0,
+                                          uint8_t data0 = 0, uint8_t data1 = 0, uint8_t data2 = 0, uint8_t data3 = 0)
+    {
+        WBusConstFrame frame{};
+        const uint8_t data[] = {data0, data1, data2, data3};
+
+        frame.bytes[frame.length++] = TXHEADER;
+        frame.bytes[frame.length++] = static_cast<uint8_t>(2 + (index != 0 ? 1 : 0) + dataLength);
+        frame.bytes[frame.length++] = command;
+
+        if (index != 0)
+            frame.bytes[frame.length++] = index;
+
+        for (uint8_t i = 0; i < dataLength && i < 4; i++)
+            frame.bytes[frame.length++] = data[i];
+
+        uint8_t checksum = 0;
+        for (uint8_t i = 0; i < frame.length; i++)
+            checksum ^= frame.bytes[i];
+        frame.bytes[frame.length++] = checksum;
+
+        frame.hash = computeHash(frame.bytes, frame.length);
+        return frame;
+    }
+
+    // Сравнение с ожидаемыми байтами (для static_assert)
+    template <typename... Bytes>
+    constexpr bool equals(Bytes... expected) const
+    {
+        const uint8_t values[] = {static_cast<uint8_t>(expected)...};
+        if (sizeof...(expected) != length)
+            return false;
+
+        for (size_t i = 0; i < sizeof...(expected); i++)
+        {
+            if (values[i] != bytes[i])
+                return false;
+        }
+        return true;
+    }
+};
+
+// Исходящий кадр W-Bus фиксированной емкости: F4 len cmd [index] [data] checksum.
+// Хранится по значению в очереди команд, отправляется без преобразований.
+// HEX строка формируется только для логов и API.
+class WBusFrame
+{
+public:
+    static const size_t CAPACITY = 32;
+
+private:
+    uint8_t bytes[CAPACITY] = {};
+    uint8_t length = 0;
+    uint32_t hashValue = 0;
+
+public:
+    WBusFrame() = default;
+
+    // Копирует готовый кадр (с контрольной суммой). Слишком длинный кадр -> пустой.
+    WBusFrame(const uint8_t *data, size_t size)
+    {
+        if (data == nullptr || size == 0 || size > CAPACITY)
+            return;
+
+        memcpy(bytes, data, size);
+        length = static_cast<uint8_t>(size);
+        hashValue = WBusConstFrame::computeHash(bytes, length);
+    }
+
+    // Кадр из таблицы во flash: контрольная сумма и хеш уже посчитаны
+    WBusFrame(const WBusConstFrame &frame) : length(frame.length), hashValue(frame.hash)
+    {
+        memcpy(bytes, frame.bytes, frame.length);
+    }
+
+    // Разбор HEX строки (консоль, API). При ошибке возвращается пустой кадр.
+    static WBusFrame fromHexString(const String &hex)
+    {
+        uint8_t buffer[CAPACITY];
+        size_t size = HexCodec::decode(hex.c_str(), hex.length(), buffer, sizeof(buffer));
+        return WBusFrame(buffer, size);
+    }
+
+    bool isEmpty() const { return length == 0; }
+    bool isValid() const { return view().isValid(); }
+
+    const uint8_t *data() const { return bytes; }
+    size_t size() const { return length; }
+    uint32_t hash() const { return hashValue; }
+
+    uint8_t getCommand() const { return length > 2 ? bytes[2] : 0; }
+    uint8_t getIndex() const { return length > 4 ? bytes[3] : 0; }
+
+    PacketView view() const { return PacketView(bytes, length); }
+
+    String toHexString() const
+    {
+        return Utils::bytesToHexString(bytes, length);
+    }
+
+    bool operator==(const WBusFrame &other) const
+    {
+        return length == other.length &&
+               hashValue == other.hashValue &&
+               memcmp(bytes, other.bytes, length) == 0;
+    }
+
+    bool operator!=(const WBusFrame &other) const
+    {
+        return !(*this == other);
+    }
+};
@@ -105,8 +105,24 @@ public:
         config.bus.queueInterval = bus["queueInterval"] | 150;
         config.bus.maxQueueSize = bus["maxQueueSize"] | 30;
         config.bus.maxPriorityQueueSize = bus["maxPriorityQueueSize"] | 10;
+        config.bus.queueSafetySize = bus["queueSafetySize"] | 4;
+        config.bus.queueBackgroundSize = bus["queueBackgroundSize"] | 8;
+        config.bus.queueAgingStep = bus["queueAgingStep"] | 2000;
         config.bus.breakSignalDuration = bus["breakSignalDuration"] | 50;
+        config.bus.breakRecoveryDuration = bus["breakRecoveryDuration"] | 25;
         config.bus.keepAliveInterval = bus["keepAliveInterval"] | 15000;
+        config.bus.frameGapTimeout = bus["frameGapTimeout"] | 100;
+        config.bus.pollStatusPeriod = bus["pollStatusPeriod"] | 1000;
+        config.bus.pollFastPeriod = bus["pollFastPeriod"] | 2000;
+        config.bus.pollSlowPeriod = bus["pollSlowPeriod"] | 10000;
+        config.bus.pollCountersPeriod = bus["pollCountersPeriod"] | 600000;
+        config.bus.pollBusBudget = bus["pollBusBudget"] | 70;
+        config.bus.minCommandTimeout = bus["minCommandTimeout"] | 200;
+        config.bus.minQueueInterval = bus["minQueueInterval"] | 20;
+        config.bus.pollMaxRetries = bus["pollMaxRetries"] | 1;
+        config.bus.busDownFailures = bus["busDownFailures"] | 3;
+        config.bus.busProbeInterval = bus["busProbeInterval"] | 1000;
+        config.bus.busProbeMaxInterval = bus["busProbeMaxInterval"] | 60000;
         config.bus.nslpPin = bus["nslpPin"] | 7;
         config.bus.nwakePin = bus["nwakePin"] | 6;
         config.bus.rxdPullupPin = bus["rxdPullupPin"] | 8;
@@ -160,8 +176,24 @@ public:
         bus["queueInterval"] = config.bus.queueInterval;
         bus["maxQueueSize"] = config.bus.maxQueueSize;
         bus["maxPriorityQueueSize"] = config.bus.maxPriorityQueueSize;
+        bus["queueSafetySize"] = config.bus.queueSafetySize;
+        bus["queueBackgroundSize"] = config.bus.queueBackgroundSize;
+        bus["queueAgingStep"] = config.bus.queueAgingStep;
         bus["breakSignalDuration"] = config.bus.breakSignalDuration;
+        bus["breakRecoveryDuration"] = config.bus.breakRecoveryDuration;
         bus["keepAliveInterval"] = config.bus.keepAliveInterval;
+        bus["frameGapTimeout"] = config.bus.frameGapTimeout;
+        bus["pollStatusPeriod"] = config.bus.pollStatusPeriod;
+        bus["pollFastPeriod"] = config.bus.pollFastPeriod;
+        bus["pollSlowPeriod"] = config.bus.pollSlowPeriod;
+        bus["pollCountersPeriod"] = config.bus.pollCountersPeriod;
+        bus["pollBusBudget"] = config.bus.pollBusBudget;
+        bus["minCommandTimeout"] = config.bus.minCommandTimeout;
+        bus["minQueueInterval"] = config.bus.minQueueInterval;
+        bus["pollMaxRetries"] = config.bus.pollMaxRetries;
+        bus["busDownFailures"] = config.bus.busDownFailures;
+        bus["busProbeInterval"] = config.bus.busProbeInterval;
+        bus["busProbeMaxInterval"] = config.bus.busProbeMaxInterval;
         bus["nslpPin"] = config.bus.nslpPin;
         bus["nwakePin"] = config.bus.nwakePin;
         bus["rxdPullupPin"] = config.bus.rxdPullupPin;
@@ -280,10 +312,42 @@ public:
                 config.bus.maxQueueSize = bus["maxQueueSize"];
             if (bus.containsKey("maxPriorityQueueSize"))
                 config.bus.maxPriorityQueueSize = bus["maxPriorityQueueSize"];
+            if (bus.containsKey("queueSafetySize"))
+                config.bus.queueSafetySize = bus["queueSafetySize"];
+            if (bus.containsKey("queueBackgroundSize"))
+                config.bus.queueBackgroundSize = bus["queueBackgroundSize"];
+            if (bus.containsKey("queueAgingStep"))
+                config.bus.queueAgingStep = bus["queueAgingStep"];
             if (bus.containsKey("breakSignalDuration"))
                 config.bus.breakSignalDuration = bus["breakSignalDuration"];
+            if (bus.containsKey("breakRecoveryDuration"))
+                config.bus.breakRecoveryDuration = bus["breakRecoveryDuration"];
             if (bus.containsKey("keepAliveInterval"))
                 config.bus.keepAliveInterval = bus["keepAliveInterval"];
+            if (bus.containsKey("frameGapTimeout"))
+                config.bus.frameGapTimeout = bus["frameGapTimeout"];
+            if (bus.containsKey("pollStatusPeriod"))
+                config.bus.pollStatusPeriod = bus["pollStatusPeriod"];
+            if (bus.containsKey("pollFastPeriod"))
+                config.bus.pollFastPeriod = bus["pollFastPeriod"];
+            if (bus.containsKey("pollSlowPeriod"))
+                config.bus.pollSlowPeriod = bus["pollSlowPeriod"];
+            if (bus.containsKey("pollCountersPeriod"))
+                config.bus.pollCountersPeriod = bus["pollCountersPeriod"];
+            if (bus.containsKey("pollBusBudget"))
+                config.bus.pollBusBudget = bus["pollBusBudget"];
+            if (bus.containsKey("minCommandTimeout"))
+                config.bus.minCommandTimeout = bus["minCommandTimeout"];
+            if (bus.containsKey("minQueueInterval"))
+                config.bus.minQueueInterval = bus["minQueueInterval"];
+            if (bus.containsKey("pollMaxRetries"))
+                config.bus.pollMaxRetries = bus["pollMaxRetries"];
+            if (bus.containsKey("busDownFailures"))
+                config.bus.busDownFailures = bus["busDownFailures"];
+            if (bus.containsKey("busProbeInterval"))
+                config.bus.busProbeInterval = bus["busProbeInterval"];
+            if (bus.containsKey("busProbeMaxInterval"))
+                config.bus.busProbeMaxInterval = bus["busProbeMaxInterval"];
         }
 
         // Обновляем network конфигурацию
@@ -410,8 +474,24 @@ public:
         bus["queueInterval"] = config.bus.queueInterval;
         bus["maxQueueSize"] = config.bus.maxQueueSize;
         bus["maxPriorityQueueSize"] = config.bus.maxPriorityQueueSize;
+        bus["queueSafetySize"] = config.bus.queueSafetySize;
+        bus["queueBackgroundSize"] = config.bus.queueBackgroundSize;
+        bus["queueAgingStep"] = config.bus.queueAgingStep;
         bus["breakSignalDuration"] = config.bus.breakSignalDuration;
+        bus["breakRecoveryDuration"] = config.bus.breakRecoveryDuration;
         bus["keepAliveInterval"] = config.bus.keepAliveInterval;
+        bus["frameGapTimeout"] = config.bus.frameGapTimeout;
+        bus["pollStatusPeriod"] = config.bus.pollStatusPeriod;
+        bus["pollFastPeriod"] = config.bus.pollFastPeriod;
+        bus["pollSlowPeriod"] = config.bus.pollSlowPeriod;
+        bus["pollCountersPeriod"] = config.bus.pollCountersPeriod;
+        bus["pollBusBudget"] = config.bus.pollBusBudget;
+        bus["minCommandTimeout"] = config.bus.minCommandTimeout;
+        bus["minQueueInterval"] = config.bus.minQueueInterval;
+        bus["pollMaxRetries"] = config.bus.pollMaxRetries;
+        bus["busDownFailures"] = config.bus.busDownFailures;
+        bus["busProbeInterval"] = config.bus.busProbeInterval;
+        bus["busProbeMaxInterval"] = config.bus.busProbeMaxInterval;
         bus["nslpPin"] = config.bus.nslpPin;
         bus["nwakePin"] = config.bus.nwakePin;
         bus["rxdPullupPin"] = config.bus.rxdPullupPin;
@@ -457,8 +537,24 @@ public:
         Serial.println("    Queue Interval: " + String(config.bus.queueInterval));
         Serial.println("    Max Queue Size: " + String(config.bus.maxQueueSize));
         Serial.println("    Max Priority Queue Size: " + String(config.bus.maxPriorityQueueSize));
+        Serial.println("    Queue Safety Size: " + String(config.bus.queueSafetySize));
+        Serial.println("    Queue Background Size: " + String(config.bus.queueBackgroundSize));
+        Serial.println("    Queue Aging Step: " + String(config.bus.queueAgingStep));
         Serial.println("    Break Signal Duration: " + String(config.bus.breakSignalDuration));
+        Serial.println("    Break Recovery: " + String(config.bus.breakRecoveryDuration));
         Serial.println("    Keep Alive Interval: " + String(config.bus.keepAliveInterval));
+        Serial.println("    Frame Gap Timeout: " + String(config.bus.frameGapTimeout));
+        Serial.println("    Poll Status Period: " + String(config.bus.pollStatusPeriod));
+        Serial.println("    Poll Fast Period: " + String(config.bus.pollFastPeriod));
+        Serial.println("    Poll Slow Period: " + String(config.bus.pollSlowPeriod));
+        Serial.println("    Poll Counters Period: " + String(config.bus.pollCountersPeriod));
+        Serial.println("    Poll Bus Budget: " + String(config.bus.pollBusBudget));
+        Serial.println("    Min Command Timeout: " + String(config.bus.minCommandTimeout));
+        Serial.println("    Min Queue Interval: " + String(config.bus.minQueueInterval));
+        Serial.println("    Poll Max Retries: " + String(config.bus.pollMaxRetries));
+        Serial.println("    Bus Down Failures: " + String(config.bus.busDownFailures));
+        Serial.println("    Bus Probe Interval: " + String(config.bus.busProbeInterval));
+        Serial.println("    Bus Probe Max Interval: " + String(config.bus.busProbeMaxInterval));
         Serial.println("    NSLP Pin: " + String(config.bus.nslpPin));
         Serial.println("    NWAKE Pin: " + String(config.bus.nwakePin));
         Serial.println("    RXD Pullup Pin: " + String(config.bus.rxdPullupPin));
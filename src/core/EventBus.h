@@ -34,6 +34,8 @@ enum class EventType
     COMMAND_SENT_TIMEOUT,
     COMMAND_SENT_ERRROR,
     COMMAND_RECEIVED,
+    BUS_HEALTH_CHANGED,
+    BUS_DRIVER_OPERATION,
 
     // События перехвата пакетов k-line
     TX_RECEIVED,
@@ -203,6 +205,8 @@ private:
         registerEvent(EventType::COMMAND_SENT, "COMMAND_SENT");
         registerEvent(EventType::COMMAND_SENT_TIMEOUT, "COMMAND_SENT_TIMEOUT");
         registerEvent(EventType::COMMAND_SENT_ERRROR, "COMMAND_SENT_ERRROR");
+        registerEvent(EventType::BUS_HEALTH_CHANGED, "BUS_HEALTH_CHANGED");
+        registerEvent(EventType::BUS_DRIVER_OPERATION, "BUS_DRIVER_OPERATION");
         registerEvent(EventType::COMMAND_RECEIVED, "COMMAND_RECEIVED");
         registerEvent(EventType::TX_RECEIVED, "TX_RECEIVED");
         registerEvent(EventType::RX_RECEIVED, "RX_RECEIVED");
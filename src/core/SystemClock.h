@@ -0,0 +1,42 @@
+#pragma once
+#include <Arduino.h>
+#include <esp_timer.h>
+#include "../interfaces/IClock.h"
+
+// Реальное время устройства. Пробуждения не нужны: цикл и так крутится постоянно.
+class SystemClock : public IClock
+{
+public:
+    unsigned long nowMs() const override
+    {
+        return millis();
+    }
+
+    int64_t nowUs() const override
+    {
+        return esp_timer_get_time();
+    }
+
+    void sleepMs(uint32_t ms) override
+    {
+        delay(ms);
+    }
+
+    void sleepUs(uint32_t us) override
+    {
+        delayMicroseconds(us);
+    }
+
+    void wakeAt(unsigned long deadlineMs) override {}
+
+    void wakeAtUs(int64_t deadlineUs) override {}
+
+    void idle(uint32_t maxUs) override
+    {
+        // delay() отдает процессор другим задачам FreeRTOS, delayMicroseconds() - нет
+        if (maxUs >= 1000)
+            delay(maxUs / 1000);
+        else
+            delayMicroseconds(maxUs);
+    }
+};
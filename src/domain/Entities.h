@@ -12,8 +12,24 @@ struct BusConfig
     uint32_t queueInterval = 150;
     uint32_t maxQueueSize = 30;
     uint32_t maxPriorityQueueSize = 10;
+    uint32_t queueSafetySize = 4; // команд keep-alive/выключения в очереди
+    uint32_t queueBackgroundSize = 8; // страниц опроса в очереди
+    uint32_t queueAgingStep = 2000; // мс ожидания, повышающие класс команды на ступень (0 - без старения)
     uint32_t breakSignalDuration = 50;
+    uint32_t breakRecoveryDuration = 25; // мс паузы после BREAK перед первым кадром
     uint32_t keepAliveInterval = 15000;
+    uint32_t frameGapTimeout = 100; // мс, пауза между байтами, после которой кадр отбрасывается
+    uint32_t pollStatusPeriod = 1000; // мс, опрос статус-флагов
+    uint32_t pollFastPeriod = 2000; // мс, рабочие измерения, состояние, подсистемы
+    uint32_t pollSlowPeriod = 10000; // мс, ошибки, подогрев топлива
+    uint32_t pollCountersPeriod = 600000; // мс, счетчики и наработка
+    uint8_t pollBusBudget = 70; // %, доля времени шины для периодического опроса
+    uint32_t minCommandTimeout = 200; // мс, нижняя граница адаптивного таймаута (верхняя - commandTimeout)
+    uint32_t minQueueInterval = 20; // мс, нижняя граница паузы между командами (верхняя - queueInterval)
+    uint8_t pollMaxRetries = 1; // повторов для страниц периодического опроса (разовые команды - maxRetries)
+    uint8_t busDownFailures = 3; // неудачных транзакций подряд до признания шины недоступной
+    uint32_t busProbeInterval = 1000; // мс, первая проверка недоступной шины, далее интервал удваивается
+    uint32_t busProbeMaxInterval = 60000; // мс, максимальный интервал проверки шины
 
     // Пины для управления TJA1020
     uint8_t nslpPin = 7;
@@ -40,6 +56,14 @@ struct BusConfig
             return SERIAL_7O1;
         return SERIAL_8E1; // по умолчанию
     }
+
+    // Бит на символ: старт + данные + четность + стоп
+    uint8_t getBitsPerChar() const
+    {
+        uint8_t dataBits = serialConfig.startsWith("7") ? 7 : 8;
+        uint8_t parityBits = serialConfig.indexOf('N') >= 0 ? 0 : 1;
+        return 1 + dataBits + parityBits + 1;
+    }
 };
 
 struct NetworkConfig
@@ -125,6 +149,102 @@ enum class ConnectionState
     CONNECTION_FAILED
 };
 
+// Состояние шины по результатам транзакций
+enum class BusHealth
+{
+    HEALTHY,  // Ответы приходят
+    DEGRADED, // Есть отказы, повторы сокращены
+    DOWN      // Шина недоступна, только пробные запросы
+};
+
+inline String getBusHealthName(BusHealth health)
+{
+    switch (health)
+    {
+    case BusHealth::HEALTHY:
+        return "HEALTHY";
+    case BusHealth::DEGRADED:
+        return "DEGRADED";
+    case BusHealth::DOWN:
+        return "DOWN";
+    default:
+        return "HEALTHY";
+    }
+}
+
+// Операции драйвера шины, выполняемые по шагам из process()
+enum class BusDriverOperation
+{
+    WAKE,  // Выход TJA1020 из сна и запуск UART
+    SLEEP, // Остановка UART и перевод TJA1020 в сон
+    BREAK  // BREAK на линии перед обменом
+};
+
+inline String getBusDriverOperationName(BusDriverOperation operation)
+{
+    switch (operation)
+    {
+    case BusDriverOperation::WAKE:
+        return "WAKE";
+    case BusDriverOperation::SLEEP:
+        return "SLEEP";
+    default:
+        return "BREAK";
+    }
+}
+
+enum class CommandOutcome
+{
+    PENDING,   // В очереди или ожидает ответа
+    ACK,       // Получен ответ
+    NAK,       // Нагреватель отклонил команду
+    TIMEOUT,   // Ответа нет после всех повторов
+    CANCELLED, // Очередь сброшена до отправки
+    UNKNOWN    // Результат не отслеживается или уже вытеснен
+};
+
+inline String getCommandOutcomeName(CommandOutcome outcome)
+{
+    switch (outcome)
+    {
+    case CommandOutcome::PENDING:
+        return "PENDING";
+    case CommandOutcome::ACK:
+        return "ACK";
+    case CommandOutcome::NAK:
+        return "NAK";
+    case CommandOutcome::TIMEOUT:
+        return "TIMEOUT";
+    case CommandOutcome::CANCELLED:
+        return "CANCELLED";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+// Дескриптор поставленной команды: по нему запрашивается результат.
+// Приводится к bool - принята ли команда в очередь.
+struct CommandHandle
+{
+    static const uint8_t NO_SLOT = 0xFF;
+
+    uint8_t slot = NO_SLOT;  // Запись в таблице результатов
+    uint16_t generation = 0; // Поколение записи: устаревший дескриптор не совпадет
+    bool accepted = false;
+
+    static CommandHandle untracked(bool accepted)
+    {
+        CommandHandle handle;
+        handle.accepted = accepted;
+        return handle;
+    }
+
+    bool isTracked() const { return slot != NO_SLOT; }
+    explicit operator bool() const { return accepted; }
+
+    uint32_t id() const { return isTracked() ? (static_cast<uint32_t>(generation) << 8) | slot : 0; }
+};
+
 // Структуры для информации об устройстве
 struct DecodedManufactureDate
 {
@@ -1,6 +1,7 @@
 // src/domain/Events.h
 #pragma once
 #include "Entities.h"
+#include "../common/PacketView.h"
 
 
 struct AppConfigUpdateEvent
@@ -23,16 +24,29 @@ struct ConnectionTimeoutEvent
     }
 };
 
+// Принятый кадр (TX_RECEIVED / RX_RECEIVED) без преобразования в текст.
+// Указывает на буфер приемника и валиден только на время обработки события
+struct FrameReceivedEvent
+{
+    PacketView frame;
+
+    String toJson() const
+    {
+        return "\"" + frame.toHexString() + "\"";
+    }
+};
+
+// Кадры указывают на буферы приемника и валидны только на время обработки события
 struct CommandReceivedEvent
 {
-    String tx;
-    String rx;
+    PacketView tx;
+    PacketView rx;
 
     String toJson() const
     {
         String json = "{";
-        json += "\"tx\":\"" + tx + "\",";
-        json += "\"rx\":\"" + rx + "\"";
+        json += "\"tx\":\"" + tx.toHexString() + "\",";
+        json += "\"rx\":\"" + rx.toHexString() + "\"";
         json += "}";
         return json;
     }
@@ -68,6 +82,43 @@ struct ConnectionStateChangedEvent
     }
 };
 
+struct BusHealthChangedEvent
+{
+    BusHealth oldState;
+    BusHealth newState;
+
+    String toJson() const
+    {
+        String json = "{";
+        json += "\"oldState\":\"" + getBusHealthName(oldState) + "\",";
+        json += "\"newState\":\"" + getBusHealthName(newState) + "\"";
+        json += "}";
+        return json;
+    }
+};
+
+struct BusDriverOperationEvent
+{
+    BusDriverOperation operation;
+    uint32_t durationMs;
+    uint32_t pulseUs = 0;    // Измеренная длительность LOW (BREAK или NWAKE)
+    int32_t pulseErrorUs = 0; // Отклонение от заданной
+
+    String toJson() const
+    {
+        String json = "{";
+        json += "\"operation\":\"" + getBusDriverOperationName(operation) + "\",";
+        json += "\"durationMs\":" + String(durationMs);
+        if (pulseUs > 0)
+        {
+            json += ",\"pulseUs\":" + String(pulseUs);
+            json += ",\"pulseErrorUs\":" + String(pulseErrorUs);
+        }
+        json += "}";
+        return json;
+    }
+};
+
 struct NakResponseEvent
 {
     String tx;
@@ -0,0 +1,172 @@
+// src/infrastructure/hardware/KLineReceiverTask.h
+#pragma once
+#include <Arduino.h>
+#include <HardwareSerial.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "../../common/SpscQueue.h"
+#include "../../interfaces/IClock.h"
+#include "../protocol/WBusFramer.h"
+
+// Отдельная задача FreeRTOS для приема K-Line.
+// Просыпается по событию UART (onReceive) или по таймеру для проверки паузы,
+// выделяет кадры и складывает их в очередь для основного цикла.
+// Без задачи (виртуальное время в host-сборке) poll() вызывает основной цикл.
+class KLineReceiverTask
+{
+public:
+    static constexpr size_t QUEUE_SIZE = 16;
+
+private:
+    static constexpr uint32_t TASK_STACK_SIZE = 4096;
+    static constexpr UBaseType_t TASK_PRIORITY = 5;
+    static constexpr BaseType_t TASK_CORE = 1;
+    static constexpr uint32_t IDLE_WAKE_MS = 10; // Период проверки паузы без новых байт
+    static constexpr uint32_t NO_PENDING_GAP = UINT32_MAX;
+
+    HardwareSerial &serial;
+    IClock &clock;
+    WBusFramer framer;
+    WBusFramerStats statsSnapshot; // Копия статистики для основного цикла (под statsMux)
+    mutable portMUX_TYPE statsMux = portMUX_INITIALIZER_UNLOCKED;
+    SpscQueue<WBusRawFrame, QUEUE_SIZE> frameQueue;
+    TaskHandle_t taskHandle = nullptr;
+
+    std::atomic<uint32_t> queueOverflows{0};
+    std::atomic<bool> statsResetRequested{false};
+    std::atomic<uint32_t> pendingGapTimeoutMs{NO_PENDING_GAP};
+
+    static void taskEntry(void *arg)
+    {
+        static_cast<KLineReceiverTask *>(arg)->run();
+    }
+
+    void run()
+    {
+        for (;;)
+        {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(IDLE_WAKE_MS));
+            poll();
+        }
+    }
+
+    // Статистику framer меняет только задача приема; читатели получают копию
+    void publishStats()
+    {
+        portENTER_CRITICAL(&statsMux);
+        statsSnapshot = framer.getStats();
+        portEXIT_CRITICAL(&statsMux);
+    }
+
+    void pushFrame(const uint8_t *frame, size_t length, int64_t timestampUs)
+    {
+        WBusRawFrame rawFrame;
+        memcpy(rawFrame.data, frame, length);
+        rawFrame.length = static_cast<uint8_t>(length);
+        rawFrame.timestampUs = timestampUs;
+
+        if (!frameQueue.push(rawFrame))
+        {
+            queueOverflows++;
+        }
+    }
+
+public:
+    KLineReceiverTask(HardwareSerial &serialRef, IClock &clk) : serial(serialRef), clock(clk) {}
+
+    // ownTask = false - задача не создается, прием ведет poll() из основного цикла
+    bool begin(uint32_t gapTimeoutMs, bool ownTask = true)
+    {
+        setGapTimeout(gapTimeoutMs);
+
+        if (taskHandle != nullptr || !ownTask)
+            return true;
+
+        BaseType_t result = xTaskCreatePinnedToCore(taskEntry, "kline_rx", TASK_STACK_SIZE,
+                                                    this, TASK_PRIORITY, &taskHandle, TASK_CORE);
+        if (result != pdPASS)
+        {
+            taskHandle = nullptr;
+            Serial.println("❌ Не удалось запустить задачу приема K-Line");
+            return false;
+        }
+
+        // Обработчик вызывается из задачи событий UART и только будит нашу задачу
+        serial.onReceive([this]()
+                         {
+                             if (taskHandle != nullptr)
+                                 xTaskNotifyGive(taskHandle); });
+
+        return true;
+    }
+
+    // Разбор принятых байт; вызывается из задачи приема либо из основного цикла
+    void poll()
+    {
+        if (statsResetRequested.exchange(false))
+        {
+            framer.resetStats();
+            queueOverflows = 0;
+        }
+
+        uint32_t gapTimeoutMs = pendingGapTimeoutMs.exchange(NO_PENDING_GAP);
+        if (gapTimeoutMs != NO_PENDING_GAP)
+        {
+            framer.setGapTimeout(gapTimeoutMs);
+        }
+
+        framer.checkGap(static_cast<uint32_t>(clock.nowUs()));
+
+        while (serial.available())
+        {
+            uint8_t readByte = serial.read();
+            int64_t now = clock.nowUs();
+
+            framer.feed(readByte, static_cast<uint32_t>(now),
+                        [this, now](const uint8_t *frame, size_t length)
+                        { pushFrame(frame, length, now); });
+        }
+
+        publishStats();
+    }
+
+    // Новая пауза применяется задачей приема в следующем poll()
+    void setGapTimeout(uint32_t gapTimeoutMs)
+    {
+        pendingGapTimeoutMs = gapTimeoutMs;
+        if (taskHandle != nullptr)
+            xTaskNotifyGive(taskHandle);
+    }
+
+    // Вызывается только из основного цикла (единственный потребитель)
+    bool popFrame(WBusRawFrame &frame)
+    {
+        return frameQueue.pop(frame);
+    }
+
+    // Снимок на момент последнего poll(), безопасен из любой задачи
+    WBusFramerStats getStats() const
+    {
+        portENTER_CRITICAL(&statsMux);
+        WBusFramerStats stats = statsSnapshot;
+        portEXIT_CRITICAL(&statsMux);
+        return stats;
+    }
+
+    uint32_t getQueueOverflows() const
+    {
+        return queueOverflows;
+    }
+
+    size_t getQueueDepth() const
+    {
+        return frameQueue.size();
+    }
+
+    // Сброс выполняется внутри задачи приема
+    void resetStats()
+    {
+        statsResetRequested = true;
+    }
+};
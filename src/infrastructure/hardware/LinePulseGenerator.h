@@ -0,0 +1,219 @@
+// src/infrastructure/hardware/LinePulseGenerator.h
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+#include <driver/uart.h>
+#include <esp_timer.h>
+#include "../../common/Constants.h"
+
+// Импульс LOW заданной длительности: BREAK на линии K-Line или импульс NWAKE.
+// BREAK - инверсия TXD средствами UART (линия в LOW без передачи байта),
+// NWAKE - GPIO. Линию отпускает одноразовый esp_timer, поэтому длительность
+// не зависит от загрузки цикла. Фактическое время LOW измеряется и
+// сравнивается с заданным; для BREAK перед отпусканием проверяется, что RXD
+// действительно в LOW (трансивер может сам отпустить линию по таймауту TXD).
+class LinePulseGenerator
+{
+public:
+    enum class Kind
+    {
+        BREAK,
+        WAKE
+    };
+
+    static const uint32_t TOLERANCE_US = 1000;      // Допустимое отклонение длительности
+    static const uint32_t RELEASE_GRACE_US = 5000;  // Запас до принудительного отпускания из poll()
+
+    struct Measurement
+    {
+        Kind kind = Kind::BREAK;
+        uint32_t targetUs = 0;
+        uint32_t lowUs = 0;
+        int32_t errorUs = 0;
+        bool lineLow = true; // Для BREAK: RXD был в LOW в момент отпускания
+        bool forced = false; // Отпущено из poll(), таймер опоздал
+    };
+
+private:
+    esp_timer_handle_t timer = nullptr;
+    uint8_t rxPin = 0;
+
+    // Заполняются до запуска таймера или в его обработчике до completed
+    Kind kind = Kind::BREAK;
+    uint8_t wakePin = 0;
+    uint32_t targetUs = 0;
+    int64_t assertedUs = 0;
+    int64_t releasedUs = 0;
+    bool lineLow = true;
+    bool forced = false;
+
+    std::atomic<bool> active{false};
+    std::atomic<bool> completed{false};
+
+    Measurement last;
+    uint32_t pulses = 0;
+    uint32_t maxErrorUs = 0;
+    uint32_t violations = 0;
+    uint32_t forcedReleases = 0;
+    uint32_t lineNotLow = 0;
+
+    static void onTimer(void *arg)
+    {
+        static_cast<LinePulseGenerator *>(arg)->release();
+    }
+
+    void assertLine()
+    {
+        if (kind == Kind::BREAK)
+            uart_set_line_inverse(static_cast<uart_port_t>(KLINE_UART_NUM), UART_SIGNAL_TXD_INV);
+        else
+            digitalWrite(wakePin, LOW);
+    }
+
+    // Вызывается из таймера или из poll(); отпускает только один из них
+    void release()
+    {
+        if (!active.exchange(false))
+            return;
+
+        if (kind == Kind::BREAK)
+        {
+            lineLow = digitalRead(rxPin) == LOW;
+            uart_set_line_inverse(static_cast<uart_port_t>(KLINE_UART_NUM), UART_SIGNAL_INV_DISABLE);
+        }
+        else
+        {
+            digitalWrite(wakePin, HIGH);
+        }
+
+        releasedUs = esp_timer_get_time();
+        completed = true;
+    }
+
+    void record()
+    {
+        last.kind = kind;
+        last.targetUs = targetUs;
+        last.lowUs = static_cast<uint32_t>(releasedUs - assertedUs);
+        last.errorUs = static_cast<int32_t>(last.lowUs) - static_cast<int32_t>(targetUs);
+        last.lineLow = lineLow;
+        last.forced = forced;
+
+        uint32_t error = last.errorUs < 0 ? -last.errorUs : last.errorUs;
+        pulses++;
+        if (error > maxErrorUs)
+            maxErrorUs = error;
+        if (forced)
+            forcedReleases++;
+        if (!lineLow)
+            lineNotLow++;
+
+        if (error > TOLERANCE_US || !lineLow)
+        {
+            violations++;
+            Serial.println("⚠️ " + String(kind == Kind::BREAK ? "BREAK" : "WAKE") + " " + String(last.lowUs) +
+                           " мкс вместо " + String(targetUs) + (lineLow ? "" : ", линия не в LOW"));
+        }
+    }
+
+public:
+    ~LinePulseGenerator()
+    {
+        if (timer)
+        {
+            esp_timer_stop(timer);
+            esp_timer_delete(timer);
+        }
+    }
+
+    bool begin(uint8_t rxdPin)
+    {
+        rxPin = rxdPin;
+        if (timer)
+            return true;
+
+        esp_timer_create_args_t args = {};
+        args.callback = &LinePulseGenerator::onTimer;
+        args.arg = this;
+        args.dispatch_method = ESP_TIMER_TASK;
+        args.name = "line_pulse";
+        return esp_timer_create(&args, &timer) == ESP_OK;
+    }
+
+    // Линия переводится в LOW сразу, отпускается через durationUs
+    bool start(Kind pulseKind, uint32_t durationUs, uint8_t pin = 0)
+    {
+        if (!timer || active || completed)
+            return false;
+
+        kind = pulseKind;
+        wakePin = pin;
+        targetUs = durationUs;
+        lineLow = true;
+        forced = false;
+
+        assertLine();
+        assertedUs = esp_timer_get_time();
+        active = true;
+
+        if (esp_timer_start_once(timer, durationUs) != ESP_OK)
+        {
+            release();
+            return false;
+        }
+        return true;
+    }
+
+    // Досрочное отпускание (сон, отмена)
+    void abort()
+    {
+        if (timer)
+            esp_timer_stop(timer);
+        release();
+        completed = false;
+    }
+
+    // Из цикла: true - импульс завершен, измерение в getLast()
+    bool poll()
+    {
+        if (active && esp_timer_get_time() - assertedUs > static_cast<int64_t>(targetUs) + RELEASE_GRACE_US)
+        {
+            esp_timer_stop(timer);
+            forced = true;
+            release();
+        }
+
+        if (!completed.exchange(false))
+            return false;
+
+        record();
+        return true;
+    }
+
+    bool isActive() const
+    {
+        return active || completed;
+    }
+
+    const Measurement &getLast() const
+    {
+        return last;
+    }
+
+    String toJson() const
+    {
+        String json = "{";
+        json += "\"pulses\":" + String(pulses) + ",";
+        json += "\"lastKind\":\"" + String(last.kind == Kind::BREAK ? "BREAK" : "WAKE") + "\",";
+        json += "\"lastTargetUs\":" + String(last.targetUs) + ",";
+        json += "\"lastLowUs\":" + String(last.lowUs) + ",";
+        json += "\"lastErrorUs\":" + String(last.errorUs) + ",";
+        json += "\"maxErrorUs\":" + String(maxErrorUs) + ",";
+        json += "\"toleranceUs\":" + String(TOLERANCE_US) + ",";
+        json += "\"violations\":" + String(violations) + ",";
+        json += "\"forcedReleases\":" + String(forcedReleases) + ",";
+        json += "\"lineNotLow\":" + String(lineNotLow);
+        json += "}";
+        return json;
+    }
+};
@@ -5,6 +5,10 @@
 #include "./domain/Entities.h"
 #include "../../domain/Events.h"
 #include "../../common/Constants.h"
+#include "../../interfaces/IClock.h"
+#include "./LinePulseGenerator.h"
+#include <atomic>
+#include <driver/uart.h>
 
 class TJA1020Driver : public IBusManager
 {
@@ -13,12 +17,40 @@ private:
     EventBus &eventBus;
     ConfigManager &configManager;
     const BusConfig &config;
+    IClock &clock;
 
     ConnectionState connectionState = ConnectionState::DISCONNECTED;
 
+    // Шаги пробуждения, сна и BREAK: переход по истечении stepDeadlineUs,
+    // без delay() - цикл и UART продолжают обслуживаться
+    enum class Step
+    {
+        IDLE,
+        WAKE_NSLP,     // NSLP HIGH, ждем 10 мс
+        WAKE_PULSE,    // Импульс NWAKE LOW 2 мс (таймер)
+        WAKE_SETTLE,   // Ждем breakSignalDuration перед запуском UART
+        SLEEP_TX,      // TX HIGH, ждем 10 мс
+        SLEEP_SETTLE,  // NSLP LOW, ждем 10 мс
+        BREAK_LOW,     // Линия удерживается в LOW breakSignalDuration (таймер)
+        BREAK_RECOVER  // Линия отпущена, пауза breakRecoveryDuration
+    };
+
+    Step step = Step::IDLE;
+    int64_t stepDeadlineUs = 0;
+    unsigned long operationStartedAt = 0;
+    std::atomic<bool> breakRequested{false};
+    LinePulseGenerator linePulse;
+
+    // Передача кадра: окончание определяется опросом UART (uart_wait_tx_done с нулевым таймаутом)
+    bool txPending = false;
+    int64_t txStartUs = 0;
+    int64_t txExpectedEndUs = 0; // Расчетное окончание: длина * бит на символ / скорость
+    int64_t txLastPollUs = 0;
+    int64_t txCompleteUs = 0;
+
 public:
-    TJA1020Driver(ConfigManager &configMmngr, HardwareSerial &serialRef, EventBus &bus)
-        : serial(serialRef), eventBus(bus), configManager(configMmngr), config(configManager.getConfig().bus) {}
+    TJA1020Driver(ConfigManager &configMmngr, HardwareSerial &serialRef, EventBus &bus, IClock &clk)
+        : serial(serialRef), eventBus(bus), configManager(configMmngr), config(configManager.getConfig().bus), clock(clk) {}
 
     bool initialize() override
     {
@@ -34,6 +66,12 @@ public:
         digitalWrite(config.nslpPin, LOW);
         digitalWrite(config.nwakePin, HIGH);
 
+        if (!linePulse.begin(config.rxTjaPin))
+        {
+            Serial.println("❌ TJA1020: line pulse timer not created");
+            return false;
+        }
+
         // Serial.println("✅ TJA1020 Driver initialized");
         // Serial.println("  NSLP Pin: " + String(config.nslpPin));
         // Serial.println("  NWAKE Pin: " + String(config.nwakePin));
@@ -69,53 +107,114 @@ public:
         return connectionState;
     }
 
+    // Пробуждение: NSLP HIGH, 10 мс -> импульс NWAKE 2 мс -> ожидание breakSignalDuration -> UART
     void wakeUp() override
     {
         setConnectionState(ConnectionState::CONNECTING);
-        digitalWrite(config.nslpPin, HIGH);
-        delay(10);
-
-        digitalWrite(config.nwakePin, LOW);
-        delay(2);
-        digitalWrite(config.nwakePin, HIGH);
-
-        delay(config.breakSignalDuration);
-
-        setConnectionState(ConnectionState::CONNECTED);
-
-        // Инициализация UART с параметрами из конфига
-        serial.begin(config.baudRate, config.getSerialConfig(), config.rxTjaPin, config.txTjaPin);
+        operationStartedAt = clock.nowMs();
 
-        setConnectionState(ConnectionState::CONNECTED);
-        Serial.println("✅ TJA1020 connected");
+        digitalWrite(config.nslpPin, HIGH);
+        enterStep(Step::WAKE_NSLP, 10000);
     }
 
+    // BREAK только запрашивается (в том числе из обработчиков HTTP),
+    // выполняется из process(), когда драйвер свободен
     void sendBreak() override
     {
-        sendBreakSignal(true);
-        delay(config.breakSignalDuration);
-
-        sendBreakSignal(false);
-        delay(config.breakSignalDuration);
+        breakRequested = true;
     }
 
+    // Сон: TX HIGH, 10 мс -> остановка UART, NSLP LOW -> 10 мс.
+    // Команды перестают приниматься сразу.
     void sleep() override
     {
+        breakRequested = false;
+        linePulse.abort();
+        setConnectionState(ConnectionState::DISCONNECTED);
+        operationStartedAt = clock.nowMs();
+
         digitalWrite(config.txTjaPin, HIGH);
-        delay(10);
+        enterStep(Step::SLEEP_TX, 10000);
+    }
 
-        serial.end();
-        digitalWrite(config.nslpPin, LOW);
-        digitalWrite(config.nwakePin, HIGH);
+    void process() override
+    {
+        if (step == Step::IDLE)
+        {
+            if (breakRequested)
+            {
+                // BREAK инвертирует TXD - передача кадра должна быть закончена
+                if (isConnected() && isTxComplete())
+                    startBreak();
+                else if (isConnected())
+                    return;
+                else if (connectionState != ConnectionState::CONNECTING)
+                    breakRequested = false; // Линия не активна - BREAK не нужен
+            }
+            return;
+        }
 
-        delay(10);
+        if (clock.nowUs() < stepDeadlineUs)
+        {
+            clock.wakeAtUs(stepDeadlineUs);
+            return;
+        }
 
-        setConnectionState(ConnectionState::DISCONNECTED);
+        switch (step)
+        {
+        case Step::WAKE_NSLP:
+            linePulse.start(LinePulseGenerator::Kind::WAKE, WAKE_PULSE_US, config.nwakePin);
+            enterStep(Step::WAKE_PULSE, 0);
+            break;
+
+        case Step::WAKE_PULSE:
+            if (linePulse.isActive() && !linePulse.poll())
+                break;
+            enterStep(Step::WAKE_SETTLE, config.breakSignalDuration * 1000UL);
+            break;
+
+        case Step::WAKE_SETTLE:
+            // Инициализация UART с параметрами из конфига
+            serial.begin(config.baudRate, config.getSerialConfig(), config.rxTjaPin, config.txTjaPin);
+            setConnectionState(ConnectionState::CONNECTED);
+            Serial.println("✅ TJA1020 connected");
+            finish(BusDriverOperation::WAKE);
+            break;
+
+        case Step::SLEEP_TX:
+            serial.end();
+            digitalWrite(config.nslpPin, LOW);
+            digitalWrite(config.nwakePin, HIGH);
+            enterStep(Step::SLEEP_SETTLE, 10000);
+            break;
+
+        case Step::SLEEP_SETTLE:
+            Serial.println("💤 TJA1020 sleeping");
+            finish(BusDriverOperation::SLEEP);
+            break;
+
+        case Step::BREAK_LOW:
+            if (linePulse.isActive() && !linePulse.poll())
+                break;
+            enterStep(Step::BREAK_RECOVER, config.breakRecoveryDuration * 1000UL);
+            break;
+
+        case Step::BREAK_RECOVER:
+            finish(BusDriverOperation::BREAK);
+            break;
+
+        default:
+            step = Step::IDLE;
+            break;
+        }
+    }
 
-        Serial.println("💤 TJA1020 sleeping");
+    bool isBusy() const override
+    {
+        return step != Step::IDLE || breakRequested;
     }
 
-    bool sendCommand(uint8_t *data, size_t length) override
+    bool sendCommand(const uint8_t *data, size_t length) override
     {
         if (!isConnected())
         {
@@ -123,27 +222,53 @@ public:
             return false;
         }
 
-        for (int i = 0; i < length; i++)
+        // Кадр (до 64 байт) помещается в TX FIFO - запись возвращается сразу
+        txStartUs = clock.nowUs();
+        serial.write(data, length);
+
+        uint32_t frameUs = static_cast<uint32_t>((uint64_t)length * config.getBitsPerChar() * 1000000ULL / config.baudRate);
+        txExpectedEndUs = txStartUs + frameUs;
+        txLastPollUs = txStartUs;
+        txPending = true;
+
+        return true;
+    }
+
+    bool isTxComplete() override
+    {
+        if (!txPending)
+            return true;
+
+        int64_t now = clock.nowUs();
+        if (uart_wait_tx_done(static_cast<uart_port_t>(KLINE_UART_NUM), 0) != ESP_OK)
         {
-            serial.write(data[i]);
+            txLastPollUs = now;
+            clock.wakeAtUs(txExpectedEndUs);
+            return false;
         }
 
-        serial.flush();
-
+        // Расчетный момент точнее момента опроса, если он между двумя опросами
+        txPending = false;
+        txCompleteUs = txExpectedEndUs > txLastPollUs && txExpectedEndUs <= now ? txExpectedEndUs : now;
         return true;
     }
 
+    int64_t getTxCompleteUs() const override
+    {
+        return txCompleteUs;
+    }
+
     void sendBreakSignal(bool set) override
     {
         if (set)
         {
-            // BREAK set - удерживаем линию в LOW
-            serial.write(0x00); // Отправляем нулевой байт для BREAK
+            // BREAK set - линия в LOW на breakSignalDuration, отпустит таймер
+            linePulse.start(LinePulseGenerator::Kind::BREAK, config.breakSignalDuration * 1000UL);
         }
         else
         {
-            // BREAK reset - отпускаем линию
-            serial.flush(); // Очищаем буфер
+            // BREAK reset - отпускаем линию досрочно
+            linePulse.abort();
         }
     }
 
@@ -163,7 +288,42 @@ public:
         serial.flush();
     }
 
+    String getLineTimingJson() const override
+    {
+        return linePulse.toJson();
+    }
+
 private:
+    static const uint32_t WAKE_PULSE_US = 2000;
+
+    void enterStep(Step next, unsigned long durationUs)
+    {
+        step = next;
+        stepDeadlineUs = clock.nowUs() + durationUs;
+    }
+
+    void startBreak()
+    {
+        breakRequested = false;
+        operationStartedAt = clock.nowMs();
+
+        sendBreakSignal(true);
+        enterStep(Step::BREAK_LOW, 0);
+    }
+
+    void finish(BusDriverOperation operation)
+    {
+        step = Step::IDLE;
+
+        BusDriverOperationEvent event = {operation, static_cast<uint32_t>(clock.nowMs() - operationStartedAt)};
+        if (operation != BusDriverOperation::SLEEP)
+        {
+            event.pulseUs = linePulse.getLast().lowUs;
+            event.pulseErrorUs = linePulse.getLast().errorUs;
+        }
+        eventBus.publish<BusDriverOperationEvent>(EventType::BUS_DRIVER_OPERATION, event);
+    }
+
     void setConnectionState(ConnectionState newState)
     {
         if (connectionState != newState)
@@ -10,6 +10,7 @@
 #include "./SystemHandlers.h"
 #include "./EventHandlers.h"
 #include "./ConfigApiHandlers.h"
+#include "./BusApiHandlers.h"
 #include "./WebSocketManager.h"
 #include "./core/FileSystemManager.h"
 #include "./ApiHelpers.h"
@@ -17,6 +18,8 @@
 #include "../../application/ErrorsManager.h"
 #include "../../application/DeviceInfoManager.h"
 #include "../../application/SensorManager.h"
+#include "../../application/CommandReceiver.h"
+#include "../../application/CommandManager.h"
 
 class AsyncApiServer
 {
@@ -31,11 +34,14 @@ private:
     SensorManager &sensorManager;
     ErrorsManager &errorsManager;
     HeaterController &heaterController;
+    CommandReceiver &commandReceiver;
+    CommandManager &commandManager;
     WebastoApiHandlers webastoApiHandlers;
     OtaHandlers otaHandlers;
     SystemHandlers systemHandlers;
     EventHandlers eventHandlers;
     ConfigApiHandlers configApiHandlers;
+    BusApiHandlers busApiHandlers;
 
 public:
     AsyncApiServer(
@@ -45,7 +51,10 @@ public:
         DeviceInfoManager &deviceInfoMngr,
         SensorManager &sensorMngr,
         ErrorsManager &errorsMngr,
-        HeaterController &heaterCtrl)
+        HeaterController &heaterCtrl,
+        CommandReceiver &receiver,
+        CommandManager &commandMngr,
+        IClock &clock)
         : server(configMngr.getConfig().network.port),
           eventBus(bus),
           fsManager(fsMgr),
@@ -54,12 +63,15 @@ public:
           sensorManager(sensorMngr),
           errorsManager(errorsMngr),
           heaterController(heaterCtrl),
-          webastoApiHandlers(server, deviceInfoMngr, sensorMngr, errorsMngr, heaterCtrl),
+          commandReceiver(receiver),
+          commandManager(commandMngr),
+          webastoApiHandlers(server, deviceInfoMngr, sensorMngr, errorsMngr, heaterCtrl, commandMngr, clock),
           systemHandlers(server, configMngr),
           webSocketManager(eventBus, heaterCtrl),
           eventHandlers(webSocketManager),
-          otaHandlers(server, webSocketManager, configMngr, fsManager),
-          configApiHandlers(server, configMngr, fsManager)
+          otaHandlers(server, webSocketManager, configMngr, fsManager, clock),
+          configApiHandlers(server, configMngr, fsManager),
+          busApiHandlers(server, receiver, commandMngr)
     {
     }
 
@@ -110,6 +122,7 @@ public:
     {
         webSocketManager.process();
         otaHandlers.process();
+        webastoApiHandlers.process();
     }
 
     void broadcastJson(EventType eventType,
@@ -130,6 +143,7 @@ private:
         otaHandlers.setupEndpoints();
         systemHandlers.setupEndpoints();
         configApiHandlers.setupEndpoints();
+        busApiHandlers.setupEndpoints();
     }
     void handleNotFound(AsyncWebServerRequest *request)
     {
@@ -0,0 +1,81 @@
+// src/infrastructure/network/BusApiHandlers.h
+#pragma once
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <ArduinoJson.h>
+#include "../../application/CommandReceiver.h"
+#include "../../application/CommandManager.h"
+#include "./ApiHelpers.h"
+
+class BusApiHandlers
+{
+private:
+  AsyncWebServer &server;
+  CommandReceiver &commandReceiver;
+  CommandManager &commandManager;
+
+public:
+  BusApiHandlers(AsyncWebServer &serv, CommandReceiver &receiver, CommandManager &commandMngr) : server(serv),
+                                                                                                commandReceiver(receiver),
+                                                                                                commandManager(commandMngr) {}
+
+  void setupEndpoints()
+  {
+    // Статистика приема кадров K-Line
+    server.on("/api/bus/receiver", HTTP_GET, [this](AsyncWebServerRequest *request)
+              { handleReceiverStats(request); });
+
+    // Сброс статистики приема
+    server.on("/api/bus/receiver/reset", HTTP_POST, [this](AsyncWebServerRequest *request)
+              {
+      commandReceiver.resetFramerStats();
+      ApiHelpers::sendJsonResponse(request, "{\"status\":\"reset\"}"); });
+
+    // Статистика по командам: запросы, время ответа, NAK, таймауты, повторы
+    server.on("/api/bus/stats", HTTP_GET, [this](AsyncWebServerRequest *request)
+              { ApiHelpers::sendJsonResponse(request, commandManager.getStatisticsJson()); });
+
+    // Сброс статистики по командам
+    server.on("/api/bus/stats/reset", HTTP_POST, [this](AsyncWebServerRequest *request)
+              {
+      commandManager.resetStatistics();
+      ApiHelpers::sendJsonResponse(request, "{\"status\":\"reset\"}"); });
+
+    // Очереди по классам: глубина, ожидание, дубликаты, отказы по емкости
+    server.on("/api/bus/queues", HTTP_GET, [this](AsyncWebServerRequest *request)
+              { ApiHelpers::sendJsonResponse(request, commandManager.getQueueJson()); });
+
+    // Состояние шины: HEALTHY / DEGRADED / DOWN, отказы, пробные запросы
+    server.on("/api/bus/health", HTTP_GET, [this](AsyncWebServerRequest *request)
+              { ApiHelpers::sendJsonResponse(request, commandManager.getHealthJson()); });
+
+    // Оценка времени ответа по классам команд, текущие таймауты и паузы
+    server.on("/api/bus/timing", HTTP_GET, [this](AsyncWebServerRequest *request)
+              { ApiHelpers::sendJsonResponse(request, commandManager.getTimingJson()); });
+
+    // Расписание периодического опроса: группы, дедлайны, бюджет шины
+    server.on("/api/bus/poll", HTTP_GET, [this](AsyncWebServerRequest *request)
+              { ApiHelpers::sendJsonResponse(request, commandManager.getPollScheduleJson()); });
+
+    // Измерения BREAK и импульса NWAKE: фактическое время LOW, отклонения, нарушения
+    server.on("/api/bus/line", HTTP_GET, [this](AsyncWebServerRequest *request)
+              { ApiHelpers::sendJsonResponse(request, commandManager.getLineTimingJson()); });
+  }
+
+  void handleReceiverStats(AsyncWebServerRequest *request)
+  {
+    WBusFramerStats stats = commandReceiver.getFramerStats();
+
+    DynamicJsonDocument doc(512);
+    doc["framesReceived"] = stats.framesReceived;
+    doc["droppedFrames"] = stats.droppedFrames();
+    doc["checksumErrors"] = stats.checksumErrors;
+    doc["lengthErrors"] = stats.lengthErrors;
+    doc["gapAborts"] = stats.gapAborts;
+    doc["resyncs"] = stats.resyncs;
+    doc["discardedBytes"] = stats.discardedBytes;
+    doc["queueOverflows"] = commandReceiver.getQueueOverflows();
+
+    ApiHelpers::sendJsonDocument(request, doc);
+  }
+};
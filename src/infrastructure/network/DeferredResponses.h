@@ -0,0 +1,167 @@
+#pragma once
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "./ApiHelpers.h"
+#include "../../application/CommandManager.h"
+#include "../../interfaces/IClock.h"
+
+// Отложенные HTTP ответы (?wait=ms): запрос удерживается, пока нагреватель
+// не ответит на команду или не истечет ожидание. Клиент получает итог
+// за один запрос вместо POST и последующего опроса статуса.
+// Число удерживаемых запросов ограничено, при нехватке места ответ - сразу.
+class DeferredResponses
+{
+public:
+    static const size_t CAPACITY = 8;
+    static const uint32_t MAX_WAIT_MS = 10000;
+
+private:
+    struct Entry
+    {
+        bool used = false;
+        AsyncWebServerRequestPtr request;
+        CommandHandle handle;
+        bool owned = false;
+        unsigned long deadline = 0;
+        String body;
+    };
+
+    CommandManager &commandManager;
+    IClock &clock;
+    Entry entries[CAPACITY];
+
+    // Итог команды добавляется в тело ответа полем "result"
+    static String withResult(const String &body, const CommandResult &result)
+    {
+        int end = body.lastIndexOf('}');
+        if (end < 0)
+            return body;
+
+        String json = body.substring(0, end);
+        json += json.endsWith("{") ? "" : ",";
+        json += "\"result\":" + result.toJson() + "}";
+        return json;
+    }
+
+    static int statusFor(CommandOutcome outcome)
+    {
+        switch (outcome)
+        {
+        case CommandOutcome::PENDING:
+            return 202;
+        case CommandOutcome::NAK:
+            return 422;
+        case CommandOutcome::TIMEOUT:
+            return 504;
+        case CommandOutcome::CANCELLED:
+            return 503;
+        default:
+            return 200;
+        }
+    }
+
+    void finish(Entry &entry, const CommandResult &result)
+    {
+        // Клиент мог отключиться, пока ждал ответа
+        std::shared_ptr<AsyncWebServerRequest> request = entry.request.lock();
+        if (request)
+            ApiHelpers::sendJsonResponse(request.get(), withResult(entry.body, result), statusFor(result.outcome));
+
+        release(entry.handle, entry.owned);
+        entry = Entry();
+    }
+
+    // Итог больше не нужен - запись результата можно занять заново.
+    // Чужую запись (шаг последовательности) освобождает ее владелец.
+    void release(const CommandHandle &handle, bool owned)
+    {
+        if (owned)
+            commandManager.releaseResult(handle);
+    }
+
+    void reply(AsyncWebServerRequest *request, const CommandHandle &handle, const String &body, bool owned)
+    {
+        int waitMs = ApiHelpers::getIntParam(request, "wait", 0);
+        if (waitMs <= 0)
+        {
+            // Итог ждать не будут - запись результата освобождается сразу
+            release(handle, owned);
+            ApiHelpers::sendJsonResponse(request, body);
+            return;
+        }
+
+        if (!handle)
+        {
+            ApiHelpers::sendJsonError(request, "Command rejected", 503);
+            return;
+        }
+
+        CommandResult result = commandManager.getResult(handle);
+        if (!handle.isTracked() || result.isDone())
+        {
+            release(handle, owned);
+            ApiHelpers::sendJsonResponse(request, withResult(body, result), statusFor(result.outcome));
+            return;
+        }
+
+        for (size_t i = 0; i < CAPACITY; i++)
+        {
+            if (entries[i].used)
+                continue;
+
+            Entry &entry = entries[i];
+            entry.used = true;
+            entry.request = request->pause();
+            entry.handle = handle;
+            entry.owned = owned;
+            entry.deadline = clock.nowMs() + (static_cast<uint32_t>(waitMs) < MAX_WAIT_MS ? waitMs : MAX_WAIT_MS);
+            entry.body = body;
+            return;
+        }
+
+        // Все места заняты - отвечаем без ожидания
+        release(handle, owned);
+        ApiHelpers::sendJsonResponse(request, withResult(body, result), statusFor(result.outcome));
+    }
+
+public:
+    DeferredResponses(CommandManager &commandMngr, IClock &clk) : commandManager(commandMngr), clock(clk) {}
+
+    // Ответ на запрос команды: сразу (body) или с итогом команды, если задан ?wait=ms
+    void respond(AsyncWebServerRequest *request, const CommandHandle &handle, const String &body)
+    {
+        reply(request, handle, body, true);
+    }
+
+    // То же для команды, итог которой читает и освобождает другой владелец
+    void observe(AsyncWebServerRequest *request, const CommandHandle &handle, const String &body)
+    {
+        reply(request, handle, body, false);
+    }
+
+    void respond(AsyncWebServerRequest *request, const CommandHandle &handle, DynamicJsonDocument &doc)
+    {
+        String body;
+        serializeJson(doc, body);
+        respond(request, handle, body);
+    }
+
+    void process()
+    {
+        unsigned long now = clock.nowMs();
+
+        for (size_t i = 0; i < CAPACITY; i++)
+        {
+            Entry &entry = entries[i];
+            if (!entry.used)
+                continue;
+
+            // UNKNOWN - запись результата уже вытеснена, ждать нечего
+            CommandResult result = commandManager.getResult(entry.handle);
+            if (result.outcome != CommandOutcome::PENDING || (long)(now - entry.deadline) >= 0)
+                finish(entry, result);
+            else
+                clock.wakeAt(entry.deadline);
+        }
+    }
+};
@@ -79,18 +79,43 @@ public:
                                              "\"" + event.source + "\"");
                            });
 
+        eventBus.subscribe(EventType::BUS_HEALTH_CHANGED,
+                           [this](const Event &event)
+                           {
+                               const auto &healthEvent = static_cast<
+                                   const TypedEvent<BusHealthChangedEvent> &>(event);
+                               broadcastJson(EventType::BUS_HEALTH_CHANGED,
+                                             healthEvent.data.toJson());
+                           });
+
+        eventBus.subscribe(EventType::BUS_DRIVER_OPERATION,
+                           [this](const Event &event)
+                           {
+                               const auto &operationEvent = static_cast<
+                                   const TypedEvent<BusDriverOperationEvent> &>(event);
+                               broadcastJson(EventType::BUS_DRIVER_OPERATION,
+                                             operationEvent.data.toJson());
+                           });
+
+        // HEX кадра формируется только при подписанных клиентах
         eventBus.subscribe(EventType::TX_RECEIVED,
                            [this](const Event &event)
                            {
-                               broadcastJson(EventType::TX_RECEIVED,
-                                                     "\"" + event.source + "\"");
+                               if (!webSocketManager.hasSubscribers(EventType::TX_RECEIVED))
+                                   return;
+                               const auto &frameEvent = static_cast<
+                                   const TypedEvent<FrameReceivedEvent> &>(event);
+                               broadcastJson(EventType::TX_RECEIVED, frameEvent.data.toJson());
                            });
 
         eventBus.subscribe(EventType::RX_RECEIVED,
                            [this](const Event &event)
                            {
-                               broadcastJson(EventType::RX_RECEIVED,
-                                                     "\"" + event.source + "\"");
+                               if (!webSocketManager.hasSubscribers(EventType::RX_RECEIVED))
+                                   return;
+                               const auto &frameEvent = static_cast<
+                                   const TypedEvent<FrameReceivedEvent> &>(event);
+                               broadcastJson(EventType::RX_RECEIVED, frameEvent.data.toJson());
                            });
 
         eventBus.subscribe(EventType::COMMAND_RECEIVED,
@@ -7,6 +7,7 @@
 #include "./common/Version.h"
 #include "./common/Utils.h"
 #include "./ApiHelpers.h"
+#include "../../interfaces/IClock.h"
 
 class OtaHandlers
 {
@@ -15,6 +16,7 @@ private:
     WebSocketManager &webSocketManager;
     ConfigManager &configManager;
     FileSystemManager &fsManager;
+    IClock &clock;
 
     struct OtaState
     {
@@ -28,8 +30,8 @@ private:
     } otaState;
 
 public:
-    OtaHandlers(AsyncWebServer &serv, WebSocketManager &wsMngr, ConfigManager &configMngr, FileSystemManager &fsMgr)
-        : server(serv), webSocketManager(wsMngr), configManager(configMngr), fsManager(fsMgr) {}
+    OtaHandlers(AsyncWebServer &serv, WebSocketManager &wsMngr, ConfigManager &configMngr, FileSystemManager &fsMgr, IClock &clk)
+        : server(serv), webSocketManager(wsMngr), configManager(configMngr), fsManager(fsMgr), clock(clk) {}
 
     void setupEndpoints()
     {
@@ -53,11 +55,18 @@ public:
     void process()
     {
         // Проверяем отложенную перезагрузку
-        if (otaState.rebootScheduled && millis() >= otaState.rebootTime)
+        if (!otaState.rebootScheduled)
+            return;
+
+        if (clock.nowMs() >= otaState.rebootTime)
         {
             Serial.println("🔄 Executing scheduled reboot...");
             ESP.restart();
         }
+        else
+        {
+            clock.wakeAt(otaState.rebootTime);
+        }
     }
 
     // Метод для отправки прогресса через WebSocket
@@ -82,7 +91,7 @@ public:
             // Рассчитываем скорость
             if (otaState.receivedSize > 0)
             {
-                uint32_t elapsed = millis() - otaState.startTime;
+                uint32_t elapsed = clock.nowMs() - otaState.startTime;
                 if (elapsed > 0)
                 {
                     uint32_t speed = (otaState.receivedSize * 1000) / elapsed;
@@ -193,7 +202,7 @@ private:
 
         otaState.inProgress = true;
         otaState.receivedSize = 0;
-        otaState.startTime = millis();
+        otaState.startTime = clock.nowMs();
         otaState.rebootScheduled = false;
         otaState.lastBroadcastProgress = -1;
 
@@ -242,14 +251,14 @@ private:
         doc["message"] = "Firmware updated successfully. Rebooting...";
         doc["filename"] = filename;
         doc["size"] = otaState.receivedSize;
-        doc["duration"] = (millis() - otaState.startTime) / 1000;
+        doc["duration"] = (clock.nowMs() - otaState.startTime) / 1000;
 
         // Планируем перезагрузку через 2 секунды
         otaState.rebootScheduled = true;
-        otaState.rebootTime = millis() + 2000;
+        otaState.rebootTime = clock.nowMs() + 2000;
 
         Serial.printf("🎉 OTA Success: %s (%u bytes in %u ms)\n",
-                      filename.c_str(), otaState.receivedSize, millis() - otaState.startTime);
+                      filename.c_str(), otaState.receivedSize, clock.nowMs() - otaState.startTime);
         Serial.println("🔄 Scheduled reboot in 2 seconds...");
 
         String json;
@@ -92,6 +92,15 @@ private:
         memory["heap"]["usedFormatted"] = String(heapUsed / 1024.0, 1) + " KB";
         memory["heap"]["usagePercent"] = String(heapUsagePercent, 1) + "%";
 
+        // Пиковое использование с момента загрузки и наибольший свободный блок
+        size_t heapMinFree = ESP.getMinFreeHeap();
+        memory["heap"]["minFree"] = heapMinFree;
+        memory["heap"]["peakUsed"] = heapTotal - heapMinFree;
+        memory["heap"]["maxAlloc"] = ESP.getMaxAllocHeap();
+        memory["heap"]["minFreeFormatted"] = String(heapMinFree / 1024.0, 1) + " KB";
+        memory["heap"]["peakUsedFormatted"] = String((heapTotal - heapMinFree) / 1024.0, 1) + " KB";
+        memory["heap"]["maxAllocFormatted"] = String(ESP.getMaxAllocHeap() / 1024.0, 1) + " KB";
+
         // PSRAM (если есть)
         if (ESP.getPsramSize() > 0)
         {
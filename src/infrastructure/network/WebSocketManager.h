@@ -34,6 +34,12 @@ public:
         ws.cleanupClients();
     }
 
+    // Позволяет не формировать сообщение, если его никто не получит
+    bool hasSubscribers(EventType eventType) const
+    {
+        return subscriptionManager.hasEventSubscribers(eventType);
+    }
+
     void broadcastJsonToClient(EventType eventType, const String &json)
     {
         auto subscribers = subscriptionManager.getEventSubscribers(eventType);
@@ -46,6 +46,13 @@ public:
         return {};
     }
 
+    // Есть ли подписчики (без копирования набора)
+    bool hasEventSubscribers(EventType eventType) const
+    {
+        auto it = eventSubscribers.find(eventType);
+        return it != eventSubscribers.end() && !it->second.empty();
+    }
+
     // Получить всех подписчиков события
     std::set<uint32_t> getEventSubscribers(EventType eventType) const
     {
@@ -4,6 +4,7 @@
 #include <ArduinoJson.h>
 #include "./domain/Events.h"
 #include "./ApiHelpers.h"
+#include "./DeferredResponses.h"
 #include "../../application/HeaterController.h"
 #include "../../application/ErrorsManager.h"
 #include "../../application/DeviceInfoManager.h"
@@ -18,17 +19,21 @@ private:
     SensorManager &sensorManager;
     ErrorsManager &errorsManager;
     HeaterController &heaterController;
+    DeferredResponses deferredResponses; // Ответы с ожиданием итога команды (?wait=ms)
 
 public:
     WebastoApiHandlers(AsyncWebServer &serv,
                        DeviceInfoManager &deviceInfoMngr,
                        SensorManager &sensorMngr,
                        ErrorsManager &errorsMngr,
-                       HeaterController &heaterCtrl) : server(serv),
-                                                       deviceInfoManager(deviceInfoMngr),
-                                                       sensorManager(sensorMngr),
-                                                       errorsManager(errorsMngr),
-                                                       heaterController(heaterCtrl) {}
+                       HeaterController &heaterCtrl,
+                       CommandManager &commandMngr,
+                       IClock &clock) : server(serv),
+                                                      deviceInfoManager(deviceInfoMngr),
+                                                      sensorManager(sensorMngr),
+                                                      errorsManager(errorsMngr),
+                                                      heaterController(heaterCtrl),
+                                                      deferredResponses(commandMngr, clock) {}
 
     void setupEndpoints()
     {
@@ -169,16 +174,44 @@ public:
                   {
                       handleClearErrors(request);
                   });
+
+        // =========================================================================
+        // ПОСЛЕДОВАТЕЛЬНОСТИ
+        // =========================================================================
+        server.on("/api/sequences", HTTP_GET,
+                  [this](AsyncWebServerRequest *request)
+                  {
+                      handleGetSequences(request);
+                  });
+
+        server.on("/api/test/self-test", HTTP_POST,
+                  [this](AsyncWebServerRequest *request)
+                  {
+                      handleSelfTest(request);
+                  });
+
+        server.on("/api/errors/readout", HTTP_POST,
+                  [this](AsyncWebServerRequest *request)
+                  {
+                      handleErrorReadout(request);
+                  });
+    }
+
+    void process()
+    {
+        deferredResponses.process();
     }
 
     // =========================================================================
     // ОБРАБОТЧИКИ HTTP ЗАПРОСОВ
+    // Команды нагревателю отвечают сразу, а с ?wait=ms - после ответа нагревателя
     // =========================================================================
 
     void handleConnect(AsyncWebServerRequest *request)
     {
-        heaterController.connect();
-        ApiHelpers::sendJsonResponse(request, "{\"status\":\"connecting\"}");
+        // Дескриптор принадлежит шагу диагностики последовательности подключения
+        CommandHandle handle = heaterController.connect();
+        deferredResponses.observe(request, handle, "{\"status\":\"connecting\"}");
     }
 
     void handleDisconnect(AsyncWebServerRequest *request)
@@ -201,72 +234,72 @@ public:
     void handleStartParking(AsyncWebServerRequest *request)
     {
         int minutes = ApiHelpers::getIntParam(request, "minutes", 59);
-        heaterController.startParkingHeat(minutes);
+        CommandHandle handle = heaterController.startParkingHeat(minutes);
 
         DynamicJsonDocument doc(128);
         doc["status"] = "started";
         doc["mode"] = "parking";
         doc["minutes"] = minutes;
 
-        ApiHelpers::sendJsonDocument(request, doc);
+        deferredResponses.respond(request, handle, doc);
     }
 
     void handleStartVentilation(AsyncWebServerRequest *request)
     {
         int minutes = ApiHelpers::getIntParam(request, "minutes", 59);
-        heaterController.startVentilation(minutes);
+        CommandHandle handle = heaterController.startVentilation(minutes);
 
         DynamicJsonDocument doc(128);
         doc["status"] = "started";
         doc["mode"] = "ventilation";
         doc["minutes"] = minutes;
 
-        ApiHelpers::sendJsonDocument(request, doc);
+        deferredResponses.respond(request, handle, doc);
     }
 
     void handleStartSupplemental(AsyncWebServerRequest *request)
     {
         int minutes = ApiHelpers::getIntParam(request, "minutes", 59);
-        heaterController.startSupplementalHeat(minutes);
+        CommandHandle handle = heaterController.startSupplementalHeat(minutes);
 
         DynamicJsonDocument doc(128);
         doc["status"] = "started";
         doc["mode"] = "supplemental";
         doc["minutes"] = minutes;
 
-        ApiHelpers::sendJsonDocument(request, doc);
+        deferredResponses.respond(request, handle, doc);
     }
 
     void handleStartBoost(AsyncWebServerRequest *request)
     {
         int minutes = ApiHelpers::getIntParam(request, "minutes", 59);
-        heaterController.startBoostMode(minutes);
+        CommandHandle handle = heaterController.startBoostMode(minutes);
 
         DynamicJsonDocument doc(128);
         doc["status"] = "started";
         doc["mode"] = "boost";
         doc["minutes"] = minutes;
 
-        ApiHelpers::sendJsonDocument(request, doc);
+        deferredResponses.respond(request, handle, doc);
     }
 
     void handleControlCirculationPump(AsyncWebServerRequest *request, JsonVariant &json)
     {
 
         int enable = json["enable"] | false;
-        heaterController.controlCirculationPump(enable);
+        CommandHandle handle = heaterController.controlCirculationPump(enable);
 
         DynamicJsonDocument doc(128);
         doc["status"] = "updated";
         doc["pumpEnabled"] = enable;
 
-        ApiHelpers::sendJsonDocument(request, doc);
+        deferredResponses.respond(request, handle, doc);
     }
 
     void handleShutdown(AsyncWebServerRequest *request)
     {
-        heaterController.shutdown();
-        ApiHelpers::sendJsonResponse(request, "{\"status\":\"shutdown\"}");
+        CommandHandle handle = heaterController.shutdown();
+        deferredResponses.respond(request, handle, "{\"status\":\"shutdown\"}");
     }
 
     void handleFuelCirculation(AsyncWebServerRequest *request, JsonVariant &json)
@@ -274,13 +307,13 @@ public:
         int seconds = json["seconds"] | 59;
 
         seconds = constrain(seconds, 1, 59);
-        heaterController.fuelCirculation(seconds);
+        CommandHandle handle = heaterController.fuelCirculation(seconds);
 
         DynamicJsonDocument doc(128);
         doc["status"] = "started";
         doc["seconds"] = seconds;
 
-        ApiHelpers::sendJsonDocument(request, doc);
+        deferredResponses.respond(request, handle, doc);
     }
 
     void handleTestCombustionFan(AsyncWebServerRequest *request, JsonVariant &json)
@@ -296,7 +329,7 @@ public:
 
         seconds = constrain(seconds, 1, 30);
         power = constrain(power, 1, 100);
-        heaterController.testCombustionFan(seconds, power);
+        CommandHandle handle = heaterController.testCombustionFan(seconds, power);
 
         DynamicJsonDocument doc(128);
         doc["status"] = "testing";
@@ -304,7 +337,7 @@ public:
         doc["seconds"] = seconds;
         doc["power"] = power;
 
-        ApiHelpers::sendJsonDocument(request, doc);
+        deferredResponses.respond(request, handle, doc);
     }
 
     void handleTestFuelPump(AsyncWebServerRequest *request, JsonVariant &json)
@@ -320,7 +353,7 @@ public:
 
         seconds = constrain(seconds, 1, 30);
         frequency = constrain(frequency, 1, 255);
-        heaterController.testFuelPump(seconds, frequency);
+        CommandHandle handle = heaterController.testFuelPump(seconds, frequency);
 
         DynamicJsonDocument doc(128);
         doc["status"] = "testing";
@@ -328,7 +361,7 @@ public:
         doc["seconds"] = seconds;
         doc["frequency"] = frequency;
 
-        ApiHelpers::sendJsonDocument(request, doc);
+        deferredResponses.respond(request, handle, doc);
     }
 
     void handleTestGlowPlug(AsyncWebServerRequest *request, JsonVariant &json)
@@ -344,7 +377,7 @@ public:
 
         seconds = constrain(seconds, 1, 30);
         power = constrain(power, 1, 100);
-        heaterController.testGlowPlug(seconds, power);
+        CommandHandle handle = heaterController.testGlowPlug(seconds, power);
 
         DynamicJsonDocument doc(128);
         doc["status"] = "testing";
@@ -352,7 +385,7 @@ public:
         doc["seconds"] = seconds;
         doc["power"] = power;
 
-        ApiHelpers::sendJsonDocument(request, doc);
+        deferredResponses.respond(request, handle, doc);
     }
 
     void handleTestCirculationPump(AsyncWebServerRequest *request, JsonVariant &json)
@@ -366,14 +399,14 @@ public:
         int seconds = json["seconds"] | 10;
 
         seconds = constrain(seconds, 1, 30);
-        heaterController.testCirculationPump(seconds);
+        CommandHandle handle = heaterController.testCirculationPump(seconds);
 
         DynamicJsonDocument doc(128);
         doc["status"] = "testing";
         doc["component"] = "circulationPump";
         doc["seconds"] = seconds;
 
-        ApiHelpers::sendJsonDocument(request, doc);
+        deferredResponses.respond(request, handle, doc);
     }
 
     void handleTestVehicleFan(AsyncWebServerRequest *request, JsonVariant &json)
@@ -386,14 +419,14 @@ public:
 
         int seconds = json["seconds"] | 10;
         seconds = constrain(seconds, 1, 30);
-        heaterController.testVehicleFan(seconds);
+        CommandHandle handle = heaterController.testVehicleFan(seconds);
 
         DynamicJsonDocument doc(128);
         doc["status"] = "testing";
         doc["component"] = "vehicleFan";
         doc["seconds"] = seconds;
 
-        ApiHelpers::sendJsonDocument(request, doc);
+        deferredResponses.respond(request, handle, doc);
     }
 
     void handleTestSolenoid(AsyncWebServerRequest *request, JsonVariant &json)
@@ -406,14 +439,14 @@ public:
 
         int seconds = json["seconds"] | 10;
         seconds = constrain(seconds, 1, 30);
-        heaterController.testSolenoidValve(seconds);
+        CommandHandle handle = heaterController.testSolenoidValve(seconds);
 
         DynamicJsonDocument doc(128);
         doc["status"] = "testing";
         doc["component"] = "solenoid";
         doc["seconds"] = seconds;
 
-        ApiHelpers::sendJsonDocument(request, doc);
+        deferredResponses.respond(request, handle, doc);
     }
 
     void handleTestFuelPreheating(AsyncWebServerRequest *request, JsonVariant &json)
@@ -429,7 +462,7 @@ public:
 
         seconds = constrain(seconds, 1, 30);
         power = constrain(power, 1, 100);
-        heaterController.testFuelPreheating(seconds, power);
+        CommandHandle handle = heaterController.testFuelPreheating(seconds, power);
 
         DynamicJsonDocument doc(128);
         doc["status"] = "testing";
@@ -437,7 +470,7 @@ public:
         doc["seconds"] = seconds;
         doc["power"] = power;
 
-        ApiHelpers::sendJsonDocument(request, doc);
+        deferredResponses.respond(request, handle, doc);
     }
 
     void handleGetDeviceInfo(AsyncWebServerRequest *request)
@@ -464,4 +497,29 @@ public:
         errorsManager.resetErrors();
         ApiHelpers::sendJsonResponse(request, "{\"status\":\"cleared\"}");
     }
+
+    void handleGetSequences(AsyncWebServerRequest *request)
+    {
+        ApiHelpers::sendJsonResponse(request, heaterController.getSequencesJson());
+    }
+
+    void handleSelfTest(AsyncWebServerRequest *request)
+    {
+        if (!heaterController.runSelfTest())
+        {
+            ApiHelpers::sendJsonError(request, "Sequence already running", 409);
+            return;
+        }
+        ApiHelpers::sendJsonResponse(request, "{\"status\":\"started\",\"sequence\":\"self-test\"}");
+    }
+
+    void handleErrorReadout(AsyncWebServerRequest *request)
+    {
+        if (!heaterController.runErrorReadout())
+        {
+            ApiHelpers::sendJsonError(request, "Sequence already running", 409);
+            return;
+        }
+        ApiHelpers::sendJsonResponse(request, "{\"status\":\"started\",\"sequence\":\"errors\"}");
+    }
 };
\ No newline at end of file
@@ -9,12 +9,14 @@
 #include "../../core/ConfigManager.h"
 #include "../../core/EventBus.h"
 #include "../../domain/Events.h"
+#include "../../interfaces/IClock.h"
 
 class WiFiManager
 {
 private:
     ConfigManager &configManager;
     EventBus &eventBus;
+    IClock &clock;
 
     // DNS сервер для captive portal
     DNSServer dnsServer;
@@ -33,8 +35,8 @@ private:
     bool isSTAMode = false;
 
 public:
-    WiFiManager(ConfigManager &config, EventBus &bus)
-        : configManager(config), eventBus(bus)
+    WiFiManager(ConfigManager &config, EventBus &bus, IClock &clk)
+        : configManager(config), eventBus(bus), clock(clk)
     {
         // Настраиваем обработчики событий WiFi
         WiFi.onEvent([this](arduino_event_id_t event, arduino_event_info_t info)
@@ -70,9 +72,11 @@ public:
 
     void process()
     {
+        unsigned long now = clock.nowMs();
+
         // Проверка таймаута подключения STA
         if (connectionInProgress &&
-            millis() - connectionStartTime > CONNECTION_TIMEOUT)
+            now - connectionStartTime > CONNECTION_TIMEOUT)
         {
             Serial.println("⏰ WiFi connection timeout");
             connectionInProgress = false;
@@ -84,14 +88,14 @@ public:
         if (!isConnected() &&
             isSTAMode &&
             !connectionInProgress &&
-            millis() - lastConnectionAttempt > netConfig.reconnectInterval &&
+            now - lastConnectionAttempt > netConfig.reconnectInterval &&
             !netConfig.staSsid.isEmpty())
         {
             Serial.println("🔄 Attempting to reconnect WiFi...");
-            lastConnectionAttempt = millis();
+            lastConnectionAttempt = now;
 
             connectionInProgress = true;
-            connectionStartTime = millis();
+            connectionStartTime = now;
 
             WiFi.reconnect();
         }
@@ -111,7 +115,7 @@ private:
             Serial.println("📡 WiFi STA mode started");
             isSTAMode = true;
             connectionInProgress = true;
-            connectionStartTime = millis();
+            connectionStartTime = clock.nowMs();
             break;
 
         case ARDUINO_EVENT_WIFI_STA_CONNECTED:
@@ -288,7 +292,7 @@ public:
 
         stopMDNS();
         WiFi.disconnect(true);
-        delay(1000);
+        clock.sleepMs(1000);
 
         return initialize();
     }
@@ -359,7 +363,7 @@ private:
         WiFi.setSleep(false);
 
         connectionInProgress = true;
-        connectionStartTime = millis();
+        connectionStartTime = clock.nowMs();
 
         WiFi.begin(netConfig.staSsid.c_str(), netConfig.staPassword.c_str());
 
@@ -401,7 +405,7 @@ private:
         if (!netConfig.staSsid.isEmpty())
         {
             connectionInProgress = true;
-            connectionStartTime = millis();
+            connectionStartTime = clock.nowMs();
             WiFi.begin(netConfig.staSsid.c_str(), netConfig.staPassword.c_str());
         }
 
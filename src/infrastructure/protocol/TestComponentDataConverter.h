@@ -1,6 +1,7 @@
 #pragma once
 #include <Arduino.h>
 #include "../../common/Utils.h"
+#include "../../common/PacketView.h"
 
 // =========================================================================
 // КЛАСС ДЛЯ ПРЕОБРАЗОВАНИЯ ПАРАМЕТРОВ ТЕСТИРОВАНИЯ
@@ -17,26 +18,26 @@ public:
         TestCommandInfo() : component(0), seconds(0), magnitude(0) {}
     };
 
-    static TestCommandInfo decodeTestCommand(const String &txCommand)
+    static TestCommandInfo decodeTestCommand(const PacketView &txCommand)
     {
         TestCommandInfo info;
 
         // Формат команды: F4 06 45 [COMPONENT] [SECONDS] [MAGNITUDE_MSB] [MAGNITUDE_LSB] [CHECKSUM]
 
-        // Проверяем минимальную длину (8 байт = 16 символов)
-        if (txCommand.length() < 16)
-        { // Учитываем пробелы в исходной строке
+        // Проверяем минимальную длину (8 байт)
+        if (txCommand.size() < 8)
+        {
             return info;
         }
 
         // Извлекаем компонент (4-й байт в команде, индекс 3)
-        info.component = Utils::extractByteFromString(txCommand, 3);
+        info.component = txCommand[3];
         // Извлекаем время в секундах (5-й байт, индекс 4)
-        info.seconds = Utils::extractByteFromString(txCommand, 4);
+        info.seconds = txCommand[4];
 
         // Извлекаем величину (2 байта, индексы 5 и 6)
-        uint8_t magnitudeMsb = Utils::extractByteFromString(txCommand, 5);
-        uint8_t magnitudeLsb = Utils::extractByteFromString(txCommand, 6);
+        uint8_t magnitudeMsb = txCommand[5];
+        uint8_t magnitudeLsb = txCommand[6];
         info.magnitude = (magnitudeMsb << 8) | magnitudeLsb;
 
         return info;
@@ -47,7 +48,7 @@ public:
     // =========================================================================
 
     // Вентилятор горения: 0-100% → 0-510 (0.5% на единицу)
-    static uint16_t combustionFanPercentToMagnitude(uint8_t percent)
+    static constexpr uint16_t combustionFanPercentToMagnitude(uint8_t percent)
     {
         percent = constrain(percent, 0, 100);
         float value_f = (percent * 510.0f) / 100.0f;
@@ -63,23 +64,22 @@ public:
 
     // =========================================================================
 
-    // Топливный насос: Гц → величина (1 Гц = 2 единицы)
-    static uint16_t fuelPumpHzToMagnitude(uint8_t frequencyHz)
+    // Топливный насос: Гц → величина (1 Гц = 20 единиц, шаг 0.05 Гц)
+    static constexpr uint16_t fuelPumpHzToMagnitude(uint8_t frequencyHz)
     {
-        frequencyHz = constrain(frequencyHz, 0, 255);
-        return frequencyHz;
+        return static_cast<uint16_t>(frequencyHz * 20U);
     }
 
     // Обратное преобразование: величина → Гц
     static uint8_t fuelPumpMagnitudeToHz(uint16_t magnitude)
     {
-        return magnitude / 2;
+        return static_cast<uint8_t>(magnitude / 20U);
     }
 
     // =========================================================================
 
     // Свеча накаливания: 0-100% → 0-200 (0.5% на единицу)
-    static uint16_t glowPlugPercentToMagnitude(uint8_t percent)
+    static constexpr uint16_t glowPlugPercentToMagnitude(uint8_t percent)
     {
         percent = constrain(percent, 0, 100);
         return static_cast<uint16_t>((percent * 200UL) / 100UL);
@@ -94,7 +94,7 @@ public:
     // =========================================================================
 
     // Циркуляционный насос: 0-100% → 0-200 (0.5% на единицу)
-    static uint16_t circulationPumpPercentToMagnitude(uint8_t percent)
+    static constexpr uint16_t circulationPumpPercentToMagnitude(uint8_t percent)
     {
         percent = constrain(percent, 0, 100);
         return percent * 2;
@@ -109,7 +109,7 @@ public:
     // =========================================================================
 
     // Подогрев топлива: 0-100% → 0-510 (0.5% на единицу)
-    static uint16_t fuelPreheatingPercentToMagnitude(uint8_t percent)
+    static constexpr uint16_t fuelPreheatingPercentToMagnitude(uint8_t percent)
     {
         percent = constrain(percent, 0, 100);
         float value_f = (percent * 510.0f) / 100.0f;
@@ -127,17 +127,17 @@ public:
     // УНИВЕРСАЛЬНЫЕ ФУНКЦИИ ДЛЯ КОМАНД БЕЗ ПАРАМЕТРОВ
     // =========================================================================
 
-    // Вентилятор автомобиля: всегда 0xffff
-    static uint16_t vehicleFanToMagnitude()
+    // Вентилятор автомобиля: всегда 1 (включить)
+    static constexpr uint16_t vehicleFanToMagnitude()
     {
-        return 0xffff;
+        return 0x0001;
     }
 
     // =========================================================================
 
-    // Соленоидный клапан: всегда 0xffff
-    static uint16_t solenoidValveToMagnitude()
+    // Соленоидный клапан: всегда 1 (включить)
+    static constexpr uint16_t solenoidValveToMagnitude()
     {
-        return 0xffff;
+        return 0x0001;
     }
 };
\ No newline at end of file
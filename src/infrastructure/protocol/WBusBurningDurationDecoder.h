@@ -2,19 +2,18 @@
 #include <Arduino.h>
 #include "../../domain/Entities.h"
 #include "../../common/Utils.h"
+#include "../../common/PacketView.h"
 
 class WBusBurningDurationDecoder
 {
 public:
-    static BurningDuration decode(const String &response)
+    static BurningDuration decode(const PacketView &response)
     {
         BurningDuration result;
 
-        PacketParser parser;
-
-        if (parser.parseFromString(response, WBusCommandBuilder::CMD_READ_SENSOR, PacketParser::WithIndex(WBusCommandBuilder::SENSOR_BURNING_DURATION), PacketParser::WithMinLength(29)))
+        if (response.matches(WBusCommandBuilder::CMD_READ_SENSOR, PacketView::WithIndex(WBusCommandBuilder::SENSOR_BURNING_DURATION), PacketView::WithMinLength(29)))
         {
-            auto *data = parser.getData();
+            const uint8_t *data = response.data();
 
             // SH 0-33% (байты 4-6)
             result.shLow = decodePowerLevel(data, 4);
@@ -39,7 +38,7 @@ public:
     }
 
 private:
-    static PowerLevelStats decodePowerLevel(uint8_t *data, int startIndex)
+    static PowerLevelStats decodePowerLevel(const uint8_t *data, int startIndex)
     {
         PowerLevelStats stats;
         if (startIndex + 2 < 29)
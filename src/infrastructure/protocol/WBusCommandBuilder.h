@@ -2,6 +2,7 @@
 #include <Arduino.h>
 #include "./TestComponentDataConverter.h"
 #include "../../common/Utils.h"
+#include "../../common/WBusFrame.h"
 
 class WBusCommandBuilder
 {
@@ -47,6 +48,7 @@ public:
     static const uint8_t SENSOR_VENTILATION_DURATION = 0x12;   // Длительность вентиляции
     static const uint8_t SENSOR_FUEL_PREWARMING = 0x13;        // Подогрев топлива
     static const uint8_t SENSOR_SPARK_TRANSMISSION = 0x14;     // Спарк-трансмиссия
+    static const uint8_t SENSOR_MULTI_READ = 0x30;             // Несколько страниц одним запросом
 
     // =========================================================================
     // ИНДЕКСЫ ИНФОРМАЦИИ (0x51)
@@ -86,6 +88,15 @@ public:
     // ФУНКЦИИ ПОЛУЧЕНИЯ ИМЕНИ ПО ИНДЕКСУ
     // =========================================================================
 
+    // Команды, у которых байт после команды - индекс (датчик, информация, компонент)
+    static bool isIndexedCommand(uint8_t command)
+    {
+        return command == CMD_READ_SENSOR ||
+               command == CMD_READ_INFO ||
+               command == CMD_READ_ERRORS ||
+               command == CMD_TEST_COMPONENT;
+    }
+
     // Получить имя команды по коду
     static String getCommandName(uint8_t command)
     {
@@ -153,6 +164,8 @@ public:
             return "FUEL_PREWARMING";
         case SENSOR_SPARK_TRANSMISSION:
             return "SPARK_TRANSMISSION";
+        case SENSOR_MULTI_READ:
+            return "MULTI_READ";
         default:
             return "UNKNOWN_SENSOR_0x" + String(sensorIndex, HEX);
         }
@@ -189,6 +202,8 @@ public:
             return "Подогрев топлива";
         case SENSOR_SPARK_TRANSMISSION:
             return "Искровая передача";
+        case SENSOR_MULTI_READ:
+            return "Групповое чтение";
         default:
             return "Неизвестный датчик (0x" + String(sensorIndex, HEX) + ")";
         }
@@ -386,175 +401,103 @@ public:
         }
     }
 
-    static void generateAndPrintAllCommands()
-    {
-        Serial.println();
-        Serial.println("═══════════════════════════════════════════════════════════");
-        Serial.println("           ТЕСТИРОВАНИЕ ВСЕХ КОМАНД W-BUS");
-        Serial.println("═══════════════════════════════════════════════════════════");
-        Serial.println();
-
-        // =========================================================================
-        // БАЗОВЫЕ КОМАНДЫ УПРАВЛЕНИЯ
-        // =========================================================================
-        Serial.println("🚗 БАЗОВЫЕ КОМАНДЫ УПРАВЛЕНИЯ:");
-        Serial.println("─────────────────────────────────────────────────────────");
-
-        testCommand("SHUTDOWN", createShutdown(), "f4 02 10 e6");
-        testCommand("DIAGNOSTIC", createDiagnostic(), "f4 02 38 ce");
-
-        testCommand("PARK_HEAT (30min)", createParkHeat(30), "f4 03 21 1e c8");
-        testCommand("PARK_HEAT (59min)", createParkHeat(59), "f4 03 21 3b ed");
-
-        testCommand("VENTILATION (30min)", createVentilation(30), "f4 03 22 1e cb");
-        testCommand("VENTILATION (59min)", createVentilation(59), "f4 03 22 3b ee");
-
-        testCommand("SUPP_HEAT (30min)", createSupplementalHeat(30), "f4 03 23 1e ca");
-        testCommand("SUPP_HEAT (59min)", createSupplementalHeat(59), "f4 03 23 3b ef");
-
-        testCommand("BOOST_MODE (30min)", createBoostMode(30), "f4 03 25 1e cc");
-        testCommand("BOOST_MODE (59min)", createBoostMode(59), "f4 03 25 3b e9");
-
-        testCommand("CIRC_PUMP ON", createCirculationPumpControl(true), "f4 03 24 01 d2");
-        testCommand("CIRC_PUMP OFF", createCirculationPumpControl(false), "f4 03 24 00 d3");
-
-        Serial.println();
-
-        // =========================================================================
-        // KEEP-ALIVE КОМАНДЫ
-        // =========================================================================
-        Serial.println("🔄 KEEP-ALIVE КОМАНДЫ:");
-        Serial.println("─────────────────────────────────────────────────────────");
-
-        testCommand("KEEPALIVE PARKING", createKeepAliveParking(), "f4 04 44 21 00 95");
-        testCommand("KEEPALIVE VENTILATION", createKeepAliveVentilation(), "f4 04 44 22 00 96");
-        testCommand("KEEPALIVE SUPPLEMENTAL", createKeepAliveSupplemental(), "f4 04 44 23 00 97");
-        testCommand("KEEPALIVE CIRC_PUMP", createKeepAliveCirculationPump(), "f4 04 44 24 00 90");
-        testCommand("KEEPALIVE BOOST", createKeepAliveBoost(), "f4 04 44 25 00 91");
-
-        Serial.println();
-
-        // =========================================================================
-        // КОМАНДЫ ЧТЕНИЯ СЕНСОРОВ (0x50)
-        // =========================================================================
-        Serial.println("📊 КОМАНДЫ ЧТЕНИЯ СЕНСОРОВ:");
-        Serial.println("─────────────────────────────────────────────────────────");
-
-        testCommand("SENSOR_STATUS_FLAGS", createReadSensor(SENSOR_STATUS_FLAGS), "f4 03 50 02 a5");
-        testCommand("SENSOR_ON_OFF_FLAGS", createReadSensor(SENSOR_ON_OFF_FLAGS), "f4 03 50 03 a4");
-        testCommand("SENSOR_FUEL_SETTINGS", createReadSensor(SENSOR_FUEL_SETTINGS), "f4 03 50 04 a3");
-        testCommand("SENSOR_OPERATIONAL", createReadSensor(SENSOR_OPERATIONAL), "f4 03 50 05 a2");
-        testCommand("SENSOR_OPERATING_TIMES", createReadSensor(SENSOR_OPERATING_TIMES), "f4 03 50 06 a1");
-        testCommand("SENSOR_OPERATING_STATE", createReadSensor(SENSOR_OPERATING_STATE), "f4 03 50 07 a0");
-        testCommand("SENSOR_BURNING_DURATION", createReadSensor(SENSOR_BURNING_DURATION), "f4 03 50 0a ad");
-        testCommand("SENSOR_WORKING_DURATION", createReadSensor(SENSOR_WORKING_DURATION), "f4 03 50 0b ac"); // не удается декодировать ответ
-        testCommand("SENSOR_START_COUNTERS", createReadSensor(SENSOR_START_COUNTERS), "f4 03 50 0c ab");
-        testCommand("SENSOR_SUBSYSTEMS", createReadSensor(SENSOR_SUBSYSTEMS_STATUS), "f4 03 50 0f a8");
-        testCommand("SENSOR_OTHER_DURATION", createReadSensor(SENSOR_OTHER_DURATION), "f4 03 50 10 b7");          // не используется
-        testCommand("SENSOR_TEMP_THRESHOLDS", createReadSensor(SENSOR_TEMPERATURE_THRESHOLDS), "f4 03 50 11 b6"); // не удается декодировать ответ
-        testCommand("SENSOR_VENTILATION_DUR", createReadSensor(SENSOR_VENTILATION_DURATION), "f4 03 50 12 b5");   // не используется
-        testCommand("SENSOR_FUEL_PREWARMING", createReadSensor(SENSOR_FUEL_PREWARMING), "f4 03 50 13 b4");
-        testCommand("SENSOR_SPARK_TRANSMISSION", createReadSensor(SENSOR_SPARK_TRANSMISSION), "f4 03 50 14 b3"); // не используется
-
-        Serial.println();
-
-        // =========================================================================
-        // КОМАНДЫ ЧТЕНИЯ ИНФОРМАЦИИ (0x51)
-        // =========================================================================
-        Serial.println("ℹ️  КОМАНДЫ ЧТЕНИЯ ИНФОРМАЦИИ:");
-        Serial.println("─────────────────────────────────────────────────────────");
-
-        testCommand("INFO_DEVICE_ID", createReadInfo(INFO_DEVICE_ID), "f4 03 51 01 a7");
-        testCommand("INFO_HARDWARE_VERSION", createReadInfo(INFO_HARDWARE_VERSION), "f4 03 51 02 a4"); // не используется
-        testCommand("INFO_DATASET_ID", createReadInfo(INFO_DATASET_ID), "f4 03 51 03 a5");             // плохо декодируется, есть нессоответствия
-        testCommand("INFO_CTRL_MFG_DATE", createReadInfo(INFO_CTRL_MFG_DATE), "f4 03 51 04 a2");
-        testCommand("INFO_HEATER_MFG_DATE", createReadInfo(INFO_HEATER_MFG_DATE), "f4 03 51 05 a3");
-        testCommand("INFO_UNKNOWN_06", createReadInfo(INFO_UNKNOWN_06), "f4 03 51 06 a0");
-        testCommand("INFO_CUSTOMER_ID", createReadInfo(INFO_CUSTOMER_ID), "f4 03 51 07 a1");
-        testCommand("INFO_SERIAL_NUMBER", createReadInfo(INFO_SERIAL_NUMBER), "f4 03 51 09 af");
-
-        testCommand("INFO_WBUS_VERSION", createReadInfo(INFO_WBUS_VERSION), "f4 03 51 0a ac");
-        testCommand("INFO_DEVICE_NAME", createReadInfo(INFO_DEVICE_NAME), "f4 03 51 0b ad");
-        testCommand("INFO_WBUS_CODE", createReadInfo(INFO_WBUS_CODE), "f4 03 51 0c aa");
-        testCommand("INFO_UNKNOWN_0D", createReadInfo(INFO_UNKNOWN_0D), "f4 03 51 0d ab"); // не используется
-
-        Serial.println();
-
-        // =========================================================================
-        // КОМАНДЫ ОШИБОК (0x56)
-        // =========================================================================
-        Serial.println("🚨 КОМАНДЫ ОШИБОК:");
-        Serial.println("─────────────────────────────────────────────────────────");
-
-        testCommand("ERROR_READ_LIST", createReadErrors(), "f4 03 56 01 a0");
-        testCommand("ERROR_CLEAR", createClearErrors(), "f4 03 56 03 a2");
-
-        Serial.println();
-
-        // =========================================================================
-        // КОМАНДЫ ТЕСТИРОВАНИЯ КОМПОНЕНТОВ
-        // =========================================================================
-        Serial.println("🔧 КОМАНДЫ ТЕСТИРОВАНИЯ КОМПОНЕНТОВ:");
-        Serial.println("─────────────────────────────────────────────────────────");
-
-        testCommand("TEST_COMBUSTION_FAN (10s, 50%)",
-                    createTestCombustionFan(10, 50),
-                    "f4 06 45 01 0a 00 ff 43");
-
-        testCommand("TEST_FUEL_PUMP (10s, 15Hz)",
-                    createTestFuelPump(10, 15),
-                    "f4 06 45 02 0a 01 2c 92");
-
-        testCommand("TEST_GLOW_PLUG (5s, 75%)",
-                    createTestGlowPlug(5, 75),
-                    "f4 06 45 03 05 00 96 27");
-
-        testCommand("TEST_CIRC_PUMP (15s)",
-                    createTestCirculationPump(15),
-                    "f4 06 45 04 0f 00 c8 74");
-
-        testCommand("TEST_VEHICLE_FAN (8s)",
-                    createTestVehicleFan(8),
-                    "f4 06 45 05 08 00 01 bb");
-
-        testCommand("TEST_SOLENOID (12s)",
-                    createTestSolenoidValve(12),
-                    "f4 06 45 09 0c 00 01 b3");
-
-        testCommand("TEST_FUEL_PREHEATING (20s, 50%)",
-                    createTestFuelPreheating(20, 50),
-                    "f4 06 45 0f 14 00 ff 53");
-
-        Serial.println();
-        Serial.println("═══════════════════════════════════════════════════════════");
-        Serial.println("                 ТЕСТИРОВАНИЕ ЗАВЕРШЕНО");
-        Serial.println("═══════════════════════════════════════════════════════════");
-        Serial.println();
-    }
-
-    static void testCommand(const String &name, const String &generated, const String &expected)
-    {
-        Serial.print("  ");
-        Serial.print(name);
-        Serial.print(": ");
-
-        if (generated == expected)
-        {
-            Serial.print("✅ ");
-        }
-        else
-        {
-            Serial.print("❌ ");
-        }
+    // =========================================================================
+    // КАДРЫ, ВЫЧИСЛЯЕМЫЕ НА ЭТАПЕ КОМПИЛЯЦИИ
+    // =========================================================================
+
+    static constexpr WBusConstFrame fixedFrame(uint8_t command, uint8_t index = 0, uint8_t dataLength = 0,
+                                               uint8_t data0 = 0, uint8_t data1 = 0, uint8_t data2 = 0, uint8_t data3 = 0)
+    {
+        return WBusConstFrame::build(command, index, dataLength, data0, data1, data2, data3);
+    }
 
-        Serial.print(generated);
+    static constexpr WBusConstFrame fixedKeepAlive(uint8_t mode)
+    {
+        return fixedFrame(CMD_KEEPALIVE, 0, 2, mode, 0x00);
+    }
+
+    // Кадры с параметрами: те же функции собирают кадр в рантайме (create*)
+    // и проверяются static_assert в конце файла
+
+    // Запуск режима на заданное время: F4 03 [режим] [минуты] CS
+    static constexpr WBusConstFrame fixedTimedMode(uint8_t command, uint8_t minutes)
+    {
+        return fixedFrame(command, 0, 1, constrain(minutes, 1, 59));
+    }
 
-        if (generated != expected)
+    static constexpr WBusConstFrame fixedCirculationPumpControl(bool enable)
+    {
+        return fixedFrame(CMD_CIRC_PUMP_CTRL, 0, 1, enable ? 0x01 : 0x00);
+    }
+
+    // Прокачка топлива: F4 05 42 03 00 [(сек - 1) / 2] CS, время нечетное, не меньше 3 сек
+    static constexpr WBusConstFrame fixedFuelCirculation(uint8_t seconds)
+    {
+        if (seconds < 3)
+            seconds = 3;
+
+        if (seconds % 2 == 0)
+            seconds--;
+
+        return fixedFrame(CMD_FUEL_CIRCULATION, 0x03, 2, 0x00, (seconds - 1) / 2);
+    }
+
+    static constexpr WBusConstFrame fixedReadErrorDetails(uint8_t errorCode)
+    {
+        return fixedFrame(CMD_READ_ERRORS, ERROR_READ_DETAILS, 1, errorCode);
+    }
+
+    // Тест компонента: F4 06 45 [компонент] [сек] [величина MSB] [величина LSB] CS
+    static constexpr WBusConstFrame fixedTestCommand(uint8_t component, uint8_t seconds, uint16_t magnitude)
+    {
+        return fixedFrame(CMD_TEST_COMPONENT, 0, 4, component, seconds, magnitude >> 8, magnitude & 0xFF);
+    }
+
+    static constexpr WBusConstFrame fixedTestCombustionFan(uint8_t seconds, uint8_t powerPercent)
+    {
+        return fixedTestCommand(TEST_COMBUSTION_FAN, seconds, TestComponentConverter::combustionFanPercentToMagnitude(powerPercent));
+    }
+
+    static constexpr WBusConstFrame fixedTestFuelPump(uint8_t seconds, uint8_t frequencyHz)
+    {
+        return fixedTestCommand(TEST_FUEL_PUMP, seconds, TestComponentConverter::fuelPumpHzToMagnitude(frequencyHz));
+    }
+
+    static constexpr WBusConstFrame fixedTestGlowPlug(uint8_t seconds, uint8_t powerPercent)
+    {
+        return fixedTestCommand(TEST_GLOW_PLUG, seconds, TestComponentConverter::glowPlugPercentToMagnitude(powerPercent));
+    }
+
+    static constexpr WBusConstFrame fixedTestCirculationPump(uint8_t seconds)
+    {
+        return fixedTestCommand(TEST_CIRCULATION_PUMP, seconds, TestComponentConverter::circulationPumpPercentToMagnitude(100));
+    }
+
+    static constexpr WBusConstFrame fixedTestVehicleFan(uint8_t seconds)
+    {
+        return fixedTestCommand(TEST_VEHICLE_FAN, seconds, TestComponentConverter::vehicleFanToMagnitude());
+    }
+
+    static constexpr WBusConstFrame fixedTestSolenoidValve(uint8_t seconds)
+    {
+        return fixedTestCommand(TEST_SOLENOID_VALVE, seconds, TestComponentConverter::solenoidValveToMagnitude());
+    }
+
+    static constexpr WBusConstFrame fixedTestFuelPreheating(uint8_t seconds, uint8_t powerPercent)
+    {
+        return fixedTestCommand(TEST_FUEL_PREHEATING, seconds, TestComponentConverter::fuelPreheatingPercentToMagnitude(powerPercent));
+    }
+
+    // Поиск кадра с индексом в таблице, неизвестный индекс собирается в рантайме
+    template <size_t N>
+    static WBusFrame fromIndexedTable(const WBusConstFrame (&table)[N], uint8_t command, uint8_t index)
+    {
+        for (size_t i = 0; i < N; i++)
         {
-            Serial.print(" (ожидалось: ");
-            Serial.print(expected);
-            Serial.print(")");
+            if (table[i].bytes[3] == index)
+                return WBusFrame(table[i]);
         }
+        return createIndexedCommand(command, index);
     }
 
     // =========================================================================
@@ -562,23 +505,26 @@ public:
     // =========================================================================
 
     // Базовая функция создания команды
-    static String createCommand(uint8_t command, uint8_t index = 0, const uint8_t *data = nullptr, size_t dataLength = 0)
+    static WBusFrame createCommand(uint8_t command, uint8_t index = 0, const uint8_t *data = nullptr, size_t dataLength = 0)
     {
         // Расчет длины: заголовок(1) + длина(1) + команда(1) + [индекс(1)] + [данные] + checksum(1)
-        uint8_t length = 2; // команда + checksum (минимально)
+        size_t length = 2; // команда + checksum (минимально)
         if (index != 0)
             length += 1;
         length += dataLength;
 
+        if (length + 2 > WBusFrame::CAPACITY)
+            return WBusFrame();
+
         // Буфер для данных пакета
-        uint8_t packet[32];
+        uint8_t packet[WBusFrame::CAPACITY];
         uint8_t packetLength = 0;
 
         // Заголовок
         packet[packetLength++] = 0xF4; // TX header
 
         // Длина
-        packet[packetLength++] = length;
+        packet[packetLength++] = static_cast<uint8_t>(length);
 
         // Команда
         packet[packetLength++] = command;
@@ -600,8 +546,7 @@ public:
         uint8_t checksum = Utils::calculateChecksum(packet, packetLength);
         packet[packetLength++] = checksum;
 
-        // Формирование строки
-        return Utils::bytesToHexString(packet, packetLength);
+        return WBusFrame(packet, packetLength);
     }
 
     // =========================================================================
@@ -609,19 +554,19 @@ public:
     // =========================================================================
 
     // Команды без данных
-    static String createSimpleCommand(uint8_t command)
+    static WBusFrame createSimpleCommand(uint8_t command)
     {
         return createCommand(command);
     }
 
     // Команды с одним байтом данных
-    static String createCommandWithByte(uint8_t command, uint8_t dataByte)
+    static WBusFrame createCommandWithByte(uint8_t command, uint8_t dataByte)
     {
         return createCommand(command, 0, &dataByte, 1);
     }
 
     // Команды с индексом (без данных)
-    static String createIndexedCommand(uint8_t command, uint8_t index)
+    static WBusFrame createIndexedCommand(uint8_t command, uint8_t index)
     {
         return createCommand(command, index);
     }
@@ -630,94 +575,85 @@ public:
     // КОМАНДЫ УПРАВЛЕНИЯ
     // =========================================================================
 
-    static String createShutdown()
+    static WBusFrame createShutdown()
     {
-        return createSimpleCommand(CMD_SHUTDOWN);
+        static constexpr WBusConstFrame frame = fixedFrame(CMD_SHUTDOWN);
+        return frame;
     }
 
-    static String createParkHeat(uint8_t minutes = 59)
+    static WBusFrame createParkHeat(uint8_t minutes = 59)
     {
-        minutes = constrain(minutes, 1, 59);
-        return createCommandWithByte(CMD_PARK_HEAT, minutes);
+        return fixedTimedMode(CMD_PARK_HEAT, minutes);
     }
 
-    static String createVentilation(uint8_t minutes = 59)
+    static WBusFrame createVentilation(uint8_t minutes = 59)
     {
-        minutes = constrain(minutes, 1, 59);
-        return createCommandWithByte(CMD_VENTILATE, minutes);
+        return fixedTimedMode(CMD_VENTILATE, minutes);
     }
 
-    static String createSupplementalHeat(uint8_t minutes = 59)
+    static WBusFrame createSupplementalHeat(uint8_t minutes = 59)
     {
-        minutes = constrain(minutes, 1, 59);
-        return createCommandWithByte(CMD_SUPP_HEAT, minutes);
+        return fixedTimedMode(CMD_SUPP_HEAT, minutes);
     }
 
-    static String createBoostMode(uint8_t minutes = 59)
+    static WBusFrame createBoostMode(uint8_t minutes = 59)
     {
-        minutes = constrain(minutes, 1, 59);
-        return createCommandWithByte(CMD_BOOST_MODE, minutes);
+        return fixedTimedMode(CMD_BOOST_MODE, minutes);
     }
 
-    static String createCirculationPumpControl(bool enable)
+    static WBusFrame createCirculationPumpControl(bool enable)
     {
-        uint8_t data = enable ? 0x01 : 0x00;
-        return createCommandWithByte(CMD_CIRC_PUMP_CTRL, data);
+        return fixedCirculationPumpControl(enable);
     }
 
-    static String createDiagnostic()
+    static WBusFrame createDiagnostic()
     {
-        return createSimpleCommand(CMD_DIAGNOSTIC);
+        static constexpr WBusConstFrame frame = fixedFrame(CMD_DIAGNOSTIC);
+        return frame;
     }
 
     // =========================================================================
     // KEEP-ALIVE КОМАНДЫ
     // =========================================================================
 
-    static String createKeepAlive(uint8_t mode)
+    static WBusFrame createKeepAlive(uint8_t mode)
     {
-        uint8_t data[] = {mode, 0x00};
-        return createCommand(CMD_KEEPALIVE, 0, data, 2);
+        return fixedKeepAlive(mode);
     }
 
-    static String createKeepAliveParking()
+    static WBusFrame createKeepAliveParking()
     {
-        return createKeepAlive(CMD_PARK_HEAT);
+        static constexpr WBusConstFrame frame = fixedKeepAlive(CMD_PARK_HEAT);
+        return frame;
     }
 
-    static String createKeepAliveVentilation()
+    static WBusFrame createKeepAliveVentilation()
     {
-        return createKeepAlive(CMD_VENTILATE);
+        static constexpr WBusConstFrame frame = fixedKeepAlive(CMD_VENTILATE);
+        return frame;
     }
 
-    static String createKeepAliveSupplemental()
+    static WBusFrame createKeepAliveSupplemental()
     {
-        return createKeepAlive(CMD_SUPP_HEAT);
+        static constexpr WBusConstFrame frame = fixedKeepAlive(CMD_SUPP_HEAT);
+        return frame;
     }
 
-    static String createKeepAliveCirculationPump()
+    static WBusFrame createKeepAliveCirculationPump()
     {
-        return createKeepAlive(CMD_CIRC_PUMP_CTRL);
+        static constexpr WBusConstFrame frame = fixedKeepAlive(CMD_CIRC_PUMP_CTRL);
+        return frame;
     }
 
-    static String createKeepAliveBoost()
+    static WBusFrame createKeepAliveBoost()
     {
-        return createKeepAlive(CMD_BOOST_MODE);
+        static constexpr WBusConstFrame frame = fixedKeepAlive(CMD_BOOST_MODE);
+        return frame;
     }
 
-    static String createFuelCirculation(uint8_t seconds)
+    static WBusFrame createFuelCirculation(uint8_t seconds)
     {
-        if (seconds < 3)
-            seconds = 3;
-
-        if (seconds % 2 == 0)
-        {
-            seconds--;
-        }
-
-        uint8_t value = (seconds - 1) / 2;
-        uint8_t data[] = {0x00, value};
-        return createCommand(CMD_FUEL_CIRCULATION, 0x03, data, 2);
+        return fixedFuelCirculation(seconds);
     }
 
     // =========================================================================
@@ -725,32 +661,102 @@ public:
     // =========================================================================
 
     // Чтение сенсоров
-    static String createReadSensor(uint8_t sensorIndex)
+    static WBusFrame createReadSensor(uint8_t sensorIndex)
+    {
+        static constexpr WBusConstFrame frames[] = {
+            fixedFrame(CMD_READ_SENSOR, SENSOR_STATUS_FLAGS),
+            fixedFrame(CMD_READ_SENSOR, SENSOR_ON_OFF_FLAGS),
+            fixedFrame(CMD_READ_SENSOR, SENSOR_FUEL_SETTINGS),
+            fixedFrame(CMD_READ_SENSOR, SENSOR_OPERATIONAL),
+            fixedFrame(CMD_READ_SENSOR, SENSOR_OPERATING_TIMES),
+            fixedFrame(CMD_READ_SENSOR, SENSOR_OPERATING_STATE),
+            fixedFrame(CMD_READ_SENSOR, SENSOR_BURNING_DURATION),
+            fixedFrame(CMD_READ_SENSOR, SENSOR_WORKING_DURATION),
+            fixedFrame(CMD_READ_SENSOR, SENSOR_START_COUNTERS),
+            fixedFrame(CMD_READ_SENSOR, SENSOR_SUBSYSTEMS_STATUS),
+            fixedFrame(CMD_READ_SENSOR, SENSOR_OTHER_DURATION),
+            fixedFrame(CMD_READ_SENSOR, SENSOR_TEMPERATURE_THRESHOLDS),
+            fixedFrame(CMD_READ_SENSOR, SENSOR_VENTILATION_DURATION),
+            fixedFrame(CMD_READ_SENSOR, SENSOR_FUEL_PREWARMING),
+            fixedFrame(CMD_READ_SENSOR, SENSOR_SPARK_TRANSMISSION)};
+        return fromIndexedTable(frames, CMD_READ_SENSOR, sensorIndex);
+    }
+
+    // Длина данных страницы в ответе (без индекса), 0 - страница не поддерживает групповое чтение.
+    // Предполагается, что в запросе 0x50 0x30 страница задается тем же индексом,
+    // что и при обычном чтении, а данные в ответе совпадают с ответом на него.
+    // Это не сверено с документацией; если блок понимает индексы иначе, ответ
+    // не пройдет проверку длин и опрос вернется к чтению по одной странице.
+    static uint8_t getSensorPageLength(uint8_t sensorIndex)
+    {
+        switch (sensorIndex)
+        {
+        case SENSOR_STATUS_FLAGS:
+            return 5;
+        case SENSOR_ON_OFF_FLAGS:
+            return 1;
+        case SENSOR_FUEL_SETTINGS:
+            return 3;
+        case SENSOR_OPERATIONAL:
+            return 8;
+        case SENSOR_OPERATING_TIMES:
+            return 8;
+        case SENSOR_OPERATING_STATE:
+            return 6;
+        case SENSOR_BURNING_DURATION:
+            return 24;
+        case SENSOR_START_COUNTERS:
+            return 6;
+        case SENSOR_SUBSYSTEMS_STATUS:
+            return 5;
+        case SENSOR_FUEL_PREWARMING:
+            return 4;
+        default:
+            return 0;
+        }
+    }
+
+    // Групповое чтение: F4 len 50 30 idx1 idx2 ... checksum
+    static WBusFrame createMultiReadSensor(const uint8_t *sensorIndexes, size_t count)
     {
-        return createIndexedCommand(CMD_READ_SENSOR, sensorIndex);
+        return createCommand(CMD_READ_SENSOR, SENSOR_MULTI_READ, sensorIndexes, count);
     }
 
     // Чтение информации
-    static String createReadInfo(uint8_t infoIndex)
-    {
-        return createIndexedCommand(CMD_READ_INFO, infoIndex);
+    static WBusFrame createReadInfo(uint8_t infoIndex)
+    {
+        static constexpr WBusConstFrame frames[] = {
+            fixedFrame(CMD_READ_INFO, INFO_DEVICE_ID),
+            fixedFrame(CMD_READ_INFO, INFO_HARDWARE_VERSION),
+            fixedFrame(CMD_READ_INFO, INFO_DATASET_ID),
+            fixedFrame(CMD_READ_INFO, INFO_CTRL_MFG_DATE),
+            fixedFrame(CMD_READ_INFO, INFO_HEATER_MFG_DATE),
+            fixedFrame(CMD_READ_INFO, INFO_UNKNOWN_06),
+            fixedFrame(CMD_READ_INFO, INFO_CUSTOMER_ID),
+            fixedFrame(CMD_READ_INFO, INFO_SERIAL_NUMBER),
+            fixedFrame(CMD_READ_INFO, INFO_WBUS_VERSION),
+            fixedFrame(CMD_READ_INFO, INFO_DEVICE_NAME),
+            fixedFrame(CMD_READ_INFO, INFO_WBUS_CODE),
+            fixedFrame(CMD_READ_INFO, INFO_UNKNOWN_0D)};
+        return fromIndexedTable(frames, CMD_READ_INFO, infoIndex);
     }
 
     // Чтение ошибок
-    static String createReadErrors()
+    static WBusFrame createReadErrors()
     {
-        return createIndexedCommand(CMD_READ_ERRORS, ERROR_READ_LIST);
+        static constexpr WBusConstFrame frame = fixedFrame(CMD_READ_ERRORS, ERROR_READ_LIST);
+        return frame;
     }
 
-    static String createClearErrors()
+    static WBusFrame createClearErrors()
     {
-        return createIndexedCommand(CMD_READ_ERRORS, ERROR_CLEAR);
+        static constexpr WBusConstFrame frame = fixedFrame(CMD_READ_ERRORS, ERROR_CLEAR);
+        return frame;
     }
 
-    static String createReadErrorDetails(uint8_t errorCode)
+    static WBusFrame createReadErrorDetails(uint8_t errorCode)
     {
-        uint8_t data[] = {errorCode};
-        return createCommand(CMD_READ_ERRORS, ERROR_READ_DETAILS, data, 1);
+        return fixedReadErrorDetails(errorCode);
     }
 
     // =========================================================================
@@ -758,59 +764,122 @@ public:
     // =========================================================================
 
     // Общая функция тестирования компонентов
-    static String createTestCommand(uint8_t component, uint8_t seconds, uint16_t magnitude)
+    static WBusFrame createTestCommand(uint8_t component, uint8_t seconds, uint16_t magnitude)
     {
-        uint8_t data[] = {
-            component,
-            seconds,
-            static_cast<uint8_t>(magnitude >> 8),
-            static_cast<uint8_t>(magnitude & 0xFF)};
-        return createCommand(CMD_TEST_COMPONENT, 0, data, 4);
+        return fixedTestCommand(component, seconds, magnitude);
     }
 
     // Специализированные функции тестирования с использованием новых конвертеров
-    static String createTestCombustionFan(uint8_t seconds, uint8_t powerPercent)
+    static WBusFrame createTestCombustionFan(uint8_t seconds, uint8_t powerPercent)
     {
-        powerPercent = constrain(powerPercent, 0, 100);
-        uint16_t magnitude = TestComponentConverter::combustionFanPercentToMagnitude(powerPercent);
-        return createTestCommand(TEST_COMBUSTION_FAN, seconds, magnitude);
+        return fixedTestCombustionFan(seconds, powerPercent);
     }
 
-    static String createTestFuelPump(uint8_t seconds, uint8_t frequencyHz)
+    static WBusFrame createTestFuelPump(uint8_t seconds, uint8_t frequencyHz)
     {
-        frequencyHz = constrain(frequencyHz, 0, 255);
-        uint16_t magnitude = TestComponentConverter::fuelPumpHzToMagnitude(frequencyHz);
-        return createTestCommand(TEST_FUEL_PUMP, seconds, magnitude);
+        return fixedTestFuelPump(seconds, frequencyHz);
     }
 
-    static String createTestGlowPlug(uint8_t seconds, uint8_t powerPercent)
+    static WBusFrame createTestGlowPlug(uint8_t seconds, uint8_t powerPercent)
     {
-        powerPercent = constrain(powerPercent, 0, 100);
-        uint16_t magnitude = TestComponentConverter::glowPlugPercentToMagnitude(powerPercent);
-        return createTestCommand(TEST_GLOW_PLUG, seconds, magnitude);
+        return fixedTestGlowPlug(seconds, powerPercent);
     }
 
-    static String createTestCirculationPump(uint8_t seconds)
+    static WBusFrame createTestCirculationPump(uint8_t seconds)
     {
-        return createTestCommand(TEST_CIRCULATION_PUMP, seconds, 100);
+        return fixedTestCirculationPump(seconds);
     }
 
-    static String createTestVehicleFan(uint8_t seconds)
+    static WBusFrame createTestVehicleFan(uint8_t seconds)
     {
-        uint16_t magnitude = TestComponentConverter::vehicleFanToMagnitude();
-        return createTestCommand(TEST_VEHICLE_FAN, seconds, magnitude);
+        return fixedTestVehicleFan(seconds);
     }
 
-    static String createTestSolenoidValve(uint8_t seconds)
+    static WBusFrame createTestSolenoidValve(uint8_t seconds)
     {
-        uint16_t magnitude = TestComponentConverter::solenoidValveToMagnitude();
-        return createTestCommand(TEST_SOLENOID_VALVE, seconds, magnitude);
+        return fixedTestSolenoidValve(seconds);
     }
 
-    static String createTestFuelPreheating(uint8_t seconds, uint8_t powerPercent)
+    static WBusFrame createTestFuelPreheating(uint8_t seconds, uint8_t powerPercent)
     {
-        powerPercent = constrain(powerPercent, 0, 100);
-        uint16_t magnitude = TestComponentConverter::fuelPreheatingPercentToMagnitude(powerPercent);
-        return createTestCommand(TEST_FUEL_PREHEATING, seconds, magnitude);
+        return fixedTestFuelPreheating(seconds, powerPercent);
     }
-};
\ No newline at end of file
+};
+
+// =========================================================================
+// ПРОВЕРКА КАДРОВ НА ЭТАПЕ КОМПИЛЯЦИИ (эталоны сверены с логами шины)
+// =========================================================================
+
+// Управление
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_SHUTDOWN).equals(0xf4, 0x02, 0x10, 0xe6), "SHUTDOWN");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_DIAGNOSTIC).equals(0xf4, 0x02, 0x38, 0xce), "DIAGNOSTIC");
+static_assert(WBusCommandBuilder::fixedTimedMode(WBusCommandBuilder::CMD_PARK_HEAT, 30).equals(0xf4, 0x03, 0x21, 0x1e, 0xc8), "PARK_HEAT (30min)");
+static_assert(WBusCommandBuilder::fixedTimedMode(WBusCommandBuilder::CMD_PARK_HEAT, 59).equals(0xf4, 0x03, 0x21, 0x3b, 0xed), "PARK_HEAT (59min)");
+static_assert(WBusCommandBuilder::fixedTimedMode(WBusCommandBuilder::CMD_VENTILATE, 30).equals(0xf4, 0x03, 0x22, 0x1e, 0xcb), "VENTILATION (30min)");
+static_assert(WBusCommandBuilder::fixedTimedMode(WBusCommandBuilder::CMD_VENTILATE, 59).equals(0xf4, 0x03, 0x22, 0x3b, 0xee), "VENTILATION (59min)");
+static_assert(WBusCommandBuilder::fixedTimedMode(WBusCommandBuilder::CMD_SUPP_HEAT, 30).equals(0xf4, 0x03, 0x23, 0x1e, 0xca), "SUPP_HEAT (30min)");
+static_assert(WBusCommandBuilder::fixedTimedMode(WBusCommandBuilder::CMD_SUPP_HEAT, 59).equals(0xf4, 0x03, 0x23, 0x3b, 0xef), "SUPP_HEAT (59min)");
+static_assert(WBusCommandBuilder::fixedTimedMode(WBusCommandBuilder::CMD_BOOST_MODE, 30).equals(0xf4, 0x03, 0x25, 0x1e, 0xcc), "BOOST_MODE (30min)");
+static_assert(WBusCommandBuilder::fixedTimedMode(WBusCommandBuilder::CMD_BOOST_MODE, 59).equals(0xf4, 0x03, 0x25, 0x3b, 0xe9), "BOOST_MODE (59min)");
+static_assert(WBusCommandBuilder::fixedTimedMode(WBusCommandBuilder::CMD_PARK_HEAT, 0).equals(0xf4, 0x03, 0x21, 0x01, 0xd7), "PARK_HEAT (0min -> 1min)");
+static_assert(WBusCommandBuilder::fixedTimedMode(WBusCommandBuilder::CMD_PARK_HEAT, 90).equals(0xf4, 0x03, 0x21, 0x3b, 0xed), "PARK_HEAT (90min -> 59min)");
+static_assert(WBusCommandBuilder::fixedCirculationPumpControl(true).equals(0xf4, 0x03, 0x24, 0x01, 0xd2), "CIRC_PUMP ON");
+static_assert(WBusCommandBuilder::fixedCirculationPumpControl(false).equals(0xf4, 0x03, 0x24, 0x00, 0xd3), "CIRC_PUMP OFF");
+
+// Keep-alive
+static_assert(WBusCommandBuilder::fixedKeepAlive(WBusCommandBuilder::CMD_PARK_HEAT).equals(0xf4, 0x04, 0x44, 0x21, 0x00, 0x95), "KEEPALIVE PARKING");
+static_assert(WBusCommandBuilder::fixedKeepAlive(WBusCommandBuilder::CMD_VENTILATE).equals(0xf4, 0x04, 0x44, 0x22, 0x00, 0x96), "KEEPALIVE VENTILATION");
+static_assert(WBusCommandBuilder::fixedKeepAlive(WBusCommandBuilder::CMD_SUPP_HEAT).equals(0xf4, 0x04, 0x44, 0x23, 0x00, 0x97), "KEEPALIVE SUPPLEMENTAL");
+static_assert(WBusCommandBuilder::fixedKeepAlive(WBusCommandBuilder::CMD_CIRC_PUMP_CTRL).equals(0xf4, 0x04, 0x44, 0x24, 0x00, 0x90), "KEEPALIVE CIRC_PUMP");
+static_assert(WBusCommandBuilder::fixedKeepAlive(WBusCommandBuilder::CMD_BOOST_MODE).equals(0xf4, 0x04, 0x44, 0x25, 0x00, 0x91), "KEEPALIVE BOOST");
+
+// Чтение сенсоров (0x50)
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_SENSOR, WBusCommandBuilder::SENSOR_STATUS_FLAGS).equals(0xf4, 0x03, 0x50, 0x02, 0xa5), "SENSOR_STATUS_FLAGS");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_SENSOR, WBusCommandBuilder::SENSOR_ON_OFF_FLAGS).equals(0xf4, 0x03, 0x50, 0x03, 0xa4), "SENSOR_ON_OFF_FLAGS");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_SENSOR, WBusCommandBuilder::SENSOR_FUEL_SETTINGS).equals(0xf4, 0x03, 0x50, 0x04, 0xa3), "SENSOR_FUEL_SETTINGS");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_SENSOR, WBusCommandBuilder::SENSOR_OPERATIONAL).equals(0xf4, 0x03, 0x50, 0x05, 0xa2), "SENSOR_OPERATIONAL");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_SENSOR, WBusCommandBuilder::SENSOR_OPERATING_TIMES).equals(0xf4, 0x03, 0x50, 0x06, 0xa1), "SENSOR_OPERATING_TIMES");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_SENSOR, WBusCommandBuilder::SENSOR_OPERATING_STATE).equals(0xf4, 0x03, 0x50, 0x07, 0xa0), "SENSOR_OPERATING_STATE");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_SENSOR, WBusCommandBuilder::SENSOR_BURNING_DURATION).equals(0xf4, 0x03, 0x50, 0x0a, 0xad), "SENSOR_BURNING_DURATION");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_SENSOR, WBusCommandBuilder::SENSOR_WORKING_DURATION).equals(0xf4, 0x03, 0x50, 0x0b, 0xac), "SENSOR_WORKING_DURATION");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_SENSOR, WBusCommandBuilder::SENSOR_START_COUNTERS).equals(0xf4, 0x03, 0x50, 0x0c, 0xab), "SENSOR_START_COUNTERS");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_SENSOR, WBusCommandBuilder::SENSOR_SUBSYSTEMS_STATUS).equals(0xf4, 0x03, 0x50, 0x0f, 0xa8), "SENSOR_SUBSYSTEMS");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_SENSOR, WBusCommandBuilder::SENSOR_OTHER_DURATION).equals(0xf4, 0x03, 0x50, 0x10, 0xb7), "SENSOR_OTHER_DURATION");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_SENSOR, WBusCommandBuilder::SENSOR_TEMPERATURE_THRESHOLDS).equals(0xf4, 0x03, 0x50, 0x11, 0xb6), "SENSOR_TEMP_THRESHOLDS");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_SENSOR, WBusCommandBuilder::SENSOR_VENTILATION_DURATION).equals(0xf4, 0x03, 0x50, 0x12, 0xb5), "SENSOR_VENTILATION_DUR");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_SENSOR, WBusCommandBuilder::SENSOR_FUEL_PREWARMING).equals(0xf4, 0x03, 0x50, 0x13, 0xb4), "SENSOR_FUEL_PREWARMING");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_SENSOR, WBusCommandBuilder::SENSOR_SPARK_TRANSMISSION).equals(0xf4, 0x03, 0x50, 0x14, 0xb3), "SENSOR_SPARK_TRANSMISSION");
+
+// Чтение информации (0x51)
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_INFO, WBusCommandBuilder::INFO_DEVICE_ID).equals(0xf4, 0x03, 0x51, 0x01, 0xa7), "INFO_DEVICE_ID");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_INFO, WBusCommandBuilder::INFO_HARDWARE_VERSION).equals(0xf4, 0x03, 0x51, 0x02, 0xa4), "INFO_HARDWARE_VERSION");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_INFO, WBusCommandBuilder::INFO_DATASET_ID).equals(0xf4, 0x03, 0x51, 0x03, 0xa5), "INFO_DATASET_ID");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_INFO, WBusCommandBuilder::INFO_CTRL_MFG_DATE).equals(0xf4, 0x03, 0x51, 0x04, 0xa2), "INFO_CTRL_MFG_DATE");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_INFO, WBusCommandBuilder::INFO_HEATER_MFG_DATE).equals(0xf4, 0x03, 0x51, 0x05, 0xa3), "INFO_HEATER_MFG_DATE");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_INFO, WBusCommandBuilder::INFO_UNKNOWN_06).equals(0xf4, 0x03, 0x51, 0x06, 0xa0), "INFO_UNKNOWN_06");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_INFO, WBusCommandBuilder::INFO_CUSTOMER_ID).equals(0xf4, 0x03, 0x51, 0x07, 0xa1), "INFO_CUSTOMER_ID");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_INFO, WBusCommandBuilder::INFO_SERIAL_NUMBER).equals(0xf4, 0x03, 0x51, 0x09, 0xaf), "INFO_SERIAL_NUMBER");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_INFO, WBusCommandBuilder::INFO_WBUS_VERSION).equals(0xf4, 0x03, 0x51, 0x0a, 0xac), "INFO_WBUS_VERSION");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_INFO, WBusCommandBuilder::INFO_DEVICE_NAME).equals(0xf4, 0x03, 0x51, 0x0b, 0xad), "INFO_DEVICE_NAME");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_INFO, WBusCommandBuilder::INFO_WBUS_CODE).equals(0xf4, 0x03, 0x51, 0x0c, 0xaa), "INFO_WBUS_CODE");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_INFO, WBusCommandBuilder::INFO_UNKNOWN_0D).equals(0xf4, 0x03, 0x51, 0x0d, 0xab), "INFO_UNKNOWN_0D");
+
+// Ошибки (0x56)
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_ERRORS, WBusCommandBuilder::ERROR_READ_LIST).equals(0xf4, 0x03, 0x56, 0x01, 0xa0), "ERROR_READ_LIST");
+static_assert(WBusCommandBuilder::fixedFrame(WBusCommandBuilder::CMD_READ_ERRORS, WBusCommandBuilder::ERROR_CLEAR).equals(0xf4, 0x03, 0x56, 0x03, 0xa2), "ERROR_CLEAR");
+static_assert(WBusCommandBuilder::fixedReadErrorDetails(0x2a).equals(0xf4, 0x04, 0x56, 0x02, 0x2a, 0x8e), "ERROR_READ_DETAILS (0x2a)");
+
+// Прокачка топлива (0x42)
+static_assert(WBusCommandBuilder::fixedFuelCirculation(31).equals(0xf4, 0x05, 0x42, 0x03, 0x00, 0x0f, 0xbf), "FUEL_CIRCULATION (31s)");
+static_assert(WBusCommandBuilder::fixedFuelCirculation(30).equals(0xf4, 0x05, 0x42, 0x03, 0x00, 0x0e, 0xbe), "FUEL_CIRCULATION (30s -> 29s)");
+static_assert(WBusCommandBuilder::fixedFuelCirculation(0).equals(0xf4, 0x05, 0x42, 0x03, 0x00, 0x01, 0xb1), "FUEL_CIRCULATION (0s -> 3s)");
+
+// Тестирование компонентов (0x45): F4 06 45 [компонент] [сек] [величина MSB] [величина LSB] CS
+static_assert(WBusCommandBuilder::fixedTestCombustionFan(10, 50).equals(0xf4, 0x06, 0x45, 0x01, 0x0a, 0x00, 0xff, 0x43), "TEST_COMBUSTION_FAN (10s, 50%)");
+static_assert(WBusCommandBuilder::fixedTestCombustionFan(10, 150).equals(0xf4, 0x06, 0x45, 0x01, 0x0a, 0x01, 0xfe, 0x43), "TEST_COMBUSTION_FAN (10s, 150% -> 100%)");
+static_assert(WBusCommandBuilder::fixedTestFuelPump(10, 15).equals(0xf4, 0x06, 0x45, 0x02, 0x0a, 0x01, 0x2c, 0x92), "TEST_FUEL_PUMP (10s, 15Hz)");
+static_assert(WBusCommandBuilder::fixedTestGlowPlug(5, 75).equals(0xf4, 0x06, 0x45, 0x03, 0x05, 0x00, 0x96, 0x27), "TEST_GLOW_PLUG (5s, 75%)");
+static_assert(WBusCommandBuilder::fixedTestCirculationPump(15).equals(0xf4, 0x06, 0x45, 0x04, 0x0f, 0x00, 0xc8, 0x74), "TEST_CIRC_PUMP (15s)");
+static_assert(WBusCommandBuilder::fixedTestVehicleFan(8).equals(0xf4, 0x06, 0x45, 0x05, 0x08, 0x00, 0x01, 0xbb), "TEST_VEHICLE_FAN (8s)");
+static_assert(WBusCommandBuilder::fixedTestSolenoidValve(12).equals(0xf4, 0x06, 0x45, 0x09, 0x0c, 0x00, 0x01, 0xb3), "TEST_SOLENOID (12s)");
+static_assert(WBusCommandBuilder::fixedTestFuelPreheating(20, 50).equals(0xf4, 0x06, 0x45, 0x0f, 0x14, 0x00, 0xff, 0x53), "TEST_FUEL_PREHEATING (20s, 50%)");
@@ -2,6 +2,7 @@
 #include <Arduino.h>
 #include "../../domain/Entities.h"
 #include "../../common/Utils.h"
+#include "../../common/PacketView.h"
 #include "WBusErrorsDecoder.h"
 
 class WBusErrorDetailsDecoder
@@ -41,15 +42,13 @@ private:
 public:
     WBusErrorDetailsDecoder() {}
 
-    ErrorDetails decode(const String &response, uint8_t errorCode)
+    ErrorDetails decode(const PacketView &response, uint8_t errorCode)
     {
         ErrorDetails details;
 
-        PacketParser parser;
-
-        if (parser.parseFromString(response, WBusCommandBuilder::CMD_READ_ERRORS, PacketParser::WithIndex(WBusCommandBuilder::ERROR_READ_DETAILS), PacketParser::WithMinLength(16)))
+        if (response.matches(WBusCommandBuilder::CMD_READ_ERRORS, PacketView::WithIndex(WBusCommandBuilder::ERROR_READ_DETAILS), PacketView::WithMinLength(16)))
         {
-            auto &data = parser.getBytes();
+            const uint8_t *data = response.data();
 
             // Проверка кода ошибки в ответе
             if (data[4] != errorCode)
@@ -5,7 +5,7 @@
 #include "../../domain/Entities.h"
 #include "../../common/Utils.h"
 #include "./WBusErrorType.h"
-#include "../../common/PacketParser.h"
+#include "../../common/PacketView.h"
 
 class WBusErrorsDecoder
 {
@@ -15,17 +15,15 @@ private:
 public:
     WBusErrorsDecoder() {}
 
-    ErrorCollection decodeErrorPacket(const String &response)
+    ErrorCollection decodeErrorPacket(const PacketView &response)
     {
         ErrorCollection result;
 
-        PacketParser parser;
-
-        if (parser.parseFromString(response, WBusCommandBuilder::CMD_READ_ERRORS, PacketParser::WithIndex(WBusCommandBuilder::ERROR_READ_LIST), PacketParser::WithMinLength(4)))
+        if (response.matches(WBusCommandBuilder::CMD_READ_ERRORS, PacketView::WithIndex(WBusCommandBuilder::ERROR_READ_LIST), PacketView::WithMinLength(4)))
         {
-            auto &data = parser.getBytes();
+            const uint8_t *data = response.data();
 
-            return decodeErrorList(&data[4], parser.getByteCounts() - 4);
+            return decodeErrorList(&data[4], response.size() - 4);
         }
 
         return result;
@@ -0,0 +1,236 @@
+// src/infrastructure/protocol/WBusFramer.h
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "../../common/ProtocolConstants.h"
+
+// Статистика приема кадров
+struct WBusFramerStats
+{
+    uint32_t framesReceived = 0;  // Корректные кадры
+    uint32_t checksumErrors = 0;  // Кадры с неверной контрольной суммой
+    uint32_t lengthErrors = 0;    // Недопустимое значение байта длины
+    uint32_t gapAborts = 0;       // Кадры, прерванные паузой между байтами
+    uint32_t resyncs = 0;         // Повторные поиски заголовка в буфере
+    uint32_t discardedBytes = 0;  // Байты вне кадров
+
+    uint32_t droppedFrames() const
+    {
+        return checksumErrors + lengthErrors + gapAborts;
+    }
+};
+
+// Принятый кадр с отметкой времени (мкс) завершения приема
+struct WBusRawFrame
+{
+    uint8_t data[WBUS_MAX_FRAME_LENGTH];
+    uint8_t length = 0;
+    int64_t timestampUs = 0;
+};
+
+// Конечный автомат выделения кадров W-Bus из потока байт K-Line.
+// Не зависит от Arduino, время передается снаружи в микросекундах.
+// Кадр: header (0xF4/0x4F), length, command, data..., checksum (XOR всех байт).
+// При ошибке (контрольная сумма, длина, пауза) накопленные байты повторно
+// просматриваются в поисках следующего заголовка (hunt mode).
+class WBusFramer
+{
+public:
+    // Минимальное значение байта длины: команда + контрольная сумма
+    static constexpr uint8_t MIN_LENGTH_BYTE = 2;
+    static constexpr uint8_t MAX_LENGTH_BYTE = WBUS_MAX_FRAME_LENGTH - 2;
+
+private:
+    enum class State
+    {
+        HUNT,   // Поиск заголовка
+        LENGTH, // Ожидание байта длины
+        BODY    // Прием тела кадра
+    };
+
+    enum class StepResult
+    {
+        NONE,  // Кадр еще не собран
+        FRAME, // Собран корректный кадр
+        FAIL   // Кадр отброшен, нужен повторный просмотр
+    };
+
+    State state = State::HUNT;
+    uint8_t buffer[WBUS_MAX_FRAME_LENGTH];
+    size_t used = 0;
+    size_t expected = 0;
+    uint8_t checksum = 0;
+    uint32_t lastByteTime = 0; // мкс
+    uint32_t gapTimeoutUs;
+    WBusFramerStats stats;
+
+    // Очередь байт на обработку (новый байт + байты для повторного просмотра).
+    // Байты кадра и очереди вместе никогда не превышают размер кадра.
+    uint8_t work[WBUS_MAX_FRAME_LENGTH];
+    size_t workLength = 0;
+
+    static bool isHeader(uint8_t value)
+    {
+        return value == TXHEADER || value == RXHEADER;
+    }
+
+    void startFrame(uint8_t header)
+    {
+        buffer[0] = header;
+        used = 1;
+        expected = 0;
+        checksum = header;
+        state = State::LENGTH;
+    }
+
+    void resetFrame()
+    {
+        used = 0;
+        expected = 0;
+        checksum = 0;
+        state = State::HUNT;
+    }
+
+    StepResult step(uint8_t value)
+    {
+        switch (state)
+        {
+        case State::HUNT:
+            if (isHeader(value))
+                startFrame(value);
+            else
+                stats.discardedBytes++;
+            return StepResult::NONE;
+
+        case State::LENGTH:
+            buffer[used++] = value;
+            if (value < MIN_LENGTH_BYTE || value > MAX_LENGTH_BYTE)
+            {
+                stats.lengthErrors++;
+                return StepResult::FAIL;
+            }
+            checksum ^= value;
+            expected = value + 2;
+            state = State::BODY;
+            return StepResult::NONE;
+
+        case State::BODY:
+            buffer[used++] = value;
+            checksum ^= value;
+
+            if (used < expected)
+                return StepResult::NONE;
+
+            // XOR всех байт кадра, включая контрольную сумму, равен нулю
+            if (checksum == 0)
+            {
+                stats.framesReceived++;
+                return StepResult::FRAME;
+            }
+
+            stats.checksumErrors++;
+            return StepResult::FAIL;
+        }
+
+        return StepResult::NONE;
+    }
+
+    // Байты отброшенного кадра (кроме заголовка) ставятся в начало очереди
+    void resync(size_t position)
+    {
+        stats.resyncs++;
+        stats.discardedBytes++;
+
+        size_t rescanLength = used - 1;
+        size_t rest = workLength - position;
+
+        if (rescanLength + rest > sizeof(work))
+        {
+            // Не должно происходить; на всякий случай отбрасываем все
+            stats.discardedBytes += rescanLength + rest;
+            workLength = 0;
+            resetFrame();
+            return;
+        }
+
+        memmove(work + rescanLength, work + position, rest);
+        memcpy(work, buffer + 1, rescanLength);
+        workLength = rescanLength + rest;
+        resetFrame();
+    }
+
+public:
+    explicit WBusFramer(uint32_t gapTimeoutMs = 100) : gapTimeoutUs(gapTimeoutMs * 1000) {}
+
+    void setGapTimeout(uint32_t gapTimeoutMs)
+    {
+        gapTimeoutUs = gapTimeoutMs * 1000;
+    }
+
+    // Подача байта. onFrame(const uint8_t *frame, size_t length) вызывается
+    // для каждого корректного кадра (после ресинхронизации их может быть несколько).
+    template <typename Handler>
+    void feed(uint8_t value, uint32_t nowUs, Handler onFrame)
+    {
+        checkGap(nowUs);
+        lastByteTime = nowUs;
+
+        work[0] = value;
+        workLength = 1;
+        size_t position = 0;
+
+        while (position < workLength)
+        {
+            switch (step(work[position++]))
+            {
+            case StepResult::FRAME:
+                onFrame(buffer, used);
+                resetFrame();
+                break;
+
+            case StepResult::FAIL:
+                resync(position);
+                position = 0;
+                break;
+
+            case StepResult::NONE:
+                break;
+            }
+        }
+
+        workLength = 0;
+    }
+
+    // Прерывание незавершенного кадра по паузе между байтами
+    void checkGap(uint32_t nowUs)
+    {
+        if (state != State::HUNT && gapTimeoutUs > 0 && nowUs - lastByteTime > gapTimeoutUs)
+        {
+            stats.gapAborts++;
+            stats.discardedBytes += used;
+            resetFrame();
+        }
+    }
+
+    void reset()
+    {
+        resetFrame();
+        workLength = 0;
+    }
+
+    bool isReceiving() const
+    {
+        return state != State::HUNT;
+    }
+
+    const WBusFramerStats &getStats() const
+    {
+        return stats;
+    }
+
+    void resetStats()
+    {
+        stats = WBusFramerStats();
+    }
+};
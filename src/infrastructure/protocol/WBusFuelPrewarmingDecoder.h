@@ -2,19 +2,18 @@
 #include <Arduino.h>
 #include "../../domain/Entities.h"
 #include "../../common/Utils.h"
+#include "../../common/PacketView.h"
 
 class WBusFuelPrewarmingDecoder
 {
 public:
-    static FuelPrewarming decode(const String &response)
+    static FuelPrewarming decode(const PacketView &response)
     {
         FuelPrewarming result = {0, 0, false};
 
-        PacketParser parser;
-
-        if (parser.parseFromString(response, WBusCommandBuilder::CMD_READ_SENSOR, PacketParser::WithIndex(WBusCommandBuilder::SENSOR_FUEL_PREWARMING), PacketParser::WithMinLength(9)))
+        if (response.matches(WBusCommandBuilder::CMD_READ_SENSOR, PacketView::WithIndex(WBusCommandBuilder::SENSOR_FUEL_PREWARMING), PacketView::WithMinLength(9)))
         {
-            auto &data = parser.getBytes();
+            const uint8_t *data = response.data();
 
             // Байты 4-5: сопротивление (big endian)
             result.resistance = (data[4] << 8) | data[5];
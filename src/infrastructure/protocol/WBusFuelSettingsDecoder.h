@@ -3,20 +3,18 @@
 #include <Arduino.h>
 #include "../../domain/Entities.h"
 #include "../../common/Utils.h"
-#include "../../common/PacketParser.h"
+#include "../../common/PacketView.h"
 
 class WBusFuelSettingsDecoder
 {
 public:
-  static FuelSettings decode(const String &response)
+  static FuelSettings decode(const PacketView &response)
   {
     FuelSettings result;
 
-    PacketParser parser;
-
-    if (parser.parseFromString(response, WBusCommandBuilder::CMD_READ_SENSOR, PacketParser::WithIndex(WBusCommandBuilder::SENSOR_FUEL_SETTINGS), PacketParser::WithMinLength(8)))
+    if (response.matches(WBusCommandBuilder::CMD_READ_SENSOR, PacketView::WithIndex(WBusCommandBuilder::SENSOR_FUEL_SETTINGS), PacketView::WithMinLength(8)))
     {
-      auto &data = parser.getBytes();
+      const uint8_t *data = response.data();
 
       result.fuelType = data[4];
       result.maxHeatingTime = data[5];
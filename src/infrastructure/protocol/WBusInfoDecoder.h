@@ -3,18 +3,21 @@
 #include <Arduino.h>
 #include "../../domain/Entities.h"
 #include "../../common/Utils.h"
+#include "../../common/HexCodec.h"
+#include "../../common/PacketView.h"
 
 class WBusInfoDecoder
 {
 public:
-    static String decodeWBusVersion(const String &response)
+    static String decodeWBusVersion(const PacketView &response)
     {
         String result = "";
 
-        String versionData = extractDataFromResponse(response, "d10a", 2);
-        if (versionData.length() == 2)
+        size_t length = 0;
+        const uint8_t *versionData = extractDataFromResponse(response, WBusCommandBuilder::INFO_WBUS_VERSION, length);
+        if (length >= 1)
         {
-            uint8_t versionByte = Utils::hexStringToByte(versionData);
+            uint8_t versionByte = versionData[0];
 
             result = String((versionByte >> 4) & 0x0F) + "." + String(versionByte & 0x0F);
         }
@@ -22,14 +25,15 @@ public:
         return result;
     }
 
-    static String decodeDeviceName(const String &response)
+    static String decodeDeviceName(const PacketView &response)
     {
         String result = "";
 
-        String nameData = extractDataFromResponse(response, "d10b");
-        if (nameData.length() > 0)
+        size_t length = 0;
+        const uint8_t *nameData = extractDataFromResponse(response, WBusCommandBuilder::INFO_DEVICE_NAME, length);
+        if (length > 0)
         {
-            String text = hexToString(nameData);
+            String text = bytesToText(nameData, length);
             text.trim();
             result = text;
         }
@@ -37,22 +41,21 @@ public:
         return result;
     }
 
-    static DecodedWBusCode decodeWBusCode(const String &response)
+    static DecodedWBusCode decodeWBusCode(const PacketView &response)
     {
         DecodedWBusCode result;
         WBusCodeFlags flags = {};
 
-        String codeData = extractDataFromResponse(response, "d10c");
-        if (codeData.length() >= 14)
+        size_t length = 0;
+        const uint8_t *codeData = extractDataFromResponse(response, WBusCommandBuilder::INFO_WBUS_CODE, length);
+        if (length >= 7)
         { // Need at least 7 bytes
-            result.codeString = codeData;
+            result.codeString = bytesToHex(codeData, length);
 
             // Parse each byte
-            for (int byteNum = 0; byteNum < 7 && (byteNum * 2 + 2) <= codeData.length(); byteNum++)
+            for (uint8_t byteNum = 0; byteNum < 7; byteNum++)
             {
-                String byteStr = codeData.substring(byteNum * 2, byteNum * 2 + 2);
-                uint8_t byteVal = Utils::hexStringToByte(byteStr);
-                parseWBusCodeByte(byteNum, byteVal, flags);
+                parseWBusCodeByte(byteNum, codeData[byteNum], flags);
             }
 
             result.flags = flags;
@@ -61,123 +64,114 @@ public:
         return result;
     }
 
-    static String decodeDeviceID(const String &response)
+    static String decodeDeviceID(const PacketView &response)
     {
         String result = "";
 
-        String idData = extractDataFromResponse(response, "d101");
-        if (idData.length() > 0)
+        size_t length = 0;
+        const uint8_t *idData = extractDataFromResponse(response, WBusCommandBuilder::INFO_DEVICE_ID, length);
+        if (length > 0)
         {
-            result = idData;
+            result = bytesToHex(idData, length);
         }
 
         return result;
     }
 
-    static DecodedManufactureDate decodeHeaterManufactureDate(const String &response)
+    static DecodedManufactureDate decodeHeaterManufactureDate(const PacketView &response)
     {
-        return decodeManufactureDate(response, "d105");
+        return decodeManufactureDate(response, WBusCommandBuilder::INFO_HEATER_MFG_DATE);
     }
 
-    static DecodedManufactureDate decodeControllerManufactureDate(const String &response)
+    static DecodedManufactureDate decodeControllerManufactureDate(const PacketView &response)
     {
-        return decodeManufactureDate(response, "d104");
+        return decodeManufactureDate(response, WBusCommandBuilder::INFO_CTRL_MFG_DATE);
     }
 
-    static String decodeCustomerID(const String &response)
+    static String decodeCustomerID(const PacketView &response)
     {
         String result = "";
 
-        String data = extractDataFromResponse(response, "d107");
-        if (data.length() > 0)
+        size_t length = 0;
+        const uint8_t *data = extractDataFromResponse(response, WBusCommandBuilder::INFO_CUSTOMER_ID, length);
+        if (length > 0)
         {
-            result = hexToString(data);
+            result = bytesToText(data, length);
         }
 
         return result;
     }
 
-    static String decodeSerialNumber(const String &response)
+    static String decodeSerialNumber(const PacketView &response)
     {
         String result = "";
 
-        String data = extractDataFromResponse(response, "d109");
-        if (data.length() >= 10)
+        size_t length = 0;
+        const uint8_t *data = extractDataFromResponse(response, WBusCommandBuilder::INFO_SERIAL_NUMBER, length);
+        if (length >= 5)
         {
-            result = data.substring(0, 10);
+            result = bytesToHex(data, 5);
         }
 
         return result;
     }
 
 private:
-    static String extractDataFromResponse(const String &response, const String &command, int dataLength = 0)
+    // Данные ответа 0x51: 4F len D1 [index] data... checksum
+    static const uint8_t *extractDataFromResponse(const PacketView &response, uint8_t infoIndex, size_t &dataLength)
     {
-        String cleanData = response;
-        cleanData.replace(" ", "");
-        cleanData.toLowerCase();
+        dataLength = 0;
 
-        int start = cleanData.indexOf(command);
-        if (start == -1)
+        if (!response.matches(WBusCommandBuilder::CMD_READ_INFO, PacketView::WithIndex(infoIndex)))
         {
-            return "";
+            return nullptr;
         }
 
-        start += command.length();
-
-        if (dataLength > 0)
-        {
-            if (cleanData.length() >= start + dataLength)
-            {
-                return cleanData.substring(start, start + dataLength);
-            }
-        }
-        else
-        {
-            if (cleanData.length() >= start + 2)
-            {
-                return cleanData.substring(start, cleanData.length() - 2);
-            }
-        }
+        dataLength = response.size() - 5;
+        return response.data() + 4;
+    }
 
-        return "";
+    // HEX без разделителей (как в исходном ответе)
+    static String bytesToHex(const uint8_t *data, size_t length)
+    {
+        return Utils::bytesToHexString(data, length, '\0');
     }
 
-    static String hexToString(const String &hexData)
+    // ASCII текст до первого нулевого байта, непечатаемые символы пропускаются
+    static String bytesToText(const uint8_t *data, size_t length)
     {
         String result = "";
-        for (int i = 0; i < hexData.length(); i += 2)
+        for (size_t i = 0; i < length; i++)
         {
-            if (i + 2 <= hexData.length())
+            if (data[i] == 0x00)
+                break;
+            char c = (char)data[i];
+            if (c >= 32 && c <= 126)
             {
-                String byteStr = hexData.substring(i, i + 2);
-                if (byteStr == "00")
-                    break;
-                char c = (char)strtoul(byteStr.c_str(), NULL, 16);
-                if (c >= 32 && c <= 126)
-                {
-                    result += c;
-                }
+                result += c;
             }
         }
         return result;
     }
 
-    static DecodedManufactureDate decodeManufactureDate(const String &response, const String &command)
+    static DecodedManufactureDate decodeManufactureDate(const PacketView &response, uint8_t infoIndex)
     {
         DecodedManufactureDate result = {"N/A", 0, 0, 0};
 
-        String dateData = extractDataFromResponse(response, command, 6);
-        if (dateData.length() == 6)
+        size_t length = 0;
+        const uint8_t *dateData = extractDataFromResponse(response, infoIndex, length);
+        if (length >= 3)
         {
-            String dayStr = dateData.substring(0, 2);
-            String monthStr = dateData.substring(2, 4);
-            String yearStr = dateData.substring(4, 6);
-
-            result.day = Utils::hexStringToByte(dayStr);
-            result.month = Utils::hexStringToByte(monthStr);
-            result.year = 2000 + Utils::hexStringToByte(yearStr);
-            result.dateString = dayStr + "." + monthStr + ".20" + yearStr;
+            // "dd.mm.20yy" - байты даты в BCD, выводятся как HEX
+            char date[11] = "00.00.2000";
+            HexCodec::encodeByte(dateData[0], date);
+            HexCodec::encodeByte(dateData[1], date + 3);
+            HexCodec::encodeByte(dateData[2], date + 8);
+
+            result.day = dateData[0];
+            result.month = dateData[1];
+            result.year = 2000 + dateData[2];
+            result.dateString = date;
         }
 
         return result;
@@ -0,0 +1,101 @@
+// src/infrastructure/protocol/WBusMultiReadDecoder.h
+#pragma once
+#include <Arduino.h>
+#include "./WBusCommandBuilder.h"
+#include "../../common/PacketView.h"
+#include "../../common/ProtocolConstants.h"
+#include "../../common/Utils.h"
+
+// Разбор ответа группового чтения 0x50 0x30:
+//   запрос: F4 len 50 30 idx1 idx2 ... cs
+//   ответ:  4F len D0 30 idx1 data1 idx2 data2 ... cs
+// Каждая страница пересобирается в обычный кадр 4F len D0 idx data cs,
+// чтобы ее разобрал существующий декодер страницы.
+class WBusMultiReadDecoder
+{
+public:
+    // Байт на страницы в ответе: кадр без 4F len D0 30 и контрольной суммы
+    static const size_t MAX_RESPONSE_PAYLOAD = WBUS_MAX_FRAME_LENGTH - 5;
+
+    // Размер, который страница займет в ответе (индекс + данные), 0 - не поддерживается
+    static size_t pageCost(uint8_t sensorIndex)
+    {
+        uint8_t length = WBusCommandBuilder::getSensorPageLength(sensorIndex);
+        return length > 0 ? length + 1 : 0;
+    }
+
+    // Байт страниц в ответе на групповое чтение tx, 0 - не групповое чтение
+    static size_t expectedPayload(const PacketView &tx)
+    {
+        if (!isMultiRead(tx) || tx.size() < 5)
+            return 0;
+
+        size_t payload = 0;
+        for (size_t i = 4; i + 1 < tx.size(); i++)
+            payload += pageCost(tx[i]);
+        return payload;
+    }
+
+    static bool isMultiRead(const PacketView &frame)
+    {
+        return frame.getCommandWithoutAck() == WBusCommandBuilder::CMD_READ_SENSOR &&
+               frame.getIndex() == WBusCommandBuilder::SENSOR_MULTI_READ;
+    }
+
+    // Ответ содержит ровно запрошенные страницы в том же порядке и с ожидаемыми длинами
+    static bool isValidResponse(const PacketView &tx, const PacketView &rx)
+    {
+        if (!tx.isValid() || !rx.isValid() || rx.isNak() || !isMultiRead(tx) || !isMultiRead(rx))
+            return false;
+
+        size_t requested = tx.size() - 5; // F4 len 50 30 ... cs
+        size_t pos = 4;
+        size_t end = rx.size() - 1;
+
+        for (size_t i = 0; i < requested; i++)
+        {
+            uint8_t index = tx[4 + i];
+            uint8_t length = WBusCommandBuilder::getSensorPageLength(index);
+
+            if (length == 0 || pos + 1 + length > end || rx[pos] != index)
+                return false;
+
+            pos += 1 + length;
+        }
+
+        return pos == end;
+    }
+
+    // Вызывает handler(tx, rx) для каждой страницы, false - ответ не соответствует запросу
+    template <typename Handler>
+    static bool split(const PacketView &tx, const PacketView &rx, Handler handler)
+    {
+        if (!isValidResponse(tx, rx))
+            return false;
+
+        size_t pos = 4;
+        size_t end = rx.size() - 1;
+
+        while (pos < end)
+        {
+            uint8_t index = rx[pos];
+            uint8_t length = WBusCommandBuilder::getSensorPageLength(index);
+
+            uint8_t pageTx[5] = {TXHEADER, 0x03, WBusCommandBuilder::CMD_READ_SENSOR, index, 0};
+            pageTx[4] = Utils::calculateChecksum(pageTx, 4);
+
+            uint8_t pageRx[WBUS_MAX_FRAME_LENGTH];
+            pageRx[0] = RXHEADER;
+            pageRx[1] = static_cast<uint8_t>(length + 3);
+            pageRx[2] = rx.getCommand();
+            pageRx[3] = index;
+            memcpy(&pageRx[4], rx.data() + pos + 1, length);
+            pageRx[4 + length] = Utils::calculateChecksum(pageRx, 4 + length);
+
+            handler(PacketView(pageTx, sizeof(pageTx)), PacketView(pageRx, length + 5));
+            pos += 1 + length;
+        }
+
+        return true;
+    }
+};
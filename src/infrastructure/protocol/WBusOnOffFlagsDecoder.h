@@ -3,20 +3,18 @@
 #include <Arduino.h>
 #include "../../domain/Entities.h"
 #include "../../common/Utils.h"
-#include "../../common/PacketParser.h"
+#include "../../common/PacketView.h"
 
 class WBusOnOffFlagsDecoder
 {
 public:
-    static OnOffFlags decode(const String &response)
+    static OnOffFlags decode(const PacketView &response)
     {
         OnOffFlags result;
 
-        PacketParser parser;
-
-        if (parser.parseFromString(response, WBusCommandBuilder::CMD_READ_SENSOR, PacketParser::WithIndex(WBusCommandBuilder::SENSOR_ON_OFF_FLAGS), PacketParser::WithMinLength(6)))
+        if (response.matches(WBusCommandBuilder::CMD_READ_SENSOR, PacketView::WithIndex(WBusCommandBuilder::SENSOR_ON_OFF_FLAGS), PacketView::WithMinLength(6)))
         {
-            auto &data = parser.getBytes();
+            const uint8_t *data = response.data();
 
             uint8_t flags = data[4];
             result.combustionAirFan = (flags & 0x01) != 0;
@@ -3,24 +3,21 @@
 #include <Arduino.h>
 #include "../../domain/Entities.h"
 #include "../../common/Utils.h"
-#include "../../common/PacketParser.h"
+#include "../../common/PacketView.h"
 #include "../../infrastructure/protocol/WBusCommandBuilder.h"
 
 class WBusOperatingStateDecoder
 {
 public:
-    static OperatingState decode(const String &response)
+    static OperatingState decode(const PacketView &response)
     {
         OperatingState result;
 
-        PacketParser parser;
-
-        if (parser.parseFromString(response, 
-            WBusCommandBuilder::CMD_READ_SENSOR, 
-            PacketParser::WithIndex(WBusCommandBuilder::SENSOR_OPERATING_STATE), 
-            PacketParser::WithMinLength(11)))
+        if (response.matches(WBusCommandBuilder::CMD_READ_SENSOR, 
+            PacketView::WithIndex(WBusCommandBuilder::SENSOR_OPERATING_STATE), 
+            PacketView::WithMinLength(11)))
         {
-            auto &data = parser.getBytes();
+            const uint8_t *data = response.data();
 
             // Сохраняем сырые данные
             result.stateCode = Utils::formatHexString(data[4]);
@@ -2,19 +2,18 @@
 #include <Arduino.h>
 #include "../../domain/Entities.h"
 #include "../../common/Utils.h"
+#include "../../common/PacketView.h"
 
 class WBusOperatingTimesDecoder
 {
 public:
-    static OperatingTimes decode(const String &response)
+    static OperatingTimes decode(const PacketView &response)
     {
         OperatingTimes result = {0, 0, 0, 0, 0};
 
-        PacketParser parser;
-
-        if (parser.parseFromString(response, WBusCommandBuilder::CMD_READ_SENSOR, PacketParser::WithIndex(WBusCommandBuilder::SENSOR_OPERATING_TIMES), PacketParser::WithMinLength(13)))
+        if (response.matches(WBusCommandBuilder::CMD_READ_SENSOR, PacketView::WithIndex(WBusCommandBuilder::SENSOR_OPERATING_TIMES), PacketView::WithMinLength(13)))
         {
-            auto &data = parser.getBytes();
+            const uint8_t *data = response.data();
 
             result.workingHours = (data[4] << 8) | data[5];
             result.workingMinutes = data[6];
@@ -3,20 +3,18 @@
 #include <Arduino.h>
 #include "../../domain/Entities.h"
 #include "../../common/Utils.h"
-#include "../../common/PacketParser.h"
+#include "../../common/PacketView.h"
 
 class WBusOperationalInfoDecoder
 {
 public:
-    static OperationalMeasurements decode(const String &response)
+    static OperationalMeasurements decode(const PacketView &response)
     {
         OperationalMeasurements result;
 
-        PacketParser parser;
-
-        if (parser.parseFromString(response, WBusCommandBuilder::CMD_READ_SENSOR, PacketParser::WithIndex(WBusCommandBuilder::SENSOR_OPERATIONAL), PacketParser::WithMinLength(13)))
+        if (response.matches(WBusCommandBuilder::CMD_READ_SENSOR, PacketView::WithIndex(WBusCommandBuilder::SENSOR_OPERATIONAL), PacketView::WithMinLength(13)))
         {
-            auto &data = parser.getBytes();
+            const uint8_t *data = response.data();
 
             result.temperature = data[4] - 50.0;
             result.voltage = (float)((data[5] << 8) | data[6]) / 1000.0;
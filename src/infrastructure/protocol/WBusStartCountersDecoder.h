@@ -2,19 +2,18 @@
 #include <Arduino.h>
 #include "../../domain/Entities.h"
 #include "../../common/Utils.h"
+#include "../../common/PacketView.h"
 
 class WBusStartCountersDecoder
 {
 public:
-    static StartCounters decode(const String &response)
+    static StartCounters decode(const PacketView &response)
     {
         StartCounters result = {0, 0, 0};
 
-        PacketParser parser;
-
-        if (parser.parseFromString(response, WBusCommandBuilder::CMD_READ_SENSOR, PacketParser::WithIndex(WBusCommandBuilder::SENSOR_START_COUNTERS), PacketParser::WithMinLength(11)))
+        if (response.matches(WBusCommandBuilder::CMD_READ_SENSOR, PacketView::WithIndex(WBusCommandBuilder::SENSOR_START_COUNTERS), PacketView::WithMinLength(11)))
         {
-            auto &data = parser.getBytes();
+            const uint8_t *data = response.data();
 
             result.shStarts = (data[4] << 8) | data[5];
             result.zhStarts = (data[6] << 8) | data[7];
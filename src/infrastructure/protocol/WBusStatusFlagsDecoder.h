@@ -3,19 +3,18 @@
 #include <Arduino.h>
 #include "../../domain/Entities.h"
 #include "../../common/Utils.h"
+#include "../../common/PacketView.h"
 
 class WBusStatusFlagsDecoder
 {
 public:
-    static StatusFlags decode(const String &response)
+    static StatusFlags decode(const PacketView &response)
     {
         StatusFlags result;
 
-        PacketParser parser;
-
-        if (parser.parseFromString(response, WBusCommandBuilder::CMD_READ_SENSOR, PacketParser::WithIndex(WBusCommandBuilder::SENSOR_STATUS_FLAGS), PacketParser::WithMinLength(10)))
+        if (response.matches(WBusCommandBuilder::CMD_READ_SENSOR, PacketView::WithIndex(WBusCommandBuilder::SENSOR_STATUS_FLAGS), PacketView::WithMinLength(10)))
         {
-            auto &data = parser.getBytes();
+            const uint8_t *data = response.data();
 
             // Байт 0
             result.mainSwitch = (data[4] & 0x01) != 0;
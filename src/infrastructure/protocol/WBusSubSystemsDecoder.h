@@ -3,19 +3,18 @@
 #include <Arduino.h>
 #include "../../domain/Entities.h"
 #include "../../common/Utils.h"
+#include "../../common/PacketView.h"
 
 class WBusSubSystemsDecoder
 {
 public:
-    static SubsystemsStatus decode(const String &response)
+    static SubsystemsStatus decode(const PacketView &response)
     {
         SubsystemsStatus result;
 
-        PacketParser parser;
-
-        if (parser.parseFromString(response, WBusCommandBuilder::CMD_READ_SENSOR, PacketParser::WithIndex(WBusCommandBuilder::SENSOR_SUBSYSTEMS_STATUS), PacketParser::WithMinLength(10)))
+        if (response.matches(WBusCommandBuilder::CMD_READ_SENSOR, PacketView::WithIndex(WBusCommandBuilder::SENSOR_SUBSYSTEMS_STATUS), PacketView::WithMinLength(10)))
         {
-            auto &data = parser.getBytes();
+            const uint8_t *data = response.data();
 
             result.glowPlugPower = data[4];
             result.fuelPumpFrequency = data[5];
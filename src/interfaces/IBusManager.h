@@ -12,13 +12,22 @@ public:
     virtual bool isConnected() const = 0;
     virtual ConnectionState getConnectionState() const = 0;
 
-    virtual bool sendCommand(uint8_t *data, size_t length) = 0;
+    // Кадр ставится в буфер UART одной записью, без ожидания передачи.
+    // Окончание передачи - isTxComplete(), момент - getTxCompleteUs()
+    virtual bool sendCommand(const uint8_t *data, size_t length) = 0;
+    virtual bool isTxComplete() = 0;
+    virtual int64_t getTxCompleteUs() const = 0;
 
+    // Пробуждение, сон и BREAK только запускаются: выполняются по шагам в process(),
+    // по завершении публикуется BUS_DRIVER_OPERATION
     virtual void sendBreak() = 0;
     virtual void wakeUp() = 0;
     virtual void sleep() = 0;
+    virtual void process() = 0;
+    virtual bool isBusy() const = 0; // Идет операция или ждет запрошенный BREAK
 
     virtual void sendBreakSignal(bool set) = 0;
+    virtual String getLineTimingJson() const = 0; // Измерения BREAK и импульса пробуждения
     virtual int available() = 0;
     virtual uint8_t read() = 0;
     virtual void flush() = 0;
@@ -0,0 +1,28 @@
+#pragma once
+#include <stdint.h>
+
+// Источник времени для всех компонентов: текущее время, пауза и плановое
+// пробуждение. На устройстве - millis()/delay() (SystemClock), в host-сборке
+// может быть виртуальным: время стоит, пока цикл работает, и перескакивает
+// к ближайшему запрошенному пробуждению.
+class IClock
+{
+public:
+    virtual ~IClock() = default;
+
+    virtual unsigned long nowMs() const = 0;
+    virtual int64_t nowUs() const = 0;
+
+    // Блокирующая пауза (аналог delay()/delayMicroseconds())
+    virtual void sleepMs(uint32_t ms) = 0;
+    virtual void sleepUs(uint32_t us) = 0;
+
+    // Вызывающему нужно управление не позже deadlineMs: истечение таймера,
+    // дедлайн опроса, шаг последовательности. Реальные часы это игнорируют.
+    virtual void wakeAt(unsigned long deadlineMs) = 0;
+    virtual void wakeAtUs(int64_t deadlineUs) = 0;
+
+    // Пауза основного цикла между проходами. Реальные часы спят maxUs,
+    // виртуальные сразу переходят к ближайшему запрошенному пробуждению.
+    virtual void idle(uint32_t maxUs) = 0;
+};
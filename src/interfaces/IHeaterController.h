@@ -8,25 +8,25 @@ public:
     virtual void initialize() = 0;
     virtual HeaterStatus getStatus() const = 0;
     
-    // Управление подключением
-    virtual void connect() = 0;
+    // Управление подключением: connect() возвращает дескриптор запроса диагностики
+    virtual CommandHandle connect() = 0;
     virtual void disconnect() = 0;
     
-    // Основные команды управления
-    virtual void startParkingHeat(int minutes = 59) = 0;
-    virtual void startVentilation(int minutes = 59) = 0;
-    virtual void startSupplementalHeat(int minutes = 59) = 0;
-    virtual void startBoostMode(int minutes = 59) = 0;
-    virtual void controlCirculationPump(bool enable) = 0;
-    virtual void fuelCirculation(int seconds) = 0;
-    virtual void shutdown() = 0;
+    // Основные команды управления (возвращают дескриптор результата команды)
+    virtual CommandHandle startParkingHeat(int minutes = 59) = 0;
+    virtual CommandHandle startVentilation(int minutes = 59) = 0;
+    virtual CommandHandle startSupplementalHeat(int minutes = 59) = 0;
+    virtual CommandHandle startBoostMode(int minutes = 59) = 0;
+    virtual CommandHandle controlCirculationPump(bool enable) = 0;
+    virtual CommandHandle fuelCirculation(int seconds) = 0;
+    virtual CommandHandle shutdown() = 0;
     
     // Тестирование компонентов
-    virtual void testCombustionFan(int seconds, int powerPercent) = 0;
-    virtual void testFuelPump(int seconds, int frequencyHz) = 0;
-    virtual void testGlowPlug(int seconds, int powerPercent) = 0;
-    virtual void testCirculationPump(int seconds) = 0;
-    virtual void testVehicleFan(int seconds) = 0;
-    virtual void testSolenoidValve(int seconds) = 0;
-    virtual void testFuelPreheating(int seconds, int powerPercent) = 0;
+    virtual CommandHandle testCombustionFan(int seconds, int powerPercent) = 0;
+    virtual CommandHandle testFuelPump(int seconds, int frequencyHz) = 0;
+    virtual CommandHandle testGlowPlug(int seconds, int powerPercent) = 0;
+    virtual CommandHandle testCirculationPump(int seconds) = 0;
+    virtual CommandHandle testVehicleFan(int seconds) = 0;
+    virtual CommandHandle testSolenoidValve(int seconds) = 0;
+    virtual CommandHandle testFuelPreheating(int seconds, int powerPercent) = 0;
 };
\ No newline at end of file
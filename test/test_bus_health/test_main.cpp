@@ -0,0 +1,176 @@
+// test/test_bus_health/test_main.cpp
+// Состояния шины, пробные запросы и отказ транзакции (pio test -e native)
+#include <Arduino.h>
+#include <unity.h>
+#include "../../host/ScriptedBus.h"
+
+HardwareSerial Serial(0);
+LittleFSFS LittleFS;
+
+static ScriptedStack stack;
+
+static WBusFrame sensor(uint8_t index)
+{
+    return WBusCommandBuilder::createReadSensor(index);
+}
+
+static CommandOutcome outcomeOf(const CommandHandle &handle)
+{
+    return stack.commandManager.getResult(handle).outcome;
+}
+
+static BusHealth health()
+{
+    return stack.commandManager.getBusHealth();
+}
+
+static bool jsonHas(const String &json, const String &fragment)
+{
+    return json.indexOf(fragment) >= 0;
+}
+
+// Команда без ответа: исчерпывает повторы и завершается таймаутом
+static CommandHandle failOne(uint8_t index)
+{
+    CommandHandle handle = stack.commandManager.addCommand(sensor(index), CommandClass::INTERACTIVE);
+    TEST_ASSERT_TRUE(handle.isTracked());
+    TEST_ASSERT_TRUE(stack.runUntil([&]()
+                                    { return stack.commandManager.getResult(handle).isDone(); }));
+    TEST_ASSERT_EQUAL((int)CommandOutcome::TIMEOUT, (int)outcomeOf(handle));
+    return handle;
+}
+
+static void takeBusDown()
+{
+    for (uint8_t i = 0; i < stack.config().busDownFailures; i++)
+        failOne(WBusCommandBuilder::SENSOR_STATUS_FLAGS + i);
+    TEST_ASSERT_EQUAL((int)BusHealth::DOWN, (int)health());
+}
+
+void setUp(void)
+{
+    stack.reset();
+}
+
+void tearDown(void) {}
+
+void test_failure_degrades_and_answer_recovers(void)
+{
+    TEST_ASSERT_EQUAL((int)BusHealth::HEALTHY, (int)health());
+
+    failOne(WBusCommandBuilder::SENSOR_STATUS_FLAGS);
+    TEST_ASSERT_EQUAL((int)BusHealth::DEGRADED, (int)health());
+    TEST_ASSERT_EQUAL(1 + stack.config().maxRetries, stack.bus.sent.size());
+
+    // При деградации команда повторяется не больше одного раза
+    failOne(WBusCommandBuilder::SENSOR_OPERATIONAL);
+    TEST_ASSERT_EQUAL((int)BusHealth::DEGRADED, (int)health());
+    TEST_ASSERT_EQUAL(1 + stack.config().maxRetries + 2, stack.bus.sent.size());
+
+    CommandHandle handle = stack.commandManager.addCommand(sensor(WBusCommandBuilder::SENSOR_OPERATING_STATE), CommandClass::INTERACTIVE);
+    TEST_ASSERT_TRUE(stack.runUntilSent(stack.bus.sent.size() + 1));
+    stack.bus.reply({0x4F, 0x04, 0xD0, WBusCommandBuilder::SENSOR_OPERATING_STATE, 0x01});
+    stack.step();
+
+    TEST_ASSERT_EQUAL((int)CommandOutcome::ACK, (int)outcomeOf(handle));
+    TEST_ASSERT_EQUAL((int)BusHealth::HEALTHY, (int)health());
+}
+
+void test_consecutive_failures_take_bus_down_and_drop_queue(void)
+{
+    CommandHandle handles[3];
+    for (uint8_t i = 0; i < 3; i++)
+        handles[i] = stack.commandManager.addCommand(sensor(WBusCommandBuilder::SENSOR_STATUS_FLAGS + i), CommandClass::INTERACTIVE);
+    CommandHandle queued = stack.commandManager.addCommand(sensor(WBusCommandBuilder::SENSOR_OPERATING_STATE), CommandClass::INTERACTIVE);
+
+    TEST_ASSERT_TRUE(stack.runUntil([]()
+                                    { return health() == BusHealth::DOWN; }, 120000));
+
+    for (uint8_t i = 0; i < 3; i++)
+        TEST_ASSERT_EQUAL((int)CommandOutcome::TIMEOUT, (int)outcomeOf(handles[i]));
+
+    // Оставшаяся очередь сброшена, новые команды не принимаются
+    TEST_ASSERT_EQUAL((int)CommandOutcome::CANCELLED, (int)outcomeOf(queued));
+    TEST_ASSERT_EQUAL(0, stack.commandManager.getTotalQueueSize());
+    TEST_ASSERT_FALSE(stack.commandManager.addCommand(sensor(WBusCommandBuilder::SENSOR_OPERATIONAL), CommandClass::INTERACTIVE).isTracked());
+}
+
+void test_probe_interval_doubles_up_to_max(void)
+{
+    takeBusDown();
+    unsigned long failedAt = stack.clock.nowMs();
+    const BusConfig &config = stack.config();
+
+    uint32_t interval = config.busProbeInterval;
+    for (int probe = 0; probe < 10; probe++)
+    {
+        size_t before = stack.bus.sent.size();
+        TEST_ASSERT_TRUE(stack.runUntilSent(before + 1, config.busProbeMaxInterval + config.commandTimeout));
+
+        // Пробный запрос - статус-флаги, не раньше назначенного интервала
+        TEST_ASSERT_EQUAL_HEX8(WBusCommandBuilder::SENSOR_STATUS_FLAGS, stack.bus.last()[3]);
+        unsigned long waited = stack.bus.sentAt[before] - failedAt;
+        TEST_ASSERT_GREATER_OR_EQUAL(interval - 1, waited); // failedAt снят после прохода цикла
+        TEST_ASSERT_LESS_OR_EQUAL(interval + config.commandTimeout, waited);
+
+        // Ответа нет - после таймаута пробного запроса интервал удваивается
+        TEST_ASSERT_TRUE(stack.runUntil([]()
+                                        { return stack.commandManager.isEmpty(); }));
+        failedAt = stack.clock.nowMs();
+
+        interval = interval * 2 > config.busProbeMaxInterval ? config.busProbeMaxInterval : interval * 2;
+        TEST_ASSERT_TRUE(jsonHas(stack.commandManager.getHealthJson(), "\"probeIntervalMs\":" + String(interval)));
+        TEST_ASSERT_EQUAL((int)BusHealth::DOWN, (int)health());
+    }
+
+    TEST_ASSERT_EQUAL(config.busProbeMaxInterval, interval);
+}
+
+void test_probe_answer_restores_bus(void)
+{
+    takeBusDown();
+
+    TEST_ASSERT_TRUE(stack.runUntilSent(stack.bus.sent.size() + 1));
+    stack.bus.reply({0x4F, 0x04, 0xD0, WBusCommandBuilder::SENSOR_STATUS_FLAGS, 0x00});
+    stack.step();
+
+    TEST_ASSERT_EQUAL((int)BusHealth::HEALTHY, (int)health());
+    TEST_ASSERT_TRUE(jsonHas(stack.commandManager.getHealthJson(), "\"recoveries\":"));
+    TEST_ASSERT_TRUE(stack.commandManager.addCommand(sensor(WBusCommandBuilder::SENSOR_OPERATIONAL), CommandClass::INTERACTIVE).isTracked());
+}
+
+void test_failed_transaction_drops_only_itself(void)
+{
+    CommandHandle failing = stack.commandManager.addCommand(sensor(WBusCommandBuilder::SENSOR_STATUS_FLAGS), CommandClass::INTERACTIVE);
+    CommandHandle next = stack.commandManager.addCommand(sensor(WBusCommandBuilder::SENSOR_OPERATIONAL), CommandClass::INTERACTIVE);
+    TEST_ASSERT_TRUE(stack.commandManager.addPolling(sensor(WBusCommandBuilder::SENSOR_OPERATING_STATE)));
+
+    TEST_ASSERT_TRUE(stack.runUntil([&]()
+                                    { return stack.commandManager.getResult(failing).isDone(); }));
+    TEST_ASSERT_EQUAL((int)CommandOutcome::TIMEOUT, (int)outcomeOf(failing));
+    TEST_ASSERT_EQUAL((int)CommandOutcome::PENDING, (int)outcomeOf(next));
+
+    // Следующая команда из очереди уходит на шину и получает ответ
+    TEST_ASSERT_TRUE(stack.runUntil([]()
+                                    { return stack.bus.last()[3] == WBusCommandBuilder::SENSOR_OPERATIONAL; }));
+    stack.runFor(50);
+    stack.bus.reply({0x4F, 0x04, 0xD0, WBusCommandBuilder::SENSOR_OPERATIONAL, 0x01});
+    stack.step();
+    TEST_ASSERT_EQUAL((int)CommandOutcome::ACK, (int)outcomeOf(next));
+
+    // Страница опроса тоже осталась в расписании
+    TEST_ASSERT_TRUE(stack.runUntil([]()
+                                    { return stack.bus.last()[3] == WBusCommandBuilder::SENSOR_OPERATING_STATE; }));
+    TEST_ASSERT_EQUAL((int)BusHealth::HEALTHY, (int)health());
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_failure_degrades_and_answer_recovers);
+    RUN_TEST(test_consecutive_failures_take_bus_down_and_drop_queue);
+    RUN_TEST(test_probe_interval_doubles_up_to_max);
+    RUN_TEST(test_probe_answer_restores_bus);
+    RUN_TEST(test_failed_transaction_drops_only_itself);
+    return UNITY_END();
+}
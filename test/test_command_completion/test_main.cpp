@@ -0,0 +1,148 @@
+// test/test_command_completion/test_main.cpp
+// Таблица результатов команд: поколения, вытеснение, переполнение (pio test -e native)
+#include <Arduino.h>
+#include <unity.h>
+#include <vector>
+#include "application/CommandCompletion.h"
+#include "common/Utils.h"
+
+HardwareSerial Serial(0);
+
+static const unsigned long T0 = 100000;
+
+static std::vector<uint8_t> withChecksum(std::vector<uint8_t> frame)
+{
+    frame[1] = static_cast<uint8_t>(frame.size() - 1);
+    frame.push_back(Utils::calculateChecksum(frame.data(), frame.size()));
+    return frame;
+}
+
+static bool jsonHas(const String &json, const char *fragment)
+{
+    return json.indexOf(fragment) >= 0;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_complete_stores_ack_and_nak(void)
+{
+    CompletionTable table;
+    CommandHandle ack = table.open(T0);
+    CommandHandle nak = table.open(T0);
+    TEST_ASSERT_TRUE(ack.isTracked());
+    TEST_ASSERT_EQUAL((int)CommandOutcome::PENDING, (int)table.get(ack).outcome);
+
+    std::vector<uint8_t> rx = withChecksum({0x4F, 0x00, 0xD0, 0x05, 0x42});
+    table.complete(ack, PacketView(rx.data(), rx.size()), T0 + 40);
+    std::vector<uint8_t> nakRx = withChecksum({0x4F, 0x00, 0x7F, 0x50, 0x33});
+    table.complete(nak, PacketView(nakRx.data(), nakRx.size()), T0 + 60);
+
+    CommandResult result = table.get(ack);
+    TEST_ASSERT_EQUAL((int)CommandOutcome::ACK, (int)result.outcome);
+    TEST_ASSERT_EQUAL(rx.size(), result.responseLength);
+    TEST_ASSERT_EQUAL_HEX8(0x42, result.response[4]);
+    TEST_ASSERT_EQUAL(40, result.elapsedMs);
+
+    TEST_ASSERT_EQUAL((int)CommandOutcome::NAK, (int)table.get(nak).outcome);
+    TEST_ASSERT_EQUAL_HEX8(0x33, table.get(nak).nakCode);
+
+    // Повторное завершение итог не меняет
+    table.fail(ack, CommandOutcome::TIMEOUT, T0 + 80);
+    TEST_ASSERT_EQUAL((int)CommandOutcome::ACK, (int)table.get(ack).outcome);
+}
+
+void test_stale_handle_does_not_see_reused_record(void)
+{
+    CompletionTable table;
+    CommandHandle stale = table.open(T0);
+    table.fail(stale, CommandOutcome::TIMEOUT, T0 + 10);
+    table.release(stale);
+    TEST_ASSERT_EQUAL((int)CommandOutcome::UNKNOWN, (int)table.get(stale).outcome);
+
+    // Освобожденная запись занята заново - с новым поколением
+    CommandHandle fresh = table.open(T0 + 20);
+    TEST_ASSERT_EQUAL(stale.slot, fresh.slot);
+    TEST_ASSERT_TRUE(stale.generation != fresh.generation);
+    TEST_ASSERT_TRUE(stale.id() != fresh.id());
+
+    // Старый дескриптор не читает и не завершает чужую команду
+    TEST_ASSERT_EQUAL((int)CommandOutcome::UNKNOWN, (int)table.get(stale).outcome);
+    table.fail(stale, CommandOutcome::CANCELLED, T0 + 30);
+    table.release(stale);
+    TEST_ASSERT_EQUAL((int)CommandOutcome::PENDING, (int)table.get(fresh).outcome);
+}
+
+void test_release_keeps_pending_record_until_finished(void)
+{
+    CompletionTable table;
+    CommandHandle handle = table.open(T0);
+
+    table.release(handle);
+    TEST_ASSERT_EQUAL((int)CommandOutcome::PENDING, (int)table.get(handle).outcome);
+    TEST_ASSERT_TRUE(jsonHas(table.toJson(), "\"used\":1,\"pending\":1"));
+
+    // Итог никто не ждет - запись свободна сразу после завершения
+    table.fail(handle, CommandOutcome::TIMEOUT, T0 + 10);
+    TEST_ASSERT_EQUAL((int)CommandOutcome::UNKNOWN, (int)table.get(handle).outcome);
+    TEST_ASSERT_TRUE(jsonHas(table.toJson(), "\"used\":0"));
+}
+
+void test_oldest_finished_record_is_evicted(void)
+{
+    CompletionTable table;
+    CommandHandle handles[CompletionTable::CAPACITY];
+    for (size_t i = 0; i < CompletionTable::CAPACITY; i++)
+        handles[i] = table.open(T0);
+
+    // Завершены три записи; раньше всех - handles[5], хотя открыта не первой
+    table.fail(handles[9], CommandOutcome::TIMEOUT, T0 + 300);
+    table.fail(handles[5], CommandOutcome::TIMEOUT, T0 + 100);
+    table.fail(handles[12], CommandOutcome::TIMEOUT, T0 + 200);
+
+    CommandHandle next = table.open(T0 + 400);
+    TEST_ASSERT_TRUE(next.isTracked());
+    TEST_ASSERT_EQUAL(handles[5].slot, next.slot);
+    TEST_ASSERT_EQUAL((int)CommandOutcome::UNKNOWN, (int)table.get(handles[5]).outcome);
+    TEST_ASSERT_EQUAL((int)CommandOutcome::TIMEOUT, (int)table.get(handles[12]).outcome);
+    TEST_ASSERT_EQUAL((int)CommandOutcome::TIMEOUT, (int)table.get(handles[9]).outcome);
+
+    CommandHandle after = table.open(T0 + 500);
+    TEST_ASSERT_EQUAL(handles[12].slot, after.slot);
+    TEST_ASSERT_TRUE(jsonHas(table.toJson(), "\"evicted\":2"));
+}
+
+void test_all_pending_falls_back_to_untracked(void)
+{
+    CompletionTable table;
+    CommandHandle handles[CompletionTable::CAPACITY];
+    for (size_t i = 0; i < CompletionTable::CAPACITY; i++)
+    {
+        handles[i] = table.open(T0);
+        TEST_ASSERT_TRUE(handles[i].isTracked());
+    }
+
+    // Команда принимается, но ее итог не отслеживается; ожидающие не вытесняются
+    CommandHandle overflow = table.open(T0 + 10);
+    TEST_ASSERT_TRUE((bool)overflow);
+    TEST_ASSERT_FALSE(overflow.isTracked());
+    TEST_ASSERT_EQUAL(0, overflow.id());
+    TEST_ASSERT_EQUAL((int)CommandOutcome::UNKNOWN, (int)table.get(overflow).outcome);
+    for (size_t i = 0; i < CompletionTable::CAPACITY; i++)
+        TEST_ASSERT_EQUAL((int)CommandOutcome::PENDING, (int)table.get(handles[i]).outcome);
+
+    TEST_ASSERT_TRUE(jsonHas(table.toJson(), "\"pending\":16"));
+    TEST_ASSERT_TRUE(jsonHas(table.toJson(), "\"untracked\":1,\"evicted\":0"));
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_complete_stores_ack_and_nak);
+    RUN_TEST(test_stale_handle_does_not_see_reused_record);
+    RUN_TEST(test_release_keeps_pending_record_until_finished);
+    RUN_TEST(test_oldest_finished_record_is_evicted);
+    RUN_TEST(test_all_pending_falls_back_to_untracked);
+    return UNITY_END();
+}
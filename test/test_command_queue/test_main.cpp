@@ -0,0 +1,177 @@
+// test/test_command_queue/test_main.cpp
+// Классы очереди, дубликаты и старение (pio test -e native)
+#include <Arduino.h>
+#include <unity.h>
+#include "application/CommandQueue.h"
+#include "infrastructure/protocol/WBusCommandBuilder.h"
+
+HardwareSerial Serial(0);
+
+static CommandQueue queue;
+static BusConfig config;
+
+static bool push(CommandClass commandClass, const WBusFrame &frame, unsigned long now)
+{
+    return queue.push(commandClass, Command(frame), now, config);
+}
+
+static bool jsonHas(const String &json, const char *fragment)
+{
+    return json.indexOf(fragment) >= 0;
+}
+
+void setUp(void)
+{
+    queue.clear();
+    config = BusConfig();
+}
+
+void tearDown(void) {}
+
+void test_duplicate_in_same_class_is_rejected(void)
+{
+    WBusFrame status = WBusCommandBuilder::createReadSensor(0x05);
+
+    TEST_ASSERT_TRUE(push(CommandClass::BACKGROUND, status, 0));
+    TEST_ASSERT_FALSE(push(CommandClass::BACKGROUND, status, 10));
+    TEST_ASSERT_EQUAL(1, queue.size());
+    TEST_ASSERT_TRUE(queue.contains(CommandClass::BACKGROUND, status));
+    TEST_ASSERT_TRUE(jsonHas(queue.toJson(10, config), "\"duplicates\":1"));
+}
+
+void test_same_frame_in_other_class_is_accepted(void)
+{
+    WBusFrame status = WBusCommandBuilder::createReadSensor(0x05);
+
+    TEST_ASSERT_TRUE(push(CommandClass::BACKGROUND, status, 0));
+    TEST_ASSERT_TRUE(push(CommandClass::INTERACTIVE, status, 0));
+    TEST_ASSERT_EQUAL(2, queue.size());
+    TEST_ASSERT_TRUE(queue.containsAny(status));
+}
+
+void test_frame_can_be_queued_again_after_pop(void)
+{
+    WBusFrame status = WBusCommandBuilder::createReadSensor(0x05);
+
+    TEST_ASSERT_TRUE(push(CommandClass::BACKGROUND, status, 0));
+    Command command = queue.pop(0, config);
+    TEST_ASSERT_TRUE(command.frame == status);
+    TEST_ASSERT_FALSE(queue.containsAny(status));
+    TEST_ASSERT_TRUE(push(CommandClass::BACKGROUND, status, 0));
+}
+
+void test_hash_collision_chain_survives_erase(void)
+{
+    // Много кадров в одном классе: удаление из середины цепочки
+    // не должно терять остальные записи таблицы хешей
+    for (uint8_t index = 1; index <= 8; index++)
+        TEST_ASSERT_TRUE(push(CommandClass::BACKGROUND, WBusCommandBuilder::createReadSensor(index), 0));
+
+    queue.pop(0, config);
+    queue.pop(0, config);
+
+    for (uint8_t index = 3; index <= 8; index++)
+        TEST_ASSERT_TRUE(queue.contains(CommandClass::BACKGROUND, WBusCommandBuilder::createReadSensor(index)));
+    TEST_ASSERT_FALSE(queue.contains(CommandClass::BACKGROUND, WBusCommandBuilder::createReadSensor(1)));
+}
+
+void test_higher_class_goes_first(void)
+{
+    WBusFrame poll = WBusCommandBuilder::createReadSensor(0x05);
+    WBusFrame keepAlive = WBusCommandBuilder::createKeepAliveParking();
+    WBusFrame info = WBusCommandBuilder::createReadInfo(0x0A);
+
+    push(CommandClass::BACKGROUND, poll, 0);
+    push(CommandClass::INTERACTIVE, info, 0);
+    push(CommandClass::SAFETY, keepAlive, 0);
+
+    TEST_ASSERT_TRUE(queue.pop(0, config).frame == keepAlive);
+    TEST_ASSERT_TRUE(queue.pop(0, config).frame == info);
+    TEST_ASSERT_TRUE(queue.pop(0, config).frame == poll);
+    TEST_ASSERT_TRUE(queue.isEmpty());
+}
+
+void test_fifo_within_class(void)
+{
+    push(CommandClass::BACKGROUND, WBusCommandBuilder::createReadSensor(0x05), 0);
+    push(CommandClass::BACKGROUND, WBusCommandBuilder::createReadSensor(0x07), 5);
+
+    TEST_ASSERT_EQUAL_HEX8(0x05, queue.pop(10, config).frame.getIndex());
+    TEST_ASSERT_EQUAL_HEX8(0x07, queue.pop(10, config).frame.getIndex());
+}
+
+void test_aging_promotes_waiting_background(void)
+{
+    WBusFrame poll = WBusCommandBuilder::createReadSensor(0x05);
+    WBusFrame control = WBusCommandBuilder::createParkHeat(30);
+
+    // BACKGROUND (ранг 3) ждет три шага старения - ранг 0, раньше CONTROL (ранг 1)
+    push(CommandClass::BACKGROUND, poll, 0);
+    unsigned long now = 3 * config.queueAgingStep;
+    push(CommandClass::CONTROL, control, now);
+
+    TEST_ASSERT_TRUE(queue.pop(now, config).frame == poll);
+    TEST_ASSERT_TRUE(queue.pop(now, config).frame == control);
+    TEST_ASSERT_TRUE(jsonHas(queue.toJson(now, config), "\"aged\":1"));
+}
+
+void test_no_aging_before_step(void)
+{
+    WBusFrame poll = WBusCommandBuilder::createReadSensor(0x05);
+    WBusFrame control = WBusCommandBuilder::createParkHeat(30);
+
+    push(CommandClass::BACKGROUND, poll, 0);
+    unsigned long now = config.queueAgingStep - 1;
+    push(CommandClass::CONTROL, control, now);
+
+    TEST_ASSERT_TRUE(queue.pop(now, config).frame == control);
+}
+
+void test_aging_disabled(void)
+{
+    config.queueAgingStep = 0;
+    WBusFrame poll = WBusCommandBuilder::createReadSensor(0x05);
+    WBusFrame control = WBusCommandBuilder::createParkHeat(30);
+
+    push(CommandClass::BACKGROUND, poll, 0);
+    push(CommandClass::CONTROL, control, 100000);
+
+    TEST_ASSERT_TRUE(queue.pop(100000, config).frame == control);
+}
+
+void test_class_capacity(void)
+{
+    config.queueSafetySize = 2;
+
+    TEST_ASSERT_TRUE(push(CommandClass::SAFETY, WBusCommandBuilder::createKeepAliveParking(), 0));
+    TEST_ASSERT_TRUE(push(CommandClass::SAFETY, WBusCommandBuilder::createShutdown(), 0));
+    TEST_ASSERT_FALSE(push(CommandClass::SAFETY, WBusCommandBuilder::createKeepAliveBoost(), 0));
+    TEST_ASSERT_EQUAL(2, queue.size(CommandClass::SAFETY));
+
+    // Заполненный класс не мешает остальным
+    TEST_ASSERT_TRUE(push(CommandClass::CONTROL, WBusCommandBuilder::createKeepAliveBoost(), 0));
+}
+
+void test_pop_empty_returns_empty_command(void)
+{
+    Command command = queue.pop(0, config);
+
+    TEST_ASSERT_EQUAL(0, command.frame.size());
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_duplicate_in_same_class_is_rejected);
+    RUN_TEST(test_same_frame_in_other_class_is_accepted);
+    RUN_TEST(test_frame_can_be_queued_again_after_pop);
+    RUN_TEST(test_hash_collision_chain_survives_erase);
+    RUN_TEST(test_higher_class_goes_first);
+    RUN_TEST(test_fifo_within_class);
+    RUN_TEST(test_aging_promotes_waiting_background);
+    RUN_TEST(test_no_aging_before_step);
+    RUN_TEST(test_aging_disabled);
+    RUN_TEST(test_class_capacity);
+    RUN_TEST(test_pop_empty_returns_empty_command);
+    return UNITY_END();
+}
@@ -0,0 +1,149 @@
+// test/test_framer/test_main.cpp
+// Выделение кадров W-Bus из потока байт (pio test -e native)
+#include <Arduino.h>
+#include <unity.h>
+#include <vector>
+#include "infrastructure/protocol/WBusFramer.h"
+
+HardwareSerial Serial(0);
+
+using Bytes = std::vector<uint8_t>;
+
+static WBusFramer framer;
+static std::vector<Bytes> frames;
+static uint32_t nowUs = 0;
+
+static void feed(const Bytes &bytes, uint32_t byteTimeUs = 4583)
+{
+    for (uint8_t value : bytes)
+    {
+        nowUs += byteTimeUs;
+        framer.feed(value, nowUs, [](const uint8_t *frame, size_t length)
+                    { frames.push_back(Bytes(frame, frame + length)); });
+    }
+}
+
+void setUp(void)
+{
+    framer = WBusFramer(100);
+    frames.clear();
+    nowUs = 1000000;
+}
+
+void tearDown(void) {}
+
+static const Bytes KEEP_ALIVE = {0xF4, 0x04, 0x44, 0x2A, 0x00, 0x9E};
+static const Bytes KEEP_ALIVE_ACK = {0x4F, 0x03, 0xC4, 0x00, 0x88};
+
+void test_valid_frame_is_delivered_once(void)
+{
+    feed(KEEP_ALIVE);
+
+    TEST_ASSERT_EQUAL(1, frames.size());
+    TEST_ASSERT_EQUAL(KEEP_ALIVE.size(), frames[0].size());
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(KEEP_ALIVE.data(), frames[0].data(), KEEP_ALIVE.size());
+    TEST_ASSERT_EQUAL_UINT32(1, framer.getStats().framesReceived);
+    TEST_ASSERT_EQUAL_UINT32(0, framer.getStats().droppedFrames());
+    TEST_ASSERT_FALSE(framer.isReceiving());
+}
+
+void test_back_to_back_frames(void)
+{
+    feed(KEEP_ALIVE);
+    feed(KEEP_ALIVE_ACK);
+
+    TEST_ASSERT_EQUAL(2, frames.size());
+    TEST_ASSERT_EQUAL_HEX8(0x4F, frames[1][0]);
+    TEST_ASSERT_EQUAL_UINT32(2, framer.getStats().framesReceived);
+}
+
+void test_garbage_before_header_is_discarded(void)
+{
+    feed({0x00, 0x11, 0x22});
+    feed(KEEP_ALIVE_ACK);
+
+    TEST_ASSERT_EQUAL(1, frames.size());
+    TEST_ASSERT_EQUAL_UINT32(3, framer.getStats().discardedBytes);
+}
+
+void test_checksum_error_is_counted(void)
+{
+    Bytes corrupted = KEEP_ALIVE_ACK;
+    corrupted.back() ^= 0x01;
+    feed(corrupted);
+
+    TEST_ASSERT_EQUAL(0, frames.size());
+    TEST_ASSERT_EQUAL_UINT32(1, framer.getStats().checksumErrors);
+    TEST_ASSERT_EQUAL_UINT32(0, framer.getStats().framesReceived);
+}
+
+void test_resync_finds_frame_inside_broken_one(void)
+{
+    // Обрезанный запрос "F4 04", сразу за ним - ответ: ответ становится
+    // телом ложного кадра, после ошибки контрольной суммы находится заново
+    feed({0xF4, 0x04});
+    feed(KEEP_ALIVE_ACK);
+
+    TEST_ASSERT_EQUAL(1, frames.size());
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(KEEP_ALIVE_ACK.data(), frames[0].data(), KEEP_ALIVE_ACK.size());
+    TEST_ASSERT_EQUAL_UINT32(1, framer.getStats().checksumErrors);
+    TEST_ASSERT_EQUAL_UINT32(1, framer.getStats().resyncs);
+}
+
+void test_invalid_length_byte(void)
+{
+    feed({0xF4, 0x01});
+    feed(KEEP_ALIVE);
+
+    TEST_ASSERT_EQUAL(1, frames.size());
+    TEST_ASSERT_EQUAL_UINT32(1, framer.getStats().lengthErrors);
+}
+
+void test_gap_aborts_partial_frame(void)
+{
+    feed({0xF4, 0x04, 0x44});
+    TEST_ASSERT_TRUE(framer.isReceiving());
+
+    // Пауза больше frameGapTimeout: начатый кадр отбрасывается
+    nowUs += 150000;
+    framer.checkGap(nowUs);
+
+    TEST_ASSERT_FALSE(framer.isReceiving());
+    TEST_ASSERT_EQUAL_UINT32(1, framer.getStats().gapAborts);
+    TEST_ASSERT_EQUAL_UINT32(3, framer.getStats().discardedBytes);
+
+    feed(KEEP_ALIVE);
+    TEST_ASSERT_EQUAL(1, frames.size());
+}
+
+void test_gap_within_timeout_keeps_frame(void)
+{
+    feed({0xF4, 0x04, 0x44});
+    feed({0x2A, 0x00, 0x9E}, 50000);
+
+    TEST_ASSERT_EQUAL(1, frames.size());
+    TEST_ASSERT_EQUAL_UINT32(0, framer.getStats().gapAborts);
+}
+
+void test_reset_stats(void)
+{
+    feed(KEEP_ALIVE);
+    framer.resetStats();
+
+    TEST_ASSERT_EQUAL_UINT32(0, framer.getStats().framesReceived);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_valid_frame_is_delivered_once);
+    RUN_TEST(test_back_to_back_frames);
+    RUN_TEST(test_garbage_before_header_is_discarded);
+    RUN_TEST(test_checksum_error_is_counted);
+    RUN_TEST(test_resync_finds_frame_inside_broken_one);
+    RUN_TEST(test_invalid_length_byte);
+    RUN_TEST(test_gap_aborts_partial_frame);
+    RUN_TEST(test_gap_within_timeout_keeps_frame);
+    RUN_TEST(test_reset_stats);
+    return UNITY_END();
+}
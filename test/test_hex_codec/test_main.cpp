@@ -0,0 +1,151 @@
+// test/test_hex_codec/test_main.cpp
+// Табличное HEX кодирование в буфер вызывающего (pio test -e native)
+#include <Arduino.h>
+#include <unity.h>
+#include "common/HexCodec.h"
+#include "common/Utils.h"
+
+HardwareSerial Serial(0);
+
+static const uint8_t FRAME[] = {0xF4, 0x03, 0x50, 0x05, 0xA2};
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_encode_with_separator(void)
+{
+    char out[HexCodec::encodedSize(sizeof(FRAME))];
+    size_t written = HexCodec::encode(FRAME, sizeof(FRAME), out, sizeof(out));
+
+    TEST_ASSERT_EQUAL_STRING("f4 03 50 05 a2", out);
+    TEST_ASSERT_EQUAL(14, written);
+    TEST_ASSERT_EQUAL(15, sizeof(out));
+}
+
+void test_encode_without_separator_upper_case(void)
+{
+    char out[HexCodec::encodedSize(sizeof(FRAME), '\0')];
+    HexCodec::encode(FRAME, sizeof(FRAME), out, sizeof(out), '\0', true);
+
+    TEST_ASSERT_EQUAL_STRING("F4035005A2", out);
+}
+
+void test_encode_truncates_to_whole_bytes(void)
+{
+    char out[8]; // "f4 03" + ' ' не помещает третий байт целиком
+    size_t written = HexCodec::encode(FRAME, sizeof(FRAME), out, sizeof(out));
+
+    TEST_ASSERT_EQUAL_STRING("f4 03", out);
+    TEST_ASSERT_EQUAL(5, written);
+}
+
+void test_encode_empty_and_null(void)
+{
+    char out[4] = "xyz";
+
+    TEST_ASSERT_EQUAL(0, HexCodec::encode(FRAME, 0, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_STRING("", out);
+    TEST_ASSERT_EQUAL(0, HexCodec::encode(FRAME, sizeof(FRAME), nullptr, 10));
+    TEST_ASSERT_EQUAL(1, HexCodec::encodedSize(0));
+}
+
+void test_decode_spaced_and_compact_mixed_case(void)
+{
+    uint8_t out[8];
+    const char *spaced = "f4 03 50 05 a2";
+    const char *compact = "F4035005a2";
+
+    TEST_ASSERT_EQUAL(5, HexCodec::decode(spaced, strlen(spaced), out, sizeof(out)));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(FRAME, out, sizeof(FRAME));
+
+    memset(out, 0, sizeof(out));
+    TEST_ASSERT_EQUAL(5, HexCodec::decode(compact, strlen(compact), out, sizeof(out)));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(FRAME, out, sizeof(FRAME));
+}
+
+void test_decode_rejects_bad_input(void)
+{
+    uint8_t out[8];
+
+    TEST_ASSERT_EQUAL(0, HexCodec::decode("f4 0g", 5, out, sizeof(out)));   // Не HEX символ
+    TEST_ASSERT_EQUAL(0, HexCodec::decode("f4 0", 4, out, sizeof(out)));    // Нечетное число цифр
+    TEST_ASSERT_EQUAL(0, HexCodec::decode("f4 03 50", 8, out, 2));          // Нет места
+    TEST_ASSERT_EQUAL(0, HexCodec::decode(nullptr, 4, out, sizeof(out)));
+}
+
+void test_round_trip_all_byte_values(void)
+{
+    uint8_t bytes[256];
+    for (size_t i = 0; i < sizeof(bytes); i++)
+        bytes[i] = static_cast<uint8_t>(i);
+
+    char hex[HexCodec::encodedSize(sizeof(bytes))];
+    uint8_t decoded[sizeof(bytes)];
+    size_t written = HexCodec::encode(bytes, sizeof(bytes), hex, sizeof(hex));
+
+    TEST_ASSERT_EQUAL(sizeof(hex) - 1, written);
+    TEST_ASSERT_EQUAL(sizeof(bytes), HexCodec::decode(hex, written, decoded, sizeof(decoded)));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(bytes, decoded, sizeof(bytes));
+}
+
+void test_nibble_table(void)
+{
+    TEST_ASSERT_EQUAL_HEX8(0x0, HexCodec::nibble('0'));
+    TEST_ASSERT_EQUAL_HEX8(0x9, HexCodec::nibble('9'));
+    TEST_ASSERT_EQUAL_HEX8(0xA, HexCodec::nibble('a'));
+    TEST_ASSERT_EQUAL_HEX8(0xF, HexCodec::nibble('F'));
+    TEST_ASSERT_EQUAL_HEX8(HexCodec::INVALID_NIBBLE, HexCodec::nibble('g'));
+    TEST_ASSERT_EQUAL_HEX8(HexCodec::INVALID_NIBBLE, HexCodec::nibble(' '));
+    TEST_ASSERT_EQUAL_HEX8(HexCodec::INVALID_NIBBLE, HexCodec::nibble(static_cast<char>(0xC1)));
+}
+
+void test_byte_at_skips_spaces(void)
+{
+    const char *hex = "4f 04 7f 50 33 57";
+    uint8_t value = 0;
+
+    TEST_ASSERT_TRUE(HexCodec::byteAt(hex, strlen(hex), 0, value));
+    TEST_ASSERT_EQUAL_HEX8(0x4F, value);
+    TEST_ASSERT_TRUE(HexCodec::byteAt(hex, strlen(hex), 4, value));
+    TEST_ASSERT_EQUAL_HEX8(0x33, value);
+    TEST_ASSERT_FALSE(HexCodec::byteAt(hex, strlen(hex), 6, value));
+}
+
+void test_utils_wrappers(void)
+{
+    TEST_ASSERT_EQUAL_STRING("f4 03 50 05 a2", Utils::bytesToHexString(FRAME, sizeof(FRAME)).c_str());
+    TEST_ASSERT_EQUAL_STRING("0a", Utils::byteToHexString(0x0A).c_str());
+    TEST_ASSERT_EQUAL_HEX8(0x33, Utils::extractByteFromString("4f 04 7f 50 33 57", 4));
+    TEST_ASSERT_EQUAL_HEX8(0x00, Utils::extractByteFromString("4f 04", 5));
+    TEST_ASSERT_TRUE(Utils::isNakPacket("4F047F503357"));
+    TEST_ASSERT_FALSE(Utils::isNakPacket("4f 03 c4 00 88"));
+}
+
+void test_long_buffer_in_chunks(void)
+{
+    // bytesToHexString кодирует частями по 64 байта - разделитель на стыке
+    uint8_t bytes[130];
+    for (size_t i = 0; i < sizeof(bytes); i++)
+        bytes[i] = static_cast<uint8_t>(i);
+
+    String hex = Utils::bytesToHexString(bytes, sizeof(bytes));
+    TEST_ASSERT_EQUAL(HexCodec::encodedSize(sizeof(bytes)) - 1, hex.length());
+    TEST_ASSERT_EQUAL_STRING("3f 40 41", hex.substring(63 * 3, 66 * 3 - 1).c_str());
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_encode_with_separator);
+    RUN_TEST(test_encode_without_separator_upper_case);
+    RUN_TEST(test_encode_truncates_to_whole_bytes);
+    RUN_TEST(test_encode_empty_and_null);
+    RUN_TEST(test_decode_spaced_and_compact_mixed_case);
+    RUN_TEST(test_decode_rejects_bad_input);
+    RUN_TEST(test_round_trip_all_byte_values);
+    RUN_TEST(test_nibble_table);
+    RUN_TEST(test_byte_at_skips_spaces);
+    RUN_TEST(test_utils_wrappers);
+    RUN_TEST(test_long_buffer_in_chunks);
+    return UNITY_END();
+}
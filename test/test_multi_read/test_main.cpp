@@ -0,0 +1,297 @@
+// test/test_multi_read/test_main.cpp
+// Групповое чтение 0x50 0x30: разбор ответа, сбор страниц и возврат
+// к опросу по одной странице (pio test -e native)
+#include <Arduino.h>
+#include <unity.h>
+#include <vector>
+#include "../../host/ScriptedBus.h"
+#include "application/PollScheduler.h"
+#include "infrastructure/protocol/WBusMultiReadDecoder.h"
+
+HardwareSerial Serial(0);
+LittleFSFS LittleFS;
+
+static const unsigned long T0 = 100000;
+
+static const uint8_t STATUS_PAGE = WBusCommandBuilder::SENSOR_STATUS_FLAGS;
+static const uint8_t OPERATIONAL_PAGE = WBusCommandBuilder::SENSOR_OPERATIONAL;
+static const uint8_t STATE_PAGE = WBusCommandBuilder::SENSOR_OPERATING_STATE;
+static const uint8_t MULTI_READ = WBusCommandBuilder::SENSOR_MULTI_READ;
+static const uint8_t READ_SENSOR = WBusCommandBuilder::CMD_READ_SENSOR;
+
+static ScriptedStack stack;
+
+static std::vector<uint8_t> withChecksum(std::vector<uint8_t> frame)
+{
+    frame[1] = static_cast<uint8_t>(frame.size() - 1);
+    frame.push_back(Utils::calculateChecksum(frame.data(), frame.size()));
+    return frame;
+}
+
+static const uint8_t STATUS_DATA[] = {0x01, 0x02, 0x03, 0x04, 0x05};
+static const uint8_t OPERATIONAL_DATA[] = {0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17};
+
+// 4F len D0 30 02 [5 байт] 05 [8 байт] cs
+static std::vector<uint8_t> statusAndOperationalReply()
+{
+    std::vector<uint8_t> rx = {0x4F, 0x00, 0xD0, MULTI_READ};
+    rx.push_back(STATUS_PAGE);
+    rx.insert(rx.end(), STATUS_DATA, STATUS_DATA + sizeof(STATUS_DATA));
+    rx.push_back(OPERATIONAL_PAGE);
+    rx.insert(rx.end(), OPERATIONAL_DATA, OPERATIONAL_DATA + sizeof(OPERATIONAL_DATA));
+    return rx;
+}
+
+static WBusFrame statusAndOperationalRequest()
+{
+    const uint8_t indexes[] = {STATUS_PAGE, OPERATIONAL_PAGE};
+    return WBusCommandBuilder::createMultiReadSensor(indexes, 2);
+}
+
+// Опрос: две страницы одной группы (FAST), всегда должны одновременно
+static const uint8_t STATE_DATA[] = {0x20, 0x21, 0x22, 0x23, 0x24, 0x25};
+
+static WBusFrame pollBatchRequest()
+{
+    const uint8_t indexes[] = {OPERATIONAL_PAGE, STATE_PAGE};
+    return WBusCommandBuilder::createMultiReadSensor(indexes, 2);
+}
+
+static std::vector<uint8_t> pollBatchReply()
+{
+    std::vector<uint8_t> rx = {0x4F, 0x00, 0xD0, MULTI_READ, OPERATIONAL_PAGE};
+    rx.insert(rx.end(), OPERATIONAL_DATA, OPERATIONAL_DATA + sizeof(OPERATIONAL_DATA));
+    rx.push_back(STATE_PAGE);
+    rx.insert(rx.end(), STATE_DATA, STATE_DATA + sizeof(STATE_DATA));
+    return withChecksum(rx);
+}
+
+static bool isMultiReadSent()
+{
+    return !stack.bus.sent.empty() && stack.bus.last()[3] == MULTI_READ;
+}
+
+static void startBatchPolling()
+{
+    stack.commandManager.setMultiReadSupported(true);
+    TEST_ASSERT_TRUE(stack.commandManager.addPolling(WBusCommandBuilder::createReadSensor(OPERATIONAL_PAGE)));
+    TEST_ASSERT_TRUE(stack.commandManager.addPolling(WBusCommandBuilder::createReadSensor(STATE_PAGE)));
+}
+
+static void waitMultiRead()
+{
+    size_t before = stack.bus.sent.size();
+    TEST_ASSERT_TRUE(stack.runUntil([before]()
+                                    { return stack.bus.sent.size() > before && isMultiReadSent(); }));
+    stack.runFor(50);
+}
+
+void setUp(void)
+{
+    stack.reset();
+}
+
+void tearDown(void) {}
+
+void test_split_rebuilds_each_page(void)
+{
+    WBusFrame tx = statusAndOperationalRequest();
+    std::vector<uint8_t> rx = withChecksum(statusAndOperationalReply());
+
+    std::vector<std::vector<uint8_t>> pages;
+    bool ok = WBusMultiReadDecoder::split(tx.view(), PacketView(rx.data(), rx.size()),
+                                          [&pages](const PacketView &pageTx, const PacketView &pageRx)
+                                          {
+                                              TEST_ASSERT_TRUE(pageTx.isValid());
+                                              TEST_ASSERT_TRUE(pageRx.isValid());
+                                              TEST_ASSERT_EQUAL_HEX8(pageTx.getIndex(), pageRx.getIndex());
+                                              pages.emplace_back(pageRx.data(), pageRx.data() + pageRx.size());
+                                          });
+
+    TEST_ASSERT_TRUE(ok);
+    TEST_ASSERT_EQUAL(2, pages.size());
+
+    // 4F 08 D0 02 [5 байт] cs и 4F 0B D0 05 [8 байт] cs
+    TEST_ASSERT_EQUAL(sizeof(STATUS_DATA) + 5, pages[0].size());
+    TEST_ASSERT_EQUAL_HEX8(0xD0, pages[0][2]);
+    TEST_ASSERT_EQUAL_HEX8(STATUS_PAGE, pages[0][3]);
+    TEST_ASSERT_EQUAL_MEMORY(STATUS_DATA, &pages[0][4], sizeof(STATUS_DATA));
+
+    TEST_ASSERT_EQUAL(sizeof(OPERATIONAL_DATA) + 5, pages[1].size());
+    TEST_ASSERT_EQUAL_HEX8(OPERATIONAL_PAGE, pages[1][3]);
+    TEST_ASSERT_EQUAL_MEMORY(OPERATIONAL_DATA, &pages[1][4], sizeof(OPERATIONAL_DATA));
+}
+
+void test_truncated_reply_is_rejected(void)
+{
+    WBusFrame tx = statusAndOperationalRequest();
+    std::vector<uint8_t> rx = statusAndOperationalReply();
+    rx.pop_back(); // Последняя страница на байт короче
+    rx = withChecksum(rx);
+
+    int calls = 0;
+    bool ok = WBusMultiReadDecoder::split(tx.view(), PacketView(rx.data(), rx.size()),
+                                          [&calls](const PacketView &, const PacketView &)
+                                          { calls++; });
+
+    TEST_ASSERT_FALSE(ok);
+    TEST_ASSERT_EQUAL(0, calls);
+
+    // Ответ без второй страницы целиком
+    std::vector<uint8_t> firstOnly(rx.begin(), rx.begin() + 5 + sizeof(STATUS_DATA));
+    firstOnly = withChecksum(firstOnly);
+    TEST_ASSERT_FALSE(WBusMultiReadDecoder::isValidResponse(tx.view(), PacketView(firstOnly.data(), firstOnly.size())));
+}
+
+void test_pages_out_of_order_are_rejected(void)
+{
+    const uint8_t indexes[] = {OPERATIONAL_PAGE, STATUS_PAGE};
+    WBusFrame tx = WBusCommandBuilder::createMultiReadSensor(indexes, 2);
+    std::vector<uint8_t> rx = withChecksum(statusAndOperationalReply());
+
+    TEST_ASSERT_FALSE(WBusMultiReadDecoder::isValidResponse(tx.view(), PacketView(rx.data(), rx.size())));
+}
+
+void test_unknown_page_length_is_not_batched(void)
+{
+    // Длина страницы 0x10 в групповом ответе неизвестна
+    uint8_t unknown = WBusCommandBuilder::SENSOR_OTHER_DURATION;
+    TEST_ASSERT_EQUAL(0, WBusCommandBuilder::getSensorPageLength(unknown));
+    TEST_ASSERT_EQUAL(0, WBusMultiReadDecoder::pageCost(unknown));
+
+    PollScheduler scheduler;
+    BusConfig config;
+    scheduler.add(WBusCommandBuilder::createReadSensor(unknown), PollGroup::SLOW, T0);
+    scheduler.add(WBusCommandBuilder::createReadSensor(STATUS_PAGE), PollGroup::STATUS, T0 + 1);
+    scheduler.add(WBusCommandBuilder::createReadSensor(OPERATIONAL_PAGE), PollGroup::FAST, T0 + 1);
+
+    // Первой выбрана неизвестная страница - она идет отдельным запросом
+    int first = scheduler.next(T0 + 1, config);
+    TEST_ASSERT_EQUAL_INT(0, first);
+    TEST_ASSERT_EQUAL_HEX16(0, scheduler.collectSensorBatch(first, T0 + 1, WBusMultiReadDecoder::MAX_RESPONSE_PAYLOAD));
+
+    // Остальные собираются в группу без нее
+    first = scheduler.next(T0 + 1, config);
+    TEST_ASSERT_EQUAL_HEX16(0x0006, scheduler.collectSensorBatch(first, T0 + 1, WBusMultiReadDecoder::MAX_RESPONSE_PAYLOAD));
+
+    // Запрос с такой страницей не разбирается
+    const uint8_t indexes[] = {STATUS_PAGE, unknown};
+    WBusFrame tx = WBusCommandBuilder::createMultiReadSensor(indexes, 2);
+    std::vector<uint8_t> rx = {0x4F, 0x00, 0xD0, MULTI_READ, STATUS_PAGE};
+    rx.insert(rx.end(), STATUS_DATA, STATUS_DATA + sizeof(STATUS_DATA));
+    rx.push_back(unknown);
+    rx.push_back(0x00);
+    rx = withChecksum(rx);
+    TEST_ASSERT_FALSE(WBusMultiReadDecoder::isValidResponse(tx.view(), PacketView(rx.data(), rx.size())));
+}
+
+void test_batch_is_sent_and_answered(void)
+{
+    startBatchPolling();
+    waitMultiRead();
+
+    WBusFrame request = pollBatchRequest();
+    TEST_ASSERT_TRUE(stack.bus.last() == std::vector<uint8_t>(request.data(), request.data() + request.size()));
+
+    stack.bus.reply(pollBatchReply());
+    stack.step();
+
+    TEST_ASSERT_TRUE(stack.commandManager.isPollSnapshotComplete());
+    TEST_ASSERT_TRUE(stack.commandManager.isMultiReadSupported());
+}
+
+void test_repeated_naks_fall_back_to_single_pages(void)
+{
+    startBatchPolling();
+
+    // NAK кроме 0x33 - отказ группового чтения, но шина отвечает
+    for (int i = 0; i < 3; i++)
+    {
+        TEST_ASSERT_TRUE(stack.commandManager.isMultiReadSupported());
+        waitMultiRead();
+        stack.bus.reply({0x4F, 0x04, 0x7F, READ_SENSOR, 0x22});
+        stack.step();
+    }
+
+    TEST_ASSERT_FALSE(stack.commandManager.isMultiReadSupported());
+    TEST_ASSERT_EQUAL((int)BusHealth::HEALTHY, (int)stack.commandManager.getBusHealth());
+
+    // Дальше страницы опрашиваются по одной
+    size_t before = stack.bus.sent.size();
+    TEST_ASSERT_TRUE(stack.runUntilSent(before + 1, 5000));
+    TEST_ASSERT_TRUE(stack.bus.last()[3] != MULTI_READ);
+}
+
+void test_answered_batch_resets_failure_count(void)
+{
+    startBatchPolling();
+
+    for (int round = 0; round < 2; round++)
+    {
+        for (int i = 0; i < 2; i++)
+        {
+            waitMultiRead();
+            stack.bus.reply({0x4F, 0x04, 0x7F, READ_SENSOR, 0x22});
+            stack.step();
+        }
+
+        waitMultiRead();
+        stack.bus.reply(pollBatchReply());
+        stack.step();
+    }
+
+    TEST_ASSERT_TRUE(stack.commandManager.isMultiReadSupported());
+}
+
+void test_unsupported_nak_falls_back_at_once(void)
+{
+    startBatchPolling();
+    waitMultiRead();
+
+    stack.bus.reply({0x4F, 0x04, 0x7F, READ_SENSOR, NAK_CODE_UNSUPPORTED});
+    stack.step();
+
+    TEST_ASSERT_FALSE(stack.commandManager.isMultiReadSupported());
+}
+
+void test_timeouts_count_only_while_bus_answers(void)
+{
+    startBatchPolling();
+
+    for (int i = 0; i < 3; i++)
+    {
+        TEST_ASSERT_TRUE(stack.commandManager.isMultiReadSupported());
+        waitMultiRead();
+
+        // Групповое чтение остается без ответа
+        TEST_ASSERT_TRUE(stack.runUntil([]()
+                                        { return stack.commandManager.getBusHealth() != BusHealth::HEALTHY; }));
+
+        // Обычная команда получает ответ - шина исправна, не отвечает именно групповое чтение
+        WBusFrame info = WBusCommandBuilder::createReadInfo(WBusCommandBuilder::INFO_DEVICE_ID);
+        stack.commandManager.addCommand(info, CommandClass::CONTROL);
+        TEST_ASSERT_TRUE(stack.runUntil([]()
+                                        { return !stack.bus.sent.empty() && stack.bus.last()[2] == WBusCommandBuilder::CMD_READ_INFO; }));
+        stack.runFor(50);
+        stack.bus.reply({0x4F, 0x04, 0xD1, WBusCommandBuilder::INFO_DEVICE_ID, 0x01});
+        stack.step();
+        TEST_ASSERT_EQUAL((int)BusHealth::HEALTHY, (int)stack.commandManager.getBusHealth());
+    }
+
+    TEST_ASSERT_FALSE(stack.commandManager.isMultiReadSupported());
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_split_rebuilds_each_page);
+    RUN_TEST(test_truncated_reply_is_rejected);
+    RUN_TEST(test_pages_out_of_order_are_rejected);
+    RUN_TEST(test_unknown_page_length_is_not_batched);
+    RUN_TEST(test_batch_is_sent_and_answered);
+    RUN_TEST(test_repeated_naks_fall_back_to_single_pages);
+    RUN_TEST(test_answered_batch_resets_failure_count);
+    RUN_TEST(test_unsupported_nak_falls_back_at_once);
+    RUN_TEST(test_timeouts_count_only_while_bus_answers);
+    return UNITY_END();
+}
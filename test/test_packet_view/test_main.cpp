@@ -0,0 +1,136 @@
+// test/test_packet_view/test_main.cpp
+// Проверка кадра и доступ к полям без копирования (pio test -e native)
+#include <Arduino.h>
+#include <unity.h>
+#include "common/PacketView.h"
+#include "common/WBusFrame.h"
+
+HardwareSerial Serial(0);
+
+// 4F 06 D0 05 <данные> - ответ на чтение страницы 0x05
+static const uint8_t SENSOR_RESPONSE[] = {0x4F, 0x06, 0xD0, 0x05, 0x12, 0x34, 0x56, 0x00};
+static const uint8_t NAK_RESPONSE[] = {0x4F, 0x04, 0x7F, 0x50, 0x33, 0x00};
+static uint8_t response[sizeof(SENSOR_RESPONSE)];
+static uint8_t nak[sizeof(NAK_RESPONSE)];
+
+static void sealChecksum(uint8_t *frame, size_t length)
+{
+    frame[length - 1] = Utils::calculateChecksum(frame, length - 1);
+}
+
+void setUp(void)
+{
+    memcpy(response, SENSOR_RESPONSE, sizeof(response));
+    sealChecksum(response, sizeof(response));
+    memcpy(nak, NAK_RESPONSE, sizeof(nak));
+    sealChecksum(nak, sizeof(nak));
+}
+
+void tearDown(void) {}
+
+void test_valid_response_fields(void)
+{
+    PacketView view(response, sizeof(response));
+
+    TEST_ASSERT_TRUE(view.isValid());
+    TEST_ASSERT_TRUE(view.isResponse());
+    TEST_ASSERT_TRUE(view.isAck());
+    TEST_ASSERT_FALSE(view.isNak());
+    TEST_ASSERT_EQUAL_HEX8(0x4F, view.getHeader());
+    TEST_ASSERT_EQUAL_HEX8(0x06, view.getLength());
+    TEST_ASSERT_EQUAL_HEX8(0xD0, view.getCommand());
+    TEST_ASSERT_EQUAL_HEX8(0x50, view.getCommandWithoutAck());
+    TEST_ASSERT_EQUAL_HEX8(0x05, view.getIndex());
+    TEST_ASSERT_TRUE(view.data() == response); // Без копирования
+}
+
+void test_matches_command_index_and_length(void)
+{
+    PacketView view(response, sizeof(response));
+
+    TEST_ASSERT_TRUE(view.matches(0x50));
+    TEST_ASSERT_TRUE(view.matches(0x50, PacketView::WithIndex(0x05)));
+    TEST_ASSERT_TRUE(view.matches(0x50, PacketView::WithIndex(0x05), PacketView::WithMinLength(8)));
+    TEST_ASSERT_FALSE(view.matches(0x51));
+    TEST_ASSERT_FALSE(view.matches(0x50, PacketView::WithIndex(0x07)));
+    TEST_ASSERT_FALSE(view.matches(0x50, PacketView::WithMinLength(9)));
+}
+
+void test_bad_checksum_is_invalid(void)
+{
+    response[4] ^= 0xFF;
+    PacketView view(response, sizeof(response));
+
+    TEST_ASSERT_FALSE(view.isValid());
+    TEST_ASSERT_FALSE(view.matches(0x50));
+}
+
+void test_length_byte_must_match_size(void)
+{
+    PacketView view(response, sizeof(response) - 1);
+
+    TEST_ASSERT_FALSE(view.isValid());
+}
+
+void test_nak_response(void)
+{
+    PacketView view(nak, sizeof(nak));
+
+    TEST_ASSERT_TRUE(view.isValid());
+    TEST_ASSERT_TRUE(view.isNak());
+    TEST_ASSERT_FALSE(view.isAck());
+    TEST_ASSERT_EQUAL_HEX8(0x50, view.at(3));
+    TEST_ASSERT_EQUAL_HEX8(0x33, view.at(4));
+}
+
+void test_at_is_bounds_checked(void)
+{
+    PacketView view(response, sizeof(response));
+
+    TEST_ASSERT_EQUAL_HEX8(0x00, view.at(sizeof(response)));
+    TEST_ASSERT_EQUAL_HEX8(0x00, view.at(1000));
+}
+
+void test_empty_view(void)
+{
+    PacketView view;
+
+    TEST_ASSERT_TRUE(view.isEmpty());
+    TEST_ASSERT_FALSE(view.isValid());
+    TEST_ASSERT_EQUAL_HEX8(0x00, view.getCommand());
+    TEST_ASSERT_EQUAL_HEX8(0x00, view.getChecksum());
+    TEST_ASSERT_TRUE(view.toHexString().isEmpty());
+}
+
+void test_hex_string_on_demand(void)
+{
+    PacketView view(nak, sizeof(nak));
+
+    TEST_ASSERT_EQUAL_STRING("4f 04 7f 50 33 57", view.toHexString().c_str());
+}
+
+void test_outgoing_frame_view(void)
+{
+    WBusFrame frame = WBusFrame::fromHexString("f4 03 50 05 a2");
+    PacketView view(frame.data(), frame.size());
+
+    TEST_ASSERT_TRUE(view.isValid());
+    TEST_ASSERT_FALSE(view.isResponse());
+    TEST_ASSERT_EQUAL_HEX8(0x50, view.getCommand());
+    TEST_ASSERT_EQUAL_HEX8(0x05, view.getIndex());
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_valid_response_fields);
+    RUN_TEST(test_matches_command_index_and_length);
+    RUN_TEST(test_bad_checksum_is_invalid);
+    RUN_TEST(test_length_byte_must_match_size);
+    RUN_TEST(test_nak_response);
+    RUN_TEST(test_at_is_bounds_checked);
+    RUN_TEST(test_empty_view);
+    RUN_TEST(test_hex_string_on_demand);
+    RUN_TEST(test_outgoing_frame_view);
+    return UNITY_END();
+}
@@ -0,0 +1,249 @@
+// test/test_poll_scheduler/test_main.cpp
+// EDF выбор страниц, бюджет шины и групповое чтение (pio test -e native)
+#include <Arduino.h>
+#include <unity.h>
+#include "application/PollScheduler.h"
+
+HardwareSerial Serial(0);
+
+// Время не с нуля: бюджет копится от первого обращения к планировщику
+static const unsigned long T0 = 100000;
+
+static PollScheduler scheduler;
+static BusConfig config;
+
+static WBusFrame sensor(uint8_t index)
+{
+    return WBusCommandBuilder::createReadSensor(index);
+}
+
+void setUp(void)
+{
+    scheduler = PollScheduler();
+    config = BusConfig();
+}
+
+void tearDown(void) {}
+
+void test_earliest_deadline_first(void)
+{
+    // Слот 0 стал должен позже слота 1 - первым выдается слот 1
+    scheduler.add(sensor(WBusCommandBuilder::SENSOR_STATUS_FLAGS), PollGroup::STATUS, T0 + 500);
+    scheduler.add(sensor(WBusCommandBuilder::SENSOR_OPERATIONAL), PollGroup::FAST, T0);
+
+    TEST_ASSERT_EQUAL_INT(1, scheduler.next(T0 + 600, config));
+    TEST_ASSERT_EQUAL_INT(0, scheduler.next(T0 + 600, config));
+    TEST_ASSERT_EQUAL_INT(-1, scheduler.next(T0 + 600, config)); // Оба в полете
+}
+
+void test_not_due_is_not_returned(void)
+{
+    scheduler.add(sensor(WBusCommandBuilder::SENSOR_STATUS_FLAGS), PollGroup::STATUS, T0);
+    int slot = scheduler.next(T0, config);
+    scheduler.complete(slot, T0, T0 + 100, config);
+
+    TEST_ASSERT_EQUAL_INT(-1, scheduler.next(T0 + 999, config));
+    TEST_ASSERT_EQUAL_INT(slot, scheduler.next(T0 + 1000, config));
+}
+
+void test_period_counts_from_deadline(void)
+{
+    scheduler.add(sensor(WBusCommandBuilder::SENSOR_STATUS_FLAGS), PollGroup::STATUS, T0);
+    int slot = scheduler.next(T0 + 300, config);
+    scheduler.complete(slot, T0 + 300, T0 + 400, config);
+
+    // Дедлайн T0 + период, а не момент завершения + период
+    unsigned long at = 0;
+    TEST_ASSERT_TRUE(scheduler.nextDueAt(T0 + 400, config, at));
+    TEST_ASSERT_EQUAL_UINT32(T0 + config.pollStatusPeriod, at);
+}
+
+void test_period_restarts_after_long_stall(void)
+{
+    scheduler.add(sensor(WBusCommandBuilder::SENSOR_STATUS_FLAGS), PollGroup::STATUS, T0);
+    int slot = scheduler.next(T0, config);
+    scheduler.complete(slot, T0 + 4000, T0 + 5000, config);
+
+    unsigned long at = 0;
+    TEST_ASSERT_TRUE(scheduler.nextDueAt(T0 + 5000, config, at));
+    TEST_ASSERT_EQUAL_UINT32(T0 + 5000 + config.pollStatusPeriod, at);
+}
+
+void test_zero_budget_disables_polling(void)
+{
+    config.pollBusBudget = 0;
+    scheduler.add(sensor(WBusCommandBuilder::SENSOR_STATUS_FLAGS), PollGroup::STATUS, T0);
+
+    unsigned long at = 0;
+    TEST_ASSERT_EQUAL_INT(-1, scheduler.next(T0 + 5000, config));
+    TEST_ASSERT_FALSE(scheduler.nextDueAt(T0 + 5000, config, at));
+}
+
+void test_budget_deficit_defers_next_poll(void)
+{
+    scheduler.add(sensor(WBusCommandBuilder::SENSOR_STATUS_FLAGS), PollGroup::STATUS, T0);
+    scheduler.add(sensor(WBusCommandBuilder::SENSOR_OPERATIONAL), PollGroup::FAST, T0);
+
+    // Накоплен полный запас (MAX_BURST_MS), транзакция на 2 с исчерпывает бюджет
+    int first = scheduler.next(T0, config);
+    scheduler.complete(first, T0 - 2000, T0, config);
+
+    TEST_ASSERT_EQUAL_INT(-1, scheduler.next(T0 + 1, config));
+    TEST_ASSERT_TRUE(scheduler.toJson(config, T0 + 1).indexOf("\"budgetSkips\":1") >= 0);
+
+    // nextDueAt указывает момент восстановления бюджета, тогда страница выдается
+    unsigned long at = 0;
+    TEST_ASSERT_TRUE(scheduler.nextDueAt(T0 + 1, config, at));
+    TEST_ASSERT_GREATER_THAN(T0 + 1, at);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, scheduler.next(at, config));
+}
+
+void test_deficit_larger_than_burst_is_repaid(void)
+{
+    scheduler.add(sensor(WBusCommandBuilder::SENSOR_STATUS_FLAGS), PollGroup::STATUS, T0);
+
+    // Долг больше запаса: таймауты с повтором заняли шину на 6 с
+    int slot = scheduler.next(T0, config);
+    scheduler.complete(slot, T0, T0 + 6000, config);
+
+    // Опрос не вызывается, пока не наступит момент из nextDueAt
+    unsigned long at = 0;
+    TEST_ASSERT_TRUE(scheduler.nextDueAt(T0 + 6000, config, at));
+    TEST_ASSERT_GREATER_THAN(T0 + 6000, at);
+    TEST_ASSERT_EQUAL_INT(slot, scheduler.next(at, config));
+}
+
+void test_sensor_batch_collects_due_pages(void)
+{
+    scheduler.add(sensor(WBusCommandBuilder::SENSOR_OPERATIONAL), PollGroup::FAST, T0);
+    scheduler.add(sensor(WBusCommandBuilder::SENSOR_OPERATING_STATE), PollGroup::FAST, T0);
+    scheduler.add(sensor(WBusCommandBuilder::SENSOR_SUBSYSTEMS_STATUS), PollGroup::FAST, T0 + 5000); // Не должна
+    scheduler.add(WBusCommandBuilder::createReadErrors(), PollGroup::SLOW, T0);                      // Не 0x50
+
+    int first = scheduler.next(T0, config);
+    uint16_t mask = scheduler.collectSensorBatch(first, T0, WBusMultiReadDecoder::MAX_RESPONSE_PAYLOAD);
+
+    TEST_ASSERT_EQUAL_HEX16(0x0003, mask);
+
+    scheduler.completeBatch(mask, T0, T0 + 300, config);
+    unsigned long at = 0;
+    TEST_ASSERT_TRUE(scheduler.nextDueAt(T0 + 300, config, at));
+    TEST_ASSERT_EQUAL_UINT32(T0, at); // Ошибки (слот 3) все еще ждут
+}
+
+void test_sensor_batch_respects_payload_budget(void)
+{
+    scheduler.add(sensor(WBusCommandBuilder::SENSOR_OPERATIONAL), PollGroup::FAST, T0);
+    scheduler.add(sensor(WBusCommandBuilder::SENSOR_OPERATING_STATE), PollGroup::FAST, T0);
+
+    int first = scheduler.next(T0, config);
+    size_t onlyFirst = WBusMultiReadDecoder::pageCost(WBusCommandBuilder::SENSOR_OPERATIONAL);
+
+    TEST_ASSERT_EQUAL_HEX16(1u << first, scheduler.collectSensorBatch(first, T0, onlyFirst));
+}
+
+void test_page_with_callback_is_not_batched(void)
+{
+    scheduler.add(sensor(WBusCommandBuilder::SENSOR_OPERATIONAL), PollGroup::FAST, T0,
+                  [](const PacketView &tx, const PacketView &rx) {});
+
+    int first = scheduler.next(T0, config);
+    TEST_ASSERT_EQUAL_HEX16(0, scheduler.collectSensorBatch(first, T0, WBusMultiReadDecoder::MAX_RESPONSE_PAYLOAD));
+}
+
+void test_release_keeps_deadline(void)
+{
+    scheduler.add(sensor(WBusCommandBuilder::SENSOR_STATUS_FLAGS), PollGroup::STATUS, T0);
+    int slot = scheduler.next(T0, config);
+    scheduler.release(slot);
+
+    TEST_ASSERT_EQUAL_INT(slot, scheduler.next(T0 + 1, config));
+}
+
+void test_add_existing_frame_updates_entry(void)
+{
+    TEST_ASSERT_TRUE(scheduler.add(sensor(WBusCommandBuilder::SENSOR_OPERATIONAL), PollGroup::FAST, T0));
+    TEST_ASSERT_TRUE(scheduler.add(sensor(WBusCommandBuilder::SENSOR_OPERATIONAL), PollGroup::SLOW, T0));
+
+    String json = scheduler.toJson(config, T0);
+    TEST_ASSERT_TRUE(json.indexOf("\"group\":\"slow\"") >= 0);
+    TEST_ASSERT_TRUE(json.indexOf("\"group\":\"fast\"") < 0);
+}
+
+void test_remove_and_snapshot(void)
+{
+    scheduler.add(sensor(WBusCommandBuilder::SENSOR_STATUS_FLAGS), PollGroup::STATUS, T0);
+    scheduler.add(sensor(WBusCommandBuilder::SENSOR_OPERATIONAL), PollGroup::FAST, T0);
+    TEST_ASSERT_FALSE(scheduler.isSnapshotComplete());
+
+    scheduler.recordAnswer(1u << 0);
+    TEST_ASSERT_FALSE(scheduler.isSnapshotComplete());
+
+    scheduler.remove(1);
+    TEST_ASSERT_TRUE(scheduler.isSnapshotComplete());
+    TEST_ASSERT_TRUE(scheduler.hasEntries());
+
+    scheduler.remove(0);
+    TEST_ASSERT_FALSE(scheduler.hasEntries());
+}
+
+void test_nak_backs_off_period(void)
+{
+    scheduler.add(sensor(WBusCommandBuilder::SENSOR_OPERATIONAL), PollGroup::FAST, T0);
+    unsigned long at = 0;
+
+    // Первый NAK - следующий опрос через 2 периода, второй - через 4
+    int slot = scheduler.next(T0, config);
+    scheduler.complete(slot, T0, T0 + 100, config);
+    TEST_ASSERT_FALSE(scheduler.recordNak(slot, T0 + 100, config));
+    TEST_ASSERT_TRUE(scheduler.nextDueAt(T0 + 100, config, at));
+    TEST_ASSERT_EQUAL_UINT32(T0 + 100 + 2 * config.pollFastPeriod, at);
+
+    unsigned long now = at;
+    slot = scheduler.next(now, config);
+    scheduler.complete(slot, now, now + 100, config);
+    TEST_ASSERT_FALSE(scheduler.recordNak(slot, now + 100, config));
+    TEST_ASSERT_TRUE(scheduler.nextDueAt(now + 100, config, at));
+    TEST_ASSERT_EQUAL_UINT32(now + 100 + 4 * config.pollFastPeriod, at);
+
+    // Ответ сбрасывает счетчик - снова обычный период от дедлайна
+    now = at;
+    slot = scheduler.next(now, config);
+    scheduler.complete(slot, now, now + 100, config);
+    scheduler.recordAnswer(1u << slot);
+    TEST_ASSERT_TRUE(scheduler.nextDueAt(now + 100, config, at));
+    TEST_ASSERT_EQUAL_UINT32(now + config.pollFastPeriod, at);
+}
+
+void test_consecutive_naks_remove_page(void)
+{
+    scheduler.add(sensor(WBusCommandBuilder::SENSOR_OPERATIONAL), PollGroup::FAST, T0);
+
+    for (uint8_t i = 1; i < PollScheduler::MAX_CONSECUTIVE_NAKS; i++)
+        TEST_ASSERT_FALSE(scheduler.recordNak(0, T0, config));
+
+    TEST_ASSERT_TRUE(scheduler.hasEntries());
+    TEST_ASSERT_TRUE(scheduler.recordNak(0, T0, config));
+    TEST_ASSERT_FALSE(scheduler.hasEntries());
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_earliest_deadline_first);
+    RUN_TEST(test_not_due_is_not_returned);
+    RUN_TEST(test_period_counts_from_deadline);
+    RUN_TEST(test_period_restarts_after_long_stall);
+    RUN_TEST(test_zero_budget_disables_polling);
+    RUN_TEST(test_budget_deficit_defers_next_poll);
+    RUN_TEST(test_deficit_larger_than_burst_is_repaid);
+    RUN_TEST(test_sensor_batch_collects_due_pages);
+    RUN_TEST(test_sensor_batch_respects_payload_budget);
+    RUN_TEST(test_page_with_callback_is_not_batched);
+    RUN_TEST(test_release_keeps_deadline);
+    RUN_TEST(test_add_existing_frame_updates_entry);
+    RUN_TEST(test_remove_and_snapshot);
+    RUN_TEST(test_nak_backs_off_period);
+    RUN_TEST(test_consecutive_naks_remove_page);
+    return UNITY_END();
+}
@@ -0,0 +1,194 @@
+// test/test_request_coalescer/test_main.cpp
+// Объединение одинаковых запросов и раздача ответа ожидающим (pio test -e native)
+#include <Arduino.h>
+#include <unity.h>
+#include <vector>
+#include "application/RequestCoalescer.h"
+
+HardwareSerial Serial(0);
+
+static const unsigned long T0 = 100000;
+
+static const uint8_t OPERATIONAL_PAGE = WBusCommandBuilder::SENSOR_OPERATIONAL;
+static const uint8_t STATE_PAGE = WBusCommandBuilder::SENSOR_OPERATING_STATE;
+
+static std::vector<uint8_t> withChecksum(std::vector<uint8_t> frame)
+{
+    frame[1] = static_cast<uint8_t>(frame.size() - 1);
+    frame.push_back(Utils::calculateChecksum(frame.data(), frame.size()));
+    return frame;
+}
+
+static WBusFrame sensor(uint8_t index)
+{
+    return WBusCommandBuilder::createReadSensor(index);
+}
+
+static WBusFrame batchRequest()
+{
+    const uint8_t indexes[] = {OPERATIONAL_PAGE, STATE_PAGE};
+    return WBusCommandBuilder::createMultiReadSensor(indexes, 2);
+}
+
+// 4F len D0 30 05 [8 байт] 07 [6 байт] cs
+static std::vector<uint8_t> batchReply()
+{
+    return withChecksum({0x4F, 0x00, 0xD0, WBusCommandBuilder::SENSOR_MULTI_READ,
+                         OPERATIONAL_PAGE, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+                         STATE_PAGE, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25});
+}
+
+static bool jsonHas(const String &json, const char *fragment)
+{
+    return json.indexOf(fragment) >= 0;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_exact_waiter_gets_same_response(void)
+{
+    CompletionTable completions;
+    RequestCoalescer coalescer(completions);
+    WBusFrame tx = sensor(OPERATIONAL_PAGE);
+    CommandHandle handle = completions.open(T0);
+    int calls = 0;
+    CommandCallback callback = [&calls](const PacketView &, const PacketView &rx)
+    {
+        TEST_ASSERT_EQUAL_HEX8(0x42, rx[4]);
+        calls++;
+    };
+
+    TEST_ASSERT_TRUE(coalescer.attach(tx, callback, handle));
+    TEST_ASSERT_FALSE((bool)callback); // Обработчик забран
+
+    std::vector<uint8_t> rx = withChecksum({0x4F, 0x00, 0xD0, OPERATIONAL_PAGE, 0x42});
+    coalescer.resolve(tx.view(), PacketView(rx.data(), rx.size()), T0 + 100);
+
+    TEST_ASSERT_EQUAL(1, calls);
+    TEST_ASSERT_EQUAL((int)CommandOutcome::ACK, (int)completions.get(handle).outcome);
+    TEST_ASSERT_EQUAL(0, coalescer.size());
+}
+
+void test_attach_overflow_returns_callback_to_caller(void)
+{
+    CompletionTable completions;
+    RequestCoalescer coalescer(completions);
+    WBusFrame tx = sensor(OPERATIONAL_PAGE);
+    for (size_t i = 0; i < RequestCoalescer::CAPACITY; i++)
+    {
+        CommandCallback callback = [](const PacketView &, const PacketView &) {};
+        TEST_ASSERT_TRUE(coalescer.attach(tx, callback, CommandHandle()));
+    }
+
+    int calls = 0;
+    CommandCallback callback = [&calls](const PacketView &, const PacketView &)
+    { calls++; };
+    TEST_ASSERT_FALSE(coalescer.attach(tx, callback, CommandHandle()));
+
+    // Обработчик остался у вызывающего - он отправит запрос сам
+    TEST_ASSERT_TRUE((bool)callback);
+    callback(tx.view(), tx.view());
+    TEST_ASSERT_EQUAL(1, calls);
+    TEST_ASSERT_TRUE(jsonHas(coalescer.toJson(), "\"overflows\":1"));
+}
+
+void test_page_waiter_is_resolved_from_batch(void)
+{
+    CompletionTable completions;
+    RequestCoalescer coalescer(completions);
+    WBusFrame page = sensor(STATE_PAGE);
+    WBusFrame batch = batchRequest();
+    TEST_ASSERT_TRUE(RequestCoalescer::covers(batch, page));
+    TEST_ASSERT_FALSE(RequestCoalescer::covers(batch, sensor(WBusCommandBuilder::SENSOR_STATUS_FLAGS)));
+
+    CommandHandle handle = completions.open(T0);
+    std::vector<uint8_t> pageRx;
+    CommandCallback callback = [&pageRx](const PacketView &tx, const PacketView &rx)
+    {
+        TEST_ASSERT_EQUAL_HEX8(STATE_PAGE, tx.getIndex());
+        pageRx.assign(rx.data(), rx.data() + rx.size());
+    };
+    TEST_ASSERT_TRUE(coalescer.attach(page, callback, handle));
+
+    std::vector<uint8_t> rx = batchReply();
+    coalescer.resolve(batch.view(), PacketView(rx.data(), rx.size()), T0 + 100);
+
+    // Страница пересобрана в обычный ответ 4F 09 D0 07 [6 байт] cs
+    std::vector<uint8_t> expected = withChecksum({0x4F, 0x00, 0xD0, STATE_PAGE, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25});
+    TEST_ASSERT_TRUE(pageRx == expected);
+
+    CommandResult result = completions.get(handle);
+    TEST_ASSERT_EQUAL((int)CommandOutcome::ACK, (int)result.outcome);
+    TEST_ASSERT_EQUAL(expected.size(), result.responseLength);
+    TEST_ASSERT_EQUAL(0, coalescer.size());
+}
+
+void test_batch_nak_leaves_page_waiters(void)
+{
+    CompletionTable completions;
+    RequestCoalescer coalescer(completions);
+    WBusFrame page = sensor(STATE_PAGE);
+    WBusFrame batch = batchRequest();
+    CommandCallback callback = nullptr;
+    TEST_ASSERT_TRUE(coalescer.attach(page, callback, completions.open(T0)));
+
+    std::vector<uint8_t> nak = withChecksum({0x4F, 0x00, 0x7F, WBusCommandBuilder::CMD_READ_SENSOR, 0x22});
+    coalescer.resolve(batch.view(), PacketView(nak.data(), nak.size()), T0 + 100);
+
+    TEST_ASSERT_EQUAL(1, coalescer.size());
+}
+
+void test_drop_fails_covered_waiters_with_timeout(void)
+{
+    CompletionTable completions;
+    RequestCoalescer coalescer(completions);
+    WBusFrame batch = batchRequest();
+    CommandHandle pageHandle = completions.open(T0);
+    CommandHandle otherHandle = completions.open(T0);
+    int calls = 0;
+    CommandCallback pageCallback = [&calls](const PacketView &, const PacketView &)
+    { calls++; };
+    CommandCallback otherCallback = nullptr;
+
+    TEST_ASSERT_TRUE(coalescer.attach(sensor(OPERATIONAL_PAGE), pageCallback, pageHandle));
+    TEST_ASSERT_TRUE(coalescer.attach(sensor(WBusCommandBuilder::SENSOR_STATUS_FLAGS), otherCallback, otherHandle));
+
+    coalescer.drop(batch, T0 + 500);
+
+    // Ожидавший страницу группового чтения получает таймаут, обработчик не вызывается
+    TEST_ASSERT_EQUAL((int)CommandOutcome::TIMEOUT, (int)completions.get(pageHandle).outcome);
+    TEST_ASSERT_EQUAL(0, calls);
+
+    // Запрос, не входивший в групповое чтение, продолжает ждать
+    TEST_ASSERT_EQUAL((int)CommandOutcome::PENDING, (int)completions.get(otherHandle).outcome);
+    TEST_ASSERT_EQUAL(1, coalescer.size());
+    TEST_ASSERT_TRUE(jsonHas(coalescer.toJson(), "\"dropped\":1"));
+}
+
+void test_clear_cancels_waiters(void)
+{
+    CompletionTable completions;
+    RequestCoalescer coalescer(completions);
+    CommandHandle handle = completions.open(T0);
+    CommandCallback callback = nullptr;
+    TEST_ASSERT_TRUE(coalescer.attach(sensor(OPERATIONAL_PAGE), callback, handle));
+
+    coalescer.clear(T0 + 10);
+
+    TEST_ASSERT_EQUAL((int)CommandOutcome::CANCELLED, (int)completions.get(handle).outcome);
+    TEST_ASSERT_EQUAL(0, coalescer.size());
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_exact_waiter_gets_same_response);
+    RUN_TEST(test_attach_overflow_returns_callback_to_caller);
+    RUN_TEST(test_page_waiter_is_resolved_from_batch);
+    RUN_TEST(test_batch_nak_leaves_page_waiters);
+    RUN_TEST(test_drop_fails_covered_waiters_with_timeout);
+    RUN_TEST(test_clear_cancels_waiters);
+    return UNITY_END();
+}
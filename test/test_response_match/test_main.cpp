@@ -0,0 +1,140 @@
+// test/test_response_match/test_main.cpp
+// Сопоставление ответа с текущим запросом CommandManager (pio test -e native)
+#include <Arduino.h>
+#include <unity.h>
+#include "../../host/ScriptedBus.h"
+
+HardwareSerial Serial(0);
+LittleFSFS LittleFS;
+
+static ScriptedStack stack;
+
+static CommandHandle send(const WBusFrame &frame)
+{
+    CommandHandle handle = stack.commandManager.addCommand(frame, CommandClass::INTERACTIVE);
+    TEST_ASSERT_TRUE(handle.isTracked());
+    TEST_ASSERT_TRUE(stack.runUntilSent(stack.bus.sent.size() + 1));
+    return handle;
+}
+
+static void deliver(const std::vector<uint8_t> &frame)
+{
+    stack.bus.reply(frame);
+    stack.step();
+}
+
+static CommandOutcome outcomeOf(const CommandHandle &handle)
+{
+    return stack.commandManager.getResult(handle).outcome;
+}
+
+static bool waitDone(const CommandHandle &handle, unsigned long limitMs)
+{
+    unsigned long startedAt = stack.clock.nowMs();
+    while (!stack.commandManager.getResult(handle).isDone())
+    {
+        if (stack.clock.nowMs() - startedAt >= limitMs)
+            return false;
+        stack.step();
+    }
+    return true;
+}
+
+void setUp(void)
+{
+    stack.reset();
+}
+
+void tearDown(void) {}
+
+void test_ack_with_same_index_completes(void)
+{
+    CommandHandle handle = send(WBusCommandBuilder::createReadSensor(WBusCommandBuilder::SENSOR_STATUS_FLAGS));
+
+    deliver({0x4F, 0x04, 0xD0, 0x02, 0x11});
+
+    CommandResult result = stack.commandManager.getResult(handle);
+    TEST_ASSERT_EQUAL((int)CommandOutcome::ACK, (int)result.outcome);
+    TEST_ASSERT_EQUAL_HEX8(0x11, result.getResponse()[4]);
+    TEST_ASSERT_TRUE(stack.commandManager.isEmpty());
+}
+
+void test_stale_ack_for_other_command_is_ignored(void)
+{
+    CommandHandle handle = send(WBusCommandBuilder::createReadSensor(WBusCommandBuilder::SENSOR_STATUS_FLAGS));
+
+    // Запоздавший ACK keep-alive от прошлой транзакции
+    deliver({0x4F, 0x03, 0xC4, 0x00});
+    TEST_ASSERT_EQUAL((int)CommandOutcome::PENDING, (int)outcomeOf(handle));
+
+    deliver({0x4F, 0x04, 0xD0, 0x02, 0x22});
+    CommandResult result = stack.commandManager.getResult(handle);
+    TEST_ASSERT_EQUAL((int)CommandOutcome::ACK, (int)result.outcome);
+    TEST_ASSERT_EQUAL_HEX8(0x22, result.getResponse()[4]);
+}
+
+void test_ack_with_other_index_is_ignored(void)
+{
+    CommandHandle handle = send(WBusCommandBuilder::createReadSensor(WBusCommandBuilder::SENSOR_STATUS_FLAGS));
+
+    // Ответ на ту же команду чтения, но другую страницу
+    deliver({0x4F, 0x04, 0xD0, 0x07, 0x33});
+    TEST_ASSERT_EQUAL((int)CommandOutcome::PENDING, (int)outcomeOf(handle));
+
+    deliver({0x4F, 0x04, 0xD0, 0x02, 0x44});
+    TEST_ASSERT_EQUAL((int)CommandOutcome::ACK, (int)outcomeOf(handle));
+}
+
+void test_ack_without_index_echo_matches_by_command(void)
+{
+    // Keep-alive (0x44) - не команда чтения, индекс в ответе не сверяется
+    CommandHandle handle = send(WBusCommandBuilder::createKeepAliveParking());
+
+    deliver({0x4F, 0x03, 0xC4, 0x00});
+    TEST_ASSERT_EQUAL((int)CommandOutcome::ACK, (int)outcomeOf(handle));
+}
+
+void test_nak_for_other_command_is_ignored(void)
+{
+    CommandHandle handle = send(WBusCommandBuilder::createReadSensor(WBusCommandBuilder::SENSOR_STATUS_FLAGS));
+
+    // NAK сопоставляется по коду команды в rx[3]
+    deliver({0x4F, 0x04, 0x7F, 0x51, 0x33});
+    TEST_ASSERT_EQUAL((int)CommandOutcome::PENDING, (int)outcomeOf(handle));
+
+    deliver({0x4F, 0x04, 0x7F, 0x50, 0x22});
+    CommandResult result = stack.commandManager.getResult(handle);
+    TEST_ASSERT_EQUAL((int)CommandOutcome::NAK, (int)result.outcome);
+    TEST_ASSERT_EQUAL_HEX8(0x22, result.nakCode);
+}
+
+void test_late_reply_after_timeout_is_not_taken_by_next_command(void)
+{
+    CommandHandle first = send(WBusCommandBuilder::createReadSensor(WBusCommandBuilder::SENSOR_STATUS_FLAGS));
+    TEST_ASSERT_TRUE(waitDone(first, 60000));
+    TEST_ASSERT_EQUAL((int)CommandOutcome::TIMEOUT, (int)outcomeOf(first));
+
+    CommandHandle second = send(WBusCommandBuilder::createReadSensor(WBusCommandBuilder::SENSOR_OPERATIONAL));
+
+    // Ответ на первый запрос пришел, когда ждут ответа на второй
+    deliver({0x4F, 0x04, 0xD0, 0x02, 0x55});
+    TEST_ASSERT_EQUAL((int)CommandOutcome::PENDING, (int)outcomeOf(second));
+    TEST_ASSERT_EQUAL((int)CommandOutcome::TIMEOUT, (int)outcomeOf(first));
+
+    deliver({0x4F, 0x04, 0xD0, 0x05, 0x66});
+    CommandResult result = stack.commandManager.getResult(second);
+    TEST_ASSERT_EQUAL((int)CommandOutcome::ACK, (int)result.outcome);
+    TEST_ASSERT_EQUAL_HEX8(0x66, result.getResponse()[4]);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_ack_with_same_index_completes);
+    RUN_TEST(test_stale_ack_for_other_command_is_ignored);
+    RUN_TEST(test_ack_with_other_index_is_ignored);
+    RUN_TEST(test_ack_without_index_echo_matches_by_command);
+    RUN_TEST(test_nak_for_other_command_is_ignored);
+    RUN_TEST(test_late_reply_after_timeout_is_not_taken_by_next_command);
+    return UNITY_END();
+}
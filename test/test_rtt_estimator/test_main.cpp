@@ -0,0 +1,147 @@
+// test/test_rtt_estimator/test_main.cpp
+// Адаптивный таймаут и пауза по классам команд (pio test -e native)
+#include <Arduino.h>
+#include <unity.h>
+#include "application/RttEstimator.h"
+
+HardwareSerial Serial(0);
+
+static RttEstimator estimator;
+static BusConfig config;
+
+static const uint8_t SENSOR = WBusCommandBuilder::CMD_READ_SENSOR;
+static const uint8_t INFO = WBusCommandBuilder::CMD_READ_INFO;
+static const uint8_t ERRORS = WBusCommandBuilder::CMD_READ_ERRORS;
+static const uint8_t KEEP_ALIVE = 0x44;
+
+void setUp(void)
+{
+    estimator.reset();
+    config = BusConfig();
+}
+
+void tearDown(void) {}
+
+void test_command_classes(void)
+{
+    TEST_ASSERT_TRUE(RttEstimator::classFor(SENSOR) == RttClass::SENSOR);
+    TEST_ASSERT_TRUE(RttEstimator::classFor(SENSOR | 0x80) == RttClass::SENSOR); // ACK
+    TEST_ASSERT_TRUE(RttEstimator::classFor(INFO) == RttClass::INFO);
+    TEST_ASSERT_TRUE(RttEstimator::classFor(ERRORS) == RttClass::ERRORS);
+    TEST_ASSERT_TRUE(RttEstimator::classFor(KEEP_ALIVE) == RttClass::CONTROL);
+}
+
+void test_unprimed_uses_configured_bounds(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(config.commandTimeout, estimator.getTimeoutMs(SENSOR, config));
+    TEST_ASSERT_EQUAL_UINT32(config.queueInterval, estimator.getGapMs(SENSOR, config));
+}
+
+void test_first_sample_primes_rto(void)
+{
+    // SRTT = 100 мс, RTTVAR = 50 мс: RTO = 100 + 4 * 50 = 300 мс
+    estimator.addSample(SENSOR, 100000);
+
+    TEST_ASSERT_EQUAL_UINT32(300, estimator.getTimeoutMs(SENSOR, config));
+    TEST_ASSERT_EQUAL_UINT32(50, estimator.getGapMs(SENSOR, config));
+}
+
+void test_stable_samples_converge_to_floor(void)
+{
+    for (int i = 0; i < 50; i++)
+        estimator.addSample(SENSOR, 60000);
+
+    // RTTVAR стремится к нулю, RTO к SRTT - ниже minCommandTimeout не опускается
+    TEST_ASSERT_EQUAL_UINT32(config.minCommandTimeout, estimator.getTimeoutMs(SENSOR, config));
+    TEST_ASSERT_EQUAL_UINT32(30, estimator.getGapMs(SENSOR, config));
+}
+
+void test_srtt_follows_slower_responses(void)
+{
+    for (int i = 0; i < 50; i++)
+        estimator.addSample(SENSOR, 60000);
+    for (int i = 0; i < 50; i++)
+        estimator.addSample(SENSOR, 400000);
+
+    uint32_t timeout = estimator.getTimeoutMs(SENSOR, config);
+    TEST_ASSERT_GREATER_OR_EQUAL(400, timeout);
+    TEST_ASSERT_LESS_THAN(500, timeout);
+}
+
+void test_timeout_backoff_doubles_and_resets(void)
+{
+    estimator.addSample(SENSOR, 100000); // RTO 300 мс
+
+    estimator.onTimeout(SENSOR);
+    TEST_ASSERT_EQUAL_UINT32(600, estimator.getTimeoutMs(SENSOR, config));
+    estimator.onTimeout(SENSOR);
+    TEST_ASSERT_EQUAL_UINT32(1200, estimator.getTimeoutMs(SENSOR, config));
+
+    // Верхняя граница - commandTimeout
+    estimator.onTimeout(SENSOR);
+    TEST_ASSERT_EQUAL_UINT32(config.commandTimeout, estimator.getTimeoutMs(SENSOR, config));
+
+    // Ответ снимает удвоение
+    estimator.addSample(SENSOR, 100000);
+    TEST_ASSERT_LESS_THAN(600, estimator.getTimeoutMs(SENSOR, config));
+}
+
+void test_backoff_is_bounded(void)
+{
+    config.commandTimeout = 100000;
+    estimator.addSample(SENSOR, 100000);
+
+    for (int i = 0; i < 10; i++)
+        estimator.onTimeout(SENSOR);
+
+    TEST_ASSERT_EQUAL_UINT32(300u << RttEstimator::MAX_BACKOFF_SHIFT, estimator.getTimeoutMs(SENSOR, config));
+}
+
+void test_classes_are_independent(void)
+{
+    estimator.addSample(SENSOR, 100000);
+    estimator.onTimeout(ERRORS);
+
+    TEST_ASSERT_EQUAL_UINT32(300, estimator.getTimeoutMs(SENSOR, config));
+    TEST_ASSERT_EQUAL_UINT32(config.commandTimeout, estimator.getTimeoutMs(ERRORS, config));
+    TEST_ASSERT_EQUAL_UINT32(config.commandTimeout, estimator.getTimeoutMs(INFO, config));
+}
+
+void test_reply_wire_time_is_added_to_timeout(void)
+{
+    for (int i = 0; i < 50; i++)
+        estimator.addSample(SENSOR, 60000);
+
+    // Групповое чтение: 6 страниц, 72 байта данных * 4583 мкс = 330 мс сверх RTT
+    const uint32_t replyWireUs = 72 * 4583;
+    for (int i = 0; i < 50; i++)
+        estimator.addSample(SENSOR, 60000 + replyWireUs, replyWireUs);
+
+    // Длинные ответы не сдвигают оценку одиночного чтения
+    TEST_ASSERT_EQUAL_UINT32(config.minCommandTimeout, estimator.getTimeoutMs(SENSOR, config));
+    TEST_ASSERT_EQUAL_UINT32(config.minCommandTimeout + 330, estimator.getTimeoutMs(SENSOR, config, replyWireUs));
+}
+
+void test_reset_forgets_samples(void)
+{
+    estimator.addSample(KEEP_ALIVE, 50000);
+    estimator.reset();
+
+    TEST_ASSERT_EQUAL_UINT32(config.commandTimeout, estimator.getTimeoutMs(KEEP_ALIVE, config));
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_command_classes);
+    RUN_TEST(test_unprimed_uses_configured_bounds);
+    RUN_TEST(test_first_sample_primes_rto);
+    RUN_TEST(test_stable_samples_converge_to_floor);
+    RUN_TEST(test_srtt_follows_slower_responses);
+    RUN_TEST(test_timeout_backoff_doubles_and_resets);
+    RUN_TEST(test_backoff_is_bounded);
+    RUN_TEST(test_classes_are_independent);
+    RUN_TEST(test_reply_wire_time_is_added_to_timeout);
+    RUN_TEST(test_reset_forgets_samples);
+    return UNITY_END();
+}
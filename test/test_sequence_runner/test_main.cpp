@@ -0,0 +1,321 @@
+// test/test_sequence_runner/test_main.cpp
+// Этапы последовательностей, причины прерывания, шаги DELAY/SNAPSHOT/DRAIN (pio test -e native)
+#include <Arduino.h>
+#include <unity.h>
+#include <string.h>
+#include "../../host/ScriptedBus.h"
+#include "application/SequenceRunner.h"
+
+HardwareSerial Serial(0);
+LittleFSFS LittleFS;
+
+static const uint8_t STATUS_PAGE = WBusCommandBuilder::SENSOR_STATUS_FLAGS;
+static const uint8_t OPERATIONAL_PAGE = WBusCommandBuilder::SENSOR_OPERATIONAL;
+static const uint8_t STATE_PAGE = WBusCommandBuilder::SENSOR_OPERATING_STATE;
+
+static ScriptedStack stack;
+static SequenceRunner runner(stack.commandManager, stack.bus, stack.clock);
+
+static SequenceReport report;
+static bool finished = false;
+static unsigned long calledAt = 0;
+
+static WBusFrame sensor(uint8_t index)
+{
+    return WBusCommandBuilder::createReadSensor(index);
+}
+
+static void onFinished(const SequenceReport &finishedReport)
+{
+    report = finishedReport;
+    finished = true;
+}
+
+static void markCalled()
+{
+    calledAt = stack.clock.nowMs();
+}
+
+static void step()
+{
+    stack.step();
+    runner.process();
+}
+
+template <typename Condition>
+static bool runUntil(Condition done, unsigned long limitMs = 60000)
+{
+    unsigned long startedAt = stack.clock.nowMs();
+    while (!done())
+    {
+        if (stack.clock.nowMs() - startedAt >= limitMs)
+            return false;
+        step();
+    }
+    return true;
+}
+
+static void runFor(unsigned long ms)
+{
+    unsigned long startedAt = stack.clock.nowMs();
+    while (stack.clock.nowMs() - startedAt < ms)
+        step();
+}
+
+static bool wasSent(uint8_t index)
+{
+    for (size_t i = 0; i < stack.bus.sent.size(); i++)
+    {
+        if (stack.bus.sent[i][3] == index)
+            return true;
+    }
+    return false;
+}
+
+// Ждет передачи кадра номер count и отвечает на него как блок
+static void answer(size_t count)
+{
+    TEST_ASSERT_TRUE(runUntil([count]()
+                              { return stack.bus.sent.size() >= count; }));
+    runFor(static_cast<unsigned long>(stack.bus.last().size() * stack.bus.byteTimeUs() / 1000 + 1));
+
+    const std::vector<uint8_t> &tx = stack.bus.sent[count - 1];
+    stack.bus.reply({0x4F, 0x04, static_cast<uint8_t>(tx[2] | 0x80), tx[3], 0x00});
+    step();
+}
+
+static const SequenceReport::Step &reportStep(const char *name)
+{
+    for (size_t i = 0; i < report.count; i++)
+    {
+        if (strcmp(report.steps[i].name, name) == 0)
+            return report.steps[i];
+    }
+    TEST_FAIL_MESSAGE("Шаг не найден в отчете");
+    return report.steps[0];
+}
+
+void setUp(void)
+{
+    runner.cancel();
+    stack.reset();
+    report = SequenceReport();
+    finished = false;
+    calledAt = 0;
+}
+
+void tearDown(void) {}
+
+void test_next_stage_starts_after_current_one(void)
+{
+    runner.prepare("stages")
+        .send("status", sensor(STATUS_PAGE))
+        .send("operational", sensor(OPERATIONAL_PAGE))
+        .stage()
+        .send("state", sensor(STATE_PAGE));
+    runner.start(onFinished);
+
+    // Оба шага первого этапа ставятся сразу, третий ждет их завершения
+    answer(1);
+    TEST_ASSERT_TRUE(runUntil([]()
+                              { return stack.bus.sent.size() >= 2; }));
+    runFor(stack.config().commandTimeout / 2);
+    TEST_ASSERT_FALSE(wasSent(STATE_PAGE));
+
+    answer(stack.bus.sent.size());
+    TEST_ASSERT_TRUE(runUntil([]()
+                              { return wasSent(STATE_PAGE); }));
+    answer(stack.bus.sent.size());
+
+    TEST_ASSERT_TRUE(runUntil([]()
+                              { return finished; }));
+    TEST_ASSERT_EQUAL((int)SequenceState::COMPLETED, (int)report.state);
+    TEST_ASSERT_EQUAL(0, reportStep("status").stage);
+    TEST_ASSERT_EQUAL(0, reportStep("operational").stage);
+    TEST_ASSERT_EQUAL(1, reportStep("state").stage);
+    TEST_ASSERT_EQUAL((int)StepState::DONE, (int)reportStep("state").state);
+    TEST_ASSERT_GREATER_OR_EQUAL(reportStep("operational").startMs + reportStep("operational").durationMs,
+                                 reportStep("state").startMs);
+}
+
+void test_required_step_failure_aborts(void)
+{
+    runner.prepare("failed")
+        .send("diagnostic", sensor(STATUS_PAGE), true)
+        .stage()
+        .send("after", sensor(OPERATIONAL_PAGE));
+    runner.start(onFinished);
+
+    TEST_ASSERT_TRUE(runUntil([]()
+                              { return finished; }));
+    TEST_ASSERT_EQUAL((int)SequenceState::ABORTED, (int)report.state);
+    TEST_ASSERT_EQUAL((int)SequenceAbort::STEP_FAILED, (int)report.abort);
+    TEST_ASSERT_EQUAL_STRING("diagnostic", report.abortStep);
+    TEST_ASSERT_EQUAL((int)CommandOutcome::TIMEOUT, (int)reportStep("diagnostic").outcome);
+
+    // Следующий этап не начинался
+    TEST_ASSERT_EQUAL((int)StepState::SKIPPED, (int)reportStep("after").state);
+    for (size_t i = 0; i < stack.bus.sent.size(); i++)
+        TEST_ASSERT_EQUAL_HEX8(STATUS_PAGE, stack.bus.sent[i][3]);
+}
+
+void test_optional_step_failure_does_not_abort(void)
+{
+    runner.prepare("optional")
+        .send("optional", sensor(STATUS_PAGE))
+        .stage()
+        .call("after", markCalled);
+    runner.start(onFinished);
+
+    TEST_ASSERT_TRUE(runUntil([]()
+                              { return finished; }));
+    TEST_ASSERT_EQUAL((int)SequenceState::COMPLETED, (int)report.state);
+    TEST_ASSERT_EQUAL((int)StepState::FAILED, (int)reportStep("optional").state);
+    TEST_ASSERT_EQUAL((int)StepState::DONE, (int)reportStep("after").state);
+    TEST_ASSERT_TRUE(calledAt > 0);
+}
+
+void test_required_step_timeout_aborts(void)
+{
+    const uint32_t stepTimeout = 300;
+    runner.prepare("timeout")
+        .send("slow", sensor(STATUS_PAGE), true, stepTimeout);
+    runner.start(onFinished);
+    unsigned long startedAt = stack.clock.nowMs();
+
+    TEST_ASSERT_TRUE(runUntil([]()
+                              { return finished; }));
+    TEST_ASSERT_EQUAL((int)SequenceAbort::STEP_TIMEOUT, (int)report.abort);
+    TEST_ASSERT_EQUAL_STRING("slow", report.abortStep);
+    TEST_ASSERT_EQUAL((int)CommandOutcome::PENDING, (int)reportStep("slow").outcome);
+
+    // Прервана по таймауту шага, не дожидаясь таймаута команды
+    unsigned long waited = stack.clock.nowMs() - startedAt;
+    TEST_ASSERT_GREATER_OR_EQUAL(stepTimeout, waited);
+    TEST_ASSERT_LESS_THAN(stack.config().commandTimeout, waited);
+}
+
+void test_rejected_required_step_aborts(void)
+{
+    stack.bus.disconnect();
+    runner.prepare("rejected")
+        .send("diagnostic", sensor(STATUS_PAGE), true);
+    runner.start(onFinished);
+
+    // Команда не принята в очередь - прерывание сразу при запуске
+    TEST_ASSERT_TRUE(finished);
+    TEST_ASSERT_EQUAL((int)SequenceAbort::STEP_REJECTED, (int)report.abort);
+    TEST_ASSERT_EQUAL_STRING("diagnostic", report.abortStep);
+    TEST_ASSERT_EQUAL(0, stack.bus.sent.size());
+}
+
+void test_sequence_timeout_aborts(void)
+{
+    runner.prepare("sequence", 1000)
+        .delay("pause", 5000)
+        .call("after", markCalled);
+    runner.start(onFinished);
+
+    TEST_ASSERT_TRUE(runUntil([]()
+                              { return finished; }));
+    TEST_ASSERT_EQUAL((int)SequenceAbort::STEP_TIMEOUT, (int)report.abort);
+    TEST_ASSERT_EQUAL_STRING("sequence", report.abortStep);
+    TEST_ASSERT_EQUAL(1000, report.durationMs);
+    TEST_ASSERT_EQUAL(0, calledAt);
+}
+
+void test_delay_step_pauses_next_stage(void)
+{
+    runner.prepare("delay")
+        .delay("pause", 500)
+        .call("after", markCalled);
+    runner.start(onFinished);
+    unsigned long startedAt = stack.clock.nowMs();
+
+    TEST_ASSERT_TRUE(runUntil([]()
+                              { return finished; }));
+    TEST_ASSERT_EQUAL((int)SequenceState::COMPLETED, (int)report.state);
+    TEST_ASSERT_EQUAL(500, calledAt - startedAt);
+    TEST_ASSERT_EQUAL(500, reportStep("pause").durationMs);
+    TEST_ASSERT_EQUAL(1, reportStep("after").stage);
+}
+
+void test_snapshot_waits_for_every_poll_page(void)
+{
+    runner.prepare("snapshot")
+        .poll("operational", sensor(OPERATIONAL_PAGE))
+        .poll("state", sensor(STATE_PAGE))
+        .stage()
+        .snapshot(5000)
+        .call("after", markCalled);
+    runner.start(onFinished);
+
+    // Пока ответила одна страница из двух, снимок не полный
+    answer(1);
+    TEST_ASSERT_FALSE(finished);
+    TEST_ASSERT_EQUAL(0, calledAt);
+
+    answer(2);
+    TEST_ASSERT_TRUE(runUntil([]()
+                              { return finished; }));
+    TEST_ASSERT_EQUAL((int)SequenceState::COMPLETED, (int)report.state);
+    TEST_ASSERT_EQUAL((int)StepState::DONE, (int)reportStep("snapshot").state);
+    TEST_ASSERT_TRUE(runner.toJson().indexOf("\"lastMs\":" + String(reportStep("snapshot").startMs +
+                                                                         reportStep("snapshot").durationMs)) >= 0);
+}
+
+void test_required_snapshot_times_out(void)
+{
+    runner.prepare("snapshot")
+        .poll("operational", sensor(OPERATIONAL_PAGE))
+        .stage()
+        .snapshot(300, true);
+    runner.start(onFinished);
+
+    TEST_ASSERT_TRUE(runUntil([]()
+                              { return finished; }));
+    TEST_ASSERT_EQUAL((int)SequenceAbort::STEP_TIMEOUT, (int)report.abort);
+    TEST_ASSERT_EQUAL_STRING("snapshot", report.abortStep);
+}
+
+void test_drain_waits_for_foreground_commands(void)
+{
+    stack.commandManager.addCommand(sensor(STATUS_PAGE), CommandClass::INTERACTIVE);
+    stack.commandManager.addCommand(sensor(OPERATIONAL_PAGE), CommandClass::INTERACTIVE);
+
+    runner.prepare("drain")
+        .drain(10000)
+        .call("after", markCalled);
+    runner.start(onFinished);
+
+    answer(1);
+    TEST_ASSERT_EQUAL(0, calledAt);
+
+    // Последняя разовая команда еще ждет ответа
+    TEST_ASSERT_TRUE(runUntil([]()
+                              { return stack.bus.sent.size() >= 2; }));
+    runFor(stack.config().commandTimeout / 2);
+    TEST_ASSERT_EQUAL(0, calledAt);
+
+    answer(stack.bus.sent.size());
+    TEST_ASSERT_TRUE(runUntil([]()
+                              { return finished; }));
+    TEST_ASSERT_EQUAL((int)StepState::DONE, (int)reportStep("drain").state);
+    TEST_ASSERT_TRUE(calledAt > 0);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_next_stage_starts_after_current_one);
+    RUN_TEST(test_required_step_failure_aborts);
+    RUN_TEST(test_optional_step_failure_does_not_abort);
+    RUN_TEST(test_required_step_timeout_aborts);
+    RUN_TEST(test_rejected_required_step_aborts);
+    RUN_TEST(test_sequence_timeout_aborts);
+    RUN_TEST(test_delay_step_pauses_next_stage);
+    RUN_TEST(test_snapshot_waits_for_every_poll_page);
+    RUN_TEST(test_required_snapshot_times_out);
+    RUN_TEST(test_drain_waits_for_foreground_commands);
+    return UNITY_END();
+}